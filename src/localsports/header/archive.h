@@ -0,0 +1,88 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+struct sqlite3;
+
+namespace teamcore {
+namespace archive {
+
+    // =================== Season Catalog ===================
+    /**
+     * @brief Bir sezonun (takvim yılı) sıcak tablolardaki durumu
+     */
+    struct SeasonInfo {
+        std::string season;  ///< "YYYY" (games.date ilk 4 karakter)
+        int games = 0;       ///< Sezondaki maç sayısı
+        int unplayed = 0;    ///< Oynanmamış maç sayısı (0 değilse sezon kapalı değil)
+        bool closed = false; ///< Geçmiş yıl ve tüm maçlar oynanmış
+    };
+
+    /**
+     * @brief Arşivlenmiş bir sezon (_ls_archives kataloğu)
+     */
+    struct ArchiveEntry {
+        std::string season;
+        std::string path;    ///< Arşiv dosyası yolu
+        int games = 0;
+        int stats = 0;
+        int messages = 0;
+        std::string archivedAt;
+    };
+
+    /**
+     * @brief Katalog tablosunu oluştur (yoksa)
+     */
+    bool EnsureCatalog(sqlite3* db);
+
+    /**
+     * @brief Sıcak tablolardaki sezonları listele
+     * @param currentYear Bu yıl ve sonrası hiçbir zaman kapalı sayılmaz
+     */
+    std::vector<SeasonInfo> ListSeasons(sqlite3* db, int currentYear);
+
+    /**
+     * @brief Arşivlenmiş sezonları listele (en yeni önce)
+     */
+    std::vector<ArchiveEntry> ListArchives(sqlite3* db);
+
+    /**
+     * @brief Ana veritabanı yolundan sezon arşiv dosyası yolunu üret
+     * @details "dir/localsports.db" + "2023" -> "dir/localsports_2023.db"
+     */
+    std::string ArchivePathFor(const std::string& dbPath, const std::string& season);
+
+    // =================== Archive / Attach ===================
+    /**
+     * @brief Kapalı bir sezonun games/stats/messages satırlarını sezon dosyasına taşı
+     * @details Arşiv dosyası okuma-yazma ATTACH edilir. Satırlar önce arşive kopyalanıp
+     *          ayrı bir transaction'da commit edilir (synchronous=FULL); ardından ikinci
+     *          transaction'da her sezon satırının arşivde bulunduğu doğrulanıp ana veritabanından
+     *          silinir. WAL modunda ATTACH edilmiş dosyalar arası commit atomik olmadığından
+     *          arada çökme satırları iki yerde bırakır, hiçbir zaman kaybettirmez; kopyalama
+     *          INSERT OR REPLACE olduğundan işlem tekrar çalıştırılabilir.
+     *          Bağlı arşivler ve birleşik görünümler önce kaldırılır.
+     * @param season "YYYY"
+     * @param out Taşınan satır sayıları (isteğe bağlı)
+     * @return false ise sezon kapalı değil, bulunamadı veya SQL hatası
+     */
+    bool ArchiveSeason(sqlite3* db, const std::string& dbPath, const std::string& season,
+                       int currentYear, ArchiveEntry* out = nullptr);
+
+    /**
+     * @brief Katalogdaki arşivleri salt-okunur ATTACH et ve birleşik TEMP görünümleri kur
+     * @details all_games, all_stats, all_messages: main + arch_YYYY tabloları (UNION ALL).
+     *          Bağlantı SQLITE_OPEN_URI ile açılmış olmalıdır (file:...?mode=ro).
+     *          ATTACH limiti aşılırsa en yeni sezonlar bağlanır.
+     * @return Bağlanan arşiv sayısı; hata durumunda -1
+     */
+    int AttachArchives(sqlite3* db);
+
+    /**
+     * @brief Birleşik görünümleri kaldır ve arch_* veritabanlarını ayır
+     */
+    void DetachArchives(sqlite3* db);
+
+} // namespace archive
+} // namespace teamcore
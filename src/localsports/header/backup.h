@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+struct sqlite3;
+
+namespace teamcore {
+namespace backup {
+
+    // =================== Options & Progress ===================
+    /**
+     * @brief Yedekleme ilerleme bilgisi
+     */
+    struct BackupProgress {
+        int totalPages = 0;      ///< Kaynak veritabanındaki toplam sayfa
+        int remainingPages = 0;  ///< Kopyalanmayı bekleyen sayfa
+        int steps = 0;           ///< sqlite3_backup_step çağrı sayısı
+    };
+
+    /**
+     * @brief Yedekleme/geri yükleme seçenekleri
+     */
+    struct BackupOptions {
+        int pagesPerStep = 64;   ///< Her adımda kopyalanacak sayfa (küçük = daha az kilit süresi)
+        int sleepMs = 5;         ///< Adımlar arası bekleme (throttle); yazarlar bu sürede ilerler
+        bool encrypt = false;    ///< Çıktıyı AES-256-GCM ile şifrele
+        const unsigned char* key = nullptr; ///< 32 baytlık paket anahtarı (nullptr = AppKey); iş bitene kadar geçerli kalmalı
+        bool compress = false;   ///< Sıfır dizilerini sıkıştır (secure_delete boş alanı sıfırlar)
+        bool verify = true;      ///< Bitişte quick_check + paket geri okuma doğrulaması
+        std::function<void(const BackupProgress&)> onProgress; ///< Her adımdan sonra çağrılır
+    };
+
+    enum class BackupStatus {
+        IDLE,
+        RUNNING,
+        SUCCEEDED,
+        FAILED,
+        CANCELLED
+    };
+
+    // =================== BackupJob ===================
+    /**
+     * @brief SQLite online backup API ile arka plan yedekleme/geri yükleme işi
+     * @details Kaynak bağlantı olarak uygulamanın kendi bağlantısı kullanılır; böylece
+     *          aynı bağlantı üzerinden yapılan yazmalar yedeği yeniden başlatmaz.
+     *          Adımlar arasında kilit bırakılır, etkileşimli yazmalar bloklanmaz.
+     */
+    class BackupJob {
+    public:
+        BackupJob();
+        ~BackupJob();
+        BackupJob(const BackupJob&) = delete;
+        BackupJob& operator=(const BackupJob&) = delete;
+
+        /**
+         * @brief Canlı veritabanının yedeğini arka planda başlat
+         * @details Paketlenen (encrypt/compress) yedekte düz kopya diske yazılmaz: varsayılan
+         *          VFS'te sayfalar bellekte toplanıp paketlenir. Sayfa VFS'inde ara dosya o VFS
+         *          üzerinden 0600 yazılır ve silinmeden önce sıfırlanır; geri yükleme de aynı yolu izler.
+         * @param source Açık kaynak bağlantı (SQLITE_OPEN_FULLMUTEX)
+         * @param destPath Yedek dosya yolu
+         * @return false ise iş zaten çalışıyor veya parametre hatalı
+         */
+        bool StartBackup(sqlite3* source, const std::string& destPath, const BackupOptions& options);
+
+        /**
+         * @brief Yedek dosyasını hedef bağlantıya arka planda geri yükle
+         * @details Düz SQLite dosyası veya şifreli/sıkıştırılmış paket kabul edilir.
+         * @param target Geri yüklenecek bağlantı (iş süresince kullanılmamalı)
+         * @param backupPath Yedek dosya yolu
+         */
+        bool StartRestore(sqlite3* target, const std::string& backupPath, const BackupOptions& options);
+
+        /**
+         * @brief İş bitene kadar bekle
+         * @return Son durum
+         */
+        BackupStatus Wait();
+
+        /**
+         * @brief Çalışan işi iptal et (bir sonraki adımda durur)
+         */
+        void Cancel();
+
+        BackupStatus Status() const { return status_.load(); }
+        BackupProgress Progress() const;
+        std::string LastError() const;
+
+    private:
+        void RunBackup(sqlite3* source, std::string destPath, BackupOptions options);
+        void RunRestore(sqlite3* target, std::string backupPath, BackupOptions options);
+        bool CopyPages(sqlite3* from, sqlite3* to, const BackupOptions& options);
+        void Fail(const std::string& message);
+        void Join();
+
+        std::thread worker_;
+        std::atomic<BackupStatus> status_;
+        std::atomic<bool> cancel_;
+        mutable std::mutex mutex_;
+        BackupProgress progress_;
+        std::string lastError_;
+    };
+
+    // =================== Synchronous Helpers ===================
+    /**
+     * @brief Yedeği başlat ve bitmesini bekle
+     * @return true ise yedek başarılı (ve verify açıksa doğrulandı)
+     */
+    bool RunBackup(sqlite3* source, const std::string& destPath, const BackupOptions& options);
+
+    /**
+     * @brief Geri yüklemeyi başlat ve bitmesini bekle
+     */
+    bool RunRestore(sqlite3* target, const std::string& backupPath, const BackupOptions& options);
+
+    /**
+     * @brief Yedek dosyasını doğrula (paket ise açılır, sonra PRAGMA quick_check)
+     * @param vfs Yedeği açarken kullanılacak VFS (sayfa şifreli yedekler için; nullptr = varsayılan)
+     * @param key Şifreli paketin anahtarı (BackupOptions::key ile aynı; nullptr = AppKey)
+     * @return true ise yedek okunabilir ve tutarlı
+     */
+    bool VerifyBackup(const std::string& backupPath, const char* vfs = nullptr, const unsigned char* key = nullptr);
+
+} // namespace backup
+} // namespace teamcore
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "security_layer.h"
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+namespace teamcore {
+namespace hybrid {
+
+    // =================== Configuration ===================
+    /**
+     * @brief Hibrit (RAM + kalıcı log) mod ayarları
+     */
+    struct HybridConfig {
+        std::string diskPath;                 ///< Kalıcı veritabanı dosyası
+        std::string logPath;                  ///< Boşsa diskPath + ".journal"
+        std::string vfs;                      ///< Disk (ve ATTACH) için VFS; boşsa varsayılan
+        unsigned checkpointIntervalMs = 5000; ///< Periyodik checkpoint aralığı
+        uint64_t checkpointLogBytes = 1u << 20; ///< Log bu boyutu aşınca erken checkpoint
+        const unsigned char* logKey = nullptr; ///< 32 bayt; verilirse log kayıtları AES-256-GCM ile şifrelenir
+        std::function<bool(sqlite3*)> diskSetup; ///< Disk bağlantısı açıldığında (yükleme öncesi) çağrılır
+    };
+
+    /**
+     * @brief Hibrit mod sayaçları
+     */
+    struct HybridStats {
+        uint64_t loggedTx = 0;        ///< Log'a yazılan commit
+        uint64_t replayedTx = 0;      ///< Açılışta yeniden uygulanan commit
+        uint64_t replayErrors = 0;    ///< Replay sırasında hata veren ifade (ilk çalıştırmada da hata vermiştir)
+        uint64_t checkpoints = 0;     ///< Diske yazılan tam görüntü
+        uint64_t checkpointSeq = 0;   ///< Diskteki görüntünün içerdiği son sıra numarası
+        uint64_t lastSeq = 0;         ///< Son commit sıra numarası
+        uint64_t logBytes = 0;        ///< Güncel log boyutu
+        double lastCheckpointMs = 0;  ///< Son checkpoint süresi
+    };
+
+    // =================== HybridStore ===================
+    /**
+     * @brief Veritabanını RAM'e yükleyip sorguları bellekten sunan, yazmaları log ile kalıcı kılan depo
+     * @details Açılışta disk dosyası backup API ile bir :memory: veritabanına kopyalanır ve
+     *          log'daki checkpoint sonrası kayıtlar yeniden uygulanır. Yazma yapan her ifade
+     *          (parametreleri açılmış SQL) commit anında sıra numarasıyla log'a eklenip fsync
+     *          edilir. Arka plan thread'i periyodik olarak bellek görüntüsünü diske yazar
+     *          (sıra numarası görüntünün içinde tutulur) ve log'u sıfırlar.
+     *          Replay, ifadelerin deterministik olmasına dayanır: datetime('now') / random()
+     *          gibi değerler SQL içinde değil, parametre olarak verilmelidir. Yalnızca "main"
+     *          şemasını değiştiren ifadeler loglanır; ATTACH/DETACH, BEGIN, TEMP nesneleri ve
+     *          bağlı veritabanlarına yazmalar (ör. arşiv) loglanmaz: replay her kaydı kendi
+     *          transaction'ında, arşivler bağlı olmadan uygular.
+     */
+    class HybridStore {
+    public:
+        HybridStore();
+        ~HybridStore();
+        HybridStore(const HybridStore&) = delete;
+        HybridStore& operator=(const HybridStore&) = delete;
+
+        /**
+         * @brief Diski yükle, log'u uygula, hook'ları ve checkpoint thread'ini başlat
+         * @return false ise açılış başarısız (ayrıntı std::cerr'e yazılır)
+         */
+        bool Open(const HybridConfig& config);
+
+        /**
+         * @brief Son checkpoint'i yap ve kapat (Db() geçersizleşir)
+         */
+        void Close();
+
+        /**
+         * @brief Bellek görüntüsünü hemen diske yaz ve log'u sıfırla
+         * @return true ise disk görüntüsü güncel
+         */
+        bool Checkpoint();
+
+        bool IsOpen() const { return mem_ != nullptr; }
+        sqlite3* Db() const { return mem_; }      ///< Uygulamanın kullanacağı bellek bağlantısı
+        sqlite3* DiskDb() const { return disk_; } ///< Yalnızca okuma/inceleme için
+        const std::string& DiskPath() const { return config_.diskPath; }
+        HybridStats Stats() const;
+
+    private:
+        static int TraceThunk(unsigned type, void* self, void* p, void* x);
+        static int CommitThunk(void* self);
+        static void RollbackThunk(void* self);
+        static int AuthorizeThunk(void* self, int action, const char* a1, const char* a2,
+                                  const char* schema, const char* trigger);
+
+        void OnStatement(sqlite3_stmt* stmt, const char* sql);
+        bool TargetsMainOnly(const char* sql);
+        int OnCommit();
+        void OnRollback();
+
+        bool LoadFromDisk();
+        bool Replay();
+        bool OpenLog(bool truncate);
+        bool AppendRecord(uint64_t seq, const std::string& payload);
+        bool CheckpointLocked();
+        void CheckpointLoop();
+
+        HybridConfig config_;
+        SecureBuffer logKey_;
+        sqlite3* mem_;
+        sqlite3* disk_;
+        std::FILE* log_;
+
+        // Commit hook'u uygulama thread'inde, bellek bağlantısının mutex'i altında çalışır
+        std::vector<std::string> pending_;
+        std::unordered_map<std::string, bool> mainOnly_; ///< SQL metni -> yalnızca "main"e yazar mı
+        bool probeMain_;
+        bool probeForeign_;
+        bool suppress_;
+        std::atomic<uint64_t> lastSeq_;
+
+        mutable std::mutex statsMutex_;
+        HybridStats stats_;
+
+        std::thread worker_;
+        std::mutex wakeMutex_;
+        std::condition_variable wake_;
+        std::atomic<bool> running_;
+    };
+
+} // namespace hybrid
+} // namespace teamcore
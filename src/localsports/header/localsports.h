@@ -3,6 +3,7 @@
 #define LOCALSPORTS_H
 
 #include <cstdint>
+#include <iosfwd>
 
 // --------- Binary file names (defined in .cpp) ----------
 extern const char* FILE_PLAYERS;
@@ -60,6 +61,9 @@ struct User {
 
 // --------------- Public API (used by app) ---------------
 void LS_Init();
+// Expensive setup without opening the database (AppKey KDF, subkeys, page VFS). The zygote calls it
+// before forking; LS_Init does it too and skips what is already done. false = error (on cerr)
+bool LS_Preload();
 
 // Roster
 void LS_ListPlayersInteractive();
@@ -75,10 +79,33 @@ void LS_RecordResultInteractive();
 // Statistics
 void LS_RecordStatsInteractive();
 void LS_ViewPlayerTotalsInteractive();
+void LS_ViewAllSeasonTotalsInteractive();
 
 // Communications
 void LS_ListMessagesInteractive();
 void LS_AddMessageInteractive();
+void LS_SearchMessagesInteractive();
+
+// Message feed: messages with id > afterId in id order, at most limit; only this page is decrypted.
+// Returns the count, -1 on error. Wait blocks up to timeoutMs until a commit in this process
+// publishes a newer message, then fetches once more (0 = nothing new).
+int LS_FetchMessages(uint32_t afterId, Message* page, int limit);
+int LS_WaitForMessages(uint32_t afterId, Message* page, int limit, int timeoutMs);
+
+// Read state of the logged-in user. The unread count comes from counters kept by triggers
+// (no scan of messages); -1 when nobody is logged in. The read cursor only moves forward;
+// LS_ListMessagesInteractive marks everything it showed as read.
+int LS_UnreadMessageCount();
+bool LS_MarkMessagesRead(uint32_t upToId);
+
+// Messages are stored in one table per month behind the "messages" view.
+// Drops every month before "YYYY-MM" as a whole table; returns messages removed, -1 on error.
+int LS_PurgeMessagesBefore(const char* month);
+
+// Keyword search over encrypted messages: words are normalized and stored as HMAC tokens in an
+// inverted index; only matching rows are decrypted. Messages older than the index are backfilled
+// in batches on first search. Newest first; returns the count, -1 on error.
+int LS_SearchMessages(const char* query, Message* page, int limit);
 
 // Authentication
 bool LS_AuthLoginInteractive();
@@ -87,4 +114,94 @@ void LS_AuthLogout();
 bool LS_IsAuthenticated();
 const char* LS_CurrentUsername();
 
+// Data management
+void LS_BackupInteractive();
+void LS_RestoreInteractive();
+void LS_MaintenanceStatusInteractive();
+void LS_ArchiveSeasonInteractive();
+
+// Encryption at rest (call before LS_Init; LS_DB_ENCRYPTION=page selects PAGES in the app)
+enum LSEncryptionMode {
+    LS_ENCRYPT_FIELDS = 0, // per-field AES-GCM on PII columns (default)
+    LS_ENCRYPT_PAGES = 1   // whole-page AES-GCM through the "ls-crypt" VFS; columns stay searchable
+};
+void LS_SetEncryptionMode(LSEncryptionMode mode);
+LSEncryptionMode LS_GetEncryptionMode();
+// Per-page checksums for FIELDS mode through the "ls-cksum" VFS (call before LS_Init; LS_DB_CHECKSUMS=1
+// in the app). Applies to newly created database files; PAGES mode is already authenticated by AES-GCM.
+// Either way a background verifier sweeps the file and logs DB_PAGE_CHECKSUM_MISMATCH events.
+void LS_SetPageChecksums(bool enabled);
+bool LS_GetPageChecksums();
+
+// Storage (call before LS_Init; the app reads LS_DB_PATH and LS_DB_MODE=memory)
+enum LSStorageMode {
+    LS_STORAGE_DISK = 0,  // queries go to the database file (default)
+    LS_STORAGE_MEMORY = 1 // file loaded into RAM; commits journaled to <path>.journal, checkpointed in background
+};
+void LS_SetDatabasePath(const char* path); // nullptr/"" = "localsports.db"
+const char* LS_GetDatabasePath();
+void LS_SetStorageMode(LSStorageMode mode);
+LSStorageMode LS_GetStorageMode();
+
+// Tenants (one database per club under LS_TENANT_DIR, default "tenants")
+void LS_ConfigureTenants(const char* baseDir, int maxOpen);
+bool LS_SelectTenant(const char* tenantId); // nullptr/"" = default database
+void LS_SelectTenantInteractive();
+const char* LS_CurrentTenant();
+
+// ------------- Instance-scoped contexts -----------------
+// Each context owns its connection(s), AppKey, caches and login session. Every API above
+// has an overload taking the context first; the plain signatures use LS_DefaultContext().
+// A context must be used by one thread at a time; different contexts may run in parallel.
+// Backups are still sealed with the process-wide AppKey.
+struct LSContext;
+LSContext& LS_DefaultContext();
+LSContext* LS_CreateContext(const char* dbPath); // nullptr/"" = "localsports.db"
+void LS_DestroyContext(LSContext* ctx);          // closes its databases; ignores the default context
+void LS_SetContextKey(LSContext& ctx, const unsigned char key32[32]); // before LS_Init; skips AppKey prompt
+void LS_SetContextStreams(LSContext& ctx, std::istream* in, std::ostream* out); // nullptr = std::cin/std::cout
+
+void LS_Init(LSContext& ctx);
+bool LS_Preload(LSContext& ctx);
+void LS_ListPlayersInteractive(LSContext& ctx);
+void LS_AddPlayerInteractive(LSContext& ctx);
+void LS_EditPlayerInteractive(LSContext& ctx);
+void LS_RemovePlayerInteractive(LSContext& ctx);
+void LS_ListGamesInteractive(LSContext& ctx);
+void LS_AddGameInteractive(LSContext& ctx);
+void LS_RecordResultInteractive(LSContext& ctx);
+void LS_RecordStatsInteractive(LSContext& ctx);
+void LS_ViewPlayerTotalsInteractive(LSContext& ctx);
+void LS_ViewAllSeasonTotalsInteractive(LSContext& ctx);
+void LS_ListMessagesInteractive(LSContext& ctx);
+void LS_AddMessageInteractive(LSContext& ctx);
+int LS_FetchMessages(LSContext& ctx, uint32_t afterId, Message* page, int limit);
+int LS_WaitForMessages(LSContext& ctx, uint32_t afterId, Message* page, int limit, int timeoutMs); // only reads the context
+int LS_UnreadMessageCount(LSContext& ctx);
+bool LS_MarkMessagesRead(LSContext& ctx, uint32_t upToId);
+int LS_PurgeMessagesBefore(LSContext& ctx, const char* month);
+int LS_SearchMessages(LSContext& ctx, const char* query, Message* page, int limit);
+void LS_SearchMessagesInteractive(LSContext& ctx);
+bool LS_AuthLoginInteractive(LSContext& ctx);
+void LS_AuthRegisterInteractive(LSContext& ctx);
+void LS_AuthLogout(LSContext& ctx);
+bool LS_IsAuthenticated(LSContext& ctx);
+const char* LS_CurrentUsername(LSContext& ctx);
+void LS_BackupInteractive(LSContext& ctx);
+void LS_RestoreInteractive(LSContext& ctx);
+void LS_MaintenanceStatusInteractive(LSContext& ctx);
+void LS_ArchiveSeasonInteractive(LSContext& ctx);
+void LS_SetEncryptionMode(LSContext& ctx, LSEncryptionMode mode);
+LSEncryptionMode LS_GetEncryptionMode(LSContext& ctx);
+void LS_SetPageChecksums(LSContext& ctx, bool enabled);
+bool LS_GetPageChecksums(LSContext& ctx);
+void LS_SetDatabasePath(LSContext& ctx, const char* path);
+const char* LS_GetDatabasePath(LSContext& ctx);
+void LS_SetStorageMode(LSContext& ctx, LSStorageMode mode);
+LSStorageMode LS_GetStorageMode(LSContext& ctx);
+void LS_ConfigureTenants(LSContext& ctx, const char* baseDir, int maxOpen);
+bool LS_SelectTenant(LSContext& ctx, const char* tenantId);
+void LS_SelectTenantInteractive(LSContext& ctx);
+const char* LS_CurrentTenant(LSContext& ctx);
+
 #endif // LOCALSPORTS_H
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+struct sqlite3;
+
+namespace teamcore {
+namespace maintenance {
+
+    // =================== Configuration ===================
+    /**
+     * @brief Bakım zamanlayıcısı ayarları
+     */
+    struct MaintenanceConfig {
+        int pollMs = 250;                        ///< Zamanlayıcı uyanma aralığı
+        int idleMs = 2000;                       ///< Bu süre yazma olmazsa "boşta" sayılır
+        int busyCheckpointPages = 1000;          ///< Boşta olmasa bile PASSIVE checkpoint eşiği (WAL sayfası)
+        int64_t walTruncateBytes = 4 * 1024 * 1024; ///< WAL dosyası bunu aşarsa TRUNCATE checkpoint
+        int optimizeIntervalMs = 60 * 60 * 1000; ///< PRAGMA optimize aralığı
+        int vacuumIntervalMs = 10 * 60 * 1000;   ///< incremental_vacuum aralığı
+        int vacuumPages = 256;                   ///< Tek seferde geri verilecek en fazla serbest sayfa
+        int busyTimeoutMs = 200;                 ///< Bakım bağlantısının kilit bekleme süresi
+    };
+
+    /**
+     * @brief Tek bir bakım görevinin ölçümü
+     */
+    struct TaskTiming {
+        const char* task;   ///< "checkpoint_passive", "checkpoint_truncate", "optimize", "incremental_vacuum"
+        double ms;          ///< Görev süresi
+        int rc;             ///< SQLite dönüş kodu
+        int walFrames;      ///< Checkpoint: WAL'deki frame sayısı; vacuum: öncesi serbest sayfa
+        int done;           ///< Checkpoint: aktarılan frame; vacuum: geri verilen sayfa
+    };
+
+    typedef std::function<void(const TaskTiming&)> TimingSink;
+
+    /**
+     * @brief Toplam bakım istatistikleri
+     */
+    struct MaintenanceStats {
+        uint64_t passiveCheckpoints = 0;
+        uint64_t truncateCheckpoints = 0;
+        uint64_t optimizeRuns = 0;
+        uint64_t vacuumRuns = 0;
+        uint64_t busySkips = 0;      ///< SQLITE_BUSY nedeniyle ertelenen görev
+        double totalMs = 0.0;        ///< Bakıma harcanan toplam süre
+        double maxMs = 0.0;          ///< En uzun tek görev
+    };
+
+    // =================== MaintenanceScheduler ===================
+    /**
+     * @brief WAL checkpoint ve periyodik bakım için arka plan zamanlayıcısı
+     * @details Uygulama bağlantısının otomatik checkpoint'i kapatılır (wal_hook ile değiştirilir);
+     *          böylece checkpoint maliyeti yazma yapan isteğe binmez. Checkpoint ve bakım
+     *          görevleri ayrı bir bakım bağlantısı üzerinden yürütülür, uygulama bağlantısının
+     *          mutex'i tutulmaz. Boşta iken PASSIVE, WAL dosyası büyüdüğünde TRUNCATE çalışır.
+     */
+    class MaintenanceScheduler {
+    public:
+        MaintenanceScheduler();
+        ~MaintenanceScheduler();
+        MaintenanceScheduler(const MaintenanceScheduler&) = delete;
+        MaintenanceScheduler& operator=(const MaintenanceScheduler&) = delete;
+
+        /**
+         * @brief Zamanlayıcıyı başlat
+         * @param appDb Uygulama bağlantısı (WAL modunda); commit bildirimleri buradan alınır
+         * @param dbPath Aynı veritabanının dosya yolu (bakım bağlantısı için)
+         * @param sink Görev ölçümleri; boşsa std::clog'a "[MAINT]" satırı yazılır
+         * @return false ise bakım bağlantısı açılamadı veya zaten çalışıyor
+         */
+        bool Start(sqlite3* appDb, const std::string& dbPath,
+                   const MaintenanceConfig& config = MaintenanceConfig(),
+                   TimingSink sink = TimingSink());
+
+        /**
+         * @brief Zamanlayıcıyı durdur ve otomatik checkpoint'i geri aç
+         */
+        void Stop();
+
+        bool IsRunning() const { return running_.load(); }
+
+        /**
+         * @brief Yazma etkinliğini bildir (boşta sayacını sıfırlar)
+         * @details Uygulama bağlantısındaki commit'ler wal_hook ile otomatik bildirilir.
+         */
+        void NotifyActivity();
+
+        // Görevleri elle tetikleme (zamanlayıcı thread'i de bunları kullanır)
+        int RunPassiveCheckpoint();
+        int RunTruncateCheckpoint();
+        int RunOptimize();
+        int RunIncrementalVacuum();
+
+        /**
+         * @brief WAL dosyasının diskteki boyutu (yoksa 0)
+         */
+        int64_t WalFileBytes() const;
+
+        MaintenanceStats Stats() const;
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        static int WalHook(void* self, sqlite3* db, const char* dbName, int walPages);
+        void Loop();
+        void Tick();
+        int Checkpoint(int mode, const char* task);
+        void Record(const TaskTiming& t);
+
+        sqlite3* appDb_;
+        sqlite3* maintDb_;
+        std::string dbPath_;
+        MaintenanceConfig config_;
+        TimingSink sink_;
+
+        std::thread worker_;
+        std::atomic<bool> running_;
+        std::atomic<int> walPages_;
+        std::atomic<int64_t> lastActivityMs_;
+        Clock::time_point lastOptimize_;
+        Clock::time_point lastVacuum_;
+
+        std::mutex taskMutex_;            // bakım bağlantısını korur
+        std::mutex waitMutex_;
+        std::condition_variable wake_;
+        mutable std::mutex statsMutex_;
+        MaintenanceStats stats_;
+    };
+
+} // namespace maintenance
+} // namespace teamcore
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace teamcore {
+namespace feed {
+
+    // =================== FeedNotifier ===================
+    /**
+     * @brief Veritabanı başına son mesaj id'sini tutan ve bekleyenleri uyandıran bildirim noktası
+     * @details Anahtar veritabanı dosya yoludur; aynı dosyaya farklı bağlantılardan (bağlamlardan)
+     *          yazan ve bekleyenler birbirini görür. Publish commit'ten sonra çağrılır; bekleyen
+     *          taraf kilit altında kontrol ettiği için uyandırma kaybolmaz. Başka süreçlerin
+     *          yazmaları bildirilmez, bu yüzden beklemeler her zaman bir zaman aşımıyla yapılır.
+     */
+    class FeedNotifier {
+    public:
+        /**
+         * @brief Yeni mesajı duyur (id yalnızca büyürse kaydedilir)
+         */
+        void Publish(const std::string& key, uint64_t id);
+
+        /**
+         * @brief Bilinen son id (hiç duyurulmadıysa 0)
+         */
+        uint64_t Latest(const std::string& key) const;
+
+        /**
+         * @brief afterId'den büyük bir id duyurulana ya da süre dolana kadar bekle
+         * @return true ise yeni mesaj duyuruldu
+         */
+        bool WaitBeyond(const std::string& key, uint64_t afterId, unsigned timeoutMs);
+
+    private:
+        mutable std::mutex mutex_;
+        std::condition_variable changed_;
+        std::map<std::string, uint64_t> latest_;
+    };
+
+    /**
+     * @brief Süreç geneli mesaj bildirimcisi
+     */
+    FeedNotifier& MessageFeed();
+
+} // namespace feed
+} // namespace teamcore
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct sqlite3;
+
+namespace teamcore {
+namespace search {
+
+    /**
+     * @brief Backfill sırasında şifreli metni çözen fonksiyon
+     */
+    typedef std::function<std::string(const std::string&)> Decryptor;
+
+    // =================== Tokenizer ===================
+    /**
+     * @brief Metinden normalize edilmiş, tekrarsız kelimeleri çıkar
+     * @details ASCII küçük harfe çevrilir, Türkçe harfler katlanır (ç→c, ğ→g, ı/İ→i, ö→o, ş→s, ü→u),
+     *          harf/rakam dışı karakterler ayırıcıdır; 2 karakterden kısa kelimeler atlanır.
+     */
+    std::vector<std::string> Tokenize(const std::string& text);
+
+    /**
+     * @brief Kelimenin anahtarlı token'ı: HMAC-SHA256(key, kelime) ilk 16 bayt
+     * @details Aynı kelime her zaman aynı token'ı verir (eşitlik araması için); anahtar
+     *          olmadan token'lardan kelime sözlüğü ile geri dönülemez.
+     */
+    std::string TokenFor(const unsigned char key32[32], const std::string& word);
+
+    // =================== Index ===================
+    /**
+     * @brief Ters indeks tablolarını oluştur; mevcut mesajları backfill kuyruğuna al
+     * @param lastId İndeks ilk kez kurulurken var olan en büyük mesaj id'si (bu id'ye kadar backfill)
+     */
+    bool EnsureSchema(sqlite3* db, int64_t lastId);
+
+    /**
+     * @brief Tek mesajın token'larını ekle (çağıranın transaction'ı içinde)
+     */
+    bool IndexMessage(sqlite3* db, const unsigned char key32[32], int64_t id, const std::string& plaintext);
+
+    /**
+     * @brief Backfill kuyruğundan en fazla batch mesajı çöz ve indeksle (tek transaction)
+     * @return İndekslenen mesaj sayısı (0 = backfill bitti); hata durumunda -1
+     */
+    int BackfillBatch(sqlite3* db, const unsigned char key32[32], int batch, const Decryptor& decrypt);
+
+    /**
+     * @brief Backfill'i bekleyen mesaj aralığı var mı?
+     */
+    bool BackfillPending(sqlite3* db);
+
+    /**
+     * @brief Sorgudaki tüm kelimeleri içeren mesaj id'leri (en yeni önce)
+     * @details Mesaj tablosunda artık olmayan id'ler LIMIT'ten önce elenir; limit kadar
+     *          eşleşen mesaj varsa hepsi döner.
+     */
+    std::vector<int64_t> Lookup(sqlite3* db, const unsigned char key32[32], const std::string& query, int limit);
+
+    /**
+     * @brief Silinecek mesajların token'larını sil (saklama süresi / arşiv)
+     * @details Mesajlar silinmeden önce, aynı transaction içinde çağrılır.
+     * @param idQuery Silinecek mesaj id'lerini dönen SELECT; varsa ?1 = param
+     * @return Silinen token sayısı (indeks kurulmamışsa 0); hata durumunda -1
+     */
+    int64_t PruneMessages(sqlite3* db, const std::string& idQuery, const std::string& param);
+
+} // namespace search
+} // namespace teamcore
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct sqlite3;
+
+namespace teamcore {
+namespace partition {
+
+    /**
+     * @brief Aylık bir mesaj bölümü (message_partitions kataloğu)
+     */
+    struct PartitionInfo {
+        std::string month;  ///< "YYYY-MM" (datetime'ı bozuk mesajlar için "0000-00")
+        std::string table;  ///< "messages_pYYYYMM"
+        int64_t rows = 0;   ///< Tetikleyicilerle tutulan satır sayısı
+        int64_t minId = 0;  ///< Bölüme eklenmiş en küçük id (silmelerde daralmaz)
+        int64_t maxId = 0;  ///< Bölüme eklenmiş en büyük id (silmelerde daralmaz)
+    };
+
+    /**
+     * @brief Bölüm satırı ziyaretçisi (id, datetime, text)
+     */
+    typedef std::function<void(int64_t, const char*, const char*)> RowVisitor;
+
+    // =================== Schema ===================
+    /**
+     * @brief Aylık bölümlü mesaj şemasını kur; eski tek "messages" tablosunu bölümlere taşı
+     * @details "messages" artık bölümlerin UNION ALL görünümüdür. INSTEAD OF tetikleyicileri
+     *          görünüm üzerinden DELETE'i ve mevcut aylara INSERT'i bölümlere yönlendirir.
+     *          Her bölümün tetikleyicileri message_seq (id sırası), message_counters.posted,
+     *          message_reads.read_count ve katalog satır sayısını günceller; her yeni satıra
+     *          message_ordinals'tan artan bir ekleme sırası (ord) verir. ord sütunu olmayan
+     *          eski bölümlere sütun eklenir.
+     *          Görünüm en fazla SQLITE_MAX_COMPOUND_SELECT (varsayılan 500) bölüm birleştirebilir.
+     * @return false ise SQL hatası (ayrıntı std::cerr'e yazılır)
+     */
+    bool EnsureSchema(sqlite3* db);
+
+    /**
+     * @brief "messages" bölümlü görünüm mü?
+     */
+    bool IsPartitioned(sqlite3* db);
+
+    // =================== Repository ===================
+    /**
+     * @brief Mesajı datetime'ın ayına ait bölüme ekle (bölüm yoksa oluşturulur)
+     * @param id Atanan id (isteğe bağlı); id'ler bölümler arasında artan ve tekrar kullanılmaz
+     */
+    bool InsertMessage(sqlite3* db, const std::string& datetime, const std::string& text, int64_t* id);
+
+    /**
+     * @brief id > afterId olan en fazla limit mesajı id sırasıyla ziyaret et
+     * @details Katalogdaki id aralığı afterId'yi geçmeyen bölümlere hiç dokunulmaz.
+     * @return Ziyaret edilen satır sayısı; hata durumunda -1
+     */
+    int ForEachAfter(sqlite3* db, int64_t afterId, int limit, const RowVisitor& visit);
+
+    /**
+     * @brief afterId < id <= upToId aralığındaki mesaj sayısı
+     * @details Aralıkta silme ya da sıra dışı id ile ekleme olmadıysa iki uç mesajın ord farkıdır;
+     *          aksi halde (ya da uçlardan birinin sırası yoksa) bölümler üzerinde COUNT'a düşer.
+     * @return Mesaj sayısı; hata durumunda -1
+     */
+    int64_t CountRange(sqlite3* db, int64_t afterId, int64_t upToId);
+
+    /**
+     * @brief Şimdiye kadar atanmış en büyük mesaj id'si (silinmiş olabilir)
+     */
+    int64_t LastAssignedId(sqlite3* db);
+
+    /**
+     * @brief Bölümleri ay sırasıyla listele
+     */
+    std::vector<PartitionInfo> ListPartitions(sqlite3* db);
+
+    // =================== Retention ===================
+    /**
+     * @brief month'tan ("YYYY-MM") eski bölümleri tablo olarak düşür
+     * @details Satır satır DELETE yerine DROP TABLE; sayaçlar katalogdaki satır sayısıyla
+     *          tek adımda düzeltilir. Çağıranın transaction'ı içinde SAVEPOINT ile çalışır.
+     *          "0000-00" bölümü (tarihi bozuk mesajlar) DropBefore/DropYear ile düşürülmez.
+     * @return Silinen mesaj sayısı; hata durumunda -1
+     */
+    int64_t DropBefore(sqlite3* db, const std::string& month);
+
+    /**
+     * @brief Bir yılın ("YYYY") tüm bölümlerini düşür (sezon arşivi)
+     * @return Silinen mesaj sayısı; hata durumunda -1
+     */
+    int64_t DropYear(sqlite3* db, const std::string& year);
+
+} // namespace partition
+} // namespace teamcore
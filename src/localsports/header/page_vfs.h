@@ -0,0 +1,223 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct sqlite3;
+
+namespace teamcore {
+namespace pagevfs {
+
+    // =================== Page Codec ===================
+    /**
+     * @brief Sayfa dönüşümü (şifreleme, checksum vb.) için genel arayüz
+     * @details Her sayfanın son ReserveBytes() baytı codec'e aittir (SQLite "reserved space").
+     *          Encode/Decode sayfayı yerinde dönüştürür. Sayfa 1'in ilk 100 baytı (veritabanı
+     *          başlığı) VFS tarafından her zaman düz bırakılır; codec'e başlangıç ofseti verilir.
+     */
+    class PageCodec {
+    public:
+        virtual ~PageCodec() {}
+
+        /**
+         * @brief Sayfa sonunda ayrılacak bayt sayısı (0-255)
+         */
+        virtual int ReserveBytes() const = 0;
+
+        /**
+         * @brief Sayfayı diske yazmadan önce dönüştür
+         * @param page Sayfa kopyası (pageSize bayt, yazılabilir)
+         * @param pageSize Sayfa boyutu
+         * @param start Dönüştürülecek bölgenin başı (sayfa 1 için 100, diğerleri 0)
+         * @param pgno Sayfanın veritabanındaki numarası (ana dosya, journal ve WAL için aynı)
+         * @return false ise yazma SQLITE_IOERR ile başarısız olur
+         */
+        virtual bool Encode(unsigned char* page, int pageSize, int start, uint32_t pgno) = 0;
+
+        /**
+         * @brief Diskten okunan sayfayı geri dönüştür
+         * @details Reserve alanı sıfırlanarak bırakılmalıdır: SQLite WAL frame checksum'ını
+         *          bellekteki sayfadan (reserve sıfır) hesaplar ve kurtarmada aynı baytları görmelidir.
+         * @return false ise okuma SQLITE_IOERR_DATA ile başarısız olur (bozulma / yanlış anahtar / yer değiştirmiş sayfa)
+         */
+        virtual bool Decode(unsigned char* page, int pageSize, int start, uint32_t pgno) = 0;
+    };
+
+    /**
+     * @brief AES-256-GCM sayfa codec'i
+     * @details Reserve alanı: nonce(12) + tag(16). Her yazmada rastgele nonce üretilir.
+     *          Sayfa numarası (big-endian 32 bit) AAD olarak bağlanır: aynı anahtarla yazılmış
+     *          geçerli bir sayfanın başka bir sayfa numarasına taşınması Decode'da reddedilir.
+     * @param key32 32 baytlık anahtar (kopyalanır)
+     */
+    std::shared_ptr<PageCodec> MakeAesGcmCodec(const unsigned char* key32);
+
+    /**
+     * @brief Sayfa checksum codec'i (şifrelemesiz bütünlük)
+     * @details Reserve alanı: 8 bayt, iki 32-bit Fletcher toplamı (SQLite cksumvfs algoritması,
+     *          little-endian kelimeler). Sayfa 1'in başlığı dahil reserve dışındaki tüm sayfa
+     *          kapsanır; sayfa verisi değiştirilmez. Anahtarsızdır: bozulmayı ve checksum'ı
+     *          güncellemeyen dış düzenlemeleri yakalar, checksum'ı yeniden hesaplayan
+     *          saldırgana karşı MakeAesGcmCodec gerekir.
+     */
+    std::shared_ptr<PageCodec> MakeChecksumCodec();
+
+    // =================== VFS Registration ===================
+    /**
+     * @brief Şifreli VFS'in varsayılan adı
+     */
+    extern const char* const ENCRYPTED_VFS_NAME; // "ls-crypt"
+
+    /**
+     * @brief Checksum VFS'inin varsayılan adı
+     */
+    extern const char* const CHECKSUM_VFS_NAME; // "ls-cksum"
+
+    /**
+     * @brief Varsayılan VFS üzerine sayfa dönüştüren bir shim VFS kaydet
+     * @details Aynı adla tekrar çağrılırsa yeni codec sonraki açılışlarda kullanılır.
+     *          Dönüşüm ana veritabanı, rollback journal ve WAL dosyalarına uygulanır;
+     *          yalnızca başlığı bu codec'in reserve/page size değerleriyle oluşturulmuş
+     *          veritabanlarında etkindir (diğerleri olduğu gibi geçer).
+     *          mmap kapalıdır (xFetch her zaman okuma yoluna düşer).
+     * @param name VFS adı (sqlite3_open_v2 zVfs parametresi)
+     * @param codec Sayfa codec'i
+     * @param pageSize Bu VFS ile oluşturulacak veritabanlarının sayfa boyutu
+     * @return false ise varsayılan VFS bulunamadı veya kayıt başarısız
+     */
+    bool RegisterPageVfs(const char* name, std::shared_ptr<PageCodec> codec, int pageSize = 4096);
+
+    /**
+     * @brief RegisterPageVfs ile kaydedilmiş VFS'i kaldır ve codec'ini (anahtarını) bırak
+     * @details Bu VFS üzerinden açık dosya kalmamalıdır (bağlantılar kapatıldıktan sonra çağrılır);
+     *          açık dosya varsa VFS kayıtlı kalır. Codec'e başka sahip yoksa anahtarı silinir.
+     * @return false ise ad kayıtlı değil veya VFS hâlâ kullanımda
+     */
+    bool UnregisterPageVfs(const char* name);
+
+    /**
+     * @brief Boş bir veritabanını codec düzenine hazırla (page_size + reserved bytes)
+     * @details İlk tablo oluşturulmadan (ve journal_mode=WAL'dan) önce çağrılmalıdır.
+     *          Veritabanı bir sayfa VFS'i ile açılmamışsa veya boş değilse hiçbir şey yapmaz.
+     * @param schema "main" veya ATTACH adı
+     * @return true ise veritabanı hazırlandı
+     */
+    bool PrepareNewDatabase(sqlite3* db, const char* schema = "main");
+
+    /**
+     * @brief Veritabanı sayfa VFS'i üzerinden açılmış ve sayfaları dönüştürülüyor mu?
+     */
+    bool IsPageTransformed(sqlite3* db, const char* schema = "main");
+
+    /**
+     * @brief Bağlantının kullandığı VFS adı ("unix", "ls-crypt", ...)
+     * @return Bulunamazsa nullptr
+     */
+    const char* VfsNameOf(sqlite3* db, const char* schema = "main");
+
+    /**
+     * @brief Bağlantının sayfalarını dönüştüren codec (doğrulayıcıya vermek için)
+     * @return Veritabanı sayfa VFS'i üzerinden dönüştürülmüyorsa boş
+     */
+    std::shared_ptr<PageCodec> CodecOf(sqlite3* db, const char* schema = "main");
+
+    // =================== Page Verifier ===================
+    /**
+     * @brief VerifyPages sonucu
+     */
+    struct PageScanResult {
+        bool transformed = false;      ///< Dosya başlığı codec düzeninde mi (değilse sayfa okunmaz)
+        int64_t pageCount = 0;         ///< Dosyadaki sayfa sayısı
+        int64_t pagesChecked = 0;      ///< Okunan sayfa (boş/sıfır sayfalar dahil)
+        int64_t nextPage = 1;          ///< Sonraki çağrının başlangıcı (dosya sonunda 1'e döner)
+        std::vector<int64_t> badPages; ///< Codec'in reddettiği sayfa numaraları
+    };
+
+    /**
+     * @brief Veritabanı dosyasının ham sayfalarını codec ile doğrula (SQLite'a dokunmadan)
+     * @details Sayfalar dosyadan okunup kopyada Decode edilir. Reddedilen sayfa bir kez daha
+     *          okunur: eşzamanlı checkpoint yazımının yarım okunması bozulma sayılmaz.
+     *          WAL'deki henüz aktarılmamış sayfalar kapsanmaz (okuma yolunda doğrulanır).
+     * @param path Veritabanı dosyası
+     * @param codec Dosyayı yazan VFS'in codec'i
+     * @param firstPage 1 tabanlı başlangıç sayfası (dosya dışındaysa 1)
+     * @param maxPages En fazla okunacak sayfa
+     * @return false ise dosya açılamadı veya SQLite başlığı yok
+     */
+    bool VerifyPages(const std::string& path, PageCodec& codec, int64_t firstPage, int maxPages, PageScanResult* out);
+
+    /**
+     * @brief Arka plan doğrulayıcı ayarları
+     */
+    struct VerifierConfig {
+        int pagesPerSecond = 256;  ///< Hız sınırı (4 KB sayfada ~1 MB/s)
+        int batchPages = 32;       ///< Uyanış başına okunacak sayfa
+    };
+
+    /**
+     * @brief Toplam doğrulama istatistikleri
+     */
+    struct VerifierStats {
+        uint64_t pagesChecked = 0;
+        uint64_t sweeps = 0;       ///< Tamamlanan tam dosya turu
+        uint64_t mismatches = 0;   ///< Bildirilen bozuk sayfa (sayfa başına bir kez)
+        double totalMs = 0.0;      ///< Okuma + doğrulamaya harcanan süre
+    };
+
+    typedef std::function<void(const std::string& path, int64_t page)> MismatchSink;
+
+    // =================== PageVerifier ===================
+    /**
+     * @brief Veritabanı dosyasını hız sınırıyla sürekli tarayan arka plan doğrulayıcı
+     * @details Dosyayı batchPages'lik parçalarla baştan sona dolaşır ve başa döner. Bozuk
+     *          bulunan her sayfa sink'e bir kez bildirilir (thread'den, kilit tutulmadan).
+     */
+    class PageVerifier {
+    public:
+        PageVerifier();
+        ~PageVerifier();
+        PageVerifier(const PageVerifier&) = delete;
+        PageVerifier& operator=(const PageVerifier&) = delete;
+
+        /**
+         * @brief Doğrulayıcıyı başlat
+         * @return false ise codec boş veya zaten çalışıyor
+         */
+        bool Start(const std::string& dbPath, std::shared_ptr<PageCodec> codec,
+                   const VerifierConfig& config, MismatchSink sink);
+
+        /**
+         * @brief Doğrulayıcıyı durdur (bekleyen batch bitince döner)
+         */
+        void Stop();
+
+        bool IsRunning() const { return running_.load(); }
+
+        VerifierStats Stats() const;
+
+    private:
+        void Loop();
+
+        std::string dbPath_;
+        std::shared_ptr<PageCodec> codec_;
+        VerifierConfig config_;
+        MismatchSink sink_;
+
+        std::thread worker_;
+        std::atomic<bool> running_;
+        std::mutex waitMutex_;
+        std::condition_variable wake_;
+        mutable std::mutex statsMutex_;
+        VerifierStats stats_;
+    };
+
+} // namespace pagevfs
+} // namespace teamcore
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <vector>
@@ -14,6 +15,8 @@ namespace rasp {
         std::string eventType;
         std::string description;
         int severity; // 1=info, 2=warning, 3=critical
+        int count = 1;              // özet kaydında pencere içinde bastırılan tekrar sayısı
+        std::string firstTimestamp; // özet kaydında ilk tekrarın zamanı (timestamp = son tekrar)
     };
 
     // =================== IsDebuggerPresent & ptrace ===================
@@ -60,6 +63,59 @@ namespace rasp {
      */
     bool BootTimeIntegrityCheck(const std::string& expectedChecksum);
 
+    // =================== Shared Library Integrity ===================
+    /**
+     * @brief Paylaşımlı kütüphane temel ölçümünün özeti (boot maliyeti ayrı raporlanır)
+     */
+    struct LibraryBaselineReport {
+        int modules = 0;          // hash'lenen kütüphane sayısı
+        int chunks = 0;           // 1 MB'lık kod parçası sayısı
+        std::size_t bytes = 0;    // hash'lenen çalıştırılabilir segment baytı
+        int threads = 0;          // kullanılan hash thread'i
+        double elapsedMs = 0.0;   // boot'ta harcanan süre
+        int mismatches = 0;       // manifest ile uyuşmayan kütüphane
+        int unknown = 0;          // manifestte olmayan kütüphane
+        bool manifestCreated = false;
+        bool tampered = false;    // manifest doğrulanamadı ya da kurulumdan sonra kayboldu
+        bool manifestPending = false; // anahtar yok: karşılaştırma VerifyLibraryManifest'e kaldı
+    };
+
+    /**
+     * @brief Yüklü kütüphanelerin çalıştırılabilir segmentlerini paralel hash'le ve manifestle karşılaştır
+     * @details dl_iterate_phdr ile bulunan her kütüphanenin PF_X PT_LOAD segmentleri 1 MB'lık
+     *          parçalara bölünür ve çekirdekler arasında SHA-256 ile hash'lenir; kütüphane özeti
+     *          parça hash'lerinin SHA-256'sıdır. Manifest (RASPConfig::libraryManifestPath) son
+     *          satırında HMAC-SHA256 taşır; anahtar RASPConfig::libraryManifestKey, boşsa AppKey'in
+     *          "localsports/rasp-library-manifest/v1" alt anahtarıdır. İkisi de yoksa karşılaştırma
+     *          VerifyLibraryManifest'e ertelenir (manifestPending). Manifest yalnızca ilk kurulumda
+     *          (güvenlik günlüğü boşken) oluşturulur; sonradan kaybolması LIBRARY_MANIFEST_TAMPERED'dır.
+     *          Parça hash'leri VerifyLibraryChunks için saklanır. Windows'ta boş döner.
+     * @param report İsteğe bağlı özet
+     * @return false ise bir kütüphane manifestle uyuşmuyor (LIBRARY_INTEGRITY_MISMATCH) ya da
+     *         manifest doğrulanamadı/kayboldu (LIBRARY_MANIFEST_TAMPERED; dosya yazılmaz)
+     */
+    bool CaptureLibraryBaseline(LibraryBaselineReport* report = nullptr);
+
+    /**
+     * @brief Ertelenmiş manifest karşılaştırmasını anahtar hazırsa yap
+     * @details Boot özetleri kullanılır; kütüphane taraması (izleme döngüsü) her turda çağırır.
+     * @return false ise manifest uyuşmuyor ya da doğrulanamadı; bekleyen iş yoksa true
+     */
+    bool VerifyLibraryManifest(LibraryBaselineReport* report = nullptr);
+
+    /**
+     * @brief Boot ölçümüne karşı en fazla maxChunks parçayı sırayla yeniden doğrula
+     * @details Her çağrı kaldığı parçadan devam eder; PerformSecurityScan bunu
+     *          libraryChunksPerScan ile çağırır. Kaldırılmış (dlclose) kütüphaneler atlanır.
+     * @return Değişmiş parça sayısı; temel ölçüm yoksa -1
+     */
+    int VerifyLibraryChunks(int maxChunks);
+
+    /**
+     * @brief Son CaptureLibraryBaseline özeti
+     */
+    LibraryBaselineReport GetLibraryBaselineReport();
+
     // =================== IAT/PLT Hook Detection ===================
     /**
      * @brief Import Address Table (Windows) hook tespiti
@@ -93,11 +149,22 @@ namespace rasp {
     // =================== Security Event Logging ===================
     /**
      * @brief Güvenlik olayını kaydet
+     * @details Olaylar (eventType, açıklama özeti) anahtarıyla birleştirilir: pencerenin ilk
+     *          olayı hemen yazılır, pencere içindeki tekrarlar sayılır ve pencere kapanınca
+     *          count/firstTimestamp taşıyan tek özet kaydı olarak yazılır. Her olay tipinin
+     *          token kovası boşsa yeni anahtarlar da sayıma düşer; severity 3 olan bir olay
+     *          kova boş olsa bile penceresinde en az bir kez yazılır.
      * @param event Olay bilgisi
-     * @return true ise kayıt başarılı
+     * @return true ise olay yazıldı ya da özet sayımına alındı; false ise dosyaya yazılamadı
      */
     bool LogSecurityEvent(const SecurityEvent& event);
 
+    /**
+     * @brief Bekleyen tüm tekrar özetlerini hemen yaz (pencereler kapanır)
+     * @details ShutdownRASP bunu kendisi çağırır.
+     */
+    void FlushSecurityEvents();
+
     /**
      * @brief Kritik güvenlik olayını kaydet ve fail-closed davranış göster
      * @param eventType Olay tipi (örn: "DEBUGGER_DETECTED")
@@ -158,6 +225,23 @@ namespace rasp {
      */
     void ShutdownRASP();
 
+    /**
+     * @brief fork() ile oluşan çocuk süreçte RASP'ı devral
+     * @details Boot integrity ve hook taraması ebeveynde yapılmıştır ve kod sayfaları
+     *          paylaşılır; tekrarlanmaz. Thread'ler fork'u geçmediği için debugger
+     *          izleme çocukta yeniden başlatılır.
+     */
+    void ReinitializeAfterFork();
+
+    /**
+     * @brief RASP'ı aktif bırakıp izleme ve tarama thread'lerini durdur (join)
+     * @details fork() eden süreç (zygote) fork'tan önce çağırır: başka bir thread'in tuttuğu
+     *          kilit (malloc, stdio, olay kaydı) çocukta sonsuza dek kilitli kalmasın. Kontroller
+     *          bundan sonra PerformSecurityScanInline ile çağıranın thread'inde yapılır;
+     *          ReinitializeAfterFork durdurulan izlemeyi çocukta yeniden başlatır.
+     */
+    void StopBackgroundThreads();
+
     /**
      * @brief RASP durumu sorgulama
      * @return true ise RASP aktif
@@ -166,19 +250,148 @@ namespace rasp {
 
     /**
      * @brief Periyodik güvenlik kontrolü yap
-     * @details Debugger, hook, integrity kontrollerini yapar
+     * @details Debugger, hook, integrity kontrollerini yapar (PerformSecurityScanDetailed().passed)
      * @return true ise tüm kontroller başarılı
      */
     bool PerformSecurityScan();
 
+    // =================== Concurrent Security Scan ===================
+    enum class ScanStatus { PASSED, FAILED, TIMED_OUT };
+
+    /**
+     * @brief Taramadaki bağımsız bir kontrol
+     */
+    struct ScanCheck {
+        std::string name;
+        std::string eventType;     // başarısızlık/zaman aşımında HandleCriticalEvent tipi
+        std::string description;
+        std::function<bool()> run; // true = geçti; istisna FAILED sayılır
+    };
+
+    struct ScanCheckResult {
+        std::string name;
+        ScanStatus status = ScanStatus::TIMED_OUT;
+        double elapsedMs = 0.0;    // zaman aşımında bekleme süresi
+    };
+
+    struct SecurityScanReport {
+        bool passed = false;
+        bool deadlineExceeded = false;
+        double elapsedMs = 0.0;    // çağıranın beklediği toplam süre (kontrollerin en uzunu, en fazla süre sınırı)
+        std::vector<ScanCheckResult> checks;
+    };
+
+    /**
+     * @brief Kontrolleri kalıcı işçi havuzunda (en fazla 8 thread) çalıştır ve süre sınırına kadar bekle
+     * @details Süre sınırını aşan kontrol işçide bitmeye bırakılır (sonucu yok sayılır) ve
+     *          TIMED_OUT raporlanır. Aynı adlı kontrolün önceki çalışması hâlâ sürüyorsa yenisi
+     *          başlatılmaz, TIMED_OUT raporlanır. İşçileri ShutdownRASP join eder.
+     *          Olay kaydı ve sonlandırma yapmaz.
+     * @param deadlineMs <= 0 ise süre sınırı yok
+     */
+    SecurityScanReport RunChecksConcurrently(const std::vector<ScanCheck>& checks, int deadlineMs);
+
+    /**
+     * @brief PerformSecurityScan'in kontrol başına durum ve süre raporlayan hali
+     * @details Debugger, .text, kütüphane ve hook kontrolleri RASPConfig::scanDeadlineMs ile
+     *          eşzamanlı çalışır. Başarısız ya da süresi dolan her kontrol çağıran thread'de
+     *          HandleCriticalEvent ile autoTerminateOnThreat'e göre fail-closed işlenir.
+     */
+    SecurityScanReport PerformSecurityScanDetailed();
+
+    /**
+     * @brief PerformSecurityScanDetailed'ın thread açmayan hali: kontroller çağıran thread'de sırayla
+     * @details Süre sınırı yoktur (TIMED_OUT üretmez). Başarısız kontroller HandleCriticalEvent
+     *          ile işlenir. StopBackgroundThreads sonrası tek thread'li kalması gereken süreç içindir.
+     */
+    SecurityScanReport PerformSecurityScanInline();
+
+    // =================== Adaptive Monitoring ===================
+    /**
+     * @brief Tek kontrolün bekleme aralığı: sakin geçen her turda backoff ile max'a doğru uzar,
+     *        uyarı ya da hassas işlemde hemen min'e iner
+     */
+    class AdaptiveInterval {
+    public:
+        AdaptiveInterval(int minMs, int maxMs, double backoff);
+        int Current() const { return current_; }
+        int OnQuiet();   // temiz tur: aralığı uzat, yeni aralığı döndür
+        void Tighten();  // alarm: min
+    private:
+        int min_;
+        int max_;
+        int current_;
+        double backoff_;
+    };
+
+    /**
+     * @brief İzleme thread'inin kontrollere harcadığı CPU, sakin ve alarm dönemleri ayrı
+     */
+    struct MonitoringStats {
+        double quietWallMs = 0.0;
+        double quietCpuMs = 0.0;
+        long quietRuns = 0;
+        double alertWallMs = 0.0;
+        double alertCpuMs = 0.0;
+        long alertRuns = 0;
+        double QuietOverheadPercent() const { return quietWallMs > 0.0 ? 100.0 * quietCpuMs / quietWallMs : 0.0; }
+        double AlertOverheadPercent() const { return alertWallMs > 0.0 ? 100.0 * alertCpuMs / alertWallMs : 0.0; }
+    };
+
+    /**
+     * @brief Uyarlanır izlemeyi başlat (InitializeRASP çağırır)
+     * @details PerformSecurityScanDetailed'daki her kontrol kendi RASPConfig aralığıyla tek bir
+     *          arka plan thread'inde çalışır. Başarısız kontrol HandleCriticalEvent ile işlenir.
+     *          severity >= 2 her olay ve NotifySensitiveOperation tüm aralıkları min'e çeker;
+     *          alertHoldMs boyunca aralıklar min'de kalır, sonra yeniden uzamaya başlar.
+     */
+    void StartAdaptiveMonitoring();
+
+    /**
+     * @brief Uyarlanır izlemeyi durdur (ShutdownRASP çağırır; izleme thread'inden de güvenli)
+     */
+    void StopAdaptiveMonitoring();
+
+    /**
+     * @brief Hassas işlem bildirimi (giriş, anahtar kullanımı, toplu dışa aktarma): aralıkları daralt
+     */
+    void NotifySensitiveOperation(const std::string& operation);
+
+    /**
+     * @brief Kontrolün şu anki aralığı ("debugger", "text-integrity", "library-integrity", "hooks")
+     * @return İzlenmiyorsa -1
+     */
+    int GetCheckIntervalMs(const std::string& checkName);
+
+    /**
+     * @brief Başlangıçtan bu yana sakin/alarm CPU yükü
+     */
+    MonitoringStats GetMonitoringStats();
+
     // =================== Configuration ===================
     struct RASPConfig {
         bool enableDebuggerDetection = true;
         bool enableChecksumVerification = true;
         bool enableHookDetection = true;
         bool autoTerminateOnThreat = true;
-        int monitoringIntervalMs = 5000;
+        int monitoringIntervalMs = 5000;   // yalnızca StartDebuggerMonitoring (sabit aralık)
         std::string logFilePath = "rasp_security.log";
+        int eventWindowMs = 60000;         // aynı olayın tekrarlarının tek özette birleştiği süre
+        int eventBurstPerType = 10;        // olay tipi başına token kovası kapasitesi
+        int eventRefillPerMinute = 20;     // kovaya dakikada eklenen token
+        bool enableLibraryVerification = true;
+        std::string libraryManifestPath = "rasp_libraries.manifest";
+        std::string libraryManifestKey;    // manifest HMAC anahtarı; boş = AppKey alt anahtarı
+        int libraryChunksPerScan = 8;      // PerformSecurityScan başına doğrulanan 1 MB'lık parça
+        int libraryHashThreads = 0;        // 0 = donanım thread sayısı
+        int scanDeadlineMs = 2000;         // PerformSecurityScan kontrollerinin toplam süre sınırı
+        struct IntervalRange { int minMs; int maxMs; };
+        IntervalRange debuggerInterval = { 1000, 30000 };    // uyarlanır izleme aralıkları
+        IntervalRange integrityInterval = { 10000, 300000 };
+        IntervalRange libraryInterval = { 2000, 60000 };
+        IntervalRange hookInterval = { 5000, 120000 };
+        double intervalBackoff = 2.0;      // sakin turda aralık çarpanı
+        int alertHoldMs = 60000;           // uyarıdan sonra aralıkların min'de kaldığı süre
     };
 
     /**
@@ -0,0 +1,328 @@
+#pragma once
+
+#include "localsports.h"
+#include "security_layer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct sqlite3;
+
+namespace teamcore {
+namespace store {
+
+    // =================== Record Handle ===================
+    /**
+     * @brief Store içindeki bir kayda kararlı (stable) referans
+     * @details slot: slab*SlabRecords + index, generation: slot yeniden kullanıldığında artar.
+     *          Kayıt silinip slot tekrar kullanılırsa eski handle geçersiz olur.
+     */
+    struct RecordHandle {
+        uint32_t slot;
+        uint32_t generation;
+
+        RecordHandle() : slot(UINT32_MAX), generation(0) {}
+        RecordHandle(uint32_t s, uint32_t g) : slot(s), generation(g) {}
+
+        bool IsNull() const { return slot == UINT32_MAX; }
+    };
+
+    // =================== RecordStore ===================
+    /**
+     * @brief Sabit boyutlu (packed) kayıtlar için slab tabanlı bitişik depolama
+     * @details Kayıtlar SlabRecords büyüklüğünde bloklarda tutulur; bloklar asla taşınmaz,
+     *          bu sayede handle ve pointer'lar kayıt silinene kadar geçerli kalır.
+     *          id -> slot eşlemesi open-addressing (linear probing) hash index ile yapılır.
+     * @tparam T uint32_t id alanına sahip kayıt tipi (Player, Game, Stat, Message)
+     * @tparam SlabRecords Bir slab'daki kayıt sayısı
+     */
+    template <typename T, std::size_t SlabRecords = 256>
+    class RecordStore {
+    public:
+        RecordStore() = default;
+        RecordStore(const RecordStore&) = delete;
+        RecordStore& operator=(const RecordStore&) = delete;
+        ~RecordStore() { Clear(); }
+
+        /**
+         * @brief Kaydı ekle; aynı id varsa yerinde güncelle
+         * @return Kaydın handle'ı
+         */
+        RecordHandle Upsert(const T& rec) {
+            const uint32_t id = rec.id;
+            uint32_t slot = FindSlot(id);
+            if (slot != UINT32_MAX) {
+                std::memcpy(SlotPtr(slot), &rec, sizeof(T));
+                return RecordHandle{ slot, generations_[slot] };
+            }
+
+            slot = AllocateSlot();
+            std::memcpy(SlotPtr(slot), &rec, sizeof(T));
+            live_[slot] = 1;
+            IndexInsert(id, slot);
+            ++count_;
+            return RecordHandle{ slot, generations_[slot] };
+        }
+
+        /**
+         * @brief Handle ile kayda eriş
+         * @return Handle geçersizse nullptr
+         */
+        T* Get(RecordHandle h) {
+            return IsValid(h) ? SlotPtr(h.slot) : nullptr;
+        }
+
+        const T* Get(RecordHandle h) const {
+            return IsValid(h) ? SlotPtr(h.slot) : nullptr;
+        }
+
+        /**
+         * @brief id ile kayda eriş (hash index, O(1) beklenen)
+         */
+        T* FindById(uint32_t id) {
+            uint32_t slot = FindSlot(id);
+            return slot == UINT32_MAX ? nullptr : SlotPtr(slot);
+        }
+
+        const T* FindById(uint32_t id) const {
+            uint32_t slot = FindSlot(id);
+            return slot == UINT32_MAX ? nullptr : SlotPtr(slot);
+        }
+
+        /**
+         * @brief id için handle üret
+         * @return Kayıt yoksa IsNull() olan handle
+         */
+        RecordHandle HandleOf(uint32_t id) const {
+            uint32_t slot = FindSlot(id);
+            if (slot == UINT32_MAX) return RecordHandle{};
+            return RecordHandle{ slot, generations_[slot] };
+        }
+
+        bool IsValid(RecordHandle h) const {
+            return !h.IsNull() && h.slot < live_.size() && live_[h.slot] &&
+                generations_[h.slot] == h.generation;
+        }
+
+        /**
+         * @brief Kaydı sil; slot güvenli şekilde sıfırlanır ve serbest listeye eklenir
+         * @return true ise kayıt bulundu ve silindi
+         */
+        bool Erase(uint32_t id) {
+            uint32_t slot = IndexErase(id);
+            if (slot == UINT32_MAX) return false;
+
+            SecureBuffer::secure_bzero(SlotPtr(slot), sizeof(T));
+            live_[slot] = 0;
+            ++generations_[slot];
+            freeSlots_.push_back(slot);
+            --count_;
+            return true;
+        }
+
+        /**
+         * @brief Tüm kayıtları sil; bellek güvenli şekilde sıfırlanır
+         * @details Slab'lar bırakılır, sonraki yüklemede yeniden ayrılır.
+         */
+        void Clear() {
+            for (std::size_t i = 0; i < slabs_.size(); ++i) {
+                SecureBuffer::secure_bzero(slabs_[i].get(), sizeof(T) * SlabRecords);
+            }
+            slabs_.clear();
+            live_.clear();
+            generations_.clear();
+            freeSlots_.clear();
+            index_.clear();
+            indexMask_ = 0;
+            count_ = 0;
+            nextSlot_ = 0;
+        }
+
+        /**
+         * @brief Beklenen kayıt sayısı için yer ayır (slab ve index)
+         */
+        void Reserve(std::size_t n) {
+            while (slabs_.size() * SlabRecords < n) AddSlab();
+            if (n * 2 > index_.size()) Rehash(NextPow2(n * 2));
+        }
+
+        std::size_t size() const { return count_; }
+        bool empty() const { return count_ == 0; }
+
+        /**
+         * @brief Canlı kayıtları slab sırasıyla (ekleme sırası) dolaş
+         * @param fn void(const T&) imzalı fonksiyon
+         */
+        template <typename Fn>
+        void ForEach(Fn fn) const {
+            for (std::size_t slot = 0; slot < live_.size(); ++slot) {
+                if (live_[slot]) fn(*SlotPtr(static_cast<uint32_t>(slot)));
+            }
+        }
+
+    private:
+        struct IndexEntry {
+            uint32_t id;
+            uint32_t slot; // UINT32_MAX = boş
+        };
+
+        static std::size_t NextPow2(std::size_t v) {
+            std::size_t p = 16;
+            while (p < v) p <<= 1;
+            return p;
+        }
+
+        // Knuth çarpımsal hash: tek sayı çarpanı ardışık id'leri tabloya dengeli dağıtır
+        std::size_t Bucket(uint32_t id) const {
+            return static_cast<std::size_t>((id * 2654435761u) & indexMask_);
+        }
+
+        T* SlotPtr(uint32_t slot) const {
+            return slabs_[slot / SlabRecords].get() + (slot % SlabRecords);
+        }
+
+        void AddSlab() {
+            slabs_.push_back(std::unique_ptr<T[]>(new T[SlabRecords]()));
+            live_.resize(slabs_.size() * SlabRecords, 0);
+            generations_.resize(slabs_.size() * SlabRecords, 0);
+        }
+
+        uint32_t AllocateSlot() {
+            if (!freeSlots_.empty()) {
+                uint32_t slot = freeSlots_.back();
+                freeSlots_.pop_back();
+                return slot;
+            }
+            if (nextSlot_ >= slabs_.size() * SlabRecords) AddSlab();
+            return nextSlot_++;
+        }
+
+        uint32_t FindSlot(uint32_t id) const {
+            if (index_.empty()) return UINT32_MAX;
+            for (std::size_t b = Bucket(id);; b = (b + 1) & indexMask_) {
+                const IndexEntry& e = index_[b];
+                if (e.slot == UINT32_MAX) return UINT32_MAX;
+                if (e.id == id) return e.slot;
+            }
+        }
+
+        void IndexInsert(uint32_t id, uint32_t slot) {
+            if ((count_ + 1) * 2 > index_.size()) Rehash(NextPow2((count_ + 1) * 2));
+            std::size_t b = Bucket(id);
+            while (index_[b].slot != UINT32_MAX) b = (b + 1) & indexMask_;
+            index_[b].id = id;
+            index_[b].slot = slot;
+        }
+
+        // Backward-shift silme: tombstone bırakmadan probe zincirini korur
+        uint32_t IndexErase(uint32_t id) {
+            if (index_.empty()) return UINT32_MAX;
+            std::size_t b = Bucket(id);
+            while (true) {
+                if (index_[b].slot == UINT32_MAX) return UINT32_MAX;
+                if (index_[b].id == id) break;
+                b = (b + 1) & indexMask_;
+            }
+
+            const uint32_t slot = index_[b].slot;
+            std::size_t hole = b;
+            for (std::size_t j = (hole + 1) & indexMask_; index_[j].slot != UINT32_MAX; j = (j + 1) & indexMask_) {
+                const std::size_t home = Bucket(index_[j].id);
+                // j'deki girdi, home..j aralığı hole'u kapsamıyorsa hole'a taşınabilir
+                const bool movable = (j > hole) ? (home <= hole || home > j)
+                                                : (home <= hole && home > j);
+                if (movable) {
+                    index_[hole] = index_[j];
+                    hole = j;
+                }
+            }
+            index_[hole].slot = UINT32_MAX;
+            return slot;
+        }
+
+        void Rehash(std::size_t newSize) {
+            std::vector<IndexEntry> old;
+            old.swap(index_);
+            index_.assign(newSize, IndexEntry{ 0, UINT32_MAX });
+            indexMask_ = newSize - 1;
+            for (std::size_t i = 0; i < old.size(); ++i) {
+                if (old[i].slot == UINT32_MAX) continue;
+                std::size_t b = Bucket(old[i].id);
+                while (index_[b].slot != UINT32_MAX) b = (b + 1) & indexMask_;
+                index_[b] = old[i];
+            }
+        }
+
+        std::vector<std::unique_ptr<T[]>> slabs_;
+        std::vector<uint8_t> live_;
+        std::vector<uint32_t> generations_;
+        std::vector<uint32_t> freeSlots_;
+        std::vector<IndexEntry> index_;
+        std::size_t indexMask_ = 0;
+        std::size_t count_ = 0;
+        uint32_t nextSlot_ = 0;
+    };
+
+    // =================== SQLite Bulk Load ===================
+    /**
+     * @brief Şifreli alanlar için çözücü (ör. decryptMaybe)
+     * @details Boş bırakılırsa değer olduğu gibi kopyalanır.
+     */
+    typedef std::function<std::string(const std::string&)> FieldDecoder;
+
+    /**
+     * @brief players tablosunu tek sıralı geçişte store'a yükle
+     * @param db Açık SQLite bağlantısı
+     * @param out Hedef store (önce temizlenir)
+     * @param decode phone/email alanları için çözücü
+     * @param activeOnly true ise sadece active=1 kayıtlar
+     * @return true ise sorgu başarıyla tamamlandı
+     */
+    bool LoadPlayers(sqlite3* db, RecordStore<Player>& out, const FieldDecoder& decode, bool activeOnly = true);
+
+    /**
+     * @brief Aktif oyuncuları PII olmadan yükle (uzun ömürlü önbellekler için)
+     * @details phone/email sütunları okunmaz, alanlar boş kalır; gerektiğinde gösterim
+     *          anında id ile okunup çözülmelidir.
+     */
+    bool LoadRoster(sqlite3* db, RecordStore<Player>& out);
+
+    /**
+     * @brief games tablosunu tek sıralı geçişte store'a yükle
+     */
+    bool LoadGames(sqlite3* db, RecordStore<Game>& out);
+
+    /**
+     * @brief stats tablosunu tek sıralı geçişte store'a yükle
+     */
+    bool LoadStats(sqlite3* db, RecordStore<Stat>& out);
+
+    /**
+     * @brief messages tablosunu tek sıralı geçişte store'a yükle
+     * @param decode text alanı için çözücü
+     */
+    bool LoadMessages(sqlite3* db, RecordStore<Message>& out, const FieldDecoder& decode);
+
+    /**
+     * @brief Çalışma kümesinin tamamı (snapshot) için store'lar
+     */
+    struct Snapshot {
+        RecordStore<Player> players;
+        RecordStore<Game> games;
+        RecordStore<Stat> stats;
+        RecordStore<Message> messages;
+    };
+
+    /**
+     * @brief Tüm tabloları snapshot'a yükle (her tablo için tek sıralı geçiş)
+     * @return true ise tüm tablolar yüklendi
+     */
+    bool LoadSnapshot(sqlite3* db, Snapshot& out, const FieldDecoder& decode);
+
+} // namespace store
+} // namespace teamcore
@@ -1,12 +1,24 @@
 #pragma once
 #include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace teamcore {
 
     // =================== SecureBuffer ===================
+    /**
+     * @brief Silinerek serbest bırakılan bayt tamponu
+     * @details INLINE_CAPACITY (64) bayta kadar içerik nesnenin içinde tutulur; anahtar, salt ve
+     *          nonce boyutları yığına hiç gitmez. Daha büyük boyutlar yığında tutulur. Taşımada
+     *          satır içi içerik kopyalanıp kaynakta silinir (data() adresi değişir).
+     */
     class SecureBuffer {
     public:
+        static const std::size_t INLINE_CAPACITY = 64;
+
         // Dardan da kullanlabilsin diye public yaptk
         static void secure_bzero(void* ptr, std::size_t len);
 
@@ -25,8 +37,113 @@ namespace teamcore {
         std::size_t size() const { return size_; }
 
     private:
+        bool isHeap() const { return data_ && data_ != inline_; }
+        void release();
+        void takeFrom(SecureBuffer& other);
+
         unsigned char* data_{ nullptr };
         std::size_t size_{ 0 };
+        unsigned char inline_[INLINE_CAPACITY];
+    };
+
+    // =================== SecureString ===================
+    /**
+     * @brief Serbest bırakmadan önce belleği silen ayırıcı
+     * @details Kapsayıcı büyürken bıraktığı eski blok da silinir; yığında düz metin parçası kalmaz.
+     */
+    template <class T>
+    struct WipingAllocator {
+        typedef T value_type;
+
+        WipingAllocator() {}
+        template <class U> WipingAllocator(const WipingAllocator<U>&) {}
+
+        T* allocate(std::size_t n) { return std::allocator<T>().allocate(n); }
+        void deallocate(T* p, std::size_t n) {
+            SecureBuffer::secure_bzero(p, n * sizeof(T));
+            std::allocator<T>().deallocate(p, n);
+        }
+    };
+
+    template <class T, class U>
+    bool operator==(const WipingAllocator<T>&, const WipingAllocator<U>&) { return true; }
+    template <class T, class U>
+    bool operator!=(const WipingAllocator<T>&, const WipingAllocator<U>&) { return false; }
+
+    /**
+     * @brief Parola ve PII için yalnızca taşınabilir metin
+     * @details İçerik WipingAllocator'lı tamponda, her zaman NUL ile biter; büyüme, clear() ve
+     *          yıkıcı eski baytları siler. Kopyalanamaz; okuma data()/size()/begin()/end() ile
+     *          (string_view benzeri) yapılır, std::string'e dönüştürme yoktur.
+     */
+    class SecureString {
+    public:
+        SecureString();
+        SecureString(const char* s, std::size_t n);
+        SecureString(const SecureString&) = delete;
+        SecureString& operator=(const SecureString&) = delete;
+        SecureString(SecureString&& other) noexcept;
+        SecureString& operator=(SecureString&& other) noexcept;
+        ~SecureString();
+
+        void push_back(char c);
+        void pop_back();
+        void append(const char* s, std::size_t n);
+        void clear();
+
+        /**
+         * @brief Sabit zamanlı eşitlik (uzunluk dışında içerik sızdırmaz)
+         */
+        bool equals(const SecureString& other) const;
+
+        const char* data() const { return buf_.data(); }
+        const char* c_str() const { return buf_.data(); }
+        std::size_t size() const { return buf_.size() - 1; }
+        bool empty() const { return size() == 0; }
+        const char* begin() const { return data(); }
+        const char* end() const { return data() + size(); }
+
+    private:
+        std::vector<char, WipingAllocator<char> > buf_;
+    };
+
+    // =================== Key Hierarchy ===================
+    /**
+     * @brief Kök anahtardan amaç etiketli alt anahtarlar (HKDF-Expand, SHA-256)
+     * @details Kök zaten PBKDF2 çıktısı (düzgün rastgele) olduğundan HKDF-Extract atlanır ve
+     *          kök PRK olarak kullanılır. Alt anahtar = HKDF-Expand(kök, etiket, 32); ilk istekte
+     *          türetilir, sonra önbellekten döner. Her özellik kendi etiketiyle bağımsız anahtar alır;
+     *          ek parola germe yoktur. İş parçacığı güvenlidir.
+     */
+    class KeyHierarchy {
+    public:
+        KeyHierarchy() {}
+        KeyHierarchy(const KeyHierarchy&) = delete;
+        KeyHierarchy& operator=(const KeyHierarchy&) = delete;
+
+        /**
+         * @brief Kök anahtarı ayarla (kopyalanır); önceki alt anahtarlar silinir
+         */
+        void Init(const unsigned char* rootKey32);
+
+        /**
+         * @brief Kökü ve tüm önbelleği sil
+         */
+        void Clear();
+
+        bool IsReady() const;
+
+        /**
+         * @brief Etiketin 32 baytlık alt anahtarı
+         * @param label Amaç etiketi, ör. "localsports/page-vfs/v1"
+         * @return Önbellekteki anahtar (Init/Clear'a kadar geçerli); kök yoksa veya HMAC hatasında nullptr
+         */
+        const SecureBuffer* Subkey(const std::string& label);
+
+    private:
+        mutable std::mutex mutex_;
+        SecureBuffer root_;
+        std::map<std::string, SecureBuffer> cache_;
     };
 
     // =================== Crypto ===================
@@ -37,13 +154,79 @@ namespace teamcore {
             int iterations,
             unsigned char* outKey32);
 
+        bool DeriveKeyFromPassphrase(const SecureString& passphrase,
+            const unsigned char* salt,
+            std::size_t saltLen,
+            int iterations,
+            unsigned char* outKey32);
+
+        /**
+         * @brief Toplu PBKDF2 işi (DeriveKeyFromPassphrase ile aynı parametreler; veriler çağıranda)
+         */
+        struct KdfJob {
+            const std::string* passphrase;
+            const unsigned char* salt;
+            std::size_t saltLen;
+            int iterations;
+            unsigned char* outKey32;
+        };
+
+        /**
+         * @brief Birçok PBKDF2-HMAC-SHA256 türetmesini SIMD şeritlerinde birlikte yürüt
+         * @details 16 iş aynı SHA-256 turlarında ilerler (derleyici şerit döngülerini vektörleştirir);
+         *          HMAC ipad/opad ara durumları bir kez hesaplanır. Sonuçlar PKCS5_PBKDF2_HMAC
+         *          (SHA-256, 32 bayt) ile bit düzeyinde aynıdır; iterasyon sayıları farklı olabilir.
+         *          Yeniden hash'leme, eski hesap denetimi gibi toplu bakım işleri içindir.
+         * @return false ise geçersiz iş (hiçbir çıktı yazılmamış olabilir) veya HMAC hatası
+         */
+        bool DeriveKeysFromPassphrases(const KdfJob* jobs, std::size_t count);
+
+        /**
+         * @brief 12 baytlık GCM IV üret (iş parçacığı başına tamponlu)
+         * @details Her iş parçacığı RAND_bytes'tan 768 baytlık blok çeker ve 12 baytlık dilimler
+         *          dağıtır; global DRBG kilidine alan başına değil 64 alanda bir gidilir. IV'ler yine
+         *          tamamen rastgeledir (tek anahtarla 2^32 şifreleme sınırı değişmez). Dağıtılan dilim
+         *          tampondan silinir; fork sonrası çocuk süreç tamponu atıp yeniden çeker.
+         * @return false ise RAND_bytes başarısız
+         */
+        bool GenerateNonce12(unsigned char out[12]);
+
+        /**
+         * @brief RFC 5869 HKDF-Expand (HMAC-SHA256)
+         * @param outLen En fazla 255 * 32 bayt
+         * @return false ise parametre veya HMAC hatası
+         */
+        bool HkdfExpandSha256(const unsigned char* prk, std::size_t prkLen,
+            const std::string& info,
+            unsigned char* out, std::size_t outLen);
+
         std::string EncryptForDB(const std::string& plaintext,
             const unsigned char* key32,
             const std::string& aad);
 
+        /**
+         * @brief EncryptForDB; düz metin SecureString'den doğrudan okunur (ara kopya yok)
+         */
+        std::string EncryptForDB(const SecureString& plaintext,
+            const unsigned char* key32,
+            const std::string& aad);
+
         std::string DecryptFromDB(const std::string& sealed,
             const unsigned char* key32,
             const std::string& aad);
+
+        /**
+         * @brief Birçok alanı tek çağrıda şifrele (toplu içe aktarma, yeniden şifreleme)
+         * @details Her eleman EncryptForDB ile aynı "GCM1:" biçimini ve kendi rastgele IV'sini alır;
+         *          boş metin "" olarak kalır. Anahtar çizelgesi, cipher bağlamı ve IV üretimi
+         *          iş parçacığı başına bir kez yapılır; büyük partiler çekirdeklere bölünür.
+         * @param sealed Çıktı; plaintexts ile aynı sırada ve boyutta
+         * @return false ise hata (sealed temizlenir)
+         */
+        bool EncryptBatchForDB(const std::vector<std::string>& plaintexts,
+            const unsigned char* key32,
+            const std::string& aad,
+            std::vector<std::string>& sealed);
     } // namespace crypto
 
     // =================== TLS ===================
@@ -64,7 +247,13 @@ namespace teamcore {
     const SecureBuffer& AppKey_Get();
     bool AppKey_IsReady();
 
+    /**
+     * @brief AppKey'den türetilmiş amaç etiketli alt anahtar (KeyHierarchy::Subkey)
+     * @return AppKey hazır değilse nullptr
+     */
+    const SecureBuffer* AppKey_Subkey(const std::string& label);
+
     // =================== Gvenli parola girii (bildirim) ===================
-    std::string read_password_secure(const std::string& prompt);
+    SecureString read_password_secure(const std::string& prompt);
 
 } // namespace teamcore
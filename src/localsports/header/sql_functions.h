@@ -0,0 +1,27 @@
+#pragma once
+
+struct sqlite3;
+
+namespace teamcore {
+namespace sqlfn {
+
+    // =================== SQL User-Defined Functions ===================
+    /**
+     * @brief Bağlantıya LocalSports SQL fonksiyonlarını kaydet
+     * @details Skaler:
+     *            ls_decrypt(x)        "GCM1:" ile başlayan değeri çözer, diğerlerini aynen döndürür
+     *                                 (çözülemezse NULL). SQLITE_DIRECTONLY: şema/trigger içinde kullanılamaz.
+     *          Aggregate (NULL değerler atlanır, boş kümede NULL):
+     *            ls_median(x)         MathUtility::calculateMedian
+     *            ls_stddev(x)         MathUtility::calculateStdDev (örneklem, n-1)
+     *            ls_quantile(x, q)    MathUtility::calculateQuantile, q ∈ [0,1]
+     *          Tümü SQLITE_DETERMINISTIC ile kaydedilir; planlayıcı ifadeyi indeks/ORDER BY
+     *          içinde tekrar kullanabilir.
+     * @param db Hedef bağlantı
+     * @param key32 ls_decrypt için 32 baytlık anahtar (kopyalanır); nullptr ise ls_decrypt kaydedilmez
+     * @return true ise tüm fonksiyonlar kaydedildi
+     */
+    bool RegisterSqlFunctions(sqlite3* db, const unsigned char* key32);
+
+} // namespace sqlfn
+} // namespace teamcore
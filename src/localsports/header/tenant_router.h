@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+struct sqlite3;
+
+namespace teamcore {
+namespace tenant {
+
+    // =================== Configuration ===================
+    /**
+     * @brief Yeni açılan her kiracı bağlantısına uygulanacak kurulum (PRAGMA'lar vb.)
+     * @return false ise bağlantı kapatılır ve Acquire başarısız olur
+     */
+    typedef std::function<bool(sqlite3*)> ConnectionSetup;
+
+    /**
+     * @brief Router ayarları
+     */
+    struct RouterConfig {
+        std::string baseDir = "tenants"; ///< Kiracı veritabanlarının dizini (yoksa oluşturulur)
+        std::size_t maxOpen = 32;        ///< Aynı anda açık tutulacak en fazla bağlantı (fd sınırı)
+        int openFlags = 0;               ///< 0 ise READWRITE|CREATE|FULLMUTEX|URI
+        std::string vfs;                 ///< Boş ise varsayılan VFS (ör. "ls-crypt")
+        ConnectionSetup setup;           ///< Her açılışta bir kez çağrılır
+    };
+
+    /**
+     * @brief Router sayaçları
+     */
+    struct RouterStats {
+        uint64_t hits = 0;       ///< Açık bağlantıdan karşılanan Acquire
+        uint64_t opens = 0;      ///< Lazy açılış
+        uint64_t evictions = 0;  ///< LRU nedeniyle kapatılan bağlantı
+        uint64_t rejected = 0;   ///< Limit dolu ve tüm bağlantılar kullanımda
+    };
+
+    class TenantRouter;
+
+    // =================== TenantLease ===================
+    /**
+     * @brief Kiracı bağlantısını kullanım süresince sabitleyen (pin) RAII nesnesi
+     * @details Lease yaşadığı sürece bağlantı LRU tarafından kapatılmaz.
+     *          Router, tüm lease'lerden uzun yaşamalıdır.
+     */
+    class TenantLease {
+    public:
+        TenantLease() : router_(nullptr), db_(nullptr) {}
+        ~TenantLease() { Release(); }
+        TenantLease(TenantLease&& other);
+        TenantLease& operator=(TenantLease&& other);
+        TenantLease(const TenantLease&) = delete;
+        TenantLease& operator=(const TenantLease&) = delete;
+
+        sqlite3* Db() const { return db_; }
+        const std::string& TenantId() const { return tenantId_; }
+        explicit operator bool() const { return db_ != nullptr; }
+
+        /**
+         * @brief Pin'i erken bırak (bağlantı açık kalır, LRU'ya döner)
+         */
+        void Release();
+
+    private:
+        friend class TenantRouter;
+        TenantLease(TenantRouter* router, const std::string& tenantId, sqlite3* db)
+            : router_(router), db_(db), tenantId_(tenantId) {}
+
+        TenantRouter* router_;
+        sqlite3* db_;
+        std::string tenantId_;
+    };
+
+    // =================== TenantRouter ===================
+    /**
+     * @brief Kiracı kimliğini kendi veritabanı dosyasına yönlendiren bağlantı havuzu
+     * @details baseDir/<tenant>.db dosyaları ilk kullanımda açılır. Açık bağlantı sayısı
+     *          maxOpen ile sınırlıdır; limit dolunca en uzun süredir kullanılmayan ve
+     *          pin'lenmemiş bağlantı kapatılır. Tüm metodlar thread-safe'tir.
+     */
+    class TenantRouter {
+    public:
+        explicit TenantRouter(const RouterConfig& config = RouterConfig());
+        ~TenantRouter();
+        TenantRouter(const TenantRouter&) = delete;
+        TenantRouter& operator=(const TenantRouter&) = delete;
+
+        /**
+         * @brief Kiracı kimliği geçerli mi? ([a-z0-9_-], 1-64 karakter)
+         * @details Kimlik dosya adına dönüştüğü için yol ayırıcı ve '.' kabul edilmez.
+         */
+        static bool IsValidTenantId(const std::string& tenantId);
+
+        /**
+         * @brief Kiracının veritabanı dosya yolu
+         */
+        std::string PathFor(const std::string& tenantId) const;
+
+        /**
+         * @brief Kiracı bağlantısını al (gerekirse aç) ve pin'le
+         * @return Geçersiz kimlik, açılış hatası veya limit dolu ise boş lease
+         */
+        TenantLease Acquire(const std::string& tenantId);
+
+        /**
+         * @brief Pin'lenmemiş bağlantıyı kapat
+         * @return false ise açık değil veya kullanımda
+         */
+        bool Close(const std::string& tenantId);
+
+        /**
+         * @brief Pin'lenmemiş tüm bağlantıları kapat
+         */
+        void CloseIdle();
+
+        std::size_t OpenCount() const;
+        bool IsOpen(const std::string& tenantId) const;
+        RouterStats Stats() const;
+
+    private:
+        friend class TenantLease;
+
+        struct Entry {
+            sqlite3* db;
+            int pins;
+            std::list<std::string>::iterator lruPos;
+        };
+
+        void Unpin(const std::string& tenantId);
+        bool EvictOneLocked();
+        void CloseLocked(std::unordered_map<std::string, Entry>::iterator it);
+
+        RouterConfig config_;
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, Entry> open_;
+        std::list<std::string> lru_; // ön = en son kullanılan
+        RouterStats stats_;
+    };
+
+} // namespace tenant
+} // namespace teamcore
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace teamcore {
+namespace zygote {
+
+    /**
+     * @brief Worker'da komutu çalıştıran fonksiyon (istemcinin argümanları -> çıkış kodu)
+     */
+    typedef std::function<int(const std::vector<std::string>&)> Handler;
+
+    /**
+     * @brief Zygote sunucu ayarları
+     */
+    struct ZygoteConfig {
+        std::string socketPath;           ///< Unix soket yolu (boşsa DefaultSocketPath())
+        int maxRequests = 0;              ///< >0 ise bu kadar bağlantıdan sonra Serve döner
+        std::function<void()> afterFork;  ///< Worker'da handler'dan önce (ör. RASP izlemeyi yeniden başlat)
+        std::function<void()> onIdle;     ///< Sunucu thread'inde, bağlantılar arasında (ör. RASP taraması)
+        int idleIntervalMs = 1000;        ///< onIdle çağrıları arasındaki en kısa süre
+    };
+
+    // =================== Server ===================
+    /**
+     * @brief Soketi dinle; her bağlantı için fork edilen worker komutu çalıştırır
+     * @details Ebeveyn pahalı hazırlığı (RASP, AppKey KDF, VFS) bir kez yapmış olmalıdır;
+     *          worker bunları kopyala-yaz sayfalarla devralır. Worker istemcinin
+     *          stdin/stdout/stderr tanımlayıcılarını (SCM_RIGHTS) alır, handler'ı çalıştırır,
+     *          çıkış kodunu sokete yazar ve _exit ile sonlanır. Soket 0600 oluşturulur ve
+     *          yalnızca aynı kullanıcının bağlantıları kabul edilir. Soketin dizini kullanıcıya
+     *          ait olmalı ve başkalarınca yazılamamalıdır.
+     *          SQLite bağlantıları fork'u geçemez: veritabanı worker'da açılmalıdır.
+     *          fork yalnızca çağıran thread'i kopyalar: Serve tek thread'li süreçten çağrılmalıdır
+     *          (başka thread'in tuttuğu kilit worker'da kilitli kalır). Periyodik işler thread
+     *          yerine onIdle ile yapılır.
+     * @return false ise soket hatası (ayrıntı std::cerr'e yazılır); POSIX dışında her zaman false
+     */
+    bool Serve(const ZygoteConfig& config, const Handler& handler);
+
+    // =================== Client ===================
+    /**
+     * @brief Komutu zygote'a gönder ve worker bitene kadar bekle
+     * @details Çağıranın stdin/stdout/stderr'i worker'a devredilir; etkileşimli menüler
+     *          doğrudan aynı terminalde çalışır.
+     * @details Soket dizini kullanıcıya ait değilse veya karşı uç başka bir kullanıcıysa
+     *          hiçbir tanımlayıcı gönderilmez.
+     * @return Worker'ın çıkış kodu; zygote'a bağlanılamazsa -1 (çağıran normal başlatmaya döner)
+     */
+    int RunClient(const std::string& socketPath, const std::vector<std::string>& args);
+
+    /**
+     * @brief Varsayılan soket yolu: $XDG_RUNTIME_DIR/localsports.zygote, yoksa $HOME/.localsports.zygote
+     * @return İkisi de yoksa boş (paylaşılan /tmp kullanılmaz)
+     */
+    std::string DefaultSocketPath();
+
+} // namespace zygote
+} // namespace teamcore
@@ -0,0 +1,378 @@
+// src/archive.cpp
+// Kapalı sezonları ayrı veritabanı dosyalarına taşıma + salt-okunur ATTACH ve birleşik görünümler
+
+#include "archive.h"
+#include "page_vfs.h"
+#include "message_partitions.h"
+#include "message_index.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+#include <sqlite3.h>
+
+namespace teamcore {
+namespace archive {
+
+    // =================== Schema ===================
+    // Arşiv şeması: sütun sırası ana tablolarla aynı, players'a FK yok (arşivde players tutulmaz)
+    static const char* ARCHIVE_SCHEMA =
+        "CREATE TABLE IF NOT EXISTS archive_rw.games ("
+        "id INTEGER PRIMARY KEY, date TEXT NOT NULL, time TEXT NOT NULL, opponent TEXT NOT NULL,"
+        "location TEXT NOT NULL, played INTEGER NOT NULL, result TEXT NOT NULL);"
+        "CREATE TABLE IF NOT EXISTS archive_rw.stats ("
+        "id INTEGER PRIMARY KEY, gameId INTEGER NOT NULL, playerId INTEGER NOT NULL,"
+        "goals INTEGER NOT NULL, assists INTEGER NOT NULL, saves INTEGER NOT NULL,"
+        "yellow INTEGER NOT NULL, red INTEGER NOT NULL);"
+        "CREATE INDEX IF NOT EXISTS archive_rw.idx_stats_player ON stats(playerId);"
+        "CREATE TABLE IF NOT EXISTS archive_rw.messages ("
+        "id INTEGER PRIMARY KEY, datetime TEXT NOT NULL, text TEXT NOT NULL);";
+
+    static const char* GAME_COLS = "id,date,time,opponent,location,played,result";
+    static const char* STAT_COLS = "id,gameId,playerId,goals,assists,saves,yellow,red";
+    static const char* MESSAGE_COLS = "id,datetime,text";
+
+    // =================== Helper Functions ===================
+    static bool Exec(sqlite3* db, const std::string& sql) {
+        char* err = nullptr;
+        if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &err) != SQLITE_OK) {
+            std::cerr << "SQL hatasi: " << (err ? err : "(null)") << "\n";
+            sqlite3_free(err);
+            return false;
+        }
+        return true;
+    }
+
+    // Sezon kimliği şema adında kullanıldığı için yalnızca 4 rakam kabul edilir
+    static bool IsValidSeason(const std::string& season) {
+        if (season.size() != 4) return false;
+        for (std::size_t i = 0; i < season.size(); ++i) {
+            if (!std::isdigit(static_cast<unsigned char>(season[i]))) return false;
+        }
+        return true;
+    }
+
+    static int StepChanges(sqlite3* db, sqlite3_stmt* st, bool& ok) {
+        if (!st) return 0;
+        if (sqlite3_step(st) != SQLITE_DONE) {
+            std::cerr << "SQL hatasi: " << sqlite3_errmsg(db) << "\n";
+            ok = false;
+        }
+        sqlite3_finalize(st);
+        return ok ? sqlite3_changes(db) : 0;
+    }
+
+    static sqlite3_stmt* PrepareSeason(sqlite3* db, const std::string& sql, const std::string& season, bool& ok) {
+        sqlite3_stmt* st = nullptr;
+        if (!ok || sqlite3_prepare_v2(db, sql.c_str(), -1, &st, nullptr) != SQLITE_OK) {
+            if (ok) std::cerr << "prepare failed: " << sqlite3_errmsg(db) << "\n";
+            ok = false;
+            return nullptr;
+        }
+        if (sqlite3_bind_parameter_count(st) >= 1) {
+            sqlite3_bind_text(st, 1, season.c_str(), -1, SQLITE_TRANSIENT);
+        }
+        return st;
+    }
+
+    // Dosya yolunu salt-okunur URI'ye çevir (?, #, % kaçışlanır)
+    static std::string ReadOnlyUri(const std::string& path) {
+        std::string uri = "file:";
+        if (path.size() > 1 && path[1] == ':') uri += "/"; // Windows sürücü harfi
+        for (std::size_t i = 0; i < path.size(); ++i) {
+            char c = path[i];
+            if (c == '\\') c = '/';
+            if (c == '?' || c == '#' || c == '%') {
+                char buf[4];
+                std::snprintf(buf, sizeof(buf), "%%%02X", static_cast<unsigned char>(c));
+                uri += buf;
+            } else {
+                uri += c;
+            }
+        }
+        return uri + "?mode=ro";
+    }
+
+    // =================== Catalog ===================
+    bool EnsureCatalog(sqlite3* db) {
+        return Exec(db, "CREATE TABLE IF NOT EXISTS main._ls_archives ("
+                        "season TEXT PRIMARY KEY,"
+                        "path TEXT NOT NULL,"
+                        "games INTEGER NOT NULL,"
+                        "stats INTEGER NOT NULL,"
+                        "messages INTEGER NOT NULL,"
+                        "archivedAt TEXT NOT NULL);");
+    }
+
+    std::vector<SeasonInfo> ListSeasons(sqlite3* db, int currentYear) {
+        std::vector<SeasonInfo> out;
+        sqlite3_stmt* st = nullptr;
+        if (sqlite3_prepare_v2(db,
+                "SELECT substr(date,1,4) AS season, COUNT(*), SUM(played=0) "
+                "FROM main.games GROUP BY season ORDER BY season;", -1, &st, nullptr) != SQLITE_OK) {
+            std::cerr << "prepare failed: " << sqlite3_errmsg(db) << "\n";
+            return out;
+        }
+        while (sqlite3_step(st) == SQLITE_ROW) {
+            const char* s = reinterpret_cast<const char*>(sqlite3_column_text(st, 0));
+            SeasonInfo info;
+            info.season = s ? s : "";
+            info.games = sqlite3_column_int(st, 1);
+            info.unplayed = sqlite3_column_int(st, 2);
+            info.closed = IsValidSeason(info.season) && info.unplayed == 0 &&
+                          std::atoi(info.season.c_str()) < currentYear;
+            out.push_back(info);
+        }
+        sqlite3_finalize(st);
+        return out;
+    }
+
+    std::vector<ArchiveEntry> ListArchives(sqlite3* db) {
+        std::vector<ArchiveEntry> out;
+        if (!EnsureCatalog(db)) return out;
+
+        sqlite3_stmt* st = nullptr;
+        if (sqlite3_prepare_v2(db,
+                "SELECT season,path,games,stats,messages,archivedAt FROM main._ls_archives ORDER BY season DESC;",
+                -1, &st, nullptr) != SQLITE_OK) {
+            return out;
+        }
+        while (sqlite3_step(st) == SQLITE_ROW) {
+            ArchiveEntry e;
+            e.season = reinterpret_cast<const char*>(sqlite3_column_text(st, 0));
+            e.path = reinterpret_cast<const char*>(sqlite3_column_text(st, 1));
+            e.games = sqlite3_column_int(st, 2);
+            e.stats = sqlite3_column_int(st, 3);
+            e.messages = sqlite3_column_int(st, 4);
+            e.archivedAt = reinterpret_cast<const char*>(sqlite3_column_text(st, 5));
+            out.push_back(e);
+        }
+        sqlite3_finalize(st);
+        return out;
+    }
+
+    std::string ArchivePathFor(const std::string& dbPath, const std::string& season) {
+        std::string base = dbPath;
+        std::size_t slash = base.find_last_of("/\\");
+        std::size_t dot = base.find_last_of('.');
+        if (dot != std::string::npos && (slash == std::string::npos || dot > slash)) {
+            base.erase(dot);
+        }
+        return base + "_" + season + ".db";
+    }
+
+    // =================== Archive ===================
+    // Ana veritabanında olup arşivde aynı id ile bulunmayan sezon satırları (games + stats + messages)
+    static int64_t CountMissingFromArchive(sqlite3* db, const std::string& season, bool& ok) {
+        const std::string inSeason = "(SELECT id FROM main.games WHERE substr(date,1,4)=?1)";
+        sqlite3_stmt* st = PrepareSeason(db,
+            "SELECT (SELECT COUNT(*) FROM main.games WHERE substr(date,1,4)=?1"
+            " AND id NOT IN (SELECT id FROM archive_rw.games))"
+            " + (SELECT COUNT(*) FROM main.stats WHERE gameId IN " + inSeason +
+            " AND id NOT IN (SELECT id FROM archive_rw.stats))"
+            " + (SELECT COUNT(*) FROM main.messages WHERE substr(datetime,1,4)=?1"
+            " AND id NOT IN (SELECT id FROM archive_rw.messages));", season, ok);
+        if (!st) return -1;
+        int64_t missing = -1;
+        if (sqlite3_step(st) == SQLITE_ROW) {
+            missing = sqlite3_column_int64(st, 0);
+        }
+        else {
+            std::cerr << "SQL hatasi: " << sqlite3_errmsg(db) << "\n";
+            ok = false;
+        }
+        sqlite3_finalize(st);
+        return missing;
+    }
+
+    bool ArchiveSeason(sqlite3* db, const std::string& dbPath, const std::string& season,
+                       int currentYear, ArchiveEntry* out) {
+        if (!db || !IsValidSeason(season) || !EnsureCatalog(db)) return false;
+
+        bool found = false;
+        std::vector<SeasonInfo> seasons = ListSeasons(db, currentYear);
+        for (std::size_t i = 0; i < seasons.size(); ++i) {
+            if (seasons[i].season != season) continue;
+            found = true;
+            if (!seasons[i].closed) {
+                std::cerr << "Sezon kapali degil (oynanmamis mac var veya guncel yil): " << season << "\n";
+                return false;
+            }
+        }
+        if (!found) {
+            std::cerr << "Sezon bulunamadi: " << season << "\n";
+            return false;
+        }
+
+        DetachArchives(db);
+
+        ArchiveEntry entry;
+        entry.season = season;
+        entry.path = ArchivePathFor(dbPath, season);
+
+        sqlite3_stmt* att = nullptr;
+        if (sqlite3_prepare_v2(db, "ATTACH DATABASE ? AS archive_rw;", -1, &att, nullptr) != SQLITE_OK) return false;
+        sqlite3_bind_text(att, 1, entry.path.c_str(), -1, SQLITE_TRANSIENT);
+        int rc = sqlite3_step(att);
+        sqlite3_finalize(att);
+        if (rc != SQLITE_DONE) {
+            std::cerr << "Arsiv dosyasi acilamadi: " << sqlite3_errmsg(db) << "\n";
+            return false;
+        }
+        // ATTACH bağlantının VFS'ini kullanır; sayfa şifreli modda yeni arşiv de aynı düzende oluşur
+        pagevfs::PrepareNewDatabase(db, "archive_rw");
+
+        // 1. aşama: kopya arşivde kendi transaction'ıyla commit edilip diske senkronlanır
+        const std::string inSeason = "(SELECT id FROM main.games WHERE substr(date,1,4)=?1)";
+        bool ok = Exec(db, ARCHIVE_SCHEMA) && Exec(db, "PRAGMA archive_rw.synchronous=FULL;") &&
+                  Exec(db, "BEGIN IMMEDIATE;");
+        if (ok) {
+            entry.games = StepChanges(db, PrepareSeason(db,
+                std::string("INSERT OR REPLACE INTO archive_rw.games(") + GAME_COLS + ") SELECT " + GAME_COLS +
+                " FROM main.games WHERE substr(date,1,4)=?1;", season, ok), ok);
+            entry.stats = StepChanges(db, PrepareSeason(db,
+                std::string("INSERT OR REPLACE INTO archive_rw.stats(") + STAT_COLS + ") SELECT " + STAT_COLS +
+                " FROM main.stats WHERE gameId IN " + inSeason + ";", season, ok), ok);
+            entry.messages = StepChanges(db, PrepareSeason(db,
+                std::string("INSERT OR REPLACE INTO archive_rw.messages(") + MESSAGE_COLS + ") SELECT " + MESSAGE_COLS +
+                " FROM main.messages WHERE substr(datetime,1,4)=?1;", season, ok), ok);
+            ok = ok && Exec(db, "COMMIT;");
+            if (!ok) sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        }
+
+        // 2. aşama: arşivde eksik satır yoksa ana veritabanından silinir. Arada çökme
+        // satırları iki yerde bırakır (tekrar çalıştırmak güvenli), hiçbir zaman kaybetmez.
+        ok = ok && Exec(db, "BEGIN IMMEDIATE;");
+        if (ok) {
+            const int64_t missing = CountMissingFromArchive(db, season, ok);
+            if (ok && missing != 0) {
+                std::cerr << "Arsiv dogrulanamadi: " << missing << " satir arsivde yok (" << entry.path << ")\n";
+                ok = false;
+            }
+
+            // Önce stats (games'e FK), sonra games ve messages
+            StepChanges(db, PrepareSeason(db, "DELETE FROM main.stats WHERE gameId IN " + inSeason + ";", season, ok), ok);
+            StepChanges(db, PrepareSeason(db, "DELETE FROM main.games WHERE substr(date,1,4)=?1;", season, ok), ok);
+            if (ok && partition::IsPartitioned(db)) {
+                // Aylık bölümler: sezonun ayları tablo olarak düşürülür
+                ok = partition::DropYear(db, season) >= 0;
+            }
+            else {
+                ok = ok && search::PruneMessages(db, "SELECT id FROM main.messages WHERE substr(datetime,1,4)=?1", season) >= 0;
+                StepChanges(db, PrepareSeason(db, "DELETE FROM main.messages WHERE substr(datetime,1,4)=?1;", season, ok), ok);
+            }
+
+            // Katalog: aynı sezon tekrar arşivlenirse toplamlar arşiv dosyasından yeniden okunur.
+            // Değerler önce okunup bağlanır; ana şemaya yazan ifade archive_rw'ye ve saate bağlı kalmaz
+            // (hibrit log'u replay'de arşiv bağlı değildir)
+            sqlite3_stmt* totals = PrepareSeason(db,
+                "SELECT (SELECT COUNT(*) FROM archive_rw.games),(SELECT COUNT(*) FROM archive_rw.stats),"
+                "(SELECT COUNT(*) FROM archive_rw.messages),datetime('now','localtime');", season, ok);
+            sqlite3_stmt* cat = PrepareSeason(db,
+                "INSERT OR REPLACE INTO main._ls_archives(season,path,games,stats,messages,archivedAt) "
+                "VALUES(?1,?2,?3,?4,?5,?6);", season, ok);
+            if (ok && sqlite3_step(totals) == SQLITE_ROW) {
+                sqlite3_bind_text(cat, 2, entry.path.c_str(), -1, SQLITE_TRANSIENT);
+                for (int c = 0; c < 4; ++c) sqlite3_bind_value(cat, 3 + c, sqlite3_column_value(totals, c));
+            }
+            else if (ok) {
+                std::cerr << "SQL hatasi: " << sqlite3_errmsg(db) << "\n";
+                ok = false;
+            }
+            if (ok) StepChanges(db, cat, ok);
+            else sqlite3_finalize(cat);
+            sqlite3_finalize(totals);
+
+            ok = ok && Exec(db, "COMMIT;");
+            if (!ok) sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        }
+        Exec(db, "DETACH DATABASE archive_rw;");
+
+        if (ok && out) *out = entry;
+        return ok;
+    }
+
+    // =================== Attach ===================
+    static int AttachedCount(sqlite3* db) {
+        sqlite3_stmt* st = nullptr;
+        int n = 0;
+        if (sqlite3_prepare_v2(db, "PRAGMA database_list;", -1, &st, nullptr) == SQLITE_OK) {
+            while (sqlite3_step(st) == SQLITE_ROW) ++n;
+        }
+        sqlite3_finalize(st);
+        return n > 2 ? n - 2 : 0; // main + temp hariç
+    }
+
+    int AttachArchives(sqlite3* db) {
+        if (!db) return -1;
+        DetachArchives(db);
+
+        // Bir slot ArchiveSeason için boş bırakılır
+        const int budget = sqlite3_limit(db, SQLITE_LIMIT_ATTACHED, -1) - AttachedCount(db) - 1;
+        std::vector<ArchiveEntry> archives = ListArchives(db);
+        std::vector<std::string> attached;
+
+        for (std::size_t i = 0; i < archives.size() && static_cast<int>(attached.size()) < budget; ++i) {
+            if (!IsValidSeason(archives[i].season)) continue;
+            const std::string schema = "arch_" + archives[i].season;
+            const std::string uri = ReadOnlyUri(archives[i].path);
+
+            sqlite3_stmt* st = nullptr;
+            std::string sql = "ATTACH DATABASE ? AS " + schema + ";";
+            if (sqlite3_prepare_v2(db, sql.c_str(), -1, &st, nullptr) != SQLITE_OK) return -1;
+            sqlite3_bind_text(st, 1, uri.c_str(), -1, SQLITE_TRANSIENT);
+            int rc = sqlite3_step(st);
+            sqlite3_finalize(st);
+            if (rc != SQLITE_DONE) {
+                std::cerr << "Arsiv baglanamadi (" << archives[i].path << "): " << sqlite3_errmsg(db) << "\n";
+                continue;
+            }
+            attached.push_back(schema);
+        }
+
+        struct ViewDef { const char* view; const char* table; const char* cols; };
+        const ViewDef views[] = {
+            { "all_games", "games", GAME_COLS },
+            { "all_stats", "stats", STAT_COLS },
+            { "all_messages", "messages", MESSAGE_COLS },
+        };
+        for (std::size_t v = 0; v < sizeof(views) / sizeof(views[0]); ++v) {
+            std::string sql = std::string("CREATE TEMP VIEW ") + views[v].view + " AS SELECT " + views[v].cols +
+                              " FROM main." + views[v].table;
+            for (std::size_t i = 0; i < attached.size(); ++i) {
+                sql += std::string(" UNION ALL SELECT ") + views[v].cols + " FROM " + attached[i] + "." + views[v].table;
+            }
+            if (!Exec(db, sql + ";")) {
+                DetachArchives(db);
+                return -1;
+            }
+        }
+        return static_cast<int>(attached.size());
+    }
+
+    void DetachArchives(sqlite3* db) {
+        if (!db) return;
+        sqlite3_exec(db,
+            "DROP VIEW IF EXISTS temp.all_games;"
+            "DROP VIEW IF EXISTS temp.all_stats;"
+            "DROP VIEW IF EXISTS temp.all_messages;", nullptr, nullptr, nullptr);
+
+        std::vector<std::string> names;
+        sqlite3_stmt* st = nullptr;
+        if (sqlite3_prepare_v2(db, "PRAGMA database_list;", -1, &st, nullptr) == SQLITE_OK) {
+            while (sqlite3_step(st) == SQLITE_ROW) {
+                const char* name = reinterpret_cast<const char*>(sqlite3_column_text(st, 1));
+                if (name && std::string(name).compare(0, 5, "arch_") == 0) names.push_back(name);
+            }
+        }
+        sqlite3_finalize(st);
+
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            Exec(db, "DETACH DATABASE " + names[i] + ";");
+        }
+    }
+
+} // namespace archive
+} // namespace teamcore
@@ -0,0 +1,790 @@
+// src/backup.cpp
+// Online incremental backup (SQLite backup API) + şifreli/sıkıştırılmış yedek paketi
+
+#include "backup.h"
+#include "security_layer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <vector>
+
+#include <sqlite3.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+
+namespace teamcore {
+namespace backup {
+
+    // =================== Container Format ===================
+    // "LSBK" | version(1) | flags(1) | [iv(12)] | payload | [tag(16)]
+    // payload: sıkıştırma açıksa [rawLen u32][encLen u32][enc] çerçeveleri, değilse ham baytlar.
+    // Başlık (magic+version+flags) GCM AAD olarak doğrulanır.
+    static const char kMagic[4] = { 'L', 'S', 'B', 'K' };
+    static const unsigned char kVersion = 1;
+    static const unsigned char kFlagEncrypt = 0x01;
+    static const unsigned char kFlagCompress = 0x02;
+    static const std::size_t kHeaderLen = 6;
+    static const std::size_t kIvLen = 12;
+    static const std::size_t kTagLen = 16;
+    static const std::size_t kChunk = 64 * 1024;
+
+    // =================== Helper Functions ===================
+    static void PutU32(std::vector<unsigned char>& out, uint32_t v) {
+        for (int i = 0; i < 4; ++i) out.push_back(static_cast<unsigned char>(v >> (8 * i)));
+    }
+
+    static uint32_t GetU32(const unsigned char* p) {
+        return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+    }
+
+    // Sıfır dizisi sıkıştırma: 0x00-0x7F = (c+1) literal bayt, 0x80 + varint = sıfır dizisi
+    static void ZeroRunEncode(const unsigned char* in, std::size_t n, std::vector<unsigned char>& out) {
+        std::size_t i = 0;
+        while (i < n) {
+            std::size_t z = i;
+            while (z < n && in[z] == 0) ++z;
+            if (z - i >= 4) {
+                std::size_t run = z - i;
+                out.push_back(0x80);
+                while (run >= 0x80) {
+                    out.push_back(static_cast<unsigned char>((run & 0x7F) | 0x80));
+                    run >>= 7;
+                }
+                out.push_back(static_cast<unsigned char>(run));
+                i = z;
+                continue;
+            }
+
+            // Literal: bir sonraki uzun sıfır dizisine veya 128 bayta kadar
+            std::size_t end = i;
+            while (end < n && end - i < 128) {
+                if (in[end] == 0) {
+                    std::size_t zz = end;
+                    while (zz < n && in[zz] == 0 && zz - end < 4) ++zz;
+                    if (zz - end >= 4) break;
+                }
+                ++end;
+            }
+            out.push_back(static_cast<unsigned char>(end - i - 1));
+            out.insert(out.end(), in + i, in + end);
+            i = end;
+        }
+    }
+
+    static bool ZeroRunDecode(const unsigned char* in, std::size_t n, std::vector<unsigned char>& out) {
+        std::size_t i = 0;
+        while (i < n) {
+            unsigned char c = in[i++];
+            if (c < 0x80) {
+                std::size_t len = std::size_t(c) + 1;
+                if (i + len > n) return false;
+                out.insert(out.end(), in + i, in + i + len);
+                i += len;
+            } else if (c == 0x80) {
+                std::size_t run = 0;
+                int shift = 0;
+                while (true) {
+                    if (i >= n || shift > 28) return false;
+                    unsigned char b = in[i++];
+                    run |= std::size_t(b & 0x7F) << shift;
+                    if (!(b & 0x80)) break;
+                    shift += 7;
+                }
+                out.insert(out.end(), run, 0);
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Bağlantının VFS adı: yedek dosyası canlı DB ile aynı VFS üzerinden yazılır/okunur
+    // (sayfa şifreleyen VFS kullanılıyorsa yedek de sayfa düzeyinde şifreli kalır)
+    static const char* VfsOf(sqlite3* db) {
+        sqlite3_vfs* vfs = nullptr;
+        if (!db || sqlite3_file_control(db, "main", SQLITE_FCNTL_VFS_POINTER, &vfs) != SQLITE_OK || !vfs) return nullptr;
+        return vfs->zName;
+    }
+
+    // Düz ara kopya yalnızca varsayılan VFS'te belleğe alınır; sayfa VFS'inin dosya düzeni
+    // (şifreli sayfalar, checksum) yalnızca o VFS üzerinden açılabilir
+    static bool OnDefaultVfs(const char* vfs) {
+        sqlite3_vfs* def = sqlite3_vfs_find(nullptr);
+        return !vfs || (def && std::strcmp(vfs, def->zName) == 0);
+    }
+
+    static bool QuickCheckDb(sqlite3* db, std::string& err) {
+        sqlite3_stmt* st = nullptr;
+        bool ok = false;
+        if (sqlite3_prepare_v2(db, "PRAGMA quick_check;", -1, &st, nullptr) == SQLITE_OK &&
+            sqlite3_step(st) == SQLITE_ROW) {
+            const char* res = reinterpret_cast<const char*>(sqlite3_column_text(st, 0));
+            ok = res && std::strcmp(res, "ok") == 0;
+            if (!ok) err = std::string("quick_check: ") + (res ? res : "(null)");
+        } else {
+            err = std::string("quick_check calistirilamadi: ") + sqlite3_errmsg(db);
+        }
+        sqlite3_finalize(st);
+        return ok;
+    }
+
+    static bool QuickCheck(const std::string& path, std::string& err, const char* vfs = nullptr) {
+        sqlite3* db = nullptr;
+        if (sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READONLY, vfs) != SQLITE_OK) {
+            err = "yedek acilamadi: " + std::string(db ? sqlite3_errmsg(db) : "(null)");
+            sqlite3_close(db);
+            return false;
+        }
+        const bool ok = QuickCheckDb(db, err);
+        sqlite3_close(db);
+        return ok;
+    }
+
+    // =================== Plaintext Staging ===================
+    // Sayfa VFS'inde ara dosya: önceden 0600 oluşturulur (SQLite mevcut dosyanın iznini,
+    // journal/WAL da ana dosyanınkini kullanır), silinmeden önce üzerine sıfır yazılır
+    static bool CreatePrivateFile(const std::string& path) {
+        std::remove(path.c_str());
+#if defined(_WIN32)
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        return static_cast<bool>(out);
+#else
+        const int fd = open(path.c_str(), O_CREAT | O_EXCL | O_WRONLY | O_CLOEXEC, 0600);
+        if (fd < 0) return false;
+        close(fd);
+        return true;
+#endif
+    }
+
+    static void ShredFile(const std::string& path) {
+        std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+        if (f) {
+            f.seekg(0, std::ios::end);
+            std::streamoff left = f.tellg();
+            f.seekp(0);
+            const std::vector<char> zeros(kChunk, 0);
+            while (f && left > 0) {
+                const std::streamoff n = left < static_cast<std::streamoff>(zeros.size()) ? left : zeros.size();
+                f.write(zeros.data(), n);
+                left -= n;
+            }
+            f.flush();
+        }
+        f.close();
+        std::remove(path.c_str());
+    }
+
+    // Bellekteki düz veritabanı görüntüsü; büyürken ve bırakılırken eski baytlar sıfırlanır
+    class PlainImage {
+    public:
+        PlainImage() : data_(nullptr), size_(0), cap_(0) {}
+        ~PlainImage() { Clear(); }
+        PlainImage(const PlainImage&) = delete;
+        PlainImage& operator=(const PlainImage&) = delete;
+
+        bool Append(const unsigned char* p, std::size_t n) {
+            if (size_ + n > cap_) {
+                std::size_t cap = cap_ ? cap_ : kChunk;
+                while (cap < size_ + n) cap *= 2;
+                unsigned char* grown = new (std::nothrow) unsigned char[cap];
+                if (!grown) return false;
+                if (size_) std::memcpy(grown, data_, size_);
+                Release();
+                data_ = grown;
+                cap_ = cap;
+            }
+            std::memcpy(data_ + size_, p, n);
+            size_ += n;
+            return true;
+        }
+
+        unsigned char* Data() { return data_; }
+        std::size_t Size() const { return size_; }
+
+        void Clear() {
+            Release();
+            data_ = nullptr;
+            size_ = cap_ = 0;
+        }
+
+    private:
+        void Release() {
+            if (data_) {
+                SecureBuffer::secure_bzero(data_, cap_);
+                delete[] data_;
+            }
+        }
+
+        unsigned char* data_;
+        std::size_t size_;
+        std::size_t cap_;
+    };
+
+    // Görüntüyü salt okunur bellek veritabanı olarak aç; görüntü bağlantı kapanana kadar yaşamalı
+    static sqlite3* OpenImage(PlainImage& image, std::string& err) {
+        // Bellek veritabanı WAL açamaz: başlığın WAL işareti (18/19 = 2) rollback'e çevrilir.
+        // Geri yükleme hedefin kendi journal modunu korur.
+        if (image.Size() >= 100 && image.Data()[18] == 2 && image.Data()[19] == 2) {
+            image.Data()[18] = image.Data()[19] = 1;
+        }
+        sqlite3* db = nullptr;
+        if (sqlite3_open_v2(":memory:", &db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr) != SQLITE_OK ||
+            sqlite3_deserialize(db, "main", image.Data(), static_cast<sqlite3_int64>(image.Size()),
+                                static_cast<sqlite3_int64>(image.Size()), SQLITE_DESERIALIZE_READONLY) != SQLITE_OK) {
+            err = "yedek bellekte acilamadi: " + std::string(db ? sqlite3_errmsg(db) : "(null)");
+            sqlite3_close(db);
+            return nullptr;
+        }
+        return db;
+    }
+
+    static bool IsContainer(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        char magic[4] = { 0 };
+        in.read(magic, 4);
+        return in.gcount() == 4 && std::memcmp(magic, kMagic, 4) == 0;
+    }
+
+    // SHA-256 yardımcı (doğrulama: paketlenen ve geri okunan içerik aynı mı)
+    class Sha256 {
+    public:
+        Sha256() : ctx_(EVP_MD_CTX_new()) { EVP_DigestInit_ex(ctx_, EVP_sha256(), nullptr); }
+        ~Sha256() { EVP_MD_CTX_free(ctx_); }
+        void Update(const unsigned char* p, std::size_t n) { EVP_DigestUpdate(ctx_, p, n); }
+        std::string Final() {
+            unsigned char md[32];
+            unsigned int len = 0;
+            EVP_DigestFinal_ex(ctx_, md, &len);
+            return std::string(reinterpret_cast<char*>(md), len);
+        }
+    private:
+        EVP_MD_CTX* ctx_;
+    };
+
+    // Paketlenecek düz içeriği parça parça verir; 0 = bitti
+    typedef std::function<std::size_t(unsigned char*, std::size_t)> PlainReader;
+    // Açılan düz içeriği alır; false = yazılamadı
+    typedef std::function<bool(const unsigned char*, std::size_t)> PlainWriter;
+
+    static PlainReader FileReader(std::ifstream& in) {
+        return [&in](unsigned char* buf, std::size_t n) {
+            in.read(reinterpret_cast<char*>(buf), n);
+            return static_cast<std::size_t>(in.gcount());
+        };
+    }
+
+    static PlainReader MemoryReader(const unsigned char* data, std::size_t size) {
+        std::size_t pos = 0;
+        return [data, size, pos](unsigned char* buf, std::size_t n) mutable {
+            if (n > size - pos) n = size - pos;
+            std::memcpy(buf, data + pos, n);
+            pos += n;
+            return n;
+        };
+    }
+
+    // Paket anahtarı: seçeneklerde verilen, yoksa süreç AppKey'i
+    static const unsigned char* PackKey(const unsigned char* key) {
+        if (key) return key;
+        return AppKey_IsReady() ? AppKey_Get().data() : nullptr;
+    }
+
+    // Düz SQLite içeriğini pakete dönüştür
+    static bool Pack(const PlainReader& read, const std::string& outPath, bool encrypt, bool compress,
+                     const unsigned char* key, std::string& plainDigest, std::string& err) {
+        std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            err = "yedek dosyasi acilamadi";
+            return false;
+        }
+
+        unsigned char header[kHeaderLen];
+        std::memcpy(header, kMagic, 4);
+        header[4] = kVersion;
+        header[5] = static_cast<unsigned char>((encrypt ? kFlagEncrypt : 0) | (compress ? kFlagCompress : 0));
+        out.write(reinterpret_cast<const char*>(header), kHeaderLen);
+
+        EVP_CIPHER_CTX* ctx = nullptr;
+        const unsigned char* packKey = encrypt ? PackKey(key) : nullptr;
+        if (encrypt) {
+            if (!packKey) {
+                err = "yedek anahtari hazir degil";
+                return false;
+            }
+            unsigned char iv[kIvLen];
+            ctx = EVP_CIPHER_CTX_new();
+            int len = 0;
+            if (!ctx || RAND_bytes(iv, sizeof(iv)) != 1 ||
+                EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), nullptr, packKey, iv) != 1 ||
+                EVP_EncryptUpdate(ctx, nullptr, &len, header, kHeaderLen) != 1) {
+                EVP_CIPHER_CTX_free(ctx);
+                err = "sifreleme baslatilamadi";
+                return false;
+            }
+            out.write(reinterpret_cast<const char*>(iv), kIvLen);
+        }
+
+        Sha256 sha;
+        std::vector<unsigned char> raw(kChunk), frame, cipher;
+        bool ok = true;
+        while (ok) {
+            std::size_t n = read(raw.data(), raw.size());
+            if (n == 0) break;
+            sha.Update(raw.data(), n);
+
+            frame.clear();
+            if (compress) {
+                std::vector<unsigned char> enc;
+                ZeroRunEncode(raw.data(), n, enc);
+                PutU32(frame, static_cast<uint32_t>(n));
+                PutU32(frame, static_cast<uint32_t>(enc.size()));
+                frame.insert(frame.end(), enc.begin(), enc.end());
+            } else {
+                frame.assign(raw.begin(), raw.begin() + n);
+            }
+            SecureBuffer::secure_bzero(raw.data(), n);
+
+            if (ctx) {
+                cipher.resize(frame.size() + 16);
+                int len = 0;
+                ok = EVP_EncryptUpdate(ctx, cipher.data(), &len, frame.data(), static_cast<int>(frame.size())) == 1;
+                out.write(reinterpret_cast<const char*>(cipher.data()), len);
+            } else {
+                out.write(reinterpret_cast<const char*>(frame.data()), frame.size());
+            }
+        }
+
+        if (ctx) {
+            unsigned char tag[kTagLen];
+            int len = 0;
+            ok = ok && EVP_EncryptFinal_ex(ctx, cipher.data(), &len) == 1 &&
+                 EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, kTagLen, tag) == 1;
+            if (ok) out.write(reinterpret_cast<const char*>(tag), kTagLen);
+            EVP_CIPHER_CTX_free(ctx);
+        }
+        if (!frame.empty()) SecureBuffer::secure_bzero(frame.data(), frame.size());
+
+        plainDigest = sha.Final();
+        if (!ok || !out) {
+            err = "yedek paketi yazilamadi";
+            return false;
+        }
+        return true;
+    }
+
+    // Paketi aç; write boşsa sadece doğrular (digest hesaplar)
+    static bool Unpack(const std::string& packPath, const PlainWriter& write, const unsigned char* key,
+                       std::string& plainDigest, std::string& err) {
+        std::ifstream in(packPath, std::ios::binary | std::ios::ate);
+        if (!in) {
+            err = "yedek paketi acilamadi";
+            return false;
+        }
+        const std::size_t fileSize = static_cast<std::size_t>(in.tellg());
+        in.seekg(0);
+
+        unsigned char header[kHeaderLen];
+        in.read(reinterpret_cast<char*>(header), kHeaderLen);
+        if (fileSize < kHeaderLen || std::memcmp(header, kMagic, 4) != 0 || header[4] != kVersion) {
+            err = "gecersiz yedek paketi";
+            return false;
+        }
+        const bool encrypted = (header[5] & kFlagEncrypt) != 0;
+        const bool compressed = (header[5] & kFlagCompress) != 0;
+
+        std::size_t payloadLen = fileSize - kHeaderLen;
+        EVP_CIPHER_CTX* ctx = nullptr;
+        const unsigned char* packKey = encrypted ? PackKey(key) : nullptr;
+        if (encrypted) {
+            if (payloadLen < kIvLen + kTagLen || !packKey) {
+                err = "sifreli yedek acilamadi (anahtar/format)";
+                return false;
+            }
+            unsigned char iv[kIvLen];
+            in.read(reinterpret_cast<char*>(iv), kIvLen);
+            payloadLen -= kIvLen + kTagLen;
+            ctx = EVP_CIPHER_CTX_new();
+            int len = 0;
+            if (!ctx || EVP_DecryptInit_ex(ctx, EVP_aes_256_gcm(), nullptr, packKey, iv) != 1 ||
+                EVP_DecryptUpdate(ctx, nullptr, &len, header, kHeaderLen) != 1) {
+                EVP_CIPHER_CTX_free(ctx);
+                err = "sifre cozme baslatilamadi";
+                return false;
+            }
+        }
+
+        Sha256 sha;
+        std::vector<unsigned char> buf(kChunk), plain, pending, decoded;
+        bool ok = true;
+        std::size_t left = payloadLen;
+        while (ok && left > 0) {
+            std::size_t n = left < buf.size() ? left : buf.size();
+            in.read(reinterpret_cast<char*>(buf.data()), n);
+            if (static_cast<std::size_t>(in.gcount()) != n) { ok = false; break; }
+            left -= n;
+
+            if (ctx) {
+                plain.resize(n + 16);
+                int len = 0;
+                ok = EVP_DecryptUpdate(ctx, plain.data(), &len, buf.data(), static_cast<int>(n)) == 1;
+                plain.resize(len);
+            } else {
+                plain.assign(buf.begin(), buf.begin() + n);
+            }
+
+            if (!compressed) {
+                sha.Update(plain.data(), plain.size());
+                if (write) ok = write(plain.data(), plain.size());
+                SecureBuffer::secure_bzero(plain.data(), plain.size());
+                continue;
+            }
+
+            // Çerçeveler chunk sınırlarını aşabilir: tamamlanan çerçeveleri işle
+            pending.insert(pending.end(), plain.begin(), plain.end());
+            std::size_t pos = 0;
+            while (ok && pending.size() - pos >= 8) {
+                uint32_t rawLen = GetU32(&pending[pos]);
+                uint32_t encLen = GetU32(&pending[pos + 4]);
+                if (pending.size() - pos - 8 < encLen) break;
+                decoded.clear();
+                ok = ZeroRunDecode(&pending[pos + 8], encLen, decoded) && decoded.size() == rawLen;
+                if (ok) {
+                    sha.Update(decoded.data(), decoded.size());
+                    if (write) ok = write(decoded.data(), decoded.size());
+                }
+                if (!decoded.empty()) SecureBuffer::secure_bzero(decoded.data(), decoded.size());
+                pos += 8 + encLen;
+            }
+            pending.erase(pending.begin(), pending.begin() + pos);
+        }
+        if (!plain.empty()) SecureBuffer::secure_bzero(plain.data(), plain.size());
+        ok = ok && pending.empty();
+
+        if (ctx) {
+            unsigned char tag[kTagLen];
+            in.read(reinterpret_cast<char*>(tag), kTagLen);
+            int len = 0;
+            ok = ok && static_cast<std::size_t>(in.gcount()) == kTagLen &&
+                 EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, kTagLen, tag) == 1 &&
+                 EVP_DecryptFinal_ex(ctx, buf.data(), &len) == 1;
+            EVP_CIPHER_CTX_free(ctx);
+        }
+
+        plainDigest = sha.Final();
+        if (!ok) err = "yedek paketi bozuk veya anahtar hatali";
+        return ok;
+    }
+
+    // =================== BackupJob ===================
+    BackupJob::BackupJob() : status_(BackupStatus::IDLE), cancel_(false) {}
+
+    BackupJob::~BackupJob() {
+        Cancel();
+        Join();
+    }
+
+    void BackupJob::Join() {
+        if (worker_.joinable()) worker_.join();
+    }
+
+    bool BackupJob::StartBackup(sqlite3* source, const std::string& destPath, const BackupOptions& options) {
+        if (!source || destPath.empty() || status_.load() == BackupStatus::RUNNING) return false;
+        Join();
+        cancel_.store(false);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            progress_ = BackupProgress();
+            lastError_.clear();
+        }
+        status_.store(BackupStatus::RUNNING);
+        worker_ = std::thread(&BackupJob::RunBackup, this, source, destPath, options);
+        return true;
+    }
+
+    bool BackupJob::StartRestore(sqlite3* target, const std::string& backupPath, const BackupOptions& options) {
+        if (!target || backupPath.empty() || status_.load() == BackupStatus::RUNNING) return false;
+        Join();
+        cancel_.store(false);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            progress_ = BackupProgress();
+            lastError_.clear();
+        }
+        status_.store(BackupStatus::RUNNING);
+        worker_ = std::thread(&BackupJob::RunRestore, this, target, backupPath, options);
+        return true;
+    }
+
+    BackupStatus BackupJob::Wait() {
+        Join();
+        return status_.load();
+    }
+
+    void BackupJob::Cancel() {
+        cancel_.store(true);
+    }
+
+    BackupProgress BackupJob::Progress() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return progress_;
+    }
+
+    std::string BackupJob::LastError() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return lastError_;
+    }
+
+    void BackupJob::Fail(const std::string& message) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            lastError_ = message;
+        }
+        status_.store(BackupStatus::FAILED);
+    }
+
+    bool BackupJob::CopyPages(sqlite3* from, sqlite3* to, const BackupOptions& options) {
+        sqlite3_backup* b = sqlite3_backup_init(to, "main", from, "main");
+        if (!b) {
+            Fail(std::string("backup_init: ") + sqlite3_errmsg(to));
+            return false;
+        }
+
+        const int pages = options.pagesPerStep > 0 ? options.pagesPerStep : -1;
+        int rc;
+        while (true) {
+            rc = sqlite3_backup_step(b, pages);
+
+            BackupProgress snapshot;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                progress_.totalPages = sqlite3_backup_pagecount(b);
+                progress_.remainingPages = sqlite3_backup_remaining(b);
+                progress_.steps++;
+                snapshot = progress_;
+            }
+            if (options.onProgress) options.onProgress(snapshot);
+
+            if (rc == SQLITE_DONE) break;
+            if (rc != SQLITE_OK && rc != SQLITE_BUSY && rc != SQLITE_LOCKED) break;
+            if (cancel_.load()) break;
+
+            // Kilidi bırak; etkileşimli yazmalar bu aralıkta ilerler
+            int waitMs = options.sleepMs;
+            if (rc != SQLITE_OK && waitMs < 10) waitMs = 10;
+            if (waitMs > 0) std::this_thread::sleep_for(std::chrono::milliseconds(waitMs));
+            else std::this_thread::yield();
+        }
+
+        int finishRc = sqlite3_backup_finish(b);
+        if (rc == SQLITE_DONE && finishRc == SQLITE_OK) return true;
+        if (cancel_.load()) {
+            status_.store(BackupStatus::CANCELLED);
+            return false;
+        }
+        Fail(std::string("backup_step: ") + sqlite3_errstr(rc == SQLITE_DONE ? finishRc : rc));
+        return false;
+    }
+
+    void BackupJob::RunBackup(sqlite3* source, std::string destPath, BackupOptions options) {
+        const bool pack = options.encrypt || options.compress;
+        const char* vfs = VfsOf(source);
+        // Paketlenecek düz veritabanı diske yazılmaz: sayfalar bellek veritabanına kopyalanır
+        const bool inMemory = pack && OnDefaultVfs(vfs);
+        const std::string plainPath = pack && !inMemory ? destPath + ".partial" : destPath;
+
+        sqlite3* dest = nullptr;
+        int rc = SQLITE_CANTOPEN;
+        if (inMemory) {
+            rc = sqlite3_open_v2(":memory:", &dest, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr);
+            // Bellek hedefinde sayfa boyutu kaynakla aynı olmalı (backup API değiştiremez)
+            sqlite3_stmt* st = nullptr;
+            if (rc == SQLITE_OK && sqlite3_prepare_v2(source, "PRAGMA page_size;", -1, &st, nullptr) == SQLITE_OK &&
+                sqlite3_step(st) == SQLITE_ROW) {
+                const std::string sql = "PRAGMA page_size = " + std::to_string(sqlite3_column_int(st, 0)) + ";";
+                sqlite3_exec(dest, sql.c_str(), nullptr, nullptr, nullptr);
+            }
+            sqlite3_finalize(st);
+        }
+        else if (!pack || CreatePrivateFile(plainPath)) {
+            rc = sqlite3_open_v2(plainPath.c_str(), &dest, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, vfs);
+        }
+        if (rc != SQLITE_OK) {
+            Fail("hedef acilamadi: " + plainPath);
+            sqlite3_close(dest);
+            if (pack && !inMemory) ShredFile(plainPath);
+            return;
+        }
+        bool ok = CopyPages(source, dest, options);
+
+        std::string err;
+        if (!inMemory) {
+            sqlite3_close(dest); // dosya yeniden açılarak doğrulanır ve paketlenir
+            dest = nullptr;
+        }
+        if (ok && options.verify && !(inMemory ? QuickCheckDb(dest, err) : QuickCheck(plainPath, err, vfs))) {
+            Fail(err);
+            ok = false;
+        }
+
+        if (ok && pack) {
+            std::string packedDigest, readBackDigest;
+            if (inMemory) {
+                sqlite3_int64 size = 0;
+                unsigned char* image = sqlite3_serialize(dest, "main", &size, 0);
+                ok = image != nullptr;
+                if (ok) {
+                    ok = Pack(MemoryReader(image, static_cast<std::size_t>(size)), destPath,
+                              options.encrypt, options.compress, options.key, packedDigest, err);
+                    SecureBuffer::secure_bzero(image, static_cast<std::size_t>(size));
+                    sqlite3_free(image);
+                }
+                else {
+                    err = "yedek bellekten okunamadi";
+                }
+            }
+            else {
+                std::ifstream in(plainPath, std::ios::binary);
+                ok = Pack(FileReader(in), destPath, options.encrypt, options.compress, options.key, packedDigest, err);
+            }
+            if (ok && options.verify) {
+                ok = Unpack(destPath, PlainWriter(), options.key, readBackDigest, err) && readBackDigest == packedDigest;
+                if (!ok && err.empty()) err = "yedek paketi dogrulanamadi";
+            }
+            if (!ok) {
+                Fail(err);
+                std::remove(destPath.c_str());
+            }
+        }
+        sqlite3_close(dest);
+
+        if (pack && !inMemory) ShredFile(plainPath);
+        if (!ok) {
+            if (!pack) std::remove(destPath.c_str());
+            return;
+        }
+        status_.store(BackupStatus::SUCCEEDED);
+    }
+
+    void BackupJob::RunRestore(sqlite3* target, std::string backupPath, BackupOptions options) {
+        std::string plainPath = backupPath;
+        std::string err;
+        const char* vfs = VfsOf(target);
+        const bool packed = IsContainer(backupPath);
+        // Düz hedefe açılan paket bellekte kalır; sayfa VFS'inde ara dosya o VFS'in düzenindedir
+        const bool inMemory = packed && OnDefaultVfs(vfs);
+        PlainImage image;
+        if (packed) {
+            std::string digest;
+            bool unpacked = false;
+            if (inMemory) {
+                unpacked = Unpack(backupPath, [&image](const unsigned char* p, std::size_t n) {
+                    return image.Append(p, n);
+                }, options.key, digest, err);
+            }
+            else {
+                plainPath = backupPath + ".restore.tmp";
+                std::ofstream out;
+                if (CreatePrivateFile(plainPath)) out.open(plainPath, std::ios::binary | std::ios::trunc);
+                unpacked = out && Unpack(backupPath, [&out](const unsigned char* p, std::size_t n) {
+                    out.write(reinterpret_cast<const char*>(p), n);
+                    return static_cast<bool>(out);
+                }, options.key, digest, err);
+                out.close();
+                if (!unpacked && err.empty()) err = "gecici dosya yazilamadi";
+            }
+            if (!unpacked) {
+                if (!inMemory) ShredFile(plainPath);
+                Fail(err);
+                return;
+            }
+        }
+
+        bool ok = true;
+        sqlite3* src = nullptr;
+        if (inMemory) {
+            src = OpenImage(image, err);
+            if (!src) {
+                Fail(err);
+                ok = false;
+            }
+        }
+        else if (sqlite3_open_v2(plainPath.c_str(), &src, SQLITE_OPEN_READONLY, vfs) != SQLITE_OK) {
+            Fail("yedek acilamadi: " + plainPath);
+            ok = false;
+        }
+        if (ok && options.verify && !QuickCheckDb(src, err)) {
+            Fail(err);
+            ok = false;
+        }
+        if (ok) ok = CopyPages(src, target, options);
+        sqlite3_close(src);
+
+        if (packed && !inMemory) ShredFile(plainPath);
+        if (ok) status_.store(BackupStatus::SUCCEEDED);
+    }
+
+    // =================== Synchronous Helpers ===================
+    bool RunBackup(sqlite3* source, const std::string& destPath, const BackupOptions& options) {
+        BackupJob job;
+        if (!job.StartBackup(source, destPath, options)) return false;
+        if (job.Wait() != BackupStatus::SUCCEEDED) {
+            std::cerr << "Yedekleme hatasi: " << job.LastError() << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    bool RunRestore(sqlite3* target, const std::string& backupPath, const BackupOptions& options) {
+        BackupJob job;
+        if (!job.StartRestore(target, backupPath, options)) return false;
+        if (job.Wait() != BackupStatus::SUCCEEDED) {
+            std::cerr << "Geri yukleme hatasi: " << job.LastError() << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    bool VerifyBackup(const std::string& backupPath, const char* vfs, const unsigned char* key) {
+        std::string err;
+        if (!IsContainer(backupPath)) {
+            return QuickCheck(backupPath, err, vfs);
+        }
+
+        std::string digest;
+        if (OnDefaultVfs(vfs)) {
+            PlainImage image;
+            if (!Unpack(backupPath, [&image](const unsigned char* p, std::size_t n) { return image.Append(p, n); },
+                        key, digest, err)) {
+                return false;
+            }
+            sqlite3* db = OpenImage(image, err);
+            const bool ok = db && QuickCheckDb(db, err);
+            sqlite3_close(db);
+            return ok;
+        }
+
+        const std::string tmp = backupPath + ".verify.tmp";
+        std::ofstream out;
+        if (CreatePrivateFile(tmp)) out.open(tmp, std::ios::binary | std::ios::trunc);
+        bool ok = out && Unpack(backupPath, [&out](const unsigned char* p, std::size_t n) {
+            out.write(reinterpret_cast<const char*>(p), n);
+            return static_cast<bool>(out);
+        }, key, digest, err);
+        out.close();
+        ok = ok && QuickCheck(tmp, err, vfs);
+        ShredFile(tmp);
+        return ok;
+    }
+
+} // namespace backup
+} // namespace teamcore
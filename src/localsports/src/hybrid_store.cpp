@@ -0,0 +1,542 @@
+// src/hybrid_store.cpp
+// RAM'de sunulan veritabanı + fsync'li commit log'u + arka plan checkpoint
+
+#include "hybrid_store.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#include <sqlite3.h>
+
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace teamcore {
+namespace hybrid {
+
+    // =================== Log Format ===================
+    // Kayıt: "LSJ1" | seq(u64) | bodyLen(u32) | body
+    //   düz     : payload | fnv1a64(seq || payload)
+    //   şifreli : iv(12) | AES-256-GCM(payload) | tag(16), AAD = seq
+    // payload  : tekrar eden [len(u32)][SQL]; bir kayıt = bir commit
+    static const char kRecordMagic[4] = { 'L', 'S', 'J', '1' };
+    static const std::size_t kRecordHeaderLen = 16;
+    static const int kIvLen = 12;
+    static const int kTagLen = 16;
+
+    // Durum tablosu bellek görüntüsüyle birlikte diske yazılır; checkpoint sırası atomik kalır
+    static const char* STATE_SCHEMA =
+        "CREATE TABLE IF NOT EXISTS _ls_hybrid(id INTEGER PRIMARY KEY CHECK(id=1), seq INTEGER NOT NULL);"
+        "INSERT OR IGNORE INTO _ls_hybrid VALUES(1,0);";
+
+    // =================== Helper Functions ===================
+    static void PutU32(std::string& out, uint32_t v) {
+        for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+    }
+
+    static void PutU64(std::string& out, uint64_t v) {
+        for (int i = 0; i < 8; ++i) out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+    }
+
+    static uint32_t GetU32(const unsigned char* p) {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    static uint64_t GetU64(const unsigned char* p) {
+        return static_cast<uint64_t>(GetU32(p)) | (static_cast<uint64_t>(GetU32(p + 4)) << 32);
+    }
+
+    static uint64_t Fnv1a64(const std::string& a, const std::string& b) {
+        uint64_t h = 1469598103934665603ULL;
+        for (std::size_t i = 0; i < a.size(); ++i) { h ^= static_cast<unsigned char>(a[i]); h *= 1099511628211ULL; }
+        for (std::size_t i = 0; i < b.size(); ++i) { h ^= static_cast<unsigned char>(b[i]); h *= 1099511628211ULL; }
+        return h;
+    }
+
+    static bool SyncFile(std::FILE* f) {
+        if (std::fflush(f) != 0) return false;
+#if defined(_WIN32)
+        return _commit(_fileno(f)) == 0;
+#else
+        return fsync(fileno(f)) == 0;
+#endif
+    }
+
+    static bool Exec(sqlite3* db, const char* sql) {
+        char* err = nullptr;
+        if (sqlite3_exec(db, sql, nullptr, nullptr, &err) != SQLITE_OK) {
+            std::cerr << "Hibrit SQL hatasi: " << (err ? err : "(null)") << "\n";
+            sqlite3_free(err);
+            return false;
+        }
+        return true;
+    }
+
+    static int QueryInt(sqlite3* db, const char* sql) {
+        sqlite3_stmt* st = nullptr;
+        int v = -1;
+        if (sqlite3_prepare_v2(db, sql, -1, &st, nullptr) == SQLITE_OK && sqlite3_step(st) == SQLITE_ROW) {
+            v = sqlite3_column_int(st, 0);
+        }
+        sqlite3_finalize(st);
+        return v;
+    }
+
+    static bool Seal(const unsigned char* key, const std::string& aad, const std::string& plain, std::string& out) {
+        unsigned char iv[kIvLen];
+        if (RAND_bytes(iv, kIvLen) != 1) return false;
+        out.assign(reinterpret_cast<const char*>(iv), kIvLen);
+        out.resize(kIvLen + plain.size() + kTagLen);
+        unsigned char* ct = reinterpret_cast<unsigned char*>(&out[kIvLen]);
+
+        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+        int len = 0;
+        bool ok = ctx &&
+            EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), nullptr, key, iv) == 1 &&
+            EVP_EncryptUpdate(ctx, nullptr, &len, reinterpret_cast<const unsigned char*>(aad.data()), static_cast<int>(aad.size())) == 1 &&
+            EVP_EncryptUpdate(ctx, ct, &len, reinterpret_cast<const unsigned char*>(plain.data()), static_cast<int>(plain.size())) == 1 &&
+            EVP_EncryptFinal_ex(ctx, ct + len, &len) == 1 &&
+            EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, kTagLen, ct + plain.size()) == 1;
+        EVP_CIPHER_CTX_free(ctx);
+        return ok;
+    }
+
+    static bool Unseal(const unsigned char* key, const std::string& aad, const unsigned char* body, std::size_t bodyLen, std::string& plain) {
+        if (bodyLen < static_cast<std::size_t>(kIvLen + kTagLen)) return false;
+        const std::size_t ctLen = bodyLen - kIvLen - kTagLen;
+        plain.resize(ctLen);
+        unsigned char* pt = reinterpret_cast<unsigned char*>(&plain[0]);
+
+        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+        int len = 0;
+        bool ok = ctx &&
+            EVP_DecryptInit_ex(ctx, EVP_aes_256_gcm(), nullptr, key, body) == 1 &&
+            EVP_DecryptUpdate(ctx, nullptr, &len, reinterpret_cast<const unsigned char*>(aad.data()), static_cast<int>(aad.size())) == 1 &&
+            EVP_DecryptUpdate(ctx, pt, &len, body + kIvLen, static_cast<int>(ctLen)) == 1 &&
+            EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, kTagLen, const_cast<unsigned char*>(body + kIvLen + ctLen)) == 1 &&
+            EVP_DecryptFinal_ex(ctx, pt + len, &len) == 1;
+        EVP_CIPHER_CTX_free(ctx);
+        return ok;
+    }
+
+    static const char* SkipSpace(const char* sql) {
+        while (*sql == ' ' || *sql == '\t' || *sql == '\n' || *sql == '\r') ++sql;
+        return sql;
+    }
+
+    // Transaction kontrolü salt-okunur sayılır; savepoint'ler replay için yine de loglanır
+    static bool IsSavepointControl(const char* sql) {
+        sql = SkipSpace(sql);
+        return sqlite3_strnicmp(sql, "SAVEPOINT", 9) == 0 ||
+               sqlite3_strnicmp(sql, "RELEASE", 7) == 0 ||
+               (sqlite3_strnicmp(sql, "ROLLBACK", 8) == 0 && sqlite3_strnicmp(sql + 8, " TO", 3) == 0);
+    }
+
+    // =================== HybridStore ===================
+    HybridStore::HybridStore()
+        : mem_(nullptr), disk_(nullptr), log_(nullptr), probeMain_(false), probeForeign_(false), suppress_(false),
+          lastSeq_(0), running_(false) {}
+
+    HybridStore::~HybridStore() {
+        Close();
+    }
+
+    bool HybridStore::Open(const HybridConfig& config) {
+        if (mem_ || config.diskPath.empty()) return false;
+        config_ = config;
+        if (config_.logPath.empty()) config_.logPath = config_.diskPath + ".journal";
+        if (config_.logKey) {
+            logKey_.resize(32);
+            std::memcpy(logKey_.data(), config_.logKey, 32);
+            config_.logKey = nullptr; // çağıranın belleğine işaretçi tutulmaz
+        }
+        {
+            std::lock_guard<std::mutex> lock(statsMutex_);
+            stats_ = HybridStats();
+        }
+
+        const char* vfs = config_.vfs.empty() ? nullptr : config_.vfs.c_str();
+        const int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX | SQLITE_OPEN_URI;
+        if (sqlite3_open_v2(config_.diskPath.c_str(), &disk_, flags, vfs) != SQLITE_OK ||
+            (config_.diskSetup && !config_.diskSetup(disk_)) ||
+            sqlite3_open_v2(":memory:", &mem_, flags, vfs) != SQLITE_OK) {
+            std::cerr << "Hibrit mod acilamadi: " << config_.diskPath << "\n";
+            sqlite3_close(mem_);
+            sqlite3_close(disk_);
+            mem_ = nullptr;
+            disk_ = nullptr;
+            return false;
+        }
+
+        bool ok = LoadFromDisk() && Replay();
+        if (ok) {
+            sqlite3_trace_v2(mem_, SQLITE_TRACE_STMT, TraceThunk, this);
+            sqlite3_commit_hook(mem_, CommitThunk, this);
+            sqlite3_rollback_hook(mem_, RollbackThunk, this);
+        }
+        else {
+            sqlite3_close(mem_);
+            sqlite3_close(disk_);
+            if (log_) std::fclose(log_);
+            mem_ = nullptr;
+            disk_ = nullptr;
+            log_ = nullptr;
+            return false;
+        }
+
+        running_.store(true);
+        worker_ = std::thread(&HybridStore::CheckpointLoop, this);
+        return true;
+    }
+
+    void HybridStore::Close() {
+        if (running_.exchange(false)) {
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex_);
+            }
+            wake_.notify_all();
+            if (worker_.joinable()) worker_.join();
+        }
+        if (!mem_) return;
+
+        if (lastSeq_.load() > Stats().checkpointSeq) Checkpoint();
+        sqlite3_trace_v2(mem_, 0, nullptr, nullptr);
+        sqlite3_commit_hook(mem_, nullptr, nullptr);
+        sqlite3_rollback_hook(mem_, nullptr, nullptr);
+        sqlite3_close_v2(mem_);
+        sqlite3_close_v2(disk_);
+        if (log_) std::fclose(log_);
+        mem_ = nullptr;
+        disk_ = nullptr;
+        log_ = nullptr;
+        pending_.clear();
+        mainOnly_.clear();
+        logKey_.cleanse();
+        logKey_.resize(0);
+    }
+
+    HybridStats HybridStore::Stats() const {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        HybridStats s = stats_;
+        s.lastSeq = lastSeq_.load();
+        return s;
+    }
+
+    // =================== Load / Replay ===================
+    bool HybridStore::LoadFromDisk() {
+        if (QueryInt(disk_, "PRAGMA page_count;") == 0) {
+            // Boş disk dosyası: kopyalanacak sayfa yok. diskSetup'ın istediği düzen (page_size,
+            // reserve) bellek DB'sine ilk tablodan önce aktarılır, checkpoint'te diske aynen gider
+            const std::string pageSize = "PRAGMA page_size=" + std::to_string(QueryInt(disk_, "PRAGMA page_size;")) + ";";
+            Exec(mem_, pageSize.c_str());
+            int reserve = -1;
+            if (sqlite3_file_control(disk_, "main", SQLITE_FCNTL_RESERVE_BYTES, &reserve) == SQLITE_OK && reserve > 0) {
+                sqlite3_file_control(mem_, "main", SQLITE_FCNTL_RESERVE_BYTES, &reserve);
+            }
+        }
+        else {
+            sqlite3_backup* b = sqlite3_backup_init(mem_, "main", disk_, "main");
+            if (!b) {
+                std::cerr << "Disk goruntusu yuklenemedi: " << sqlite3_errmsg(mem_) << "\n";
+                return false;
+            }
+            int rc = sqlite3_backup_step(b, -1);
+            sqlite3_backup_finish(b);
+            if (rc != SQLITE_DONE) {
+                std::cerr << "Disk goruntusu yuklenemedi: " << sqlite3_errstr(rc) << "\n";
+                return false;
+            }
+        }
+        if (!Exec(mem_, STATE_SCHEMA)) return false;
+
+        sqlite3_stmt* st = nullptr;
+        uint64_t seq = 0;
+        if (sqlite3_prepare_v2(mem_, "SELECT seq FROM _ls_hybrid WHERE id=1;", -1, &st, nullptr) == SQLITE_OK &&
+            sqlite3_step(st) == SQLITE_ROW) {
+            seq = static_cast<uint64_t>(sqlite3_column_int64(st, 0));
+        }
+        sqlite3_finalize(st);
+        lastSeq_.store(seq);
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats_.checkpointSeq = seq;
+        return true;
+    }
+
+    bool HybridStore::Replay() {
+        std::ifstream in(config_.logPath.c_str(), std::ios::binary);
+        std::string data;
+        if (in) data.assign((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        in.close();
+
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(data.data());
+        std::size_t pos = 0;
+        uint64_t replayed = 0, errors = 0;
+        bool tornTail = false;
+
+        while (pos < data.size()) {
+            if (data.size() - pos < kRecordHeaderLen || std::memcmp(p + pos, kRecordMagic, 4) != 0) { tornTail = true; break; }
+            const uint64_t seq = GetU64(p + pos + 4);
+            const uint32_t bodyLen = GetU32(p + pos + 12);
+            if (data.size() - pos - kRecordHeaderLen < bodyLen) { tornTail = true; break; }
+            const unsigned char* body = p + pos + kRecordHeaderLen;
+
+            std::string seqBytes;
+            PutU64(seqBytes, seq);
+            std::string payload;
+            bool valid;
+            if (logKey_.size() == 32) {
+                valid = Unseal(logKey_.data(), seqBytes, body, bodyLen, payload);
+            }
+            else {
+                valid = bodyLen >= 8;
+                if (valid) {
+                    payload.assign(reinterpret_cast<const char*>(body), bodyLen - 8);
+                    valid = GetU64(body + bodyLen - 8) == Fnv1a64(seqBytes, payload);
+                }
+            }
+            if (!valid) { tornTail = true; break; }
+            pos += kRecordHeaderLen + bodyLen;
+
+            if (seq <= lastSeq_.load()) continue; // checkpoint görüntüsünde zaten var
+
+            // Kayıt = bir commit; hata veren ifade ilk çalıştırmada da hata vermişti
+            Exec(mem_, "BEGIN;");
+            std::size_t q = 0;
+            const unsigned char* pl = reinterpret_cast<const unsigned char*>(payload.data());
+            while (q + 4 <= payload.size()) {
+                const uint32_t len = GetU32(pl + q);
+                if (payload.size() - q - 4 < len) break;
+                std::string sql(payload, q + 4, len);
+                q += 4 + len;
+                if (sqlite3_exec(mem_, sql.c_str(), nullptr, nullptr, nullptr) != SQLITE_OK) ++errors;
+            }
+            if (!Exec(mem_, "COMMIT;")) return false;
+            lastSeq_.store(seq);
+            ++replayed;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(statsMutex_);
+            stats_.replayedTx = replayed;
+            stats_.replayErrors = errors;
+        }
+        if (tornTail) {
+            std::cerr << "Uyari: commit log'unun sonu yarim/bozuk; son gecerli kayittan devam ediliyor.\n";
+        }
+        // Uygulanan kayıtlar hemen diske alınır; log sıfırdan başlar
+        if (replayed > 0 || tornTail) return CheckpointLocked();
+        return OpenLog(false);
+    }
+
+    bool HybridStore::OpenLog(bool truncate) {
+        if (log_) std::fclose(log_);
+        log_ = std::fopen(config_.logPath.c_str(), truncate ? "wb" : "ab");
+        if (!log_) {
+            std::cerr << "Commit log'u acilamadi: " << config_.logPath << "\n";
+            return false;
+        }
+        if (truncate && !SyncFile(log_)) return false;
+        std::fseek(log_, 0, SEEK_END);
+        long size = std::ftell(log_);
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats_.logBytes = size > 0 ? static_cast<uint64_t>(size) : 0;
+        return true;
+    }
+
+    bool HybridStore::AppendRecord(uint64_t seq, const std::string& payload) {
+        if (!log_) return false;
+        std::string seqBytes;
+        PutU64(seqBytes, seq);
+
+        std::string body;
+        if (logKey_.size() == 32) {
+            if (!Seal(logKey_.data(), seqBytes, payload, body)) return false;
+        }
+        else {
+            body = payload;
+            PutU64(body, Fnv1a64(seqBytes, payload));
+        }
+
+        std::string record(kRecordMagic, sizeof(kRecordMagic));
+        record += seqBytes;
+        PutU32(record, static_cast<uint32_t>(body.size()));
+        record += body;
+        if (std::fwrite(record.data(), 1, record.size(), log_) != record.size() || !SyncFile(log_)) {
+            std::cerr << "Commit log'una yazilamadi: " << config_.logPath << "\n";
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats_.logBytes += record.size();
+        stats_.loggedTx++;
+        return true;
+    }
+
+    // =================== Hooks ===================
+    int HybridStore::TraceThunk(unsigned type, void* self, void* p, void* x) {
+        if (type == SQLITE_TRACE_STMT) {
+            static_cast<HybridStore*>(self)->OnStatement(static_cast<sqlite3_stmt*>(p), static_cast<const char*>(x));
+        }
+        return 0;
+    }
+
+    int HybridStore::CommitThunk(void* self) {
+        return static_cast<HybridStore*>(self)->OnCommit();
+    }
+
+    void HybridStore::RollbackThunk(void* self) {
+        static_cast<HybridStore*>(self)->OnRollback();
+    }
+
+    // Deneme derlemesinde yazılan şemayı işaretler; trigger içindeki adımlar trigger'ın şemasına aittir.
+    // Şema adı verilmeyen eylemler (ör. ALTER TABLE) ihtiyaten "main" sayılır.
+    int HybridStore::AuthorizeThunk(void* self, int action, const char*, const char*,
+                                    const char* schema, const char* trigger) {
+        HybridStore* store = static_cast<HybridStore*>(self);
+        if (trigger) return SQLITE_OK;
+        switch (action) {
+        case SQLITE_READ:
+        case SQLITE_SELECT:
+        case SQLITE_FUNCTION:
+        case SQLITE_RECURSIVE:
+        case SQLITE_TRANSACTION: // replay her kaydı kendi transaction'ında uygular
+            return SQLITE_OK;
+        case SQLITE_ATTACH:
+        case SQLITE_DETACH:
+            store->probeForeign_ = true; // bağlantı durumu; replay'de dosya bağlanmaz
+            return SQLITE_OK;
+        default:
+            if (!schema || std::strcmp(schema, "main") == 0) store->probeMain_ = true;
+            else store->probeForeign_ = true;
+            return SQLITE_OK;
+        }
+    }
+
+    // İfade metni bir kez yetkilendirici altında yeniden derlenir; sonuç metin başına önbelleklenir
+    bool HybridStore::TargetsMainOnly(const char* sql) {
+        std::unordered_map<std::string, bool>::const_iterator it = mainOnly_.find(sql);
+        if (it != mainOnly_.end()) return it->second;
+
+        probeMain_ = false;
+        probeForeign_ = false;
+        sqlite3_set_authorizer(mem_, AuthorizeThunk, this);
+        sqlite3_stmt* probe = nullptr;
+        const int rc = sqlite3_prepare_v2(mem_, sql, -1, &probe, nullptr);
+        sqlite3_finalize(probe);
+        sqlite3_set_authorizer(mem_, nullptr, nullptr);
+        if (rc != SQLITE_OK) return true; // belirlenemedi: loglamak kaybetmekten iyidir
+
+        // Hiçbir şemaya dokunmayan ifade (ör. olmayan nesneye DROP ... IF EXISTS) atlanır ama
+        // önbelleğe alınmaz: nesne sonradan oluşursa aynı metin yazma yapar
+        if (!probeMain_ && !probeForeign_) return false;
+        const bool mainOnly = !probeForeign_;
+        if (mainOnly_.size() >= 512) mainOnly_.clear(); // değer gömülü ad-hoc SQL önbelleği şişirmesin
+        mainOnly_[sql] = mainOnly;
+        return mainOnly;
+    }
+
+    void HybridStore::OnStatement(sqlite3_stmt* stmt, const char* sql) {
+        if (suppress_ || !sql || std::strncmp(sql, "--", 2) == 0) return; // trigger alt programları
+        if (sqlite3_strnicmp(SkipSpace(sql), "PRAGMA", 6) == 0) return;     // bağlantı ayarı, veri değil
+        if (sqlite3_stmt_readonly(stmt)) {
+            if (IsSavepointControl(sql)) pending_.push_back(sql);
+            return;
+        }
+        if (!TargetsMainOnly(sql)) return; // TEMP, ATTACH ve bağlı şemalar replay'de yok
+        char* expanded = sqlite3_expanded_sql(stmt);
+        if (expanded) {
+            pending_.push_back(expanded);
+            sqlite3_free(expanded);
+        }
+        else {
+            std::cerr << "Uyari: ifade loglanamadi (bellek yetersiz), parametreler kaybolabilir.\n";
+            pending_.push_back(sql);
+        }
+    }
+
+    int HybridStore::OnCommit() {
+        if (suppress_ || pending_.empty()) return 0;
+        std::string payload;
+        for (std::size_t i = 0; i < pending_.size(); ++i) {
+            PutU32(payload, static_cast<uint32_t>(pending_[i].size()));
+            payload += pending_[i];
+        }
+        pending_.clear();
+
+        const uint64_t seq = lastSeq_.load() + 1;
+        if (!AppendRecord(seq, payload)) return 1; // log kalıcı değilse commit geri alınır
+        lastSeq_.store(seq);
+
+        if (Stats().logBytes >= config_.checkpointLogBytes) wake_.notify_all();
+        return 0;
+    }
+
+    void HybridStore::OnRollback() {
+        pending_.clear();
+    }
+
+    // =================== Checkpoint ===================
+    bool HybridStore::Checkpoint() {
+        if (!mem_) return false;
+        sqlite3_mutex* m = sqlite3_db_mutex(mem_);
+        sqlite3_mutex_enter(m);
+        bool ok = CheckpointLocked();
+        sqlite3_mutex_leave(m);
+        return ok;
+    }
+
+    // Çağıran bellek bağlantısının mutex'ini tutar: görüntü ile sıra numarası tutarlıdır
+    bool HybridStore::CheckpointLocked() {
+        if (!sqlite3_get_autocommit(mem_)) return false; // açık transaction; sonraki turda
+
+        auto t0 = std::chrono::steady_clock::now();
+        const uint64_t seq = lastSeq_.load();
+        suppress_ = true;
+        sqlite3_stmt* st = nullptr;
+        bool ok = sqlite3_prepare_v2(mem_, "UPDATE _ls_hybrid SET seq=? WHERE id=1;", -1, &st, nullptr) == SQLITE_OK;
+        if (ok) {
+            sqlite3_bind_int64(st, 1, static_cast<sqlite3_int64>(seq));
+            ok = sqlite3_step(st) == SQLITE_DONE;
+        }
+        sqlite3_finalize(st);
+        suppress_ = false;
+
+        sqlite3_backup* b = ok ? sqlite3_backup_init(disk_, "main", mem_, "main") : nullptr;
+        int rc = b ? sqlite3_backup_step(b, -1) : SQLITE_ERROR;
+        if (b) sqlite3_backup_finish(b);
+        if (rc != SQLITE_DONE) {
+            std::cerr << "Checkpoint basarisiz: " << sqlite3_errmsg(disk_) << "\n";
+            return false;
+        }
+
+        // Diskteki görüntü seq'e kadar her şeyi içerir; log güvenle sıfırlanır
+        if (!OpenLog(true)) return false;
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats_.checkpoints++;
+        stats_.checkpointSeq = seq;
+        stats_.lastCheckpointMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        return true;
+    }
+
+    void HybridStore::CheckpointLoop() {
+        while (running_.load()) {
+            {
+                std::unique_lock<std::mutex> lock(wakeMutex_);
+                wake_.wait_for(lock, std::chrono::milliseconds(config_.checkpointIntervalMs));
+            }
+            if (!running_.load()) break;
+            if (lastSeq_.load() > Stats().checkpointSeq) Checkpoint();
+        }
+    }
+
+} // namespace hybrid
+} // namespace teamcore
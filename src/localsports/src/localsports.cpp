@@ -2,6 +2,7 @@
 #include "localsports.h"
 
 #include <iostream>
+#include <fstream>
 #include <vector>
 #include <string>
 #include <iomanip>
@@ -11,6 +12,7 @@
 #include <ctime>
 #include <climits>
 #include <cstdint>
+#include <cstdlib>
 
 #if defined(_MSC_VER)
 #pragma warning(disable : 4996)
@@ -25,52 +27,203 @@ const char* FILE_USERS = "users.bin";
 
 // =================== SQLite ===================
 #include <sqlite3.h>
-static sqlite3* g_db = nullptr;
 
-// Veritaban� dosyas� (�al��ma klas�r�nde olu�turulur)
-static const char* DB_PATH = "localsports.db";
-
-// ---- Auth session (in-memory) ----
-static bool g_isAuthed = false;
-static char g_currentUser[32] = { 0 };
 
 // =================== G�venlik Katman� ===================
 #include "security_layer.h"
 #include "security_hardening.h"
 #include "rasp.h"  // RASP (Runtime Application Self-Protection)
+#include "record_store.h"
+#include "backup.h"
+#include "maintenance.h"
+#include "archive.h"
+#include "tenant_router.h"
+#include "page_vfs.h"
+#include "sql_functions.h"
+#include "hybrid_store.h"
+#include "message_feed.h"
+#include "message_partitions.h"
+#include "message_index.h"
 #include <openssl/crypto.h>  // CRYPTO_memcmp
 #include <openssl/rand.h>    // RAND_bytes
 
 using teamcore::SecureBuffer;
+using teamcore::SecureString;
 using teamcore::read_password_secure;
 using teamcore::AppKey_InitFromEnvOrPrompt;
 using teamcore::AppKey_Get;
+using teamcore::AppKey_Subkey;
+using teamcore::KeyHierarchy;
 namespace crypto = teamcore::crypto;
 namespace hardening = teamcore::hardening;
 namespace rasp = teamcore::rasp;
+namespace store = teamcore::store;
+namespace backup = teamcore::backup;
+namespace maintenance = teamcore::maintenance;
+namespace archive = teamcore::archive;
+namespace tenant = teamcore::tenant;
+namespace pagevfs = teamcore::pagevfs;
+namespace sqlfn = teamcore::sqlfn;
+namespace hybrid = teamcore::hybrid;
+namespace feed = teamcore::feed;
+namespace partition = teamcore::partition;
+namespace search = teamcore::search;
+
+// =================== Context ===================
+/**
+ * @brief Bir LocalSports örneğinin tüm durumu: bağlantı(lar), anahtar, önbellekler ve oturum
+ * @details Eski dosya-statik global'lerin yerini alır. Public fonksiyonlar bağlamı ContextScope ile
+ *          çalışan thread'e bağlar; iç fonksiyonlar cx() üzerinden erişir. Bir bağlam aynı anda
+ *          tek thread'den kullanılmalıdır; farklı bağlamlar paralel çalışabilir.
+ */
+struct LSContext {
+    sqlite3* db = nullptr;
+    std::string defaultDbPath = "localsports.db"; // LS_SetDatabasePath; varsayılan DB dosyası
+    std::string dbPath = "localsports.db";        // aktif DB dosyası (varsayılan veya kiracı)
+
+    // ---- Auth session (in-memory) ----
+    bool isAuthed = false;
+    char currentUser[32] = { 0 };
+    int currentUserId = 0;
+
+    // ---- Encryption mode ----
+    // FIELDS: PII alanları tek tek AES-GCM ile şifrelenir (indekslenemez/aranamaz)
+    // PAGES : tüm sayfalar "ls-crypt" VFS'inde şifrelenir, alanlar düz yazılır
+    LSEncryptionMode encryptionMode = LS_ENCRYPT_FIELDS;
+    const char* dbVfs = nullptr;   // nullptr = varsayılan VFS
+    std::string vfsName;           // bağlama özel anahtar varsa VFS adı ("ls-crypt-<adres>")
+    bool pageEncrypted = false;    // aktif DB gerçekten sayfa şifreli mi?
+    bool pageChecksums = false;    // FIELDS modunda yeni DB'ler "ls-cksum" VFS'i ile sayfa checksum'ı alır
+
+    // ---- Roster cache (aktif oyuncular; phone/email tutulmaz) ----
+    store::RecordStore<Player> rosterCache;
+    bool rosterCacheValid = false;
+
+    maintenance::MaintenanceScheduler maint;
+    pagevfs::PageVerifier verifier; // sayfa codec'li dosyayı arka planda tarar
+
+    // ---- Tenants ----
+    tenant::TenantRouter* router = nullptr;
+    tenant::TenantLease tenantLease;
+
+    // ---- Storage mode ----
+    // MEMORY: varsayılan DB RAM'den sunulur, yazmalar commit log'una fsync'lenir (kiracı DB'leri diskte kalır)
+    LSStorageMode storageMode = LS_STORAGE_DISK;
+    hybrid::HybridStore hybrid;
+
+    // ---- Key & I/O ----
+    SecureBuffer appKey;            // boşsa süreç geneli AppKey kullanılır
+    KeyHierarchy keys;              // appKey'den türetilen amaç etiketli alt anahtarlar
+    const SecureBuffer* searchKey = nullptr; // mesaj arama token'ları (LS_Init'te türetilir)
+    std::istream* in = &std::cin;
+    std::ostream* out = &std::cout;
+
+    ~LSContext() {
+        verifier.Stop();
+        maint.Stop();
+        if (hybrid.IsOpen()) hybrid.Close();
+        else if (db && !tenantLease) sqlite3_close_v2(db);
+        tenantLease.Release();
+        delete router;
+        // Bağlama özel VFS'in codec'i (sayfa alt anahtarı) bağlamla birlikte gider; ortak "ls-crypt" kalır
+        if (!vfsName.empty() && vfsName != pagevfs::ENCRYPTED_VFS_NAME) pagevfs::UnregisterPageVfs(vfsName.c_str());
+    }
+};
+
+static thread_local LSContext* t_ctx = nullptr;
+
+static LSContext& cx() {
+    return t_ctx ? *t_ctx : LS_DefaultContext();
+}
+
+// Public giriş noktalarında bağlamı thread'e bağlar (iç içe çağrılarda öncekini geri yükler)
+class ContextScope {
+public:
+    explicit ContextScope(LSContext& ctx) : prev_(t_ctx) { t_ctx = &ctx; }
+    ~ContextScope() { t_ctx = prev_; }
+private:
+    ContextScope(const ContextScope&);
+    ContextScope& operator=(const ContextScope&);
+    LSContext* prev_;
+};
+
+static std::ostream& out() { return *cx().out; }
+static std::istream& in() { return *cx().in; }
+
+static bool contextKeyReady() {
+    return cx().appKey.size() == 32 || teamcore::AppKey_IsReady();
+}
+
+static const SecureBuffer& contextKey() {
+    return cx().appKey.size() == 32 ? cx().appKey : AppKey_Get();
+}
+
+LSContext& LS_DefaultContext() {
+    static LSContext ctx;
+    return ctx;
+}
+
+LSContext* LS_CreateContext(const char* dbPath) {
+    LSContext* ctx = new LSContext();
+    if (dbPath && *dbPath) ctx->defaultDbPath = dbPath;
+    return ctx;
+}
+
+void LS_DestroyContext(LSContext* ctx) {
+    if (ctx == &LS_DefaultContext()) return;
+    delete ctx;
+}
+
+void LS_SetContextKey(LSContext& ctx, const unsigned char key32[32]) {
+    ctx.appKey = SecureBuffer(32);
+    std::memcpy(ctx.appKey.data(), key32, 32);
+    ctx.keys.Init(key32);
+    ctx.searchKey = nullptr;
+}
+
+void LS_SetContextStreams(LSContext& ctx, std::istream* input, std::ostream* output) {
+    ctx.in = input ? input : &std::cin;
+    ctx.out = output ? output : &std::cout;
+}
 
 // ---- Small utilities ----
 static std::string readLine(const std::string& prompt) {
-    std::cout << prompt;
+    out() << prompt;
     std::string s;
-    std::getline(std::cin, s);
+    std::getline(in(), s);
+    return s;
+}
+
+// Parola/PII satırı: karakterler doğrudan SecureString'e, ara std::string yok
+static SecureString readLineSecure(const std::string& prompt) {
+    out() << prompt;
+    SecureString s;
+    for (int c = in().get(); c != EOF && c != '\n'; c = in().get()) {
+        if (c != '\r') s.push_back(static_cast<char>(c));
+    }
     return s;
 }
 
+// Terminal ise yankısız okuma; bağlama verilmiş akıştan ise düz satır
+static SecureString readPassword(const std::string& prompt) {
+    if (&in() == &std::cin) return read_password_secure(prompt);
+    return readLineSecure(prompt);
+}
+
 static int readInt(const std::string& prompt, int minV = INT32_MIN, int maxV = INT32_MAX) {
     while (true) {
-        std::cout << prompt;
+        out() << prompt;
         std::string s;
-        if (!std::getline(std::cin, s)) return 0;
+        if (!std::getline(in(), s)) return 0;
         try {
             size_t idx = 0;
             int v = std::stoi(s, &idx);
             if (idx == s.size() && v >= minV && v <= maxV) return v;
         }
         catch (...) {}
-        std::cout << "Lutfen gecerli bir tamsayi girin";
-        if (minV != INT32_MIN || maxV != INT32_MAX) std::cout << " [" << minV << " - " << maxV << "]";
-        std::cout << ".\n";
+        out() << "Lutfen gecerli bir tamsayi girin";
+        if (minV != INT32_MIN || maxV != INT32_MAX) out() << " [" << minV << " - " << maxV << "]";
+        out() << ".\n";
     }
 }
 
@@ -93,7 +246,7 @@ static std::string nowDateTime() {
 }
 
 // ---- FNV-1a 64 (legacy passhash i�in) ----
-static uint64_t fnv1a64(const std::string& s) {
+static uint64_t fnv1a64(const SecureString& s) {
     const uint64_t FNV_OFFSET = 1469598103934665603ULL;
     const uint64_t FNV_PRIME = 1099511628211ULL;
     uint64_t h = FNV_OFFSET;
@@ -107,7 +260,7 @@ static uint64_t fnv1a64(const std::string& s) {
 // ---- SQLite helpers ----
 static bool db_exec(const char* sql) {
     char* err = nullptr;
-    int rc = sqlite3_exec(g_db, sql, nullptr, nullptr, &err);
+    int rc = sqlite3_exec(cx().db, sql, nullptr, nullptr, &err);
     if (rc != SQLITE_OK) {
         std::cerr << "SQL error: " << (err ? err : "(null)") << "\n";
         if (err) sqlite3_free(err);
@@ -117,9 +270,9 @@ static bool db_exec(const char* sql) {
 }
 
 static bool db_prepare(sqlite3_stmt** out, const char* sql) {
-    int rc = sqlite3_prepare_v2(g_db, sql, -1, out, nullptr);
+    int rc = sqlite3_prepare_v2(cx().db, sql, -1, out, nullptr);
     if (rc != SQLITE_OK) {
-        std::cerr << "prepare failed: " << sqlite3_errmsg(g_db) << "\n";
+        std::cerr << "prepare failed: " << sqlite3_errmsg(cx().db) << "\n";
         return false;
     }
     return true;
@@ -151,7 +304,7 @@ static void secure_clear_string(std::string& s) {
 
 static std::string decryptMaybe(const std::string& val) {
     if (val.rfind("GCM1:", 0) == 0) {
-        const unsigned char* k = AppKey_Get().data();
+        const unsigned char* k = contextKey().data();
         try {
             return crypto::DecryptFromDB(val, k, /*aad*/"");
         }
@@ -164,7 +317,9 @@ static std::string decryptMaybe(const std::string& val) {
 
 
 static std::string encryptIfNeeded(const std::string& val) {
-    const unsigned char* k = AppKey_Get().data();
+    // Sayfa şifrelemede disk zaten şifreli; eski "GCM1:" değerleri decryptMaybe ile okunmaya devam eder
+    if (cx().pageEncrypted) return val;
+    const unsigned char* k = contextKey().data();
     try {
         return crypto::EncryptForDB(val, k, /*aad*/"");
     }
@@ -173,8 +328,226 @@ static std::string encryptIfNeeded(const std::string& val) {
     }
 }
 
+// PII alanını bağla: sayfa şifrelemede düz, aksi halde GCM1; düz metin SecureString dışına kopyalanmaz
+static bool bindProtected(sqlite3_stmt* st, int idx, const SecureString& val) {
+    if (cx().pageEncrypted) {
+        return sqlite3_bind_text(st, idx, val.data(), static_cast<int>(val.size()), SQLITE_TRANSIENT) == SQLITE_OK;
+    }
+    std::string sealed;
+    try {
+        sealed = crypto::EncryptForDB(val, contextKey().data(), /*aad*/"");
+    }
+    catch (...) {
+        return false;
+    }
+    return !sealed.empty() && sqlite3_bind_text(st, idx, sealed.c_str(), -1, SQLITE_TRANSIENT) == SQLITE_OK;
+}
+
+// ---- Roster cache (aktif oyuncular; PII gösterim anında çözülür) ----
+static void invalidateRosterCache() {
+    cx().rosterCache.Clear();
+    cx().rosterCacheValid = false;
+}
+
+static const store::RecordStore<Player>& rosterCache() {
+    if (!cx().rosterCacheValid) {
+        cx().rosterCacheValid = store::LoadRoster(cx().db, cx().rosterCache);
+    }
+    return cx().rosterCache;
+}
+
+// =================== Maintenance ===================
+// Checkpoint/optimize/vacuum arka planda; ölçümler ayrı bir log dosyasına yazılır (menüyü bozmasın)
+static const char* MAINT_LOG_PATH = "localsports_maint.log";
+
+static void logMaintenanceTask(const maintenance::TaskTiming& t) {
+    std::ofstream log(MAINT_LOG_PATH, std::ios::app);
+    if (!log) return;
+    log << nowDateTime() << " [MAINT] " << t.task
+        << " ms=" << std::fixed << std::setprecision(2) << t.ms
+        << " rc=" << t.rc << " before=" << t.walFrames << " done=" << t.done << "\n";
+}
+
+// =================== Connection Setup ===================
+// Her yeni bağlantıya uygulanır (varsayılan DB ve router'ın açtığı kiracı DB'leri)
+static bool configureConnection(sqlite3* db) {
+    // Sayfa VFS'i ile açılmış boş DB: page_size + reserve alanı tablolardan ve WAL'den önce ayarlanır
+    pagevfs::PrepareNewDatabase(db);
+
+    static const char* PRAGMAS[] = {
+        "PRAGMA auto_vacuum=INCREMENTAL;", // yalnızca yeni veritabanında (tablolardan önce) etkili
+        "PRAGMA journal_mode=WAL;",
+        "PRAGMA synchronous=NORMAL;",
+        "PRAGMA foreign_keys=ON;",
+        "PRAGMA secure_delete=ON;",
+        "PRAGMA temp_store=MEMORY;",
+    };
+    bool ok = true;
+    for (size_t i = 0; i < sizeof(PRAGMAS) / sizeof(PRAGMAS[0]); ++i) {
+        char* err = nullptr;
+        if (sqlite3_exec(db, PRAGMAS[i], nullptr, nullptr, &err) != SQLITE_OK) {
+            std::cerr << "SQL error: " << (err ? err : "(null)") << "\n";
+            sqlite3_free(err);
+            ok = false;
+        }
+    }
+    sqlite3_busy_timeout(db, 3000);
+
+    // ls_decrypt / ls_median / ls_stddev / ls_quantile: filtreleme ve istatistik SQLite içinde
+    if (!sqlfn::RegisterSqlFunctions(db, contextKeyReady() ? contextKey().data() : nullptr)) {
+        std::cerr << "SQL fonksiyonlari kaydedilemedi: " << sqlite3_errmsg(db) << "\n";
+        ok = false;
+    }
+    return ok;
+}
+
+static void initDatabase();
+static void openDefaultDatabase();
+static bool markMessagesRead(uint32_t upToId);
+static void logDataEvent(const char* type, const char* description, int severity);
+
+// Amaca özel anahtarlar AppKey'den HKDF ile türetilir; AppKey alan şifrelemesinde doğrudan kullanıldığı için ayrı tutulur
+static const SecureBuffer* contextSubkey(const char* label) {
+    return cx().appKey.size() == 32 ? cx().keys.Subkey(label) : AppKey_Subkey(label);
+}
+
+static bool registerPageVfs() {
+    const SecureBuffer* pageKey = contextSubkey("localsports/page-vfs/v1");
+    if (!pageKey) return false;
+    // Kendi anahtarı olan bağlam kendi VFS'ini alır; aynı adı paylaşsalar codec birbirini ezerdi
+    if (cx().appKey.size() == 32) {
+        char name[48];
+        std::snprintf(name, sizeof(name), "%s-%p", pagevfs::ENCRYPTED_VFS_NAME, static_cast<void*>(&cx()));
+        cx().vfsName = name;
+    }
+    else {
+        cx().vfsName = pagevfs::ENCRYPTED_VFS_NAME;
+    }
+    bool ok = pagevfs::RegisterPageVfs(cx().vfsName.c_str(), pagevfs::MakeAesGcmCodec(pageKey->data()));
+    if (ok) cx().dbVfs = cx().vfsName.c_str();
+    return ok;
+}
+
+void LS_SetEncryptionMode(LSContext& ctx, LSEncryptionMode mode) {
+    ContextScope scope(ctx);
+    cx().encryptionMode = mode;
+    if (mode == LS_ENCRYPT_FIELDS) cx().dbVfs = nullptr;
+}
+
+void LS_SetPageChecksums(LSContext& ctx, bool enabled) {
+    ContextScope scope(ctx);
+    cx().pageChecksums = enabled;
+    if (cx().encryptionMode == LS_ENCRYPT_FIELDS) cx().dbVfs = nullptr;
+}
+
+bool LS_GetPageChecksums(LSContext& ctx) {
+    ContextScope scope(ctx);
+    return cx().pageChecksums;
+}
+
+LSEncryptionMode LS_GetEncryptionMode(LSContext& ctx) {
+    ContextScope scope(ctx);
+    return cx().encryptionMode;
+}
+
+// ---- Storage mode ----
+void LS_SetDatabasePath(LSContext& ctx, const char* path) {
+    ContextScope scope(ctx);
+    cx().defaultDbPath = (path && *path) ? path : "localsports.db";
+}
+
+const char* LS_GetDatabasePath(LSContext& ctx) {
+    ContextScope scope(ctx);
+    return cx().defaultDbPath.c_str();
+}
+
+void LS_SetStorageMode(LSContext& ctx, LSStorageMode mode) {
+    ContextScope scope(ctx);
+    cx().storageMode = mode;
+}
+
+LSStorageMode LS_GetStorageMode(LSContext& ctx) {
+    ContextScope scope(ctx);
+    return cx().storageMode;
+}
+
+static bool isHybridDb(sqlite3* db) {
+    return db && cx().hybrid.IsOpen() && db == cx().hybrid.Db();
+}
+
+// Varsayılan bağlantıyı kapat (hibrit modda son checkpoint ile)
+static void closeDefaultDatabase() {
+    if (isHybridDb(cx().db)) cx().hybrid.Close();
+    else if (cx().db) sqlite3_close_v2(cx().db);
+    cx().db = nullptr;
+}
+
+static void openHybridDatabase() {
+    hybrid::HybridConfig cfg;
+    cfg.diskPath = cx().dbPath;
+    if (cx().dbVfs) cfg.vfs = cx().dbVfs;
+    cfg.diskSetup = [](sqlite3* disk) {
+        pagevfs::PrepareNewDatabase(disk); // yeni dosya: RAM görüntüsü de aynı düzeni (reserve) alır
+        sqlite3_busy_timeout(disk, 3000);
+        return true;
+    };
+    const SecureBuffer* logKey = contextSubkey("localsports/hybrid-log/v1");
+    bool ok = logKey != nullptr;
+    if (ok) {
+        cfg.logKey = logKey->data();
+        ok = cx().hybrid.Open(cfg);
+    }
+    if (!ok) {
+        std::cerr << "DB bellege yuklenemedi: " << cx().dbPath << "\n";
+        std::exit(1);
+    }
+    cx().db = cx().hybrid.Db();
+    configureConnection(cx().db);
+}
+
+// Doğrulayıcı thread'inden çağrılır
+static void reportPageMismatch(const std::string& path, int64_t page) {
+    const std::string description = path + ": sayfa " + std::to_string(page) + " dogrulanamadi (disarida degistirilmis veya bozuk)";
+    logDataEvent("DB_PAGE_CHECKSUM_MISMATCH", description.c_str(), 3);
+}
+
 // =================== INIT ===================
-void LS_Init() {
+// AppKey KDF, alt anahtarlar ve şifreli VFS; tekrar çağrılırsa önbellekten döner
+static bool preloadContext() {
+    if (cx().appKey.size() != 32 && !AppKey_InitFromEnvOrPrompt()) {
+        std::cerr << "AppKey baslatilamadi.\n";
+        return false;
+    }
+    cx().searchKey = contextSubkey("localsports/search-token/v1");
+    if (!cx().searchKey) {
+        std::cerr << "Arama anahtari turetilemedi.\n";
+        return false;
+    }
+
+    if (cx().encryptionMode == LS_ENCRYPT_PAGES && !cx().dbVfs) {
+        if (!registerPageVfs()) {
+            std::cerr << "Sifreli VFS kaydedilemedi.\n";
+            return false;
+        }
+    }
+    else if (cx().encryptionMode == LS_ENCRYPT_FIELDS && cx().pageChecksums && !cx().dbVfs) {
+        // Codec durumsuz: tüm bağlamlar aynı VFS'i paylaşır
+        if (!pagevfs::RegisterPageVfs(pagevfs::CHECKSUM_VFS_NAME, pagevfs::MakeChecksumCodec())) {
+            std::cerr << "Checksum VFS kaydedilemedi.\n";
+            return false;
+        }
+        cx().dbVfs = pagevfs::CHECKSUM_VFS_NAME;
+    }
+    return true;
+}
+
+bool LS_Preload(LSContext& ctx) {
+    ContextScope scope(ctx);
+    return preloadContext();
+}
+
+void LS_Init(LSContext& ctx) {
+    ContextScope scope(ctx);
     // =================== GÜVENLİK KONTROLLER ===================
     // NOT: RASP (Runtime Application Self-Protection) main()'de başlatılmıştır
     // Burada sadece ek kod sertleştirme teknikleri uygulanıyor
@@ -191,23 +564,38 @@ void LS_Init() {
     // Çakışmayı önlemek için burada tekrar yapılmıyor
 
     
-    if (!AppKey_InitFromEnvOrPrompt()) {
-        std::cerr << "AppKey baslatilamadi.\n";
+    if (!preloadContext()) {
         std::exit(1);
     }
 
-    if (sqlite3_open_v2(DB_PATH, &g_db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX, nullptr) != SQLITE_OK) {
-        std::cerr << "DB acilamadi: " << sqlite3_errmsg(g_db) << "\n";
+    if (cx().tenantLease) {
+        // Kiracı seçiliyse bağlantı router'dan gelir (PRAGMA'lar açılışta uygulandı)
+        cx().db = cx().tenantLease.Db();
+    }
+    else {
+        openDefaultDatabase();
+    }
+
+    initDatabase();
+}
+
+static void openDefaultDatabase() {
+    if (cx().hybrid.IsOpen()) cx().hybrid.Close(); // mod değişmiş olabilir; log'daki her şey diske alınır
+    cx().dbPath = cx().defaultDbPath;
+    if (cx().storageMode == LS_STORAGE_MEMORY) {
+        openHybridDatabase();
+        return;
+    }
+    if (sqlite3_open_v2(cx().dbPath.c_str(), &cx().db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX | SQLITE_OPEN_URI, cx().dbVfs) != SQLITE_OK) {
+        std::cerr << "DB acilamadi: " << sqlite3_errmsg(cx().db) << "\n";
         std::exit(1);
     }
+    configureConnection(cx().db);
+}
 
-    // PRAGMA'lar
-    db_exec("PRAGMA journal_mode=WAL;");
-    db_exec("PRAGMA synchronous=NORMAL;");
-    db_exec("PRAGMA foreign_keys=ON;");
-    db_exec("PRAGMA secure_delete=ON;");
-    db_exec("PRAGMA temp_store=MEMORY;");
-    sqlite3_busy_timeout(g_db, 3000);
+// Şema + varsayılan admin + bakım; aktif cx().db üzerinde çalışır (varsayılan veya kiracı)
+static void initDatabase() {
+    invalidateRosterCache();
 
     // USERS (g�venli �ema + legacy s�tunu)
     db_exec("CREATE TABLE IF NOT EXISTS users ("
@@ -252,11 +640,16 @@ void LS_Init() {
         "FOREIGN KEY(gameId) REFERENCES games(id),"
         "FOREIGN KEY(playerId) REFERENCES players(id));");
 
-    // MESSAGES (metin �ifreli saklan�r)
-    db_exec("CREATE TABLE IF NOT EXISTS messages ("
-        "id INTEGER PRIMARY KEY AUTOINCREMENT,"
-        "datetime TEXT NOT NULL,"
-        "text TEXT NOT NULL);");  /* GCM1:... */
+    // MESSAGES (metin şifreli saklanır): aylık bölümler + "messages" görünümü.
+    // unread(user) = posted - read_count(user); read_count = imlecin (last_read_id) altındaki mesaj sayısı.
+    // Bölüm tetikleyicileri sayaçları her ekleme/silmede günceller; banner mesajları hiç taramaz.
+    if (!partition::EnsureSchema(cx().db)) {
+        std::cerr << "Mesaj bolumleri hazirlanamadi.\n";
+    }
+    // Arama indeksi: HMAC token -> mesaj id; indeksten önceki mesajlar aramada parça parça backfill edilir
+    if (!search::EnsureSchema(cx().db, partition::LastAssignedId(cx().db))) {
+        std::cerr << "Mesaj arama indeksi hazirlanamadi.\n";
+    }
 
     // Varsay�lan admin (admin/admin) - modern PBKDF2 ile
     sqlite3_stmt* st = nullptr;
@@ -290,7 +683,7 @@ void LS_Init() {
                         sqlite3_bind_blob(ins, 3, hash32, 32, SQLITE_TRANSIENT);
                         sqlite3_bind_int(ins, 4, iters);
                         if (sqlite3_step(ins) != SQLITE_DONE) {
-                            std::cerr << "admin eklenemedi: " << sqlite3_errmsg(g_db) << "\n";
+                            std::cerr << "admin eklenemedi: " << sqlite3_errmsg(cx().db) << "\n";
                         }
                         sqlite3_finalize(ins);
                     }
@@ -299,15 +692,36 @@ void LS_Init() {
             }
         }
     }
+
+    // Şema yazıldıktan sonra sayfa 1 diskte; düzen artık belli
+    if (isHybridDb(cx().db)) cx().hybrid.Checkpoint(); // yeni dosya ise şema hemen diske
+    cx().pageEncrypted = pagevfs::IsPageTransformed(isHybridDb(cx().db) ? cx().hybrid.DiskDb() : cx().db);
+    if (cx().encryptionMode == LS_ENCRYPT_PAGES && !cx().pageEncrypted) {
+        std::cerr << "Uyari: mevcut veritabani sayfa sifreli degil; alan sifrelemesi kullanilacak.\n";
+    }
+
+    // Sayfa codec'li dosya (checksum veya şifreli) hız sınırıyla taranır; bozuk sayfa RASP olayı olur
+    cx().verifier.Stop();
+    std::shared_ptr<pagevfs::PageCodec> codec = pagevfs::CodecOf(isHybridDb(cx().db) ? cx().hybrid.DiskDb() : cx().db);
+    if (codec) cx().verifier.Start(cx().dbPath, codec, pagevfs::VerifierConfig(), reportPageMismatch);
+
+    // Otomatik checkpoint yerine arka plan bakım zamanlayıcısı (hibrit modda WAL yok; checkpoint'i HybridStore yapar)
+    cx().maint.Stop();
+    if (isHybridDb(cx().db)) return;
+    if (!cx().maint.Start(cx().db, cx().dbPath, maintenance::MaintenanceConfig(), logMaintenanceTask)) {
+        std::cerr << "Bakim zamanlayicisi baslatilamadi; otomatik checkpoint kullaniliyor.\n";
+    }
 }
 
 // =================== AUTH ===================
-bool LS_AuthLoginInteractive() {
+bool LS_AuthLoginInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
+    rasp::NotifySensitiveOperation("login");
     // Opaque loop ile timing attack koruması
     hardening::OpaqueLoop(50);
     
     std::string uname = readLine("Kullanici adi: ");
-    std::string pwd = read_password_secure("Sifre: ");
+    SecureString pwd = readPassword("Sifre: ");
 
     // Anti-debug kontrolü (her login denemesinde)
     if (hardening::IsDebuggerPresent()) {
@@ -319,15 +733,16 @@ bool LS_AuthLoginInteractive() {
         "SELECT id, pass_salt, pass_hash, pass_iters, passhash "
         "FROM users WHERE active=1 AND username=?;"))
     {
-        secure_clear_string(pwd);
+        pwd.clear();
         return false;
     }
     sqlite3_bind_text(st, 1, uname.c_str(), -1, SQLITE_TRANSIENT);
 
     bool ok = false;
+    int userId = 0;
 
     if (sqlite3_step(st) == SQLITE_ROW) {
-        const int uid = sqlite3_column_int(st, 0);
+        userId = sqlite3_column_int(st, 0);
 
         unsigned char salt[16];  int saltLen = 0;
         unsigned char hash[32];  int hashLen = 0;
@@ -367,17 +782,18 @@ bool LS_AuthLoginInteractive() {
         sqlite3_finalize(st);
     }
 
-    secure_clear_string(pwd);
+    pwd.clear();
 
     // Opaque predicate ile kontrol akışını gizle
     if (hardening::OpaquePredicateAlwaysTrue()) {
         if (ok) {
-            g_isAuthed = true;
-            std::snprintf(g_currentUser, sizeof(g_currentUser), "%s", uname.c_str());
-            std::cout << "Giris basarili. Hos geldin, " << g_currentUser << "!\n";
+            cx().isAuthed = true;
+            cx().currentUserId = userId;
+            std::snprintf(cx().currentUser, sizeof(cx().currentUser), "%s", uname.c_str());
+            out() << "Giris basarili. Hos geldin, " << cx().currentUser << "!\n";
         }
         else {
-            std::cout << "Hatali kullanici adi ya da sifre.\n";
+            out() << "Hatali kullanici adi ya da sifre.\n";
         }
     }
 
@@ -387,12 +803,13 @@ bool LS_AuthLoginInteractive() {
 
 
 
-void LS_AuthRegisterInteractive() {
+void LS_AuthRegisterInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
     std::string uname;
     while (true) {
         uname = readLine("Yeni kullanici adi (3-31): ");
         if (uname.size() < 3 || uname.size() > 31) {
-            std::cout << "Uzunluk hatasi.\n";
+            out() << "Uzunluk hatasi.\n";
             continue;
         }
 
@@ -405,34 +822,34 @@ void LS_AuthRegisterInteractive() {
         sqlite3_finalize(chk);
 
         if (exists) {
-            std::cout << "Bu kullanici adi zaten var.\n";
+            out() << "Bu kullanici adi zaten var.\n";
             continue;
         }
         break;
     }
 
-    std::string pwd1 = read_password_secure("Sifre: ");
-    std::string pwd2 = read_password_secure("Sifre (tekrar): ");
-    if (pwd1 != pwd2) {
-        std::cout << "Sifreler eslesmiyor.\n";
+    SecureString pwd1 = readPassword("Sifre: ");
+    SecureString pwd2 = readPassword("Sifre (tekrar): ");
+    if (!pwd1.equals(pwd2)) {
+        out() << "Sifreler eslesmiyor.\n";
         return;
     }
 
     unsigned char salt[16];
     if (!gen_salt(salt)) {
-        std::cout << "Salt uretilemedi.\n";
+        out() << "Salt uretilemedi.\n";
         return;
     }
 
     unsigned char hash32[32];
     const int iters = 150000;
     if (!crypto::DeriveKeyFromPassphrase(pwd1, salt, 16, iters, hash32)) {
-        std::cout << "KDF hatasi.\n";
+        out() << "KDF hatasi.\n";
         return;
     }
 
-    secure_clear_string(pwd1);
-    secure_clear_string(pwd2);
+    pwd1.clear();
+    pwd2.clear();
 
     sqlite3_stmt* ins = nullptr;
     if (!db_prepare(&ins, "INSERT INTO users(username, pass_salt, pass_hash, pass_iters, role, active) VALUES(?, ?, ?, ?, 'member', 1);"))
@@ -444,10 +861,10 @@ void LS_AuthRegisterInteractive() {
     sqlite3_bind_int(ins, 4, iters);
 
     if (sqlite3_step(ins) == SQLITE_DONE) {
-        std::cout << "Kayit olusturuldu. ID=" << (int)sqlite3_last_insert_rowid(g_db) << "\n";
+        out() << "Kayit olusturuldu. ID=" << (int)sqlite3_last_insert_rowid(cx().db) << "\n";
     }
     else {
-        std::cout << "HATA: Kaydedilemedi.\n";
+        out() << "HATA: Kaydedilemedi.\n";
     }
 
     sqlite3_finalize(ins);
@@ -455,61 +872,64 @@ void LS_AuthRegisterInteractive() {
 }
 
 
-void LS_AuthLogout() {
-    g_isAuthed = false;
-    g_currentUser[0] = '\0';
-    std::cout << "Oturum kapatildi.\n";
+void LS_AuthLogout(LSContext& ctx) {
+    ContextScope scope(ctx);
+    cx().isAuthed = false;
+    cx().currentUserId = 0;
+    cx().currentUser[0] = '\0';
+    out() << "Oturum kapatildi.\n";
 }
 
-bool LS_IsAuthenticated() { return g_isAuthed; }
-const char* LS_CurrentUsername() { return g_currentUser[0] ? g_currentUser : nullptr; }
+bool LS_IsAuthenticated(LSContext& ctx) {
+    ContextScope scope(ctx);
+    return cx().isAuthed;
+}
+const char* LS_CurrentUsername(LSContext& ctx) {
+    ContextScope scope(ctx);
+    return cx().currentUser[0] ? cx().currentUser : nullptr;
+}
 
 // =================== ROSTER ===================
-void LS_ListPlayersInteractive() {
-    sqlite3_stmt* st = nullptr;
-    if (!db_prepare(&st, "SELECT id,name,position,phone,email,active FROM players WHERE active=1 ORDER BY id;"))
-        return;
-
-    std::cout << "\nID  " << std::left << std::setw(22) << "Name"
+void LS_ListPlayersInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
+    out() << "\nID  " << std::left << std::setw(22) << "Name"
         << std::setw(12) << "Position"
         << std::setw(16) << "Phone"
         << std::setw(26) << "Email"
         << "Active\n";
-    std::cout << std::string(90, '-') << "\n";
-
-    while (sqlite3_step(st) == SQLITE_ROW) {
-        int id = sqlite3_column_int(st, 0);
-        const char* name = (const char*)sqlite3_column_text(st, 1);
-        const char* pos = (const char*)sqlite3_column_text(st, 2);
-        const char* phone = (const char*)sqlite3_column_text(st, 3);
-        const char* email = (const char*)sqlite3_column_text(st, 4);
-        int active = sqlite3_column_int(st, 5);
-
-        std::string phoneDec = decryptMaybe(phone ? phone : "");
-        std::string emailDec = decryptMaybe(email ? email : "");
-
-        std::cout << std::left
-            << std::setw(4) << id
-            << std::setw(22) << (name ? name : "")
-            << std::setw(12) << (pos ? pos : "")
-            << std::setw(16) << phoneDec
-            << std::setw(26) << emailDec
-            << (active ? "Yes" : "No") << "\n";
+    out() << std::string(90, '-') << "\n";
+
+    // Önbellekte PII yok: phone/email tek sıralı sorguyla okunur, satır önbellekteki kayıtla
+    // id üzerinden birleştirilir; çözülen değer yazdırıldıktan hemen sonra silinir
+    const store::RecordStore<Player>& roster = rosterCache();
+    sqlite3_stmt* pii = nullptr;
+    if (!db_prepare(&pii, "SELECT id, phone, email FROM players WHERE active = 1 ORDER BY id;")) return;
+    while (sqlite3_step(pii) == SQLITE_ROW) {
+        const Player* p = roster.FindById(static_cast<uint32_t>(sqlite3_column_int64(pii, 0)));
+        if (!p) continue;
+        const char* ph = (const char*)sqlite3_column_text(pii, 1);
+        const char* em = (const char*)sqlite3_column_text(pii, 2);
+        std::string phone = decryptMaybe(ph ? ph : "");
+        std::string email = decryptMaybe(em ? em : "");
+        out() << std::left
+            << std::setw(4) << p->id
+            << std::setw(22) << p->name
+            << std::setw(12) << p->position
+            << std::setw(16) << phone
+            << std::setw(26) << email
+            << (p->active ? "Yes" : "No") << "\n";
+        secure_clear_string(phone);
+        secure_clear_string(email);
     }
-    sqlite3_finalize(st);
+    sqlite3_finalize(pii);
 }
 
-void LS_AddPlayerInteractive() {
+void LS_AddPlayerInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
     std::string name = readLine("Isim: ");
     std::string position = readLine("Pozisyon: ");
-    std::string phone = readLine("Telefon: ");
-    std::string email = readLine("Email: ");
-
-    std::string phoneEnc = encryptIfNeeded(phone);
-    std::string emailEnc = encryptIfNeeded(email);
-    if (phoneEnc.empty() || emailEnc.empty()) {
-        std::cout << "Sifreleme hatasi.\n"; return;
-    }
+    SecureString phone = readLineSecure("Telefon: ");
+    SecureString email = readLineSecure("Email: ");
 
     sqlite3_stmt* ins = nullptr;
     if (!db_prepare(&ins, "INSERT INTO players(name,position,phone,email,active) VALUES(?,?,?,?,1);"))
@@ -517,20 +937,24 @@ void LS_AddPlayerInteractive() {
 
     sqlite3_bind_text(ins, 1, name.c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(ins, 2, position.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(ins, 3, phoneEnc.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(ins, 4, emailEnc.c_str(), -1, SQLITE_TRANSIENT);
+    if (!bindProtected(ins, 3, phone) || !bindProtected(ins, 4, email)) {
+        sqlite3_finalize(ins);
+        out() << "Sifreleme hatasi.\n"; return;
+    }
 
     if (sqlite3_step(ins) == SQLITE_DONE) {
-        std::cout << "Player eklendi. ID=" << (int)sqlite3_last_insert_rowid(g_db) << "\n";
+        invalidateRosterCache();
+        out() << "Player eklendi. ID=" << (int)sqlite3_last_insert_rowid(cx().db) << "\n";
     }
     else {
-        std::cout << "HATA: Kaydedilemedi.\n";
+        out() << "HATA: Kaydedilemedi.\n";
     }
     sqlite3_finalize(ins);
 }
 
-void LS_EditPlayerInteractive() {
-    LS_ListPlayersInteractive();
+void LS_EditPlayerInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
+    LS_ListPlayersInteractive(cx());
     int id = readInt("Duzenlenecek Player ID: ");
 
     // Var m� kontrol
@@ -539,7 +963,7 @@ void LS_EditPlayerInteractive() {
     sqlite3_bind_int(chk, 1, id);
     bool ok = (sqlite3_step(chk) == SQLITE_ROW);
     sqlite3_finalize(chk);
-    if (!ok) { std::cout << "Bulunamadi.\n"; return; }
+    if (!ok) { out() << "Bulunamadi.\n"; return; }
 
     std::string v;
 
@@ -561,31 +985,35 @@ void LS_EditPlayerInteractive() {
         sqlite3_step(st); sqlite3_finalize(st);
     }
 
-    v = readLine("Telefon (bos = ayni): ");
-    if (!v.empty()) {
-        std::string enc = encryptIfNeeded(v);
+    SecureString pii = readLineSecure("Telefon (bos = ayni): ");
+    if (!pii.empty()) {
         sqlite3_stmt* st = nullptr;
         db_prepare(&st, "UPDATE players SET phone=? WHERE id=?;");
-        sqlite3_bind_text(st, 1, enc.c_str(), -1, SQLITE_TRANSIENT);
-        sqlite3_bind_int(st, 2, id);
-        sqlite3_step(st); sqlite3_finalize(st);
+        if (bindProtected(st, 1, pii)) {
+            sqlite3_bind_int(st, 2, id);
+            sqlite3_step(st);
+        }
+        sqlite3_finalize(st);
     }
 
-    v = readLine("Email (bos = ayni): ");
-    if (!v.empty()) {
-        std::string enc = encryptIfNeeded(v);
+    pii = readLineSecure("Email (bos = ayni): ");
+    if (!pii.empty()) {
         sqlite3_stmt* st = nullptr;
         db_prepare(&st, "UPDATE players SET email=? WHERE id=?;");
-        sqlite3_bind_text(st, 1, enc.c_str(), -1, SQLITE_TRANSIENT);
-        sqlite3_bind_int(st, 2, id);
-        sqlite3_step(st); sqlite3_finalize(st);
+        if (bindProtected(st, 1, pii)) {
+            sqlite3_bind_int(st, 2, id);
+            sqlite3_step(st);
+        }
+        sqlite3_finalize(st);
     }
 
-    std::cout << "Guncellendi.\n";
+    invalidateRosterCache();
+    out() << "Guncellendi.\n";
 }
 
-void LS_RemovePlayerInteractive() {
-    LS_ListPlayersInteractive();
+void LS_RemovePlayerInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
+    LS_ListPlayersInteractive(cx());
     int id = readInt("Silinecek Player ID: ");
 
     sqlite3_stmt* st = nullptr;
@@ -594,28 +1022,30 @@ void LS_RemovePlayerInteractive() {
 
     sqlite3_bind_int(st, 1, id);
 
-    if (sqlite3_step(st) == SQLITE_DONE && sqlite3_changes(g_db) > 0) {
-        std::cout << "Silindi (pasif).\n";
+    if (sqlite3_step(st) == SQLITE_DONE && sqlite3_changes(cx().db) > 0) {
+        invalidateRosterCache();
+        out() << "Silindi (pasif).\n";
     }
     else {
-        std::cout << "Bulunamadi veya zaten pasif.\n";
+        out() << "Bulunamadi veya zaten pasif.\n";
     }
     sqlite3_finalize(st);
 }
 
 // =================== GAMES ===================
-void LS_ListGamesInteractive() {
+void LS_ListGamesInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
     sqlite3_stmt* st = nullptr;
     if (!db_prepare(&st, "SELECT id,date,time,opponent,location,played,result FROM games ORDER BY id;"))
         return;
 
-    std::cout << "\nID  " << std::left << std::setw(12) << "Date"
+    out() << "\nID  " << std::left << std::setw(12) << "Date"
         << std::setw(8) << "Time"
         << std::setw(22) << "Opponent"
         << std::setw(22) << "Location"
         << std::setw(8) << "Played"
         << "Result\n";
-    std::cout << std::string(90, '-') << "\n";
+    out() << std::string(90, '-') << "\n";
 
     while (sqlite3_step(st) == SQLITE_ROW) {
         int id = sqlite3_column_int(st, 0);
@@ -626,7 +1056,7 @@ void LS_ListGamesInteractive() {
         int played = sqlite3_column_int(st, 5);
         const char* res = (const char*)sqlite3_column_text(st, 6);
 
-        std::cout << std::left
+        out() << std::left
             << std::setw(4) << id
             << std::setw(12) << (date ? date : "")
             << std::setw(8) << (time ? time : "")
@@ -639,7 +1069,8 @@ void LS_ListGamesInteractive() {
     sqlite3_finalize(st);
 }
 
-void LS_AddGameInteractive() {
+void LS_AddGameInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
     std::string date = readLine("Tarih (YYYY-MM-DD): ");
     std::string time = readLine("Saat (HH:MM): ");
     std::string opponent = readLine("Rakip: ");
@@ -655,16 +1086,17 @@ void LS_AddGameInteractive() {
     sqlite3_bind_text(ins, 4, location.c_str(), -1, SQLITE_TRANSIENT);
 
     if (sqlite3_step(ins) == SQLITE_DONE) {
-        std::cout << "Mac eklendi. ID=" << (int)sqlite3_last_insert_rowid(g_db) << "\n";
+        out() << "Mac eklendi. ID=" << (int)sqlite3_last_insert_rowid(cx().db) << "\n";
     }
     else {
-        std::cout << "HATA: Kaydedilemedi.\n";
+        out() << "HATA: Kaydedilemedi.\n";
     }
     sqlite3_finalize(ins);
 }
 
-void LS_RecordResultInteractive() {
-    LS_ListGamesInteractive();
+void LS_RecordResultInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
+    LS_ListGamesInteractive(cx());
     int id = readInt("Sonuc girilecek Game ID: ");
 
     sqlite3_stmt* chk = nullptr;
@@ -672,7 +1104,7 @@ void LS_RecordResultInteractive() {
     sqlite3_bind_int(chk, 1, id);
     bool ok = (sqlite3_step(chk) == SQLITE_ROW);
     sqlite3_finalize(chk);
-    if (!ok) { std::cout << "Bulunamadi.\n"; return; }
+    if (!ok) { out() << "Bulunamadi.\n"; return; }
 
     std::string res = readLine("Sonuc (ornegin 2-1 W): ");
 
@@ -681,38 +1113,33 @@ void LS_RecordResultInteractive() {
     sqlite3_bind_text(st, 1, res.c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_int(st, 2, id);
 
-    if (sqlite3_step(st) == SQLITE_DONE) std::cout << "Sonuc kaydedildi.\n";
-    else std::cout << "HATA: Kaydedilemedi.\n";
+    if (sqlite3_step(st) == SQLITE_DONE) out() << "Sonuc kaydedildi.\n";
+    else out() << "HATA: Kaydedilemedi.\n";
     sqlite3_finalize(st);
 }
 
 // =================== STATS ===================
-void LS_RecordStatsInteractive() {
+void LS_RecordStatsInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
     // Oyun se�imi
     sqlite3_stmt* gst = nullptr;
     if (!db_prepare(&gst, "SELECT id,date,time,opponent FROM games ORDER BY id;")) return;
-    std::cout << "\nMaclar:\n";
+    out() << "\nMaclar:\n";
     while (sqlite3_step(gst) == SQLITE_ROW) {
         int id = sqlite3_column_int(gst, 0);
         const char* d = (const char*)sqlite3_column_text(gst, 1);
         const char* t = (const char*)sqlite3_column_text(gst, 2);
         const char* o = (const char*)sqlite3_column_text(gst, 3);
-        std::cout << "  " << id << ") " << (d ? d : "") << " " << (t ? t : "") << " vs " << (o ? o : "") << "\n";
+        out() << "  " << id << ") " << (d ? d : "") << " " << (t ? t : "") << " vs " << (o ? o : "") << "\n";
     }
     sqlite3_finalize(gst);
     int gid = readInt("Hangi Game ID icin istatistik? ");
 
     // Oyuncu se�imi
-    sqlite3_stmt* pst = nullptr;
-    if (!db_prepare(&pst, "SELECT id,name,position FROM players WHERE active=1 ORDER BY id;")) return;
-    std::cout << "\nOyuncular:\n";
-    while (sqlite3_step(pst) == SQLITE_ROW) {
-        int id = sqlite3_column_int(pst, 0);
-        const char* n = (const char*)sqlite3_column_text(pst, 1);
-        const char* p = (const char*)sqlite3_column_text(pst, 2);
-        std::cout << "  " << id << ") " << (n ? n : "") << " (" << (p ? p : "") << ")\n";
-    }
-    sqlite3_finalize(pst);
+    out() << "\nOyuncular:\n";
+    rosterCache().ForEach([](const Player& p) {
+        out() << "  " << p.id << ") " << p.name << " (" << p.position << ")\n";
+    });
     int pid = readInt("Player ID: ");
 
     int goals = readInt("Goals: ", 0, 100);
@@ -735,16 +1162,17 @@ void LS_RecordStatsInteractive() {
     sqlite3_bind_int(ins, 7, red);
 
     if (sqlite3_step(ins) == SQLITE_DONE) {
-        std::cout << "Istatistik eklendi (Game " << gid << ", Player " << pid << ").\n";
+        out() << "Istatistik eklendi (Game " << gid << ", Player " << pid << ").\n";
     }
     else {
-        std::cout << "HATA: Kaydedilemedi.\n";
+        out() << "HATA: Kaydedilemedi.\n";
     }
     sqlite3_finalize(ins);
 }
 
-void LS_ViewPlayerTotalsInteractive() {
-    const char* SQL =
+// statsSource: "stats" (sıcak tablo) veya "all_stats" (arşivler dahil birleşik görünüm)
+static void printPlayerTotals(const std::string& statsSource) {
+    const std::string SQL =
         "SELECT p.id, p.name, "
         "COALESCE(SUM(s.goals),0)   AS goals, "
         "COALESCE(SUM(s.assists),0) AS assists, "
@@ -752,21 +1180,21 @@ void LS_ViewPlayerTotalsInteractive() {
         "COALESCE(SUM(s.yellow),0)  AS yellow, "
         "COALESCE(SUM(s.red),0)     AS red "
         "FROM players p "
-        "LEFT JOIN stats s ON s.playerId=p.id "
+        "LEFT JOIN " + statsSource + " s ON s.playerId=p.id "
         "WHERE p.active=1 "
         "GROUP BY p.id, p.name "
         "ORDER BY goals DESC;";
 
     sqlite3_stmt* st = nullptr;
-    if (!db_prepare(&st, SQL)) return;
+    if (!db_prepare(&st, SQL.c_str())) return;
 
-    std::cout << "\nID  " << std::left << std::setw(22) << "Name"
+    out() << "\nID  " << std::left << std::setw(22) << "Name"
         << std::setw(8) << "Goals"
         << std::setw(8) << "Assists"
         << std::setw(8) << "Saves"
         << std::setw(8) << "Yellow"
         << "Red\n";
-    std::cout << std::string(70, '-') << "\n";
+    out() << std::string(70, '-') << "\n";
 
     while (sqlite3_step(st) == SQLITE_ROW) {
         int id = sqlite3_column_int(st, 0);
@@ -777,7 +1205,7 @@ void LS_ViewPlayerTotalsInteractive() {
         int yellow = sqlite3_column_int(st, 5);
         int red = sqlite3_column_int(st, 6);
 
-        std::cout << std::left
+        out() << std::left
             << std::setw(4) << id
             << std::setw(22) << (name ? name : "")
             << std::setw(8) << goals
@@ -788,34 +1216,70 @@ void LS_ViewPlayerTotalsInteractive() {
             << "\n";
     }
     sqlite3_finalize(st);
+
+    // Maç başına gol dağılımı tek sorguda (satırlar C++'a taşınmadan)
+    const std::string DIST =
+        "SELECT COUNT(goals), ls_median(goals), ls_stddev(goals), ls_quantile(goals, 0.9) FROM " + statsSource + ";";
+    if (!db_prepare(&st, DIST.c_str())) return;
+    if (sqlite3_step(st) == SQLITE_ROW && sqlite3_column_int(st, 0) > 0) {
+        out() << std::string(70, '-') << "\n"
+            << "Oyuncu-mac basina gol: medyan " << std::fixed << std::setprecision(2) << sqlite3_column_double(st, 1)
+            << ", std sapma " << sqlite3_column_double(st, 2)
+            << ", %90 " << sqlite3_column_double(st, 3) << "\n";
+        out().unsetf(std::ios::floatfield);
+        out() << std::setprecision(6);
+    }
+    sqlite3_finalize(st);
+}
+
+void LS_ViewPlayerTotalsInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
+    printPlayerTotals("stats");
+}
+
+void LS_ViewAllSeasonTotalsInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
+    // Arşivler yalnızca bu sorgu için salt-okunur bağlanır; sıcak sorgular küçük tablolarda kalır
+    int n = archive::AttachArchives(cx().db);
+    if (n < 0) { out() << "HATA: Arsivler baglanamadi.\n"; return; }
+    out() << "(" << n << " arsiv sezonu dahil)\n";
+    printPlayerTotals("all_stats");
+    archive::DetachArchives(cx().db);
 }
 
 // =================== COMMUNICATIONS ===================
-void LS_ListMessagesInteractive() {
+void LS_ListMessagesInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
     sqlite3_stmt* st = nullptr;
     if (!db_prepare(&st, "SELECT id,datetime,text FROM messages ORDER BY id;"))
         return;
 
-    std::cout << "\nID  " << std::left << std::setw(18) << "Datetime"
+    out() << "\nID  " << std::left << std::setw(18) << "Datetime"
         << "Message\n";
-    std::cout << std::string(80, '-') << "\n";
+    out() << std::string(80, '-') << "\n";
 
+    uint32_t lastId = 0;
     while (sqlite3_step(st) == SQLITE_ROW) {
         int id = sqlite3_column_int(st, 0);
         const char* dt = (const char*)sqlite3_column_text(st, 1);
         const char* tx = (const char*)sqlite3_column_text(st, 2);
+        lastId = static_cast<uint32_t>(id);
 
         std::string dec = decryptMaybe(tx ? tx : "");
 
-        std::cout << std::left
+        out() << std::left
             << std::setw(4) << id
             << std::setw(18) << (dt ? dt : "")
             << dec << "\n";
     }
     sqlite3_finalize(st);
+
+    // Tüm liste gösterildi: oturumdaki kullanıcı için okundu
+    if (cx().isAuthed && lastId) markMessagesRead(lastId);
 }
 
-void LS_AddMessageInteractive() {
+void LS_AddMessageInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
     std::string text;
     do {
         text = readLine("Mesaj (1-150 karakter): ");
@@ -823,20 +1287,479 @@ void LS_AddMessageInteractive() {
 
     std::string dt = nowDateTime();
     std::string enc = encryptIfNeeded(text);
-    if (enc.empty()) { std::cout << "Sifreleme hatasi.\n"; return; }
+    if (enc.empty()) { out() << "Sifreleme hatasi.\n"; return; }
+
+    // Ayın bölümüne yazılır (bölüm yoksa açılır); arama token'ları aynı transaction'da
+    int64_t id = 0;
+    bool ok = db_exec("BEGIN IMMEDIATE;") && partition::InsertMessage(cx().db, dt, enc, &id) &&
+              search::IndexMessage(cx().db, cx().searchKey->data(), id, text);
+    ok = db_exec(ok ? "COMMIT;" : "ROLLBACK;") && ok;
+    secure_clear_string(text);
+    if (ok) {
+        out() << "Mesaj kaydedildi.\n";
+        // Commit edildi; long-poll bekleyenleri uyandır
+        feed::MessageFeed().Publish(cx().dbPath, static_cast<uint64_t>(id));
+    }
+    else {
+        out() << "HATA: Kaydedilemedi.\n";
+    }
+}
 
-    sqlite3_stmt* ins = nullptr;
-    if (!db_prepare(&ins, "INSERT INTO messages(datetime,text) VALUES(?,?);"))
+// =================== READ STATE ===================
+static bool queryInt64(const char* sql, int bindUserId, sqlite3_int64* value) {
+    sqlite3_stmt* st = nullptr;
+    if (!db_prepare(&st, sql)) return false;
+    if (bindUserId) sqlite3_bind_int(st, 1, bindUserId);
+    const int rc = sqlite3_step(st);
+    if (rc == SQLITE_ROW) *value = sqlite3_column_int64(st, 0);
+    sqlite3_finalize(st);
+    return rc == SQLITE_ROW || rc == SQLITE_DONE;
+}
+
+static int unreadMessageCount() {
+    if (!cx().db || !cx().isAuthed || cx().currentUserId <= 0) return -1;
+    sqlite3_int64 unread = -1;
+    if (!queryInt64("SELECT (SELECT posted FROM message_counters WHERE id = 1) - "
+                    "COALESCE((SELECT read_count FROM message_reads WHERE user_id = ?1), 0);",
+                    cx().currentUserId, &unread)) return -1;
+    return unread < 0 ? 0 : static_cast<int>(unread);
+}
+
+// İmleç yalnızca ileri gider; read_count yeni onaylanan aralık kadar artar (ekleme sıralarının farkı)
+static bool markMessagesRead(uint32_t upToId) {
+    const int uid = cx().currentUserId;
+    if (!cx().db || !cx().isAuthed || uid <= 0) return false;
+    if (!db_exec("BEGIN IMMEDIATE;")) return false;
+
+    sqlite3_int64 lastRead = 0, readCount = 0, maxId = 0, posted = 0;
+    bool ok = queryInt64("SELECT last_read_id FROM message_reads WHERE user_id = ?1;", uid, &lastRead) &&
+              queryInt64("SELECT read_count FROM message_reads WHERE user_id = ?1;", uid, &readCount) &&
+              queryInt64("SELECT last_id FROM message_seq WHERE id = 1;", 0, &maxId) &&
+              queryInt64("SELECT posted FROM message_counters WHERE id = 1;", 0, &posted);
+
+    sqlite3_int64 cursor = static_cast<sqlite3_int64>(upToId);
+    if (ok && cursor > lastRead) {
+        if (cursor >= maxId) {
+            cursor = maxId;
+            readCount = posted; // en sona kadar okundu
+        }
+        else {
+            const int64_t acked = partition::CountRange(cx().db, lastRead, cursor);
+            ok = acked >= 0;
+            if (ok) readCount += acked;
+        }
+
+        sqlite3_stmt* up = nullptr;
+        ok = ok && db_prepare(&up, "INSERT OR REPLACE INTO message_reads(user_id, last_read_id, read_count) VALUES(?1, ?2, ?3);");
+        if (up) {
+            sqlite3_bind_int(up, 1, uid);
+            sqlite3_bind_int64(up, 2, cursor);
+            sqlite3_bind_int64(up, 3, readCount);
+            ok = sqlite3_step(up) == SQLITE_DONE;
+            sqlite3_finalize(up);
+        }
+    }
+
+    db_exec(ok ? "COMMIT;" : "ROLLBACK;");
+    return ok;
+}
+
+int LS_UnreadMessageCount(LSContext& ctx) {
+    ContextScope scope(ctx);
+    return unreadMessageCount();
+}
+
+bool LS_MarkMessagesRead(LSContext& ctx, uint32_t upToId) {
+    ContextScope scope(ctx);
+    return markMessagesRead(upToId);
+}
+
+// =================== MESSAGE FEED ===================
+// id > afterId olan en fazla limit mesaj; yalnızca imleçten yeni bölümler okunur, dönen sayfa çözülür
+static int fetchMessagesPage(uint32_t afterId, Message* page, int limit) {
+    if (!cx().db || !page || limit <= 0) return -1;
+    int n = 0;
+    int rc = partition::ForEachAfter(cx().db, afterId, limit, [&](int64_t id, const char* dt, const char* tx) {
+        std::string dec = decryptMaybe(tx ? tx : "");
+        Message& m = page[n++];
+        m.id = static_cast<uint32_t>(id);
+        copyTo(m.datetime, sizeof(m.datetime), dt ? dt : "");
+        copyTo(m.text, sizeof(m.text), dec);
+        secure_clear_string(dec);
+    });
+    return rc < 0 ? -1 : n;
+}
+
+// =================== MESSAGE SEARCH ===================
+static const int SEARCH_BACKFILL_BATCH = 500;
+
+static int searchMessages(const std::string& query, Message* page, int limit) {
+    if (!cx().db || !page || limit <= 0 || !cx().searchKey) return -1;
+
+    // Eski mesajlar: her batch ayrı transaction, arada diğer yazmalar ilerleyebilir
+    int n = 0;
+    while ((n = search::BackfillBatch(cx().db, cx().searchKey->data(), SEARCH_BACKFILL_BATCH, decryptMaybe)) > 0) {}
+    if (n < 0) return -1;
+
+    // Yalnızca eşleşen satırlar okunur ve çözülür
+    std::vector<int64_t> ids = search::Lookup(cx().db, cx().searchKey->data(), query, limit);
+    sqlite3_stmt* st = nullptr;
+    if (!ids.empty() && !db_prepare(&st, "SELECT datetime, text FROM messages WHERE id = ?;")) return -1;
+    int found = 0;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        sqlite3_bind_int64(st, 1, ids[i]);
+        if (sqlite3_step(st) == SQLITE_ROW) {
+            const char* dt = (const char*)sqlite3_column_text(st, 0);
+            const char* tx = (const char*)sqlite3_column_text(st, 1);
+            std::string dec = decryptMaybe(tx ? tx : "");
+            Message& m = page[found++];
+            m.id = static_cast<uint32_t>(ids[i]);
+            copyTo(m.datetime, sizeof(m.datetime), dt ? dt : "");
+            copyTo(m.text, sizeof(m.text), dec);
+            secure_clear_string(dec);
+        }
+        sqlite3_reset(st);
+    }
+    sqlite3_finalize(st);
+    return found;
+}
+
+int LS_SearchMessages(LSContext& ctx, const char* query, Message* page, int limit) {
+    ContextScope scope(ctx);
+    return searchMessages(query ? query : "", page, limit);
+}
+
+void LS_SearchMessagesInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
+    std::string query = readLine("Aranacak kelimeler: ");
+    if (query.empty()) return;
+
+    std::vector<Message> page(20);
+    int n = searchMessages(query, page.data(), static_cast<int>(page.size()));
+    secure_clear_string(query);
+    if (n < 0) { out() << "HATA: Arama yapilamadi.\n"; return; }
+
+    out() << "\nID  " << std::left << std::setw(18) << "Datetime" << "Message\n";
+    out() << std::string(80, '-') << "\n";
+    for (int i = 0; i < n; ++i) {
+        out() << std::left << std::setw(4) << page[i].id << std::setw(18) << page[i].datetime << page[i].text << "\n";
+        SecureBuffer::secure_bzero(page[i].text, sizeof(page[i].text));
+    }
+    if (n == 0) out() << "Eslesen mesaj yok.\n";
+}
+
+// =================== MESSAGE RETENTION ===================
+int LS_PurgeMessagesBefore(LSContext& ctx, const char* month) {
+    ContextScope scope(ctx);
+    if (!cx().db || !month) return -1;
+    // Düşürülen bölümlerin arama token'ları aynı SAVEPOINT'te silinir
+    const int64_t dropped = partition::DropBefore(cx().db, month);
+    return dropped < 0 ? -1 : static_cast<int>(dropped);
+}
+
+int LS_FetchMessages(LSContext& ctx, uint32_t afterId, Message* page, int limit) {
+    ContextScope scope(ctx);
+    return fetchMessagesPage(afterId, page, limit);
+}
+
+int LS_WaitForMessages(LSContext& ctx, uint32_t afterId, Message* page, int limit, int timeoutMs) {
+    ContextScope scope(ctx);
+    int n = fetchMessagesPage(afterId, page, limit);
+    if (n != 0 || timeoutMs <= 0) return n;
+
+    // Boş sayfa: yeni commit duyurulana kadar bekle, sonra tek sorgu daha (başka süreçlerin
+    // yazmaları duyurulmaz; zaman aşımında da son bir kez bakılır)
+    feed::MessageFeed().WaitBeyond(cx().dbPath, afterId, static_cast<unsigned>(timeoutMs));
+    return fetchMessagesPage(afterId, page, limit);
+}
+
+// =================== BACKUP ===================
+static void logDataEvent(const char* type, const char* description, int severity) {
+    rasp::SecurityEvent evt;
+    evt.timestamp = nowDateTime();
+    evt.eventType = type;
+    evt.description = description;
+    evt.severity = severity;
+    rasp::LogSecurityEvent(evt);
+}
+
+static bool askYesNo(const std::string& prompt) {
+    std::string a = readLine(prompt + " (e/h): ");
+    return !a.empty() && (a[0] == 'e' || a[0] == 'E');
+}
+
+void LS_BackupInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
+    if (!cx().db) { out() << "Veritabani acik degil.\n"; return; }
+    rasp::NotifySensitiveOperation("backup");
+
+    std::string path = readLine("Yedek dosyasi (bos = localsports_backup.db): ");
+    if (path.empty()) path = "localsports_backup.db";
+
+    backup::BackupOptions opts;
+    opts.encrypt = askYesNo("Sifrelensin mi?");
+    opts.compress = askYesNo("Sikistirilsin mi?");
+    const SecureBuffer* backupKey = contextSubkey("localsports/backup/v1");
+    if (opts.encrypt && !backupKey) {
+        out() << "HATA: Yedek anahtari hazir degil.\n";
         return;
+    }
+    opts.key = backupKey ? backupKey->data() : nullptr;
+    std::ostream& progressOut = out(); // geri çağrı yedekleme thread'inde çalışır; bağlam orada bağlı değil
+    opts.onProgress = [&progressOut](const backup::BackupProgress& p) {
+        if (p.totalPages > 0) {
+            int done = p.totalPages - p.remainingPages;
+            progressOut << "\r  Ilerleme: " << done << "/" << p.totalPages << " sayfa" << std::flush;
+        }
+    };
 
-    sqlite3_bind_text(ins, 1, dt.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(ins, 2, enc.c_str(), -1, SQLITE_TRANSIENT);
+    // Kaynak olarak kendi bağlantımız: arka plan adımları arasında menü yazmaları bloklanmaz
+    backup::BackupJob job;
+    if (!job.StartBackup(cx().db, path, opts)) {
+        out() << "Yedekleme baslatilamadi.\n";
+        return;
+    }
+    backup::BackupStatus st = job.Wait();
+    out() << "\n";
+    if (st == backup::BackupStatus::SUCCEEDED) {
+        out() << "Yedek olusturuldu ve dogrulandi: " << path << "\n";
+        logDataEvent("BACKUP", "Veritabani yedegi olusturuldu", 1);
+    }
+    else {
+        out() << "HATA: Yedekleme basarisiz: " << job.LastError() << "\n";
+    }
+}
 
-    if (sqlite3_step(ins) == SQLITE_DONE) {
-        std::cout << "Mesaj kaydedildi.\n";
+void LS_RestoreInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
+    if (!cx().db) { out() << "Veritabani acik degil.\n"; return; }
+    rasp::NotifySensitiveOperation("restore");
+
+    std::string path = readLine("Geri yuklenecek yedek dosyasi: ");
+    if (path.empty()) return;
+    // Sayfa şifreli DB'nin yedeği de aynı VFS ile yazılır; varsayılan VFS onu okuyamaz
+    const SecureBuffer* backupKey = contextSubkey("localsports/backup/v1");
+    const unsigned char* key = backupKey ? backupKey->data() : nullptr;
+    if (!backup::VerifyBackup(path, pagevfs::VfsNameOf(cx().db), key)) {
+        out() << "HATA: Yedek dogrulanamadi (bozuk, eksik veya anahtar hatali).\n";
+        return;
+    }
+    if (!askYesNo("Mevcut veriler yedekle degistirilecek. Emin misiniz?")) return;
+
+    backup::BackupOptions opts;
+    opts.verify = false; // VerifyBackup zaten yapıldı
+    opts.key = key;
+    if (!backup::RunRestore(cx().db, path, opts)) {
+        out() << "HATA: Geri yukleme basarisiz.\n";
+        return;
+    }
+
+    if (isHybridDb(cx().db)) cx().hybrid.Checkpoint(); // backup API log'a düşmez; görüntü hemen diske
+    invalidateRosterCache();
+    logDataEvent("RESTORE", "Veritabani yedekten geri yuklendi", 2);
+    out() << "Geri yukleme tamamlandi. Guvenlik icin oturum kapatiliyor.\n";
+    LS_AuthLogout(cx());
+}
+
+static void printVerifierStatus() {
+    if (!cx().verifier.IsRunning()) return;
+    pagevfs::VerifierStats v = cx().verifier.Stats();
+    out() << "Sayfa dogrulama    : " << v.pagesChecked << " sayfa, " << v.sweeps << " tur, "
+          << v.mismatches << " bozuk" << std::fixed << std::setprecision(2) << " (" << v.totalMs << " ms)\n";
+}
+
+void LS_MaintenanceStatusInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
+    if (isHybridDb(cx().db)) {
+        hybrid::HybridStats h = cx().hybrid.Stats();
+        out() << "Mod                : bellek (hibrit)\n"
+                  << "Disk dosyasi       : " << cx().hybrid.DiskPath() << "\n"
+                  << "Log'a yazilan      : " << h.loggedTx << " commit (" << h.logBytes << " bayt)\n"
+                  << "Son commit / disk  : " << h.lastSeq << " / " << h.checkpointSeq << "\n"
+                  << "Checkpoint         : " << h.checkpoints
+                  << std::fixed << std::setprecision(2) << " (son " << h.lastCheckpointMs << " ms)\n"
+                  << "Acilista replay    : " << h.replayedTx << " commit, " << h.replayErrors << " hata\n";
+        printVerifierStatus();
+        return;
+    }
+    if (!cx().maint.IsRunning()) { out() << "Bakim zamanlayicisi calismiyor.\n"; return; }
+
+    maintenance::MaintenanceStats s = cx().maint.Stats();
+    out() << "WAL boyutu         : " << cx().maint.WalFileBytes() << " bayt\n"
+              << "PASSIVE checkpoint : " << s.passiveCheckpoints << "\n"
+              << "TRUNCATE checkpoint: " << s.truncateCheckpoints << "\n"
+              << "optimize           : " << s.optimizeRuns << "\n"
+              << "incremental_vacuum : " << s.vacuumRuns << "\n"
+              << "Ertelenen (BUSY)   : " << s.busySkips << "\n"
+              << std::fixed << std::setprecision(2)
+              << "Toplam sure        : " << s.totalMs << " ms (en uzun " << s.maxMs << " ms)\n"
+              << "Ayrinti            : " << MAINT_LOG_PATH << "\n";
+    printVerifierStatus();
+}
+
+// =================== SEASON ARCHIVE ===================
+static int currentYear() {
+    std::time_t t = std::time(nullptr);
+    std::tm tmv{};
+#if defined(_WIN32)
+    localtime_s(&tmv, &t);
+#else
+    localtime_r(&t, &tmv);
+#endif
+    return tmv.tm_year + 1900;
+}
+
+void LS_ArchiveSeasonInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
+    if (!cx().db) { out() << "Veritabani acik degil.\n"; return; }
+    rasp::NotifySensitiveOperation("bulk-export");
+
+    std::vector<archive::SeasonInfo> seasons = archive::ListSeasons(cx().db, currentYear());
+    out() << "\nSezon  Mac   Oynanmamis  Durum\n";
+    out() << std::string(40, '-') << "\n";
+    for (size_t i = 0; i < seasons.size(); ++i) {
+        out() << std::left << std::setw(7) << seasons[i].season
+            << std::setw(6) << seasons[i].games
+            << std::setw(12) << seasons[i].unplayed
+            << (seasons[i].closed ? "kapali" : "acik") << "\n";
+    }
+    std::vector<archive::ArchiveEntry> archived = archive::ListArchives(cx().db);
+    for (size_t i = 0; i < archived.size(); ++i) {
+        out() << "  [arsiv] " << archived[i].season << " -> " << archived[i].path << "\n";
+    }
+
+    std::string season = readLine("Arsivlenecek sezon (YYYY, bos = iptal): ");
+    if (season.empty()) return;
+
+    archive::ArchiveEntry entry;
+    if (!archive::ArchiveSeason(cx().db, cx().dbPath, season, currentYear(), &entry)) {
+        out() << "HATA: Sezon arsivlenemedi.\n";
+        return;
+    }
+    out() << "Arsivlendi: " << entry.games << " mac, " << entry.stats << " istatistik, "
+        << entry.messages << " mesaj -> " << entry.path << "\n";
+}
+
+// =================== TENANT ROUTING ===================
+void LS_ConfigureTenants(LSContext& ctx, const char* baseDir, int maxOpen) {
+    ContextScope scope(ctx);
+    tenant::RouterConfig cfg;
+    if (baseDir && *baseDir) cfg.baseDir = baseDir;
+    if (maxOpen > 0) cfg.maxOpen = static_cast<size_t>(maxOpen);
+    cfg.setup = configureConnection;
+    if (cx().dbVfs) cfg.vfs = cx().dbVfs;
+
+    // Aktif kiracı bağlantısı eski router ile kapanır; yeniden LS_SelectTenant gerekir
+    const bool hadTenant = static_cast<bool>(cx().tenantLease);
+    cx().verifier.Stop();
+    cx().maint.Stop();
+    cx().tenantLease.Release();
+    if (hadTenant) cx().db = nullptr;
+    delete cx().router;
+    cx().router = new tenant::TenantRouter(cfg);
+}
+
+bool LS_SelectTenant(LSContext& ctx, const char* tenantId) {
+    ContextScope scope(ctx);
+    if (!tenantId || !*tenantId) {
+        // Varsayılan (tek kulüp) veritabanına dön
+        if (!cx().tenantLease) return true;
+        cx().verifier.Stop();
+        cx().maint.Stop();
+        cx().tenantLease.Release();
+        cx().isAuthed = false;
+        cx().currentUserId = 0;
+        cx().currentUser[0] = '\0';
+        openDefaultDatabase();
+        initDatabase();
+        return true;
+    }
+    if (!tenant::TenantRouter::IsValidTenantId(tenantId)) {
+        out() << "Gecersiz kulup kimligi (a-z, 0-9, _ ve - kullanin).\n";
+        return false;
+    }
+    if (!cx().router) {
+        const char* dir = std::getenv("LS_TENANT_DIR");
+        LS_ConfigureTenants(cx(), dir, 0);
+    }
+
+    tenant::TenantLease lease = cx().router->Acquire(tenantId);
+    if (!lease) return false;
+
+    // Eski bağlantının bakımı durdurulur; varsayılan DB ise kapatılır, kiracı ise pin'i bırakılır
+    cx().verifier.Stop();
+    cx().maint.Stop();
+    if (!cx().tenantLease) closeDefaultDatabase();
+    cx().tenantLease = std::move(lease);
+    cx().db = cx().tenantLease.Db();
+    cx().dbPath = cx().router->PathFor(tenantId);
+
+    // Oturum kiracıya aittir: kiracı değişince yeniden giriş gerekir
+    cx().isAuthed = false;
+    cx().currentUserId = 0;
+    cx().currentUser[0] = '\0';
+    initDatabase();
+    return true;
+}
+
+void LS_SelectTenantInteractive(LSContext& ctx) {
+    ContextScope scope(ctx);
+    std::string id = readLine("Kulup kimligi (ornek: fc_ankara): ");
+    if (id.empty()) return;
+    if (LS_SelectTenant(cx(), id.c_str())) {
+        out() << "Aktif kulup: " << id << "\n";
     }
     else {
-        std::cout << "HATA: Kaydedilemedi.\n";
+        out() << "HATA: Kulup veritabani acilamadi.\n";
     }
-    sqlite3_finalize(ins);
 }
+
+const char* LS_CurrentTenant(LSContext& ctx) {
+    ContextScope scope(ctx);
+    return cx().tenantLease ? cx().tenantLease.TenantId().c_str() : nullptr;
+}
+
+// =================== Default Context Wrappers ===================
+// Eski imzalar süreç geneli varsayılan bağlama yönlendirilir
+void LS_SetEncryptionMode(LSEncryptionMode mode) { LS_SetEncryptionMode(LS_DefaultContext(), mode); }
+void LS_SetPageChecksums(bool enabled) { LS_SetPageChecksums(LS_DefaultContext(), enabled); }
+bool LS_GetPageChecksums() { return LS_GetPageChecksums(LS_DefaultContext()); }
+LSEncryptionMode LS_GetEncryptionMode() { return LS_GetEncryptionMode(LS_DefaultContext()); }
+void LS_SetDatabasePath(const char* path) { LS_SetDatabasePath(LS_DefaultContext(), path); }
+const char* LS_GetDatabasePath() { return LS_GetDatabasePath(LS_DefaultContext()); }
+void LS_SetStorageMode(LSStorageMode mode) { LS_SetStorageMode(LS_DefaultContext(), mode); }
+LSStorageMode LS_GetStorageMode() { return LS_GetStorageMode(LS_DefaultContext()); }
+void LS_Init() { LS_Init(LS_DefaultContext()); }
+bool LS_Preload() { return LS_Preload(LS_DefaultContext()); }
+bool LS_AuthLoginInteractive() { return LS_AuthLoginInteractive(LS_DefaultContext()); }
+void LS_AuthRegisterInteractive() { LS_AuthRegisterInteractive(LS_DefaultContext()); }
+void LS_AuthLogout() { LS_AuthLogout(LS_DefaultContext()); }
+bool LS_IsAuthenticated() { return LS_IsAuthenticated(LS_DefaultContext()); }
+const char* LS_CurrentUsername() { return LS_CurrentUsername(LS_DefaultContext()); }
+void LS_ListPlayersInteractive() { LS_ListPlayersInteractive(LS_DefaultContext()); }
+void LS_AddPlayerInteractive() { LS_AddPlayerInteractive(LS_DefaultContext()); }
+void LS_EditPlayerInteractive() { LS_EditPlayerInteractive(LS_DefaultContext()); }
+void LS_RemovePlayerInteractive() { LS_RemovePlayerInteractive(LS_DefaultContext()); }
+void LS_ListGamesInteractive() { LS_ListGamesInteractive(LS_DefaultContext()); }
+void LS_AddGameInteractive() { LS_AddGameInteractive(LS_DefaultContext()); }
+void LS_RecordResultInteractive() { LS_RecordResultInteractive(LS_DefaultContext()); }
+void LS_RecordStatsInteractive() { LS_RecordStatsInteractive(LS_DefaultContext()); }
+void LS_ViewPlayerTotalsInteractive() { LS_ViewPlayerTotalsInteractive(LS_DefaultContext()); }
+void LS_ViewAllSeasonTotalsInteractive() { LS_ViewAllSeasonTotalsInteractive(LS_DefaultContext()); }
+void LS_ListMessagesInteractive() { LS_ListMessagesInteractive(LS_DefaultContext()); }
+void LS_AddMessageInteractive() { LS_AddMessageInteractive(LS_DefaultContext()); }
+int LS_UnreadMessageCount() { return LS_UnreadMessageCount(LS_DefaultContext()); }
+bool LS_MarkMessagesRead(uint32_t upToId) { return LS_MarkMessagesRead(LS_DefaultContext(), upToId); }
+int LS_SearchMessages(const char* query, Message* page, int limit) { return LS_SearchMessages(LS_DefaultContext(), query, page, limit); }
+void LS_SearchMessagesInteractive() { LS_SearchMessagesInteractive(LS_DefaultContext()); }
+int LS_PurgeMessagesBefore(const char* month) { return LS_PurgeMessagesBefore(LS_DefaultContext(), month); }
+int LS_FetchMessages(uint32_t afterId, Message* page, int limit) { return LS_FetchMessages(LS_DefaultContext(), afterId, page, limit); }
+int LS_WaitForMessages(uint32_t afterId, Message* page, int limit, int timeoutMs) { return LS_WaitForMessages(LS_DefaultContext(), afterId, page, limit, timeoutMs); }
+void LS_BackupInteractive() { LS_BackupInteractive(LS_DefaultContext()); }
+void LS_RestoreInteractive() { LS_RestoreInteractive(LS_DefaultContext()); }
+void LS_MaintenanceStatusInteractive() { LS_MaintenanceStatusInteractive(LS_DefaultContext()); }
+void LS_ArchiveSeasonInteractive() { LS_ArchiveSeasonInteractive(LS_DefaultContext()); }
+void LS_ConfigureTenants(const char* baseDir, int maxOpen) { LS_ConfigureTenants(LS_DefaultContext(), baseDir, maxOpen); }
+bool LS_SelectTenant(const char* tenantId) { return LS_SelectTenant(LS_DefaultContext(), tenantId); }
+void LS_SelectTenantInteractive() { LS_SelectTenantInteractive(LS_DefaultContext()); }
+const char* LS_CurrentTenant() { return LS_CurrentTenant(LS_DefaultContext()); }
@@ -0,0 +1,234 @@
+// src/maintenance.cpp
+// Arka plan WAL checkpoint ve bakım zamanlayıcısı
+
+#include "maintenance.h"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include <sqlite3.h>
+
+namespace teamcore {
+namespace maintenance {
+
+    // =================== Helper Functions ===================
+    static int64_t NowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static double ElapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    static int QueryInt(sqlite3* db, const char* sql, int fallback) {
+        sqlite3_stmt* st = nullptr;
+        int v = fallback;
+        if (sqlite3_prepare_v2(db, sql, -1, &st, nullptr) == SQLITE_OK && sqlite3_step(st) == SQLITE_ROW) {
+            v = sqlite3_column_int(st, 0);
+        }
+        sqlite3_finalize(st);
+        return v;
+    }
+
+    static void DefaultSink(const TaskTiming& t) {
+        std::clog << "[MAINT] " << t.task
+                  << " ms=" << std::fixed << std::setprecision(2) << t.ms
+                  << " rc=" << t.rc
+                  << " before=" << t.walFrames
+                  << " done=" << t.done << "\n";
+    }
+
+    // =================== MaintenanceScheduler ===================
+    MaintenanceScheduler::MaintenanceScheduler()
+        : appDb_(nullptr), maintDb_(nullptr), running_(false), walPages_(0), lastActivityMs_(0) {}
+
+    MaintenanceScheduler::~MaintenanceScheduler() {
+        Stop();
+    }
+
+    bool MaintenanceScheduler::Start(sqlite3* appDb, const std::string& dbPath,
+                                     const MaintenanceConfig& config, TimingSink sink) {
+        if (!appDb || dbPath.empty() || running_.load()) return false;
+
+        // Uygulama bağlantısıyla aynı VFS (sayfa şifreleyen VFS'te checkpoint sayfaları çözebilmeli)
+        sqlite3_vfs* vfs = nullptr;
+        sqlite3_file_control(appDb, "main", SQLITE_FCNTL_VFS_POINTER, &vfs);
+        if (sqlite3_open_v2(dbPath.c_str(), &maintDb_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_FULLMUTEX,
+                            vfs ? vfs->zName : nullptr) != SQLITE_OK) {
+            std::cerr << "Bakim baglantisi acilamadi: " << (maintDb_ ? sqlite3_errmsg(maintDb_) : "(null)") << "\n";
+            sqlite3_close(maintDb_);
+            maintDb_ = nullptr;
+            return false;
+        }
+        sqlite3_busy_timeout(maintDb_, config.busyTimeoutMs);
+        // optimize içindeki ANALYZE'ın tablo başına maliyetini sınırla
+        sqlite3_exec(maintDb_, "PRAGMA analysis_limit=400;", nullptr, nullptr, nullptr);
+        // Şemayı bir kez oku: bağlantı WAL'i ancak ilk okumada açar, aksi halde checkpoint boş döner
+        sqlite3_exec(maintDb_, "PRAGMA journal_mode;", nullptr, nullptr, nullptr);
+
+        appDb_ = appDb;
+        dbPath_ = dbPath;
+        config_ = config;
+        sink_ = sink ? sink : TimingSink(DefaultSink);
+        {
+            std::lock_guard<std::mutex> lock(statsMutex_);
+            stats_ = MaintenanceStats();
+        }
+        walPages_.store(0);
+        lastActivityMs_.store(NowMs());
+        lastOptimize_ = lastVacuum_ = Clock::now();
+
+        // wal_hook, otomatik checkpoint'in yerini alır: commit eden istek artık checkpoint yapmaz
+        sqlite3_wal_hook(appDb_, &MaintenanceScheduler::WalHook, this);
+
+        running_.store(true);
+        worker_ = std::thread(&MaintenanceScheduler::Loop, this);
+        return true;
+    }
+
+    void MaintenanceScheduler::Stop() {
+        if (!running_.exchange(false)) return;
+        {
+            std::lock_guard<std::mutex> lock(waitMutex_);
+        }
+        wake_.notify_all();
+        if (worker_.joinable()) worker_.join();
+
+        sqlite3_wal_autocheckpoint(appDb_, 1000); // SQLite varsayılanı; kendi wal_hook'unu kurar
+        std::lock_guard<std::mutex> lock(taskMutex_);
+        sqlite3_close(maintDb_);
+        maintDb_ = nullptr;
+        appDb_ = nullptr;
+    }
+
+    void MaintenanceScheduler::NotifyActivity() {
+        lastActivityMs_.store(NowMs());
+    }
+
+    int MaintenanceScheduler::WalHook(void* self, sqlite3*, const char*, int walPages) {
+        MaintenanceScheduler* s = static_cast<MaintenanceScheduler*>(self);
+        s->walPages_.store(walPages);
+        s->NotifyActivity();
+        if (walPages >= s->config_.busyCheckpointPages) s->wake_.notify_one();
+        return SQLITE_OK;
+    }
+
+    void MaintenanceScheduler::Loop() {
+        while (running_.load()) {
+            {
+                std::unique_lock<std::mutex> lock(waitMutex_);
+                wake_.wait_for(lock, std::chrono::milliseconds(config_.pollMs),
+                               [this] { return !running_.load(); });
+            }
+            if (!running_.load()) break;
+            Tick();
+        }
+    }
+
+    void MaintenanceScheduler::Tick() {
+        const bool idle = NowMs() - lastActivityMs_.load() >= config_.idleMs;
+        const int64_t walBytes = WalFileBytes();
+
+        // WAL çok büyüdü: TRUNCATE (boşta iken, ya da eşiğin iki katını aştıysa hemen)
+        if (walBytes >= config_.walTruncateBytes && (idle || walBytes >= 2 * config_.walTruncateBytes)) {
+            RunTruncateCheckpoint();
+        }
+        else if (walPages_.load() > 0 && (idle || walPages_.load() >= config_.busyCheckpointPages)) {
+            RunPassiveCheckpoint();
+        }
+
+        if (!idle) return;
+        if (Clock::now() - lastOptimize_ >= std::chrono::milliseconds(config_.optimizeIntervalMs)) {
+            RunOptimize();
+        }
+        if (Clock::now() - lastVacuum_ >= std::chrono::milliseconds(config_.vacuumIntervalMs)) {
+            RunIncrementalVacuum();
+        }
+    }
+
+    int MaintenanceScheduler::Checkpoint(int mode, const char* task) {
+        std::lock_guard<std::mutex> lock(taskMutex_);
+        if (!maintDb_) return SQLITE_MISUSE;
+
+        int nLog = 0, nCkpt = 0;
+        Clock::time_point start = Clock::now();
+        int rc = sqlite3_wal_checkpoint_v2(maintDb_, "main", mode, &nLog, &nCkpt);
+        TaskTiming t = { task, ElapsedMs(start), rc, nLog, nCkpt };
+
+        // Tüm frame'ler aktarıldıysa bekleyen iş kalmadı
+        if (rc == SQLITE_OK && nCkpt >= nLog) walPages_.store(0);
+        Record(t);
+        return rc;
+    }
+
+    int MaintenanceScheduler::RunPassiveCheckpoint() {
+        return Checkpoint(SQLITE_CHECKPOINT_PASSIVE, "checkpoint_passive");
+    }
+
+    int MaintenanceScheduler::RunTruncateCheckpoint() {
+        return Checkpoint(SQLITE_CHECKPOINT_TRUNCATE, "checkpoint_truncate");
+    }
+
+    int MaintenanceScheduler::RunOptimize() {
+        std::lock_guard<std::mutex> lock(taskMutex_);
+        if (!maintDb_) return SQLITE_MISUSE;
+
+        Clock::time_point start = Clock::now();
+        // 0x10002: bu bağlantıda sorgu geçmişi olmadığı için tüm tabloları değerlendir
+        int rc = sqlite3_exec(maintDb_, "PRAGMA optimize=0x10002;", nullptr, nullptr, nullptr);
+        TaskTiming t = { "optimize", ElapsedMs(start), rc, 0, 0 };
+        lastOptimize_ = Clock::now();
+        Record(t);
+        return rc;
+    }
+
+    int MaintenanceScheduler::RunIncrementalVacuum() {
+        std::lock_guard<std::mutex> lock(taskMutex_);
+        if (!maintDb_) return SQLITE_MISUSE;
+        lastVacuum_ = Clock::now();
+
+        // auto_vacuum=INCREMENTAL (2) değilse incremental_vacuum etkisizdir
+        if (QueryInt(maintDb_, "PRAGMA auto_vacuum;", 0) != 2) return SQLITE_OK;
+        const int freeBefore = QueryInt(maintDb_, "PRAGMA freelist_count;", 0);
+        if (freeBefore == 0) return SQLITE_OK;
+
+        Clock::time_point start = Clock::now();
+        std::string sql = "PRAGMA incremental_vacuum(" + std::to_string(config_.vacuumPages) + ");";
+        int rc = sqlite3_exec(maintDb_, sql.c_str(), nullptr, nullptr, nullptr);
+        const int freeAfter = QueryInt(maintDb_, "PRAGMA freelist_count;", freeBefore);
+        TaskTiming t = { "incremental_vacuum", ElapsedMs(start), rc, freeBefore, freeBefore - freeAfter };
+        Record(t);
+        return rc;
+    }
+
+    int64_t MaintenanceScheduler::WalFileBytes() const {
+        std::ifstream wal(dbPath_ + "-wal", std::ios::binary | std::ios::ate);
+        if (!wal) return 0;
+        std::streamoff size = wal.tellg();
+        return size > 0 ? static_cast<int64_t>(size) : 0;
+    }
+
+    MaintenanceStats MaintenanceScheduler::Stats() const {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        return stats_;
+    }
+
+    void MaintenanceScheduler::Record(const TaskTiming& t) {
+        {
+            std::lock_guard<std::mutex> lock(statsMutex_);
+            const std::string task = t.task;
+            if (t.rc == SQLITE_BUSY || t.rc == SQLITE_LOCKED) stats_.busySkips++;
+            else if (task == "checkpoint_passive") stats_.passiveCheckpoints++;
+            else if (task == "checkpoint_truncate") stats_.truncateCheckpoints++;
+            else if (task == "optimize") stats_.optimizeRuns++;
+            else if (task == "incremental_vacuum") stats_.vacuumRuns++;
+            stats_.totalMs += t.ms;
+            if (t.ms > stats_.maxMs) stats_.maxMs = t.ms;
+        }
+        if (sink_) sink_(t);
+    }
+
+} // namespace maintenance
+} // namespace teamcore
@@ -0,0 +1,41 @@
+// src/message_feed.cpp
+// Mesaj akışı: veritabanı başına son id ve long-poll bekleme
+
+#include "message_feed.h"
+
+#include <chrono>
+
+namespace teamcore {
+namespace feed {
+
+    void FeedNotifier::Publish(const std::string& key, uint64_t id) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            uint64_t& latest = latest_[key];
+            if (id <= latest) return;
+            latest = id;
+        }
+        changed_.notify_all();
+    }
+
+    uint64_t FeedNotifier::Latest(const std::string& key) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::map<std::string, uint64_t>::const_iterator it = latest_.find(key);
+        return it == latest_.end() ? 0 : it->second;
+    }
+
+    bool FeedNotifier::WaitBeyond(const std::string& key, uint64_t afterId, unsigned timeoutMs) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return changed_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&]() {
+            std::map<std::string, uint64_t>::const_iterator it = latest_.find(key);
+            return it != latest_.end() && it->second > afterId;
+        });
+    }
+
+    FeedNotifier& MessageFeed() {
+        static FeedNotifier notifier;
+        return notifier;
+    }
+
+} // namespace feed
+} // namespace teamcore
@@ -0,0 +1,246 @@
+// src/message_index.cpp
+// Şifreli mesajlarda arama: normalize kelimeler -> HMAC token -> ters indeks
+
+#include "message_index.h"
+#include "security_layer.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <sqlite3.h>
+
+namespace teamcore {
+namespace search {
+
+    static const std::size_t TOKEN_BYTES = 16;
+    static const std::size_t MIN_WORD = 2;
+
+    // =================== Tokenizer ===================
+    // İki baytlık UTF-8 Türkçe harfleri ASCII karşılığına katla; eşleşme yoksa 0
+    static char FoldTurkish(unsigned char b0, unsigned char b1) {
+        if (b0 == 0xC3) {
+            switch (b1) {
+            case 0x87: case 0xA7: return 'c'; // Ç ç
+            case 0x96: case 0xB6: return 'o'; // Ö ö
+            case 0x9C: case 0xBC: return 'u'; // Ü ü
+            }
+        }
+        else if (b0 == 0xC4) {
+            switch (b1) {
+            case 0x9E: case 0x9F: return 'g'; // Ğ ğ
+            case 0xB0: case 0xB1: return 'i'; // İ ı
+            }
+        }
+        else if (b0 == 0xC5) {
+            switch (b1) {
+            case 0x9E: case 0x9F: return 's'; // Ş ş
+            }
+        }
+        return 0;
+    }
+
+    std::vector<std::string> Tokenize(const std::string& text) {
+        std::vector<std::string> words;
+        std::string cur;
+        for (std::size_t i = 0; i <= text.size(); ++i) {
+            const unsigned char c = i < text.size() ? static_cast<unsigned char>(text[i]) : 0;
+            if (c >= 0x80 && i + 1 < text.size()) {
+                const char folded = FoldTurkish(c, static_cast<unsigned char>(text[i + 1]));
+                if (folded) {
+                    cur += folded;
+                    ++i;
+                    continue;
+                }
+                cur += static_cast<char>(c); // diğer UTF-8 baytları kelimenin parçası
+                continue;
+            }
+            if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+                cur += static_cast<char>(c);
+            }
+            else if (c >= 'A' && c <= 'Z') {
+                cur += static_cast<char>(c - 'A' + 'a');
+            }
+            else {
+                if (cur.size() >= MIN_WORD) words.push_back(cur);
+                cur.clear();
+            }
+        }
+        std::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+        return words;
+    }
+
+    std::string TokenFor(const unsigned char key32[32], const std::string& word) {
+        unsigned char mac[EVP_MAX_MD_SIZE];
+        unsigned int len = 0;
+        if (!HMAC(EVP_sha256(), key32, 32, reinterpret_cast<const unsigned char*>(word.data()), word.size(), mac, &len) ||
+            len < TOKEN_BYTES) {
+            return std::string();
+        }
+        return std::string(reinterpret_cast<const char*>(mac), TOKEN_BYTES);
+    }
+
+    // =================== Helper Functions ===================
+    static bool Exec(sqlite3* db, const char* sql) {
+        char* err = nullptr;
+        if (sqlite3_exec(db, sql, nullptr, nullptr, &err) != SQLITE_OK) {
+            std::cerr << "SQL hatasi: " << (err ? err : "(null)") << "\n";
+            sqlite3_free(err);
+            return false;
+        }
+        return true;
+    }
+
+    static sqlite3_stmt* Prepare(sqlite3* db, const std::string& sql) {
+        sqlite3_stmt* st = nullptr;
+        if (sqlite3_prepare_v2(db, sql.c_str(), -1, &st, nullptr) != SQLITE_OK) {
+            std::cerr << "prepare failed: " << sqlite3_errmsg(db) << "\n";
+            return nullptr;
+        }
+        return st;
+    }
+
+    static bool ReadState(sqlite3* db, int64_t* done, int64_t* upto) {
+        sqlite3_stmt* st = Prepare(db, "SELECT backfill_done, backfill_upto FROM message_index_state WHERE id = 1;");
+        if (!st) return false;
+        const bool ok = sqlite3_step(st) == SQLITE_ROW;
+        if (ok) {
+            *done = sqlite3_column_int64(st, 0);
+            *upto = sqlite3_column_int64(st, 1);
+        }
+        sqlite3_finalize(st);
+        return ok;
+    }
+
+    // =================== Index ===================
+    bool EnsureSchema(sqlite3* db, int64_t lastId) {
+        if (!db) return false;
+        bool ok = Exec(db,
+            "CREATE TABLE IF NOT EXISTS message_tokens ("
+            "token BLOB NOT NULL, message_id INTEGER NOT NULL, PRIMARY KEY(token, message_id)) WITHOUT ROWID;"
+            "CREATE INDEX IF NOT EXISTS idx_message_tokens_id ON message_tokens(message_id);"
+            "CREATE TABLE IF NOT EXISTS message_index_state ("
+            "id INTEGER PRIMARY KEY CHECK(id = 1), backfill_done INTEGER NOT NULL, backfill_upto INTEGER NOT NULL);");
+        sqlite3_stmt* st = ok ? Prepare(db,
+            "INSERT OR IGNORE INTO message_index_state(id, backfill_done, backfill_upto) VALUES(1, 0, ?);") : nullptr;
+        if (!st) return false;
+        sqlite3_bind_int64(st, 1, lastId);
+        ok = sqlite3_step(st) == SQLITE_DONE;
+        sqlite3_finalize(st);
+        return ok;
+    }
+
+    bool IndexMessage(sqlite3* db, const unsigned char key32[32], int64_t id, const std::string& plaintext) {
+        sqlite3_stmt* st = Prepare(db, "INSERT OR IGNORE INTO message_tokens(token, message_id) VALUES(?, ?);");
+        if (!st) return false;
+        std::vector<std::string> words = Tokenize(plaintext);
+        bool ok = true;
+        for (std::size_t i = 0; ok && i < words.size(); ++i) {
+            const std::string token = TokenFor(key32, words[i]);
+            SecureBuffer::secure_bzero(&words[i][0], words[i].size());
+            if (token.empty()) { ok = false; break; }
+            sqlite3_bind_blob(st, 1, token.data(), static_cast<int>(token.size()), SQLITE_TRANSIENT);
+            sqlite3_bind_int64(st, 2, id);
+            ok = sqlite3_step(st) == SQLITE_DONE;
+            sqlite3_reset(st);
+        }
+        sqlite3_finalize(st);
+        return ok;
+    }
+
+    bool BackfillPending(sqlite3* db) {
+        int64_t done = 0, upto = 0;
+        return ReadState(db, &done, &upto) && done < upto;
+    }
+
+    int BackfillBatch(sqlite3* db, const unsigned char key32[32], int batch, const Decryptor& decrypt) {
+        if (!db || batch <= 0) return -1;
+        if (!Exec(db, "BEGIN IMMEDIATE;")) return -1;
+        int64_t done = 0, upto = 0;
+        bool ok = ReadState(db, &done, &upto);
+        int n = 0;
+        if (ok && done < upto) {
+            sqlite3_stmt* st = Prepare(db, "SELECT id, text FROM messages WHERE id > ? AND id <= ? ORDER BY id LIMIT ?;");
+            ok = st != nullptr;
+            if (st) {
+                sqlite3_bind_int64(st, 1, done);
+                sqlite3_bind_int64(st, 2, upto);
+                sqlite3_bind_int(st, 3, batch);
+                int64_t last = done;
+                while (ok && sqlite3_step(st) == SQLITE_ROW) {
+                    last = sqlite3_column_int64(st, 0);
+                    const char* tx = reinterpret_cast<const char*>(sqlite3_column_text(st, 1));
+                    std::string plain = decrypt(tx ? tx : "");
+                    ok = IndexMessage(db, key32, last, plain);
+                    if (!plain.empty()) SecureBuffer::secure_bzero(&plain[0], plain.size());
+                    ++n;
+                }
+                sqlite3_finalize(st);
+                // Kısa sayfa: aralığın sonuna gelindi (aradaki silinmiş id'ler dahil)
+                done = n < batch ? upto : last;
+            }
+            sqlite3_stmt* up = ok ? Prepare(db, "UPDATE message_index_state SET backfill_done = ? WHERE id = 1;") : nullptr;
+            if (up) {
+                sqlite3_bind_int64(up, 1, done);
+                ok = sqlite3_step(up) == SQLITE_DONE;
+                sqlite3_finalize(up);
+            }
+            else {
+                ok = false;
+            }
+        }
+        if (!ok) {
+            Exec(db, "ROLLBACK;");
+            return -1;
+        }
+        return Exec(db, "COMMIT;") ? n : -1;
+    }
+
+    std::vector<int64_t> Lookup(sqlite3* db, const unsigned char key32[32], const std::string& query, int limit) {
+        std::vector<int64_t> ids;
+        std::vector<std::string> words = Tokenize(query);
+        if (!db || words.empty() || limit <= 0) return ids;
+
+        // Tüm kelimeler: her token'ın (token, message_id) aralığı okunur, id başına sayılır
+        std::string sql = "SELECT message_id FROM message_tokens WHERE token IN (";
+        for (std::size_t i = 0; i < words.size(); ++i) sql += i ? ",?" : "?";
+        // Silinmiş mesajların kalmış token'ları LIMIT'ten önce elenir
+        sql += ") GROUP BY message_id HAVING COUNT(*) = ? AND EXISTS (SELECT 1 FROM messages WHERE id = message_id)"
+               " ORDER BY message_id DESC LIMIT ?;";
+        sqlite3_stmt* st = Prepare(db, sql);
+        if (!st) return ids;
+        int idx = 1;
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            const std::string token = TokenFor(key32, words[i]);
+            SecureBuffer::secure_bzero(&words[i][0], words[i].size());
+            sqlite3_bind_blob(st, idx++, token.data(), static_cast<int>(token.size()), SQLITE_TRANSIENT);
+        }
+        sqlite3_bind_int(st, idx++, static_cast<int>(words.size()));
+        sqlite3_bind_int(st, idx, limit);
+        while (sqlite3_step(st) == SQLITE_ROW) ids.push_back(sqlite3_column_int64(st, 0));
+        sqlite3_finalize(st);
+        return ids;
+    }
+
+    int64_t PruneMessages(sqlite3* db, const std::string& idQuery, const std::string& param) {
+        sqlite3_stmt* st = Prepare(db,
+            "SELECT COUNT(*) FROM main.sqlite_master WHERE type = 'table' AND name = 'message_tokens';");
+        if (!st) return -1;
+        const bool indexed = sqlite3_step(st) == SQLITE_ROW && sqlite3_column_int(st, 0) > 0;
+        sqlite3_finalize(st);
+        if (!indexed) return 0;
+
+        st = Prepare(db, "DELETE FROM main.message_tokens WHERE message_id IN (" + idQuery + ");");
+        if (!st) return -1;
+        if (sqlite3_bind_parameter_count(st) > 0) {
+            sqlite3_bind_text(st, 1, param.c_str(), -1, SQLITE_TRANSIENT);
+        }
+        const bool ok = sqlite3_step(st) == SQLITE_DONE;
+        sqlite3_finalize(st);
+        return ok ? sqlite3_changes(db) : -1;
+    }
+
+} // namespace search
+} // namespace teamcore
@@ -0,0 +1,378 @@
+// src/message_partitions.cpp
+// Aylık mesaj bölümleri: UNION ALL görünümü, bölüm tetikleyicileri ve DROP TABLE ile saklama süresi
+
+#include "message_partitions.h"
+#include "message_index.h"
+
+#include <cctype>
+#include <iostream>
+
+#include <sqlite3.h>
+
+namespace teamcore {
+namespace partition {
+
+    // =================== Schema ===================
+    static const char* BASE_SCHEMA =
+        "CREATE TABLE IF NOT EXISTS message_partitions ("
+        "month TEXT PRIMARY KEY, name TEXT NOT NULL, rows INTEGER NOT NULL DEFAULT 0,"
+        "min_id INTEGER, max_id INTEGER);"
+        "CREATE TABLE IF NOT EXISTS message_seq (id INTEGER PRIMARY KEY CHECK(id = 1), last_id INTEGER NOT NULL);"
+        "INSERT OR IGNORE INTO message_seq(id, last_id) VALUES(1, 0);"
+        "CREATE TABLE IF NOT EXISTS message_counters (id INTEGER PRIMARY KEY CHECK(id = 1), posted INTEGER NOT NULL);"
+        // ordinal: eklenen her mesaja verilen artan sıra; gap_id: bu id'ye kadar sıra id sırasıyla örtüşmeyebilir
+        "CREATE TABLE IF NOT EXISTS message_ordinals (id INTEGER PRIMARY KEY CHECK(id = 1),"
+        " ordinal INTEGER NOT NULL, gap_id INTEGER NOT NULL);"
+        "INSERT OR IGNORE INTO message_ordinals(id, ordinal, gap_id) SELECT 1, 0, last_id FROM message_seq WHERE id = 1;"
+        "CREATE TABLE IF NOT EXISTS message_reads ("
+        "user_id INTEGER PRIMARY KEY, last_read_id INTEGER NOT NULL DEFAULT 0, read_count INTEGER NOT NULL DEFAULT 0);"
+        "CREATE INDEX IF NOT EXISTS idx_message_reads_cursor ON message_reads(last_read_id);";
+
+    static const char* INVALID_MONTH = "0000-00";
+
+    // =================== Helper Functions ===================
+    static bool Exec(sqlite3* db, const std::string& sql) {
+        char* err = nullptr;
+        if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &err) != SQLITE_OK) {
+            std::cerr << "SQL hatasi: " << (err ? err : "(null)") << "\n";
+            sqlite3_free(err);
+            return false;
+        }
+        return true;
+    }
+
+    static sqlite3_stmt* Prepare(sqlite3* db, const std::string& sql) {
+        sqlite3_stmt* st = nullptr;
+        if (sqlite3_prepare_v2(db, sql.c_str(), -1, &st, nullptr) != SQLITE_OK) {
+            std::cerr << "prepare failed: " << sqlite3_errmsg(db) << "\n";
+            return nullptr;
+        }
+        return st;
+    }
+
+    static int64_t QueryInt64(sqlite3* db, const std::string& sql, int64_t fallback) {
+        sqlite3_stmt* st = Prepare(db, sql);
+        if (!st) return fallback;
+        int64_t v = fallback;
+        if (sqlite3_step(st) == SQLITE_ROW && sqlite3_column_type(st, 0) != SQLITE_NULL) v = sqlite3_column_int64(st, 0);
+        sqlite3_finalize(st);
+        return v;
+    }
+
+    static bool StepDone(sqlite3* db, sqlite3_stmt* st) {
+        if (!st) return false;
+        const bool ok = sqlite3_step(st) == SQLITE_DONE;
+        if (!ok) std::cerr << "SQL hatasi: " << sqlite3_errmsg(db) << "\n";
+        sqlite3_finalize(st);
+        return ok;
+    }
+
+    // Ay anahtarı tablo adında kullanıldığı için yalnızca "YYYY-MM" (rakamlar) kabul edilir
+    static std::string MonthOf(const std::string& datetime) {
+        if (datetime.size() < 7 || datetime[4] != '-') return INVALID_MONTH;
+        for (int i = 0; i < 7; ++i) {
+            if (i != 4 && !std::isdigit(static_cast<unsigned char>(datetime[i]))) return INVALID_MONTH;
+        }
+        return datetime.substr(0, 7);
+    }
+
+    static std::string TableFor(const std::string& month) {
+        return "messages_p" + month.substr(0, 4) + month.substr(5, 2);
+    }
+
+    static std::string Quote(const std::string& s) {
+        return "'" + s + "'"; // yalnızca MonthOf'tan geçmiş ay anahtarları için
+    }
+
+    // Mesajın ekleme sırası; mesaj yoksa ya da sırası atanmamışsa (eski satır) -1
+    static int64_t OrdinalOf(sqlite3* db, int64_t id) {
+        sqlite3_stmt* st = Prepare(db, "SELECT ord FROM messages WHERE id = ?;");
+        if (!st) return -1;
+        sqlite3_bind_int64(st, 1, id);
+        int64_t v = -1;
+        if (sqlite3_step(st) == SQLITE_ROW && sqlite3_column_type(st, 0) != SQLITE_NULL) v = sqlite3_column_int64(st, 0);
+        sqlite3_finalize(st);
+        return v;
+    }
+
+    static bool Savepoint(sqlite3* db) { return Exec(db, "SAVEPOINT ls_partition;"); }
+
+    static bool Finish(sqlite3* db, bool ok) {
+        if (!ok) Exec(db, "ROLLBACK TO ls_partition;");
+        return Exec(db, "RELEASE ls_partition;") && ok;
+    }
+
+    // =================== View ===================
+    static bool RebuildView(sqlite3* db) {
+        std::vector<PartitionInfo> parts = ListPartitions(db);
+        std::string view = "CREATE VIEW messages(id, datetime, text, ord) AS ";
+        std::string del = "CREATE TRIGGER messages_instead_delete INSTEAD OF DELETE ON messages BEGIN ";
+        // Mevcut aylar yönlendirilir; bölümü olmayan ay için hata (bölümü InsertMessage açar)
+        std::string ins = "CREATE TRIGGER messages_instead_insert INSTEAD OF INSERT ON messages BEGIN "
+            "SELECT RAISE(ABORT, 'messages: partition missing') WHERE NOT EXISTS "
+            "(SELECT 1 FROM message_partitions WHERE month = substr(NEW.datetime, 1, 7));";
+        if (parts.empty()) {
+            view += "SELECT CAST(NULL AS INTEGER), CAST(NULL AS TEXT), CAST(NULL AS TEXT), CAST(NULL AS INTEGER) WHERE 0";
+        }
+        for (std::size_t i = 0; i < parts.size(); ++i) {
+            if (i) view += " UNION ALL ";
+            view += "SELECT id, datetime, text, ord FROM " + parts[i].table;
+            del += "DELETE FROM " + parts[i].table + " WHERE id = OLD.id;";
+            ins += "INSERT INTO " + parts[i].table + "(id, datetime, text) "
+                "SELECT COALESCE(NEW.id, (SELECT last_id + 1 FROM message_seq WHERE id = 1)), NEW.datetime, NEW.text "
+                "WHERE substr(NEW.datetime, 1, 7) = " + Quote(parts[i].month) + ";";
+        }
+        del += parts.empty() ? "SELECT 1; END;" : "END;";
+        ins += "END;";
+        return Exec(db, "DROP VIEW IF EXISTS messages;") && Exec(db, view + ";") &&
+               Exec(db, del) && Exec(db, ins);
+    }
+
+    // =================== Partitions ===================
+    static bool CreatePartition(sqlite3* db, const std::string& month) {
+        const std::string t = TableFor(month);
+        const std::string m = Quote(month);
+        std::string sql =
+            "CREATE TABLE IF NOT EXISTS " + t + " (id INTEGER PRIMARY KEY, datetime TEXT NOT NULL, text TEXT NOT NULL, ord INTEGER);"
+            "CREATE TRIGGER IF NOT EXISTS " + t + "_ai AFTER INSERT ON " + t + " BEGIN "
+            // Sıra dışı (last_id'den küçük) id, o ana kadarki aralığın sıralarını id sırasından koparır
+            "UPDATE message_ordinals SET ordinal = ordinal + 1, gap_id = MAX(gap_id, "
+            "(SELECT CASE WHEN NEW.id <= last_id THEN last_id ELSE 0 END FROM message_seq WHERE id = 1)) WHERE id = 1;"
+            "UPDATE " + t + " SET ord = (SELECT ordinal FROM message_ordinals WHERE id = 1) WHERE id = NEW.id;"
+            "UPDATE message_seq SET last_id = MAX(last_id, NEW.id) WHERE id = 1;"
+            "UPDATE message_counters SET posted = posted + 1 WHERE id = 1;"
+            "UPDATE message_partitions SET rows = rows + 1,"
+            " min_id = MIN(COALESCE(min_id, NEW.id), NEW.id), max_id = MAX(COALESCE(max_id, NEW.id), NEW.id)"
+            " WHERE month = " + m + "; END;"
+            "CREATE TRIGGER IF NOT EXISTS " + t + "_ad AFTER DELETE ON " + t + " BEGIN "
+            "UPDATE message_counters SET posted = posted - 1 WHERE id = 1;"
+            "UPDATE message_ordinals SET gap_id = MAX(gap_id, OLD.id) WHERE id = 1;"
+            "UPDATE message_reads SET read_count = read_count - 1 WHERE last_read_id >= OLD.id;"
+            "UPDATE message_partitions SET rows = rows - 1 WHERE month = " + m + "; END;"
+            "INSERT OR IGNORE INTO message_partitions(month, name) VALUES(" + m + ", '" + t + "');";
+        return Exec(db, sql);
+    }
+
+    static bool HasPartition(sqlite3* db, const std::string& month) {
+        sqlite3_stmt* st = Prepare(db, "SELECT 1 FROM message_partitions WHERE month = ?;");
+        if (!st) return false;
+        sqlite3_bind_text(st, 1, month.c_str(), -1, SQLITE_TRANSIENT);
+        const bool found = sqlite3_step(st) == SQLITE_ROW;
+        sqlite3_finalize(st);
+        return found;
+    }
+
+    // Bölümü tablo olarak düşür; okuma imleçleri yalnızca bölüm aralığındaysa sayılır
+    static bool DropPartition(sqlite3* db, const PartitionInfo& p) {
+        bool ok = true;
+        if (p.rows > 0) {
+            // Arama token'ları bölümle aynı SAVEPOINT'te silinir
+            ok = search::PruneMessages(db, "SELECT id FROM " + p.table, std::string()) >= 0;
+            sqlite3_stmt* st = ok ? Prepare(db,
+                "UPDATE message_reads SET read_count = read_count - CASE WHEN last_read_id >= ?2 THEN ?3 "
+                "ELSE (SELECT COUNT(*) FROM " + p.table + " WHERE id <= message_reads.last_read_id) END "
+                "WHERE last_read_id >= ?1;") : nullptr;
+            if (st) {
+                sqlite3_bind_int64(st, 1, p.minId);
+                sqlite3_bind_int64(st, 2, p.maxId);
+                sqlite3_bind_int64(st, 3, p.rows);
+            }
+            ok = StepDone(db, st);
+            st = ok ? Prepare(db, "UPDATE message_counters SET posted = posted - ? WHERE id = 1;") : nullptr;
+            if (st) sqlite3_bind_int64(st, 1, p.rows);
+            ok = ok && StepDone(db, st);
+            st = ok ? Prepare(db, "UPDATE message_ordinals SET gap_id = MAX(gap_id, ?) WHERE id = 1;") : nullptr;
+            if (st) sqlite3_bind_int64(st, 1, p.maxId);
+            ok = ok && StepDone(db, st);
+        }
+        return ok && Exec(db, "DROP TABLE IF EXISTS " + p.table + ";") &&
+               Exec(db, "DELETE FROM message_partitions WHERE month = " + Quote(p.month) + ";");
+    }
+
+    // ord sütunu olmayan bölüm: sütun eklenir, tetikleyiciler yeniden kurulur (eski satırların sırası NULL kalır)
+    static bool HasOrdinal(sqlite3* db, const PartitionInfo& p) {
+        return QueryInt64(db, "SELECT COUNT(*) FROM pragma_table_info('" + p.table + "') WHERE name = 'ord';", 0) > 0;
+    }
+
+    static bool UpgradePartition(sqlite3* db, const PartitionInfo& p) {
+        return Exec(db, "ALTER TABLE " + p.table + " ADD COLUMN ord INTEGER;"
+                        "DROP TRIGGER IF EXISTS " + p.table + "_ai;"
+                        "DROP TRIGGER IF EXISTS " + p.table + "_ad;") &&
+               CreatePartition(db, p.month);
+    }
+
+    // Eski şema: tek tablo ay ay bölümlere kopyalanır, id'ler ve AUTOINCREMENT sırası korunur
+    static bool MigrateLegacyTable(sqlite3* db) {
+        int64_t lastId = QueryInt64(db, "SELECT COALESCE(MAX(id), 0) FROM messages;", 0);
+        if (QueryInt64(db, "SELECT COUNT(*) FROM sqlite_master WHERE name = 'sqlite_sequence';", 0) > 0) {
+            const int64_t seq = QueryInt64(db, "SELECT seq FROM sqlite_sequence WHERE name = 'messages';", 0);
+            if (seq > lastId) lastId = seq;
+        }
+
+        std::vector<std::string> raw;
+        sqlite3_stmt* st = Prepare(db, "SELECT DISTINCT substr(datetime, 1, 7) FROM messages;");
+        if (!st) return false;
+        while (sqlite3_step(st) == SQLITE_ROW) {
+            const char* v = reinterpret_cast<const char*>(sqlite3_column_text(st, 0));
+            raw.push_back(v ? v : "");
+        }
+        sqlite3_finalize(st);
+
+        // Sayaç bölüm tetikleyicileriyle baştan sayılır
+        bool ok = Exec(db, "INSERT OR REPLACE INTO message_counters(id, posted) VALUES(1, 0);");
+        for (std::size_t i = 0; ok && i < raw.size(); ++i) {
+            const std::string month = MonthOf(raw[i]);
+            ok = CreatePartition(db, month);
+            st = ok ? Prepare(db, "INSERT INTO " + TableFor(month) + "(id, datetime, text) "
+                                  "SELECT id, datetime, text FROM messages WHERE substr(datetime, 1, 7) IS ?;") : nullptr;
+            if (st) sqlite3_bind_text(st, 1, raw[i].c_str(), -1, SQLITE_TRANSIENT);
+            ok = ok && StepDone(db, st);
+        }
+        st = ok ? Prepare(db, "UPDATE message_seq SET last_id = MAX(last_id, ?) WHERE id = 1;") : nullptr;
+        if (st) sqlite3_bind_int64(st, 1, lastId);
+        return ok && StepDone(db, st) && Exec(db, "DROP TABLE messages;");
+    }
+
+    bool EnsureSchema(sqlite3* db) {
+        if (!db || !Savepoint(db)) return false;
+        bool ok = Exec(db, BASE_SCHEMA);
+        const int64_t legacy = ok ? QueryInt64(db,
+            "SELECT COUNT(*) FROM sqlite_master WHERE type = 'table' AND name = 'messages';", 0) : 0;
+        if (ok && legacy > 0) {
+            ok = MigrateLegacyTable(db) && RebuildView(db);
+        }
+        else if (ok) {
+            ok = Exec(db, "INSERT OR IGNORE INTO message_counters(id, posted) VALUES(1, 0);");
+            bool upgraded = false;
+            std::vector<PartitionInfo> parts = ok ? ListPartitions(db) : std::vector<PartitionInfo>();
+            for (std::size_t i = 0; ok && i < parts.size(); ++i) {
+                if (HasOrdinal(db, parts[i])) continue;
+                ok = UpgradePartition(db, parts[i]);
+                upgraded = true;
+            }
+            if (ok && (upgraded || !IsPartitioned(db))) ok = RebuildView(db);
+        }
+        return Finish(db, ok);
+    }
+
+    bool IsPartitioned(sqlite3* db) {
+        return QueryInt64(db, "SELECT COUNT(*) FROM sqlite_master WHERE type = 'view' AND name = 'messages';", 0) > 0;
+    }
+
+    // =================== Repository ===================
+    bool InsertMessage(sqlite3* db, const std::string& datetime, const std::string& text, int64_t* id) {
+        if (!db) return false;
+        const std::string month = MonthOf(datetime);
+        if (!Savepoint(db)) return false;
+        bool ok = HasPartition(db, month) || (CreatePartition(db, month) && RebuildView(db));
+
+        sqlite3_stmt* st = ok ? Prepare(db, "INSERT INTO " + TableFor(month) + "(id, datetime, text) "
+            "VALUES((SELECT last_id + 1 FROM message_seq WHERE id = 1), ?, ?);") : nullptr;
+        if (st) {
+            sqlite3_bind_text(st, 1, datetime.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_text(st, 2, text.c_str(), -1, SQLITE_TRANSIENT);
+        }
+        ok = ok && StepDone(db, st);
+        if (ok && id) *id = sqlite3_last_insert_rowid(db);
+        return Finish(db, ok);
+    }
+
+    int ForEachAfter(sqlite3* db, int64_t afterId, int limit, const RowVisitor& visit) {
+        if (!db || limit <= 0) return -1;
+        std::vector<PartitionInfo> parts = ListPartitions(db);
+        std::string sql;
+        for (std::size_t i = 0; i < parts.size(); ++i) {
+            if (parts[i].rows == 0 || parts[i].maxId <= afterId) continue;
+            sql += sql.empty() ? "" : " UNION ALL ";
+            sql += "SELECT id, datetime, text FROM " + parts[i].table + " WHERE id > ?1";
+        }
+        if (sql.empty()) return 0;
+
+        sqlite3_stmt* st = Prepare(db, sql + " ORDER BY 1 LIMIT ?2;");
+        if (!st) return -1;
+        sqlite3_bind_int64(st, 1, afterId);
+        sqlite3_bind_int(st, 2, limit);
+        int n = 0;
+        while (sqlite3_step(st) == SQLITE_ROW) {
+            visit(sqlite3_column_int64(st, 0),
+                  reinterpret_cast<const char*>(sqlite3_column_text(st, 1)),
+                  reinterpret_cast<const char*>(sqlite3_column_text(st, 2)));
+            ++n;
+        }
+        sqlite3_finalize(st);
+        return n;
+    }
+
+    int64_t CountRange(sqlite3* db, int64_t afterId, int64_t upToId) {
+        if (!db) return -1;
+        if (upToId <= afterId) return 0;
+        // Aralıkta silme ya da sıra dışı ekleme yoksa sayı iki sıranın farkıdır (iki PK araması)
+        const int64_t gapId = QueryInt64(db, "SELECT gap_id FROM message_ordinals WHERE id = 1;", -1);
+        if (gapId == 0 || (gapId > 0 && afterId > gapId)) {
+            const int64_t from = afterId > 0 ? OrdinalOf(db, afterId) : 0;
+            const int64_t to = from >= 0 ? OrdinalOf(db, upToId) : -1;
+            if (to >= from) return to - from;
+        }
+        sqlite3_stmt* st = Prepare(db, "SELECT COUNT(*) FROM messages WHERE id > ?1 AND id <= ?2;");
+        if (!st) return -1;
+        sqlite3_bind_int64(st, 1, afterId);
+        sqlite3_bind_int64(st, 2, upToId);
+        const int64_t n = sqlite3_step(st) == SQLITE_ROW ? sqlite3_column_int64(st, 0) : -1;
+        sqlite3_finalize(st);
+        return n;
+    }
+
+    int64_t LastAssignedId(sqlite3* db) {
+        return QueryInt64(db, "SELECT last_id FROM message_seq WHERE id = 1;", 0);
+    }
+
+    std::vector<PartitionInfo> ListPartitions(sqlite3* db) {
+        std::vector<PartitionInfo> out;
+        sqlite3_stmt* st = Prepare(db,
+            "SELECT month, name, rows, COALESCE(min_id, 0), COALESCE(max_id, 0) FROM message_partitions ORDER BY month;");
+        if (!st) return out;
+        while (sqlite3_step(st) == SQLITE_ROW) {
+            PartitionInfo p;
+            p.month = reinterpret_cast<const char*>(sqlite3_column_text(st, 0));
+            p.table = reinterpret_cast<const char*>(sqlite3_column_text(st, 1));
+            p.rows = sqlite3_column_int64(st, 2);
+            p.minId = sqlite3_column_int64(st, 3);
+            p.maxId = sqlite3_column_int64(st, 4);
+            out.push_back(p);
+        }
+        sqlite3_finalize(st);
+        return out;
+    }
+
+    // =================== Retention ===================
+    static int64_t DropMatching(sqlite3* db, const std::string& bound, bool yearOnly) {
+        if (!db || !Savepoint(db)) return -1;
+        std::vector<PartitionInfo> parts = ListPartitions(db);
+        int64_t dropped = 0;
+        bool ok = true;
+        bool changed = false;
+        for (std::size_t i = 0; ok && i < parts.size(); ++i) {
+            // Tarihi bozuk mesajların bölümü hiçbir aya ait değil: yaşına göre silinmez
+            if (parts[i].month == INVALID_MONTH) continue;
+            const bool match = yearOnly ? parts[i].month.compare(0, 4, bound) == 0 : parts[i].month < bound;
+            if (!match) continue;
+            ok = DropPartition(db, parts[i]);
+            dropped += parts[i].rows;
+            changed = true;
+        }
+        if (ok && changed) ok = RebuildView(db);
+        return Finish(db, ok) ? dropped : -1;
+    }
+
+    int64_t DropBefore(sqlite3* db, const std::string& month) {
+        if (MonthOf(month) != month || month == INVALID_MONTH) return -1;
+        return DropMatching(db, month, false);
+    }
+
+    int64_t DropYear(sqlite3* db, const std::string& year) {
+        if (year.size() != 4 || MonthOf(year + "-01") == INVALID_MONTH) return -1;
+        return DropMatching(db, year, true);
+    }
+
+} // namespace partition
+} // namespace teamcore
@@ -0,0 +1,665 @@
+// src/page_vfs.cpp
+// Sayfa dönüştüren SQLite shim VFS (AES-256-GCM sayfa şifreleme, sayfa checksum'ı; codec arayüzü genel)
+
+#include "page_vfs.h"
+#include "security_layer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <new>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <sqlite3.h>
+
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+
+namespace teamcore {
+namespace pagevfs {
+
+    const char* const ENCRYPTED_VFS_NAME = "ls-crypt";
+    const char* const CHECKSUM_VFS_NAME = "ls-cksum";
+
+    // =================== Constants ===================
+    static const unsigned char SQLITE_MAGIC[16] = {
+        'S','Q','L','i','t','e',' ','f','o','r','m','a','t',' ','3','\0' };
+    static const unsigned char JOURNAL_MAGIC[8] = { 0xd9, 0xd5, 0x05, 0xf9, 0x20, 0xa1, 0x63, 0xd7 };
+    static const int DB_HEADER_SIZE = 100;
+    static const int WAL_HEADER_SIZE = 32;
+    static const int WAL_FRAME_HEADER_SIZE = 24;
+
+#ifdef SQLITE_IOERR_DATA
+    static const int IOERR_DATA = SQLITE_IOERR_DATA;
+#else
+    static const int IOERR_DATA = SQLITE_CORRUPT;
+#endif
+
+    // =================== AES-GCM Codec ===================
+    class AesGcmCodec : public PageCodec {
+    public:
+        explicit AesGcmCodec(const unsigned char* key32) : key_(32) {
+            std::memcpy(key_.data(), key32, 32);
+        }
+
+        int ReserveBytes() const override { return NONCE + TAG; }
+
+        bool Encode(unsigned char* page, int pageSize, int start, uint32_t pgno) override {
+            const int end = pageSize - NONCE - TAG;
+            unsigned char* nonce = page + end;
+            unsigned char* tag = nonce + NONCE;
+            if (end <= start || RAND_bytes(nonce, NONCE) != 1) return false;
+
+            EVP_CIPHER_CTX* ctx = Context();
+            unsigned char aad[4];
+            StoreBe32(aad, pgno);
+            int len = 0;
+            return ctx &&
+                EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), nullptr, key_.data(), nonce) == 1 &&
+                EVP_EncryptUpdate(ctx, nullptr, &len, aad, sizeof(aad)) == 1 &&
+                EVP_EncryptUpdate(ctx, page + start, &len, page + start, end - start) == 1 &&
+                EVP_EncryptFinal_ex(ctx, page + start + len, &len) == 1 &&
+                EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, TAG, tag) == 1;
+        }
+
+        bool Decode(unsigned char* page, int pageSize, int start, uint32_t pgno) override {
+            const int end = pageSize - NONCE - TAG;
+            unsigned char* nonce = page + end;
+            unsigned char* tag = nonce + NONCE;
+            if (end <= start) return false;
+
+            EVP_CIPHER_CTX* ctx = Context();
+            unsigned char aad[4];
+            StoreBe32(aad, pgno);
+            int len = 0;
+            bool ok = ctx &&
+                EVP_DecryptInit_ex(ctx, EVP_aes_256_gcm(), nullptr, key_.data(), nonce) == 1 &&
+                EVP_DecryptUpdate(ctx, nullptr, &len, aad, sizeof(aad)) == 1 &&
+                EVP_DecryptUpdate(ctx, page + start, &len, page + start, end - start) == 1 &&
+                EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, TAG, tag) == 1 &&
+                EVP_DecryptFinal_ex(ctx, page + start + len, &len) == 1;
+            // SQLite reserve alanını kullanmaz; nonce/tag pager önbelleğine taşınmasın
+            std::memset(nonce, 0, NONCE + TAG);
+            return ok;
+        }
+
+    private:
+        static const int NONCE = 12;
+        static const int TAG = 16;
+
+        static void StoreBe32(unsigned char* p, uint32_t v) {
+            p[0] = static_cast<unsigned char>(v >> 24);
+            p[1] = static_cast<unsigned char>(v >> 16);
+            p[2] = static_cast<unsigned char>(v >> 8);
+            p[3] = static_cast<unsigned char>(v);
+        }
+
+        // Thread başına tek context: sayfa başına new/free maliyetinden kaçınılır
+        static EVP_CIPHER_CTX* Context() {
+            struct Holder {
+                EVP_CIPHER_CTX* ctx;
+                Holder() : ctx(EVP_CIPHER_CTX_new()) {}
+                ~Holder() { EVP_CIPHER_CTX_free(ctx); }
+            };
+            static thread_local Holder holder;
+            return holder.ctx;
+        }
+
+        SecureBuffer key_;
+    };
+
+    std::shared_ptr<PageCodec> MakeAesGcmCodec(const unsigned char* key32) {
+        return std::shared_ptr<PageCodec>(new AesGcmCodec(key32));
+    }
+
+    // =================== Checksum Codec ===================
+    class ChecksumCodec : public PageCodec {
+    public:
+        int ReserveBytes() const override { return CKSUM; }
+
+        bool Encode(unsigned char* page, int pageSize, int, uint32_t) override {
+            const int end = pageSize - CKSUM;
+            if (end <= 0) return false;
+            Compute(page, end, page + end);
+            return true;
+        }
+
+        bool Decode(unsigned char* page, int pageSize, int, uint32_t) override {
+            const int end = pageSize - CKSUM;
+            unsigned char sum[CKSUM];
+            if (end <= 0) return false;
+            Compute(page, end, sum);
+            const bool ok = std::memcmp(sum, page + end, CKSUM) == 0;
+            // SQLite'ın yazdığı (sıfır) reserve geri konur: WAL frame checksum'ı onun üzerinden hesaplandı
+            std::memset(page + end, 0, CKSUM);
+            return ok;
+        }
+
+    private:
+        static const int CKSUM = 8;
+
+        static uint32_t LoadLe32(const unsigned char* p) {
+            return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                   (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+
+        static void StoreLe32(unsigned char* p, uint32_t v) {
+            p[0] = static_cast<unsigned char>(v);
+            p[1] = static_cast<unsigned char>(v >> 8);
+            p[2] = static_cast<unsigned char>(v >> 16);
+            p[3] = static_cast<unsigned char>(v >> 24);
+        }
+
+        // n 8'in katıdır (sayfa boyutu 2'nin kuvveti, reserve 8)
+        static void Compute(const unsigned char* data, int n, unsigned char* out) {
+            uint32_t s1 = 0, s2 = 0;
+            for (int i = 0; i < n; i += 8) {
+                s1 += LoadLe32(data + i) + s2;
+                s2 += LoadLe32(data + i + 4) + s1;
+            }
+            StoreLe32(out, s1);
+            StoreLe32(out + 4, s2);
+        }
+    };
+
+    std::shared_ptr<PageCodec> MakeChecksumCodec() {
+        return std::shared_ptr<PageCodec>(new ChecksumCodec());
+    }
+
+    // =================== Shared Database State ===================
+    // Aynı veritabanının ana dosyası, journal ve WAL'i aynı kararı paylaşır:
+    // -1 = bilinmiyor (boş dosya), 0 = düz geçiş, 1 = dönüştür
+    struct DbState {
+        std::atomic<int> mode;
+        DbState() : mode(-1) {}
+    };
+
+    struct PageVfs {
+        sqlite3_vfs base;
+        sqlite3_vfs* root;
+        std::string name;
+        int pageSize;
+        std::mutex mutex;
+        std::shared_ptr<PageCodec> codec;
+        std::map<std::string, std::weak_ptr<DbState>> states;
+    };
+
+    enum FileKind { KIND_OTHER = 0, KIND_MAIN_DB, KIND_JOURNAL, KIND_WAL };
+
+    struct PageFile {
+        sqlite3_file base;
+        sqlite3_file* real;
+        PageVfs* vfs;
+        FileKind kind;
+        std::string dbName;
+        std::shared_ptr<DbState> state;
+        std::shared_ptr<PageCodec> codec;
+        std::vector<unsigned char> scratch;
+    };
+
+    static std::mutex g_registryMutex;
+    static std::map<std::string, PageVfs*> g_registry; // UnregisterPageVfs'e kadar yaşar
+
+    // =================== Helper Functions ===================
+    static bool IsAllZero(const unsigned char* p, int n) {
+        for (int i = 0; i < n; ++i) {
+            if (p[i]) return false;
+        }
+        return true;
+    }
+
+    static int HeaderPageSize(const unsigned char* h) {
+        int ps = (h[16] << 8) | h[17];
+        return ps == 1 ? 65536 : ps;
+    }
+
+    // Başlık bu codec düzeniyle mi oluşturulmuş?
+    static int ModeFromHeader(const PageFile* f, const unsigned char* h) {
+        return (HeaderPageSize(h) == f->vfs->pageSize && h[20] == f->codec->ReserveBytes()) ? 1 : 0;
+    }
+
+    static bool Active(PageFile* f, const unsigned char* page) {
+        if (f->kind == KIND_OTHER || !f->state) return false;
+        int mode = f->state->mode.load();
+        if (mode < 0 && page && std::memcmp(page, SQLITE_MAGIC, sizeof(SQLITE_MAGIC)) == 0) {
+            // Boş veritabanının ilk sayfa 1 yazımı kararı belirler
+            mode = ModeFromHeader(f, page);
+            f->state->mode.store(mode);
+        }
+        return mode == 1;
+    }
+
+    static int RegionStart(const unsigned char* page) {
+        return std::memcmp(page, SQLITE_MAGIC, sizeof(SQLITE_MAGIC)) == 0 ? DB_HEADER_SIZE : 0;
+    }
+
+    static PageFile* AsPage(sqlite3_file* f) { return reinterpret_cast<PageFile*>(f); }
+
+    static uint32_t LoadBe32(const unsigned char* p) {
+        return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+               (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+    }
+
+    /**
+     * @brief off'taki sayfa gövdesinin veritabanı sayfa numarası (codec AAD'si)
+     * @details Ana dosyada ofsetten hesaplanır. Journal kaydı [pgno][sayfa][checksum],
+     *          WAL frame'i [24 baytlık başlık][sayfa] düzenindedir ve SQLite sayfa gövdesini
+     *          ayrı okuyup yazar; numara gerçek dosyada gövdenin hemen önünden okunur.
+     * @param frame Tam WAL frame'i okunuyor/yazılıyorsa başlığı, değilse nullptr
+     */
+    static bool PageNumberAt(PageFile* f, const unsigned char* frame, sqlite3_int64 off, uint32_t* pgno) {
+        if (f->kind == KIND_MAIN_DB) {
+            *pgno = static_cast<uint32_t>(off / f->vfs->pageSize + 1);
+            return true;
+        }
+        if (frame) {
+            *pgno = LoadBe32(frame);
+            return true;
+        }
+        const sqlite3_int64 at = off - (f->kind == KIND_WAL ? WAL_FRAME_HEADER_SIZE : 4);
+        unsigned char raw[4];
+        if (at < 0 || f->real->pMethods->xRead(f->real, raw, sizeof(raw), at) != SQLITE_OK) return false;
+        *pgno = LoadBe32(raw);
+        return true;
+    }
+
+    // =================== I/O Methods ===================
+    static int xClose(sqlite3_file* pFile) {
+        PageFile* f = AsPage(pFile);
+        int rc = f->real->pMethods ? f->real->pMethods->xClose(f->real) : SQLITE_OK;
+        f->~PageFile();
+        return rc;
+    }
+
+    static int xRead(sqlite3_file* pFile, void* buf, int amt, sqlite3_int64 off) {
+        PageFile* f = AsPage(pFile);
+        int rc = f->real->pMethods->xRead(f->real, buf, amt, off);
+        if (rc != SQLITE_OK) return rc; // SHORT_READ: okunmayan kısım sıfır, dönüştürülecek veri yok
+
+        const int ps = f->vfs->pageSize;
+        unsigned char* page = nullptr;
+        const unsigned char* frame = nullptr;
+        if (amt == ps) {
+            page = static_cast<unsigned char*>(buf);
+        }
+        else if (f->kind == KIND_WAL && amt == ps + WAL_FRAME_HEADER_SIZE && off >= WAL_HEADER_SIZE) {
+            frame = static_cast<unsigned char*>(buf); // recovery: tam frame okuması
+            page = static_cast<unsigned char*>(buf) + WAL_FRAME_HEADER_SIZE;
+        }
+        if (!page || !Active(f, nullptr) || IsAllZero(page, ps)) return SQLITE_OK;
+
+        uint32_t pgno = 0;
+        if (!PageNumberAt(f, frame, off, &pgno)) return IOERR_DATA;
+        return f->codec->Decode(page, ps, RegionStart(page), pgno) ? SQLITE_OK : IOERR_DATA;
+    }
+
+    static int xWrite(sqlite3_file* pFile, const void* buf, int amt, sqlite3_int64 off) {
+        PageFile* f = AsPage(pFile);
+        const int ps = f->vfs->pageSize;
+        const unsigned char* in = static_cast<const unsigned char*>(buf);
+
+        int pageOffset = -1;
+        if (amt == ps) pageOffset = 0;
+        else if (f->kind == KIND_WAL && amt == ps + WAL_FRAME_HEADER_SIZE && off >= WAL_HEADER_SIZE) pageOffset = WAL_FRAME_HEADER_SIZE;
+
+        // Journal başlığı sektör boyutunda (çoğu zaman sayfa boyutu) yazılır; dokunulmaz
+        if (pageOffset < 0 || std::memcmp(in, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) == 0 ||
+            !Active(f, in + pageOffset)) {
+            return f->real->pMethods->xWrite(f->real, buf, amt, off);
+        }
+
+        uint32_t pgno = 0;
+        if (!PageNumberAt(f, pageOffset ? in : nullptr, off, &pgno)) return SQLITE_IOERR_WRITE;
+        f->scratch.assign(in, in + amt);
+        unsigned char* page = f->scratch.data() + pageOffset;
+        if (!f->codec->Encode(page, ps, RegionStart(page), pgno)) return SQLITE_IOERR_WRITE;
+        return f->real->pMethods->xWrite(f->real, f->scratch.data(), amt, off);
+    }
+
+    static int xTruncate(sqlite3_file* f, sqlite3_int64 size) { return AsPage(f)->real->pMethods->xTruncate(AsPage(f)->real, size); }
+    static int xSync(sqlite3_file* f, int flags) { return AsPage(f)->real->pMethods->xSync(AsPage(f)->real, flags); }
+    static int xFileSize(sqlite3_file* f, sqlite3_int64* size) { return AsPage(f)->real->pMethods->xFileSize(AsPage(f)->real, size); }
+    static int xLock(sqlite3_file* f, int lock) { return AsPage(f)->real->pMethods->xLock(AsPage(f)->real, lock); }
+    static int xUnlock(sqlite3_file* f, int lock) { return AsPage(f)->real->pMethods->xUnlock(AsPage(f)->real, lock); }
+    static int xCheckReservedLock(sqlite3_file* f, int* out) { return AsPage(f)->real->pMethods->xCheckReservedLock(AsPage(f)->real, out); }
+    static int xSectorSize(sqlite3_file* f) { return AsPage(f)->real->pMethods->xSectorSize(AsPage(f)->real); }
+    static int xDeviceCharacteristics(sqlite3_file* f) { return AsPage(f)->real->pMethods->xDeviceCharacteristics(AsPage(f)->real); }
+
+    static int xFileControl(sqlite3_file* pFile, int op, void* arg) {
+        PageFile* f = AsPage(pFile);
+        if (op == SQLITE_FCNTL_MMAP_SIZE) {
+            // mmap, xRead'i atlayacağı için kapalı tutulur
+            *static_cast<sqlite3_int64*>(arg) = 0;
+            return SQLITE_OK;
+        }
+        int rc = f->real->pMethods->xFileControl(f->real, op, arg);
+        if (op == SQLITE_FCNTL_VFSNAME && rc == SQLITE_OK) {
+            char** name = static_cast<char**>(arg);
+            *name = sqlite3_mprintf("%s/%z", f->vfs->name.c_str(), *name);
+        }
+        return rc;
+    }
+
+    static int xShmMap(sqlite3_file* f, int pg, int pgsz, int extend, void volatile** pp) {
+        return AsPage(f)->real->pMethods->xShmMap(AsPage(f)->real, pg, pgsz, extend, pp);
+    }
+    static int xShmLock(sqlite3_file* f, int offset, int n, int flags) {
+        return AsPage(f)->real->pMethods->xShmLock(AsPage(f)->real, offset, n, flags);
+    }
+    static void xShmBarrier(sqlite3_file* f) { AsPage(f)->real->pMethods->xShmBarrier(AsPage(f)->real); }
+    static int xShmUnmap(sqlite3_file* f, int deleteFlag) {
+        return AsPage(f)->real->pMethods->xShmUnmap(AsPage(f)->real, deleteFlag);
+    }
+    static int xFetch(sqlite3_file*, sqlite3_int64, int, void** pp) {
+        *pp = nullptr; // her zaman xRead yolu
+        return SQLITE_OK;
+    }
+    static int xUnfetch(sqlite3_file*, sqlite3_int64, void*) { return SQLITE_OK; }
+
+    static const sqlite3_io_methods PAGE_IO_METHODS = {
+        3, xClose, xRead, xWrite, xTruncate, xSync, xFileSize, xLock, xUnlock, xCheckReservedLock,
+        xFileControl, xSectorSize, xDeviceCharacteristics, xShmMap, xShmLock, xShmBarrier, xShmUnmap,
+        xFetch, xUnfetch
+    };
+
+    // =================== VFS Methods ===================
+    static std::shared_ptr<DbState> StateFor(PageVfs* vfs, const std::string& dbName) {
+        std::lock_guard<std::mutex> lock(vfs->mutex);
+        std::shared_ptr<DbState> s = vfs->states[dbName].lock();
+        if (!s) {
+            s = std::make_shared<DbState>();
+            vfs->states[dbName] = s;
+        }
+        return s;
+    }
+
+    static int vOpen(sqlite3_vfs* pVfs, const char* zName, sqlite3_file* pFile, int flags, int* outFlags) {
+        PageVfs* vfs = reinterpret_cast<PageVfs*>(pVfs);
+        PageFile* f = new (pFile) PageFile();
+        f->base.pMethods = nullptr;
+        f->real = reinterpret_cast<sqlite3_file*>(reinterpret_cast<char*>(pFile) + sizeof(PageFile));
+        f->vfs = vfs;
+        {
+            std::lock_guard<std::mutex> lock(vfs->mutex);
+            f->codec = vfs->codec;
+        }
+
+        if (zName && (flags & SQLITE_OPEN_MAIN_DB)) f->kind = KIND_MAIN_DB;
+        else if (zName && (flags & SQLITE_OPEN_MAIN_JOURNAL)) f->kind = KIND_JOURNAL;
+        else if (zName && (flags & SQLITE_OPEN_WAL)) f->kind = KIND_WAL;
+        else f->kind = KIND_OTHER;
+
+        int rc = vfs->root->xOpen(vfs->root, zName, f->real, flags, outFlags);
+        if (rc != SQLITE_OK) {
+            f->~PageFile();
+            return rc;
+        }
+        f->base.pMethods = &PAGE_IO_METHODS;
+
+        if (f->kind != KIND_OTHER) {
+            f->dbName = f->kind == KIND_MAIN_DB ? std::string(zName) : std::string(sqlite3_filename_database(zName));
+            f->state = StateFor(vfs, f->dbName);
+        }
+        if (f->kind == KIND_MAIN_DB && f->state->mode.load() < 0) {
+            unsigned char header[DB_HEADER_SIZE];
+            if (f->real->pMethods->xRead(f->real, header, sizeof(header), 0) == SQLITE_OK &&
+                std::memcmp(header, SQLITE_MAGIC, sizeof(SQLITE_MAGIC)) == 0) {
+                f->state->mode.store(ModeFromHeader(f, header));
+            }
+        }
+        return SQLITE_OK;
+    }
+
+    static int vDelete(sqlite3_vfs* v, const char* z, int sync) { sqlite3_vfs* r = reinterpret_cast<PageVfs*>(v)->root; return r->xDelete(r, z, sync); }
+    static int vAccess(sqlite3_vfs* v, const char* z, int flags, int* out) { sqlite3_vfs* r = reinterpret_cast<PageVfs*>(v)->root; return r->xAccess(r, z, flags, out); }
+    static int vFullPathname(sqlite3_vfs* v, const char* z, int n, char* out) { sqlite3_vfs* r = reinterpret_cast<PageVfs*>(v)->root; return r->xFullPathname(r, z, n, out); }
+    static void* vDlOpen(sqlite3_vfs* v, const char* z) { sqlite3_vfs* r = reinterpret_cast<PageVfs*>(v)->root; return r->xDlOpen(r, z); }
+    static void vDlError(sqlite3_vfs* v, int n, char* z) { sqlite3_vfs* r = reinterpret_cast<PageVfs*>(v)->root; r->xDlError(r, n, z); }
+    static void (*vDlSym(sqlite3_vfs* v, void* h, const char* z))(void) { sqlite3_vfs* r = reinterpret_cast<PageVfs*>(v)->root; return r->xDlSym(r, h, z); }
+    static void vDlClose(sqlite3_vfs* v, void* h) { sqlite3_vfs* r = reinterpret_cast<PageVfs*>(v)->root; r->xDlClose(r, h); }
+    static int vRandomness(sqlite3_vfs* v, int n, char* z) { sqlite3_vfs* r = reinterpret_cast<PageVfs*>(v)->root; return r->xRandomness(r, n, z); }
+    static int vSleep(sqlite3_vfs* v, int us) { sqlite3_vfs* r = reinterpret_cast<PageVfs*>(v)->root; return r->xSleep(r, us); }
+    static int vCurrentTime(sqlite3_vfs* v, double* t) { sqlite3_vfs* r = reinterpret_cast<PageVfs*>(v)->root; return r->xCurrentTime(r, t); }
+    static int vGetLastError(sqlite3_vfs* v, int n, char* z) { sqlite3_vfs* r = reinterpret_cast<PageVfs*>(v)->root; return r->xGetLastError ? r->xGetLastError(r, n, z) : 0; }
+    static int vCurrentTimeInt64(sqlite3_vfs* v, sqlite3_int64* t) { sqlite3_vfs* r = reinterpret_cast<PageVfs*>(v)->root; return r->xCurrentTimeInt64(r, t); }
+
+    // =================== Registration ===================
+    bool RegisterPageVfs(const char* name, std::shared_ptr<PageCodec> codec, int pageSize) {
+        if (!name || !codec || pageSize < 512 || pageSize > 65536 || (pageSize & (pageSize - 1))) return false;
+
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+        std::map<std::string, PageVfs*>::iterator it = g_registry.find(name);
+        if (it != g_registry.end()) {
+            std::lock_guard<std::mutex> vlock(it->second->mutex);
+            it->second->codec = codec;
+            it->second->pageSize = pageSize;
+            return true;
+        }
+
+        sqlite3_vfs* root = sqlite3_vfs_find(nullptr);
+        if (!root || root->iVersion < 2) return false;
+
+        PageVfs* vfs = new PageVfs();
+        vfs->root = root;
+        vfs->name = name;
+        vfs->pageSize = pageSize;
+        vfs->codec = codec;
+
+        std::memset(&vfs->base, 0, sizeof(vfs->base));
+        vfs->base.iVersion = 2;
+        vfs->base.szOsFile = static_cast<int>(sizeof(PageFile)) + root->szOsFile;
+        vfs->base.mxPathname = root->mxPathname;
+        vfs->base.zName = vfs->name.c_str();
+        vfs->base.xOpen = vOpen;
+        vfs->base.xDelete = vDelete;
+        vfs->base.xAccess = vAccess;
+        vfs->base.xFullPathname = vFullPathname;
+        vfs->base.xDlOpen = vDlOpen;
+        vfs->base.xDlError = vDlError;
+        vfs->base.xDlSym = vDlSym;
+        vfs->base.xDlClose = vDlClose;
+        vfs->base.xRandomness = vRandomness;
+        vfs->base.xSleep = vSleep;
+        vfs->base.xCurrentTime = vCurrentTime;
+        vfs->base.xGetLastError = vGetLastError;
+        vfs->base.xCurrentTimeInt64 = vCurrentTimeInt64;
+
+        if (sqlite3_vfs_register(&vfs->base, 0) != SQLITE_OK) {
+            delete vfs;
+            return false;
+        }
+        g_registry[name] = vfs;
+        return true;
+    }
+
+    bool UnregisterPageVfs(const char* name) {
+        if (!name) return false;
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+        std::map<std::string, PageVfs*>::iterator it = g_registry.find(name);
+        if (it == g_registry.end()) return false;
+
+        PageVfs* vfs = it->second;
+        {
+            // Açık dosyalar durumlarını ve vfs işaretçisini tutar
+            std::lock_guard<std::mutex> vlock(vfs->mutex);
+            for (std::map<std::string, std::weak_ptr<DbState>>::const_iterator s = vfs->states.begin();
+                 s != vfs->states.end(); ++s) {
+                if (!s->second.expired()) return false;
+            }
+        }
+        if (sqlite3_vfs_unregister(&vfs->base) != SQLITE_OK) return false;
+        g_registry.erase(it);
+        vfs->codec.reset(); // AesGcmCodec anahtarı SecureBuffer yıkıcısında silinir
+        delete vfs;
+        return true;
+    }
+
+    // =================== Database Helpers ===================
+    static PageFile* PageFileOf(sqlite3* db, const char* schema) {
+        sqlite3_file* file = nullptr;
+        if (!db || sqlite3_file_control(db, schema, SQLITE_FCNTL_FILE_POINTER, &file) != SQLITE_OK || !file) return nullptr;
+        return file->pMethods == &PAGE_IO_METHODS ? AsPage(file) : nullptr;
+    }
+
+    bool PrepareNewDatabase(sqlite3* db, const char* schema) {
+        PageFile* f = PageFileOf(db, schema);
+        if (!f) return false;
+
+        sqlite3_stmt* st = nullptr;
+        std::string sql = std::string("PRAGMA \"") + schema + "\".page_count;";
+        int pages = -1;
+        if (sqlite3_prepare_v2(db, sql.c_str(), -1, &st, nullptr) == SQLITE_OK && sqlite3_step(st) == SQLITE_ROW) {
+            pages = sqlite3_column_int(st, 0);
+        }
+        sqlite3_finalize(st);
+        if (pages != 0) return false;
+
+        sql = std::string("PRAGMA \"") + schema + "\".page_size=" + std::to_string(f->vfs->pageSize) + ";";
+        if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, nullptr) != SQLITE_OK) return false;
+        int reserve = f->codec->ReserveBytes();
+        return sqlite3_file_control(db, schema, SQLITE_FCNTL_RESERVE_BYTES, &reserve) == SQLITE_OK;
+    }
+
+    bool IsPageTransformed(sqlite3* db, const char* schema) {
+        PageFile* f = PageFileOf(db, schema);
+        return f && f->state && f->state->mode.load() == 1;
+    }
+
+    const char* VfsNameOf(sqlite3* db, const char* schema) {
+        sqlite3_vfs* vfs = nullptr;
+        if (!db || sqlite3_file_control(db, schema, SQLITE_FCNTL_VFS_POINTER, &vfs) != SQLITE_OK || !vfs) return nullptr;
+        return vfs->zName;
+    }
+
+    std::shared_ptr<PageCodec> CodecOf(sqlite3* db, const char* schema) {
+        PageFile* f = PageFileOf(db, schema);
+        if (!f || !f->state || f->state->mode.load() != 1) return std::shared_ptr<PageCodec>();
+        return f->codec;
+    }
+
+    // =================== Page Verifier ===================
+    static bool ReadPage(std::ifstream& in, int64_t pageNo, int pageSize, unsigned char* buf) {
+        in.clear();
+        in.seekg(static_cast<std::streamoff>((pageNo - 1) * pageSize));
+        in.read(reinterpret_cast<char*>(buf), pageSize);
+        return in.gcount() == pageSize;
+    }
+
+    static bool PageIsValid(std::ifstream& in, PageCodec& codec, int64_t pageNo, int pageSize,
+                            std::vector<unsigned char>& buf) {
+        if (!ReadPage(in, pageNo, pageSize, buf.data())) return true; // dosya bu arada kısaldı
+        if (IsAllZero(buf.data(), pageSize)) return true;
+        return codec.Decode(buf.data(), pageSize, RegionStart(buf.data()), static_cast<uint32_t>(pageNo));
+    }
+
+    bool VerifyPages(const std::string& path, PageCodec& codec, int64_t firstPage, int maxPages, PageScanResult* out) {
+        if (!out) return false;
+        *out = PageScanResult();
+        std::ifstream in(path.c_str(), std::ios::binary);
+        unsigned char header[DB_HEADER_SIZE];
+        if (!in || !in.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+            std::memcmp(header, SQLITE_MAGIC, sizeof(SQLITE_MAGIC)) != 0) {
+            return false;
+        }
+        const int ps = HeaderPageSize(header);
+        if (ps < 512 || ps > 65536 || (ps & (ps - 1)) || header[20] != codec.ReserveBytes()) return true;
+        out->transformed = true;
+
+        in.seekg(0, std::ios::end);
+        out->pageCount = static_cast<int64_t>(in.tellg()) / ps;
+        if (firstPage < 1 || firstPage > out->pageCount) firstPage = 1;
+
+        std::vector<unsigned char> buf(ps);
+        int64_t page = firstPage;
+        for (; page <= out->pageCount && out->pagesChecked < maxPages; ++page) {
+            ++out->pagesChecked;
+            if (PageIsValid(in, codec, page, ps, buf)) continue;
+            // Eşzamanlı checkpoint yazımının yarısı okunmuş olabilir: bir kez daha bak
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            if (!PageIsValid(in, codec, page, ps, buf)) out->badPages.push_back(page);
+        }
+        out->nextPage = page > out->pageCount ? 1 : page;
+        return true;
+    }
+
+    PageVerifier::PageVerifier() : running_(false) {}
+
+    PageVerifier::~PageVerifier() {
+        Stop();
+    }
+
+    bool PageVerifier::Start(const std::string& dbPath, std::shared_ptr<PageCodec> codec,
+                             const VerifierConfig& config, MismatchSink sink) {
+        if (!codec || dbPath.empty() || running_.load()) return false;
+        dbPath_ = dbPath;
+        codec_ = codec;
+        config_ = config;
+        config_.pagesPerSecond = std::max(1, config_.pagesPerSecond);
+        config_.batchPages = std::max(1, config_.batchPages);
+        sink_ = sink;
+        {
+            std::lock_guard<std::mutex> lock(statsMutex_);
+            stats_ = VerifierStats();
+        }
+        running_.store(true);
+        worker_ = std::thread(&PageVerifier::Loop, this);
+        return true;
+    }
+
+    void PageVerifier::Stop() {
+        if (!running_.exchange(false)) return;
+        {
+            std::lock_guard<std::mutex> lock(waitMutex_);
+        }
+        wake_.notify_all();
+        if (worker_.joinable()) worker_.join();
+        codec_.reset();
+    }
+
+    VerifierStats PageVerifier::Stats() const {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        return stats_;
+    }
+
+    void PageVerifier::Loop() {
+        typedef std::chrono::steady_clock Clock;
+        std::set<int64_t> reported; // aynı bozuk sayfa her turda tekrar bildirilmez
+        int64_t next = 1;
+        while (running_.load()) {
+            const Clock::time_point t0 = Clock::now();
+            PageScanResult r;
+            const bool ok = VerifyPages(dbPath_, *codec_, next, config_.batchPages, &r);
+            const double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+            next = r.nextPage;
+
+            std::vector<int64_t> fresh;
+            for (size_t i = 0; i < r.badPages.size(); ++i) {
+                if (reported.insert(r.badPages[i]).second) fresh.push_back(r.badPages[i]);
+            }
+            {
+                std::lock_guard<std::mutex> lock(statsMutex_);
+                stats_.pagesChecked += static_cast<uint64_t>(r.pagesChecked);
+                stats_.mismatches += fresh.size();
+                stats_.totalMs += ms;
+                if (ok && r.transformed && r.nextPage == 1) ++stats_.sweeps;
+            }
+            for (size_t i = 0; i < fresh.size(); ++i) {
+                if (sink_) sink_(dbPath_, fresh[i]);
+            }
+
+            // Hız sınırı: okunan sayfa kadar (boş/okunamayan dosyada tam batch kadar) bekle
+            const int64_t pages = r.pagesChecked > 0 ? r.pagesChecked : config_.batchPages;
+            const int64_t waitMs = std::max<int64_t>(1, pages * 1000 / config_.pagesPerSecond);
+            std::unique_lock<std::mutex> lock(waitMutex_);
+            wake_.wait_for(lock, std::chrono::milliseconds(waitMs), [this] { return !running_.load(); });
+        }
+    }
+
+} // namespace pagevfs
+} // namespace teamcore
@@ -0,0 +1,228 @@
+// src/pbkdf2_lanes.cpp
+// Çok şeritli PBKDF2-HMAC-SHA256: bağımsız türetmeler aynı SHA-256 turlarında ilerler
+
+#include "security_layer.h"
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/sha.h>
+
+namespace teamcore {
+namespace crypto {
+
+    // Şerit sayısı: 16 x 32 bit = bir AVX-512 yazmacı (AVX2'de iki, SSE2'de dört yazmaca bölünür)
+    static const int KDF_LANES = 16;
+
+    static const uint32_t K256[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+
+    static const uint32_t SHA256_IV[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+
+    static inline uint32_t Rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+    // x86-64 GCC/Linux: sıkıştırma AVX2/AVX-512 için ayrıca derlenir, çalışma anında CPU'ya göre seçilir
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define LS_KDF_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define LS_KDF_TARGET_CLONES
+#endif
+
+    // Şerit düzeni: v[i][l] = l. şeridin i. kelimesi; iç döngüler şeritler üzerinde (vektörleşir)
+    struct LaneBlock { uint32_t w[16][KDF_LANES]; };
+    struct LaneState { uint32_t h[8][KDF_LANES]; };
+
+    // Tüm şeritlerde tek SHA-256 sıkıştırması: out = compress(in, block)
+    LS_KDF_TARGET_CLONES
+    static void CompressLanes(const LaneState& in, const LaneBlock& block, LaneState& out) {
+        uint32_t w[64][KDF_LANES];
+        for (int i = 0; i < 16; ++i)
+            for (int l = 0; l < KDF_LANES; ++l) w[i][l] = block.w[i][l];
+        for (int i = 16; i < 64; ++i) {
+            for (int l = 0; l < KDF_LANES; ++l) {
+                const uint32_t s0 = Rotr(w[i - 15][l], 7) ^ Rotr(w[i - 15][l], 18) ^ (w[i - 15][l] >> 3);
+                const uint32_t s1 = Rotr(w[i - 2][l], 17) ^ Rotr(w[i - 2][l], 19) ^ (w[i - 2][l] >> 10);
+                w[i][l] = w[i - 16][l] + s0 + w[i - 7][l] + s1;
+            }
+        }
+
+        uint32_t a[KDF_LANES], b[KDF_LANES], c[KDF_LANES], d[KDF_LANES];
+        uint32_t e[KDF_LANES], f[KDF_LANES], g[KDF_LANES], h[KDF_LANES];
+        for (int l = 0; l < KDF_LANES; ++l) {
+            a[l] = in.h[0][l]; b[l] = in.h[1][l]; c[l] = in.h[2][l]; d[l] = in.h[3][l];
+            e[l] = in.h[4][l]; f[l] = in.h[5][l]; g[l] = in.h[6][l]; h[l] = in.h[7][l];
+        }
+        for (int i = 0; i < 64; ++i) {
+            for (int l = 0; l < KDF_LANES; ++l) {
+                const uint32_t S1 = Rotr(e[l], 6) ^ Rotr(e[l], 11) ^ Rotr(e[l], 25);
+                const uint32_t ch = (e[l] & f[l]) ^ (~e[l] & g[l]);
+                const uint32_t t1 = h[l] + S1 + ch + K256[i] + w[i][l];
+                const uint32_t S0 = Rotr(a[l], 2) ^ Rotr(a[l], 13) ^ Rotr(a[l], 22);
+                const uint32_t maj = (a[l] & b[l]) ^ (a[l] & c[l]) ^ (b[l] & c[l]);
+                const uint32_t t2 = S0 + maj;
+                h[l] = g[l]; g[l] = f[l]; f[l] = e[l]; e[l] = d[l] + t1;
+                d[l] = c[l]; c[l] = b[l]; b[l] = a[l]; a[l] = t1 + t2;
+            }
+        }
+        for (int l = 0; l < KDF_LANES; ++l) {
+            out.h[0][l] = in.h[0][l] + a[l]; out.h[1][l] = in.h[1][l] + b[l];
+            out.h[2][l] = in.h[2][l] + c[l]; out.h[3][l] = in.h[3][l] + d[l];
+            out.h[4][l] = in.h[4][l] + e[l]; out.h[5][l] = in.h[5][l] + f[l];
+            out.h[6][l] = in.h[6][l] + g[l]; out.h[7][l] = in.h[7][l] + h[l];
+        }
+    }
+
+    static inline uint32_t LoadBe32(const unsigned char* p) {
+        return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+    }
+
+    static inline void StoreBe32(unsigned char* p, uint32_t v) {
+        p[0] = static_cast<unsigned char>(v >> 24); p[1] = static_cast<unsigned char>(v >> 16);
+        p[2] = static_cast<unsigned char>(v >> 8);  p[3] = static_cast<unsigned char>(v);
+    }
+
+    // HMAC anahtarının ipad/opad bloklarından sonraki ara durumlar (her iterasyonda yeniden hesaplanmaz)
+    static void HmacMidstates(const std::string& pass, uint32_t ipad[8], uint32_t opad[8]) {
+        unsigned char key[64];
+        std::memset(key, 0, sizeof(key));
+        if (pass.size() > 64) {
+            SHA256(reinterpret_cast<const unsigned char*>(pass.data()), pass.size(), key);
+        }
+        else if (!pass.empty()) {
+            std::memcpy(key, pass.data(), pass.size());
+        }
+
+        LaneState iv, st;
+        LaneBlock blk;
+        for (int r = 0; r < 8; ++r)
+            for (int l = 0; l < KDF_LANES; ++l) iv.h[r][l] = SHA256_IV[r];
+        // Şerit 0 ipad, şerit 1 opad
+        for (int i = 0; i < 16; ++i) {
+            const uint32_t k = LoadBe32(key + 4 * i);
+            for (int l = 0; l < KDF_LANES; ++l) blk.w[i][l] = k ^ (l == 1 ? 0x5c5c5c5cu : 0x36363636u);
+        }
+        CompressLanes(iv, blk, st);
+        for (int r = 0; r < 8; ++r) {
+            ipad[r] = st.h[r][0];
+            opad[r] = st.h[r][1];
+        }
+        SecureBuffer::secure_bzero(key, sizeof(key));
+        SecureBuffer::secure_bzero(&blk, sizeof(blk));
+        SecureBuffer::secure_bzero(&st, sizeof(st));
+    }
+
+    static bool ValidJob(const KdfJob& job) {
+        return job.passphrase && job.salt && job.saltLen > 0 && job.iterations >= 1 && job.outKey32;
+    }
+
+    // En fazla KDF_LANES işi birlikte yürüt; her şerit kendi iterasyon sayısında durur
+    static bool DeriveLaneGroup(const KdfJob* const* jobs, int count) {
+        LaneState ipad, opad, inner, outer;
+        LaneBlock u, t;   // u: son HMAC çıktısı (ilk 8 kelime), t: XOR birikimi
+        LaneBlock innerBlk, outerBlk;
+        int iterations[KDF_LANES];
+        int maxIter = 0;
+
+        for (int l = 0; l < KDF_LANES; ++l) {
+            const KdfJob* job = jobs[l < count ? l : 0]; // boş şeritler ilk işi tekrarlar, sonuç yazılmaz
+            iterations[l] = l < count ? job->iterations : 0;
+            maxIter = std::max(maxIter, iterations[l]);
+
+            uint32_t ip[8], op[8];
+            HmacMidstates(*job->passphrase, ip, op);
+            for (int r = 0; r < 8; ++r) { ipad.h[r][l] = ip[r]; opad.h[r][l] = op[r]; }
+            SecureBuffer::secure_bzero(ip, sizeof(ip));
+            SecureBuffer::secure_bzero(op, sizeof(op));
+
+            // U1 = HMAC(P, salt || INT(1)): değişken uzunluklu, şerit başına OpenSSL ile
+            std::vector<unsigned char> msg(job->salt, job->salt + job->saltLen);
+            msg.push_back(0); msg.push_back(0); msg.push_back(0); msg.push_back(1);
+            unsigned char u1[32];
+            unsigned int len = 0;
+            if (!HMAC(EVP_sha256(), job->passphrase->data(), static_cast<int>(job->passphrase->size()),
+                msg.data(), msg.size(), u1, &len) || len != 32) {
+                return false;
+            }
+            for (int i = 0; i < 8; ++i) {
+                u.w[i][l] = LoadBe32(u1 + 4 * i);
+                t.w[i][l] = u.w[i][l];
+            }
+            SecureBuffer::secure_bzero(u1, sizeof(u1));
+        }
+
+        // 32 baytlık mesajın sabit dolgusu: 0x80, sıfırlar, uzunluk = (64 + 32) * 8 bit
+        for (int l = 0; l < KDF_LANES; ++l) {
+            for (int i = 8; i < 16; ++i) {
+                const uint32_t pad = i == 8 ? 0x80000000u : (i == 15 ? 768u : 0u);
+                innerBlk.w[i][l] = pad;
+                outerBlk.w[i][l] = pad;
+            }
+        }
+
+        // U_i = HMAC(P, U_{i-1}): iterasyon başına iki sıkıştırma, tüm şeritler birlikte
+        for (int it = 1; it < maxIter; ++it) {
+            for (int i = 0; i < 8; ++i)
+                for (int l = 0; l < KDF_LANES; ++l) innerBlk.w[i][l] = u.w[i][l];
+            CompressLanes(ipad, innerBlk, inner);
+            for (int i = 0; i < 8; ++i)
+                for (int l = 0; l < KDF_LANES; ++l) outerBlk.w[i][l] = inner.h[i][l];
+            CompressLanes(opad, outerBlk, outer);
+            for (int i = 0; i < 8; ++i) {
+                for (int l = 0; l < KDF_LANES; ++l) {
+                    u.w[i][l] = outer.h[i][l];
+                    // Kendi iterasyon sayısını doldurmuş şeridin birikimi donar
+                    t.w[i][l] ^= it < iterations[l] ? outer.h[i][l] : 0u;
+                }
+            }
+        }
+
+        for (int l = 0; l < count; ++l) {
+            for (int i = 0; i < 8; ++i) StoreBe32(jobs[l]->outKey32 + 4 * i, t.w[i][l]);
+        }
+
+        SecureBuffer::secure_bzero(&ipad, sizeof(ipad));
+        SecureBuffer::secure_bzero(&opad, sizeof(opad));
+        SecureBuffer::secure_bzero(&inner, sizeof(inner));
+        SecureBuffer::secure_bzero(&outer, sizeof(outer));
+        SecureBuffer::secure_bzero(&u, sizeof(u));
+        SecureBuffer::secure_bzero(&t, sizeof(t));
+        SecureBuffer::secure_bzero(&innerBlk, sizeof(innerBlk));
+        SecureBuffer::secure_bzero(&outerBlk, sizeof(outerBlk));
+        return true;
+    }
+
+    bool DeriveKeysFromPassphrases(const KdfJob* jobs, std::size_t count) {
+        if (!jobs && count > 0) return false;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!ValidJob(jobs[i])) return false;
+        }
+
+        // Benzer iterasyon sayıları aynı gruba düşsün; boşta dönen şerit azalır
+        std::vector<const KdfJob*> order(count);
+        for (std::size_t i = 0; i < count; ++i) order[i] = &jobs[i];
+        std::stable_sort(order.begin(), order.end(),
+            [](const KdfJob* x, const KdfJob* y) { return x->iterations < y->iterations; });
+
+        for (std::size_t i = 0; i < count; i += KDF_LANES) {
+            const int n = static_cast<int>(std::min<std::size_t>(KDF_LANES, count - i));
+            if (!DeriveLaneGroup(&order[i], n)) return false;
+        }
+        return true;
+    }
+
+} // namespace crypto
+} // namespace teamcore
@@ -3,7 +3,9 @@
 
 #include "rasp.h"
 #include "security_config.h"
+#include "security_layer.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -14,7 +16,14 @@
 #include <mutex>
 #include <cstdlib>
 #include <cstring>
+#include <condition_variable>
 #include <ctime>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <system_error>
 #include <vector>
 
 // Platform-specific includes
@@ -39,6 +48,8 @@
 // OpenSSL for SHA-256
 #include <openssl/sha.h>
 #include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/crypto.h>
 
 namespace teamcore {
 namespace rasp {
@@ -46,12 +57,32 @@ namespace rasp {
     // =================== Global State ===================
     static std::atomic<bool> g_raspActive{false};
     static std::atomic<bool> g_debuggerMonitorRunning{false};
-    static std::thread g_debuggerMonitorThread;
+    static std::thread* g_debuggerMonitorThread = nullptr;
+    static bool g_resumeDebuggerMonitor = false; // StopBackgroundThreads'ten sonra çocukta yeniden başlatılır
     static RASPConfig g_config;
     static std::vector<SecurityEvent> g_eventLog;
     static std::mutex g_logMutex;
     static std::string g_expectedChecksum;
 
+    // Olay birleştirme (g_logMutex altında): anahtar başına açık pencere, tip başına token kovası
+    struct EventAggregate {
+        std::chrono::steady_clock::time_point windowStart;
+        SecurityEvent summary; // count = pencerede bastırılan tekrar sayısı
+    };
+    struct TokenBucket {
+        double tokens;
+        std::chrono::steady_clock::time_point refilled;
+    };
+    static std::map<std::string, EventAggregate> g_aggregates;
+    static std::map<std::string, TokenBucket> g_buckets;
+    static std::ofstream g_logFile;       // her olayda aç-ekle-kapat yerine açık tutulur
+    static std::string g_logFileOpenPath;
+
+    static void FlushExpiredSecurityEvents();
+    static void TightenMonitoring();
+    static void StopScanWorkers();
+    static void ForgetScanWorkersAfterFork();
+
     // =================== Helper Functions ===================
     // Conditional logging based on configured log level
     static void LogToConsole(security::LogLevel level, const std::string& message) {
@@ -179,7 +210,7 @@ namespace rasp {
         }
 
         g_debuggerMonitorRunning.store(true);
-        g_debuggerMonitorThread = std::thread([callback, intervalMs]() {
+        g_debuggerMonitorThread = new std::thread([callback, intervalMs]() {
             while (g_debuggerMonitorRunning.load()) {
                 if (DetectDebugger()) {
                     SecurityEvent evt;
@@ -198,6 +229,7 @@ namespace rasp {
                             "Debugger detected, terminating application", true);
                     }
                 }
+                FlushExpiredSecurityEvents(); // durum düzelse de bekleyen tekrar özeti yazılır
                 std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
             }
         });
@@ -206,8 +238,10 @@ namespace rasp {
     void StopDebuggerMonitoring() {
         if (g_debuggerMonitorRunning.load()) {
             g_debuggerMonitorRunning.store(false);
-            if (g_debuggerMonitorThread.joinable()) {
-                g_debuggerMonitorThread.join();
+            if (g_debuggerMonitorThread) {
+                g_debuggerMonitorThread->join();
+                delete g_debuggerMonitorThread;
+                g_debuggerMonitorThread = nullptr;
             }
         }
     }
@@ -379,6 +413,315 @@ namespace rasp {
         return result;
     }
 
+    // =================== Shared Library Integrity ===================
+    static const std::size_t LIB_CHUNK_BYTES = 1 << 20;
+
+    // Boot'ta ölçülen 1 MB'lık kod parçası; base kütüphane hâlâ yüklü mü kontrolü için
+    struct LibraryChunk {
+        std::string module;
+        std::uintptr_t base;
+        const unsigned char* addr;
+        std::size_t len;
+        unsigned char hash[32];
+    };
+
+    static std::mutex g_libMutex;
+    static std::vector<LibraryChunk> g_libChunks;
+    static std::size_t g_libCursor = 0;
+    static bool g_libBaselineReady = false;
+    static LibraryBaselineReport g_libReport;
+    static std::map<std::string, std::string> g_libDigests;   // manifest anahtarı gelene dek saklanır
+    static bool g_libLogExisted = false;                      // boot ölçümünde günlük doluydu mu
+
+    static bool Sha256(const void* data, std::size_t len, unsigned char out[32]) {
+        unsigned int outLen = 0;
+        return EVP_Digest(data, len, out, &outLen, EVP_sha256(), nullptr) == 1 && outLen == 32;
+    }
+
+#if !defined(_WIN32)
+    static bool IsLibraryName(const char* name) {
+        // Ana program ("") .text kontrolüyle doğrulanır; vdso gibi dosyasız nesnelerin yolu yok
+        return name && std::strchr(name, '/') != nullptr;
+    }
+
+    static int CollectLibraryChunks(struct dl_phdr_info* info, size_t, void* data) {
+        if (!IsLibraryName(info->dlpi_name)) return 0;
+        std::vector<LibraryChunk>* chunks = static_cast<std::vector<LibraryChunk>*>(data);
+        for (int i = 0; i < info->dlpi_phnum; ++i) {
+            const ElfW(Phdr)& ph = info->dlpi_phdr[i];
+            if (ph.p_type != PT_LOAD || !(ph.p_flags & PF_X) || !(ph.p_flags & PF_R)) continue;
+            const unsigned char* start = reinterpret_cast<const unsigned char*>(info->dlpi_addr + ph.p_vaddr);
+            for (std::size_t off = 0; off < ph.p_filesz; off += LIB_CHUNK_BYTES) {
+                LibraryChunk c;
+                c.module = info->dlpi_name;
+                c.base = static_cast<std::uintptr_t>(info->dlpi_addr);
+                c.addr = start + off;
+                c.len = std::min<std::size_t>(LIB_CHUNK_BYTES, ph.p_filesz - off);
+                chunks->push_back(c);
+            }
+        }
+        return 0;
+    }
+
+    static int CollectLoadedBases(struct dl_phdr_info* info, size_t, void* data) {
+        if (IsLibraryName(info->dlpi_name)) {
+            static_cast<std::vector<std::uintptr_t>*>(data)->push_back(static_cast<std::uintptr_t>(info->dlpi_addr));
+        }
+        return 0;
+    }
+#endif
+
+    static const char MANIFEST_MAC_TAG[] = "hmac-sha256 ";
+
+    static const char MANIFEST_KEY_LABEL[] = "localsports/rasp-library-manifest/v1";
+
+    static bool ManifestKey(std::string* key) {
+        // Yapılandırılmış anahtar ya da AppKey hiyerarşisinden alt anahtar; herkese açık bir
+        // değerden (ör. beklenen checksum) türetilmez
+        if (!g_config.libraryManifestKey.empty()) {
+            *key = g_config.libraryManifestKey;
+            return true;
+        }
+        const SecureBuffer* sub = AppKey_Subkey(MANIFEST_KEY_LABEL);
+        if (!sub) return false;
+        key->assign(reinterpret_cast<const char*>(sub->data()), sub->size());
+        return true;
+    }
+
+    static std::string ManifestMac(const std::string& key, const std::string& body) {
+        unsigned char mac[32];
+        unsigned int len = 0;
+        if (!HMAC(EVP_sha256(), key.data(), static_cast<int>(key.size()),
+                  reinterpret_cast<const unsigned char*>(body.data()), body.size(), mac, &len) || len != 32) {
+            return std::string();
+        }
+        return BytesToHex(mac, sizeof(mac));
+    }
+
+    static bool FileHasContent(const std::string& path) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        return in.is_open() && in.tellg() > 0;
+    }
+
+    static bool WriteLibraryManifest(const std::string& path, const std::string& key,
+                                     const std::map<std::string, std::string>& digests) {
+        std::string body;
+        for (auto it = digests.begin(); it != digests.end(); ++it) body += it->second + " " + it->first + "\n";
+        const std::string mac = ManifestMac(key, body);
+        if (mac.empty()) return false;
+        std::ofstream out(path, std::ios::trunc);
+        out << body << MANIFEST_MAC_TAG << mac << "\n";
+        return out.good();
+    }
+
+    /**
+     * @brief Manifesti oku; son satırdaki HMAC gövdeyle uyuşmazsa *authentic = false
+     */
+    static std::map<std::string, std::string> ReadLibraryManifest(const std::string& path, const std::string& key,
+                                                                  bool* exists, bool* authentic) {
+        std::map<std::string, std::string> manifest;
+        std::ifstream in(path);
+        *exists = in.is_open();
+        *authentic = false;
+        std::string line, body, mac;
+        while (std::getline(in, line)) {
+            if (line.compare(0, sizeof(MANIFEST_MAC_TAG) - 1, MANIFEST_MAC_TAG) == 0) {
+                mac = line.substr(sizeof(MANIFEST_MAC_TAG) - 1);
+                break; // MAC satırından sonrası yok sayılır
+            }
+            body += line + "\n";
+            // "<sha256 hex> <yol>"
+            const std::size_t sp = line.find(' ');
+            if (sp == 64) manifest[line.substr(sp + 1)] = line.substr(0, sp);
+        }
+        const std::string expected = ManifestMac(key, body);
+        *authentic = !mac.empty() && mac.size() == expected.size() &&
+                     CRYPTO_memcmp(mac.data(), expected.data(), mac.size()) == 0;
+        if (!*authentic) manifest.clear();
+        return manifest;
+    }
+
+    /**
+     * @brief Boot özetlerini manifestle karşılaştır; ilk kurulumda manifesti yaz
+     * @details Doğrulanamayan manifest ve kurulumdan sonra kaybolan manifest aynı şekilde
+     *          LIBRARY_MANIFEST_TAMPERED olur: karşılaştırılmaz, yeniden yazılmaz (fail-closed).
+     */
+    static bool CheckLibraryManifest(const std::string& key, const std::map<std::string, std::string>& digests,
+                                     bool logExisted, LibraryBaselineReport* r) {
+        bool exists = false;
+        bool authentic = false;
+        const std::map<std::string, std::string> manifest =
+            ReadLibraryManifest(g_config.libraryManifestPath, key, &exists, &authentic);
+        const bool missing = !exists && logExisted;
+        std::vector<std::string> mismatched;
+        if ((exists && !authentic) || missing) {
+            r->tampered = true;
+        }
+        else if (exists) {
+            for (auto it = digests.begin(); it != digests.end(); ++it) {
+                auto m = manifest.find(it->first);
+                if (m == manifest.end()) ++r->unknown;
+                else if (m->second != it->second) mismatched.push_back(it->first);
+            }
+        }
+        else if (!digests.empty()) {
+            // İlk kurulum (günlük henüz boş): mevcut kütüphaneler temel kabul edilir
+            r->manifestCreated = WriteLibraryManifest(g_config.libraryManifestPath, key, digests);
+        }
+        r->mismatches = static_cast<int>(mismatched.size());
+        {
+            std::lock_guard<std::mutex> lock(g_libMutex);
+            g_libReport = *r;
+        }
+
+        if (r->tampered) {
+            HandleCriticalEvent("LIBRARY_MANIFEST_TAMPERED",
+                (missing ? "Library manifest missing after install: " : "Library manifest failed authentication: ")
+                    + g_config.libraryManifestPath, g_config.autoTerminateOnThreat);
+        }
+        else if (r->manifestCreated || r->unknown > 0) {
+            SecurityEvent evt;
+            evt.timestamp = GetCurrentTimestamp();
+            evt.eventType = r->manifestCreated ? "LIBRARY_MANIFEST_CREATED" : "LIBRARY_NOT_IN_MANIFEST";
+            evt.description = r->manifestCreated ? "Library baseline written to " + g_config.libraryManifestPath
+                                                 : std::to_string(r->unknown) + " loaded libraries are not in the manifest";
+            evt.severity = r->manifestCreated ? 1 : 2;
+            LogSecurityEvent(evt);
+        }
+        for (std::size_t i = 0; i < mismatched.size(); ++i) {
+            HandleCriticalEvent("LIBRARY_INTEGRITY_MISMATCH",
+                "Shared library code differs from manifest: " + mismatched[i], g_config.autoTerminateOnThreat);
+        }
+        return mismatched.empty() && !r->tampered;
+    }
+
+    bool CaptureLibraryBaseline(LibraryBaselineReport* report) {
+        const auto t0 = std::chrono::steady_clock::now();
+        std::vector<LibraryChunk> chunks;
+#if !defined(_WIN32)
+        dl_iterate_phdr(CollectLibraryChunks, &chunks);
+#endif
+
+        // Parçalar çekirdekler arasında paylaştırılır (libcrypto gibi büyük kütüphaneler de bölünür)
+        unsigned threads = g_config.libraryHashThreads > 0 ? static_cast<unsigned>(g_config.libraryHashThreads)
+                                                           : std::thread::hardware_concurrency();
+        threads = std::max(1u, std::min<unsigned>(threads ? threads : 1u, static_cast<unsigned>(chunks.size())));
+        std::atomic<std::size_t> next(0);
+        std::atomic<bool> hashOk(true);
+        auto worker = [&]() {
+            for (std::size_t i = next++; i < chunks.size(); i = next++) {
+                if (!Sha256(chunks[i].addr, chunks[i].len, chunks[i].hash)) hashOk.store(false);
+            }
+        };
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+        worker();
+        for (std::size_t t = 0; t < pool.size(); ++t) pool[t].join();
+
+        // Kütüphane özeti: parça hash'lerinin sıralı SHA-256'sı
+        std::map<std::string, std::string> digests;
+        std::map<std::string, std::string> joined;
+        for (std::size_t i = 0; i < chunks.size(); ++i) {
+            joined[chunks[i].module].append(reinterpret_cast<const char*>(chunks[i].hash), 32);
+        }
+        for (auto it = joined.begin(); it != joined.end(); ++it) {
+            unsigned char digest[32];
+            if (!Sha256(it->second.data(), it->second.size(), digest)) hashOk.store(false);
+            digests[it->first] = BytesToHex(digest, sizeof(digest));
+        }
+
+        LibraryBaselineReport r;
+        r.modules = static_cast<int>(digests.size());
+        r.chunks = static_cast<int>(chunks.size());
+        r.threads = static_cast<int>(threads);
+        for (std::size_t i = 0; i < chunks.size(); ++i) r.bytes += chunks[i].len;
+
+        r.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        // Bu süreç günlüğe yazmadan önce: doluysa ilk kurulum değil
+        const bool logExisted = FileHasContent(g_config.logFilePath);
+
+        std::string key;
+        const bool keyed = ManifestKey(&key);
+        r.manifestPending = !keyed;
+        {
+            std::lock_guard<std::mutex> lock(g_libMutex);
+            g_libChunks.swap(chunks);
+            g_libCursor = 0;
+            g_libBaselineReady = hashOk.load();
+            g_libDigests = digests;
+            g_libLogExisted = logExisted;
+            g_libReport = r;
+        }
+        const bool manifestOk = keyed ? CheckLibraryManifest(key, digests, logExisted, &r) : true;
+        if (keyed) {
+            OPENSSL_cleanse(&key[0], key.size());
+        } else {
+            LogToConsole(security::LogLevel::DEBUG, "[RASP] Library manifest check deferred until the AppKey is ready.");
+        }
+        if (report) *report = r;
+        return hashOk.load() && manifestOk;
+    }
+
+    bool VerifyLibraryManifest(LibraryBaselineReport* report) {
+        std::string key;
+        const bool keyed = ManifestKey(&key);
+        std::map<std::string, std::string> digests;
+        bool logExisted = false;
+        LibraryBaselineReport r;
+        {
+            std::lock_guard<std::mutex> lock(g_libMutex);
+            r = g_libReport;
+            if (!r.manifestPending || !keyed) {
+                if (report) *report = r;
+                return true; // yapılmış ya da hâlâ anahtar bekliyor
+            }
+            g_libReport.manifestPending = false; // tek çağıran karşılaştırır
+            digests = g_libDigests;
+            logExisted = g_libLogExisted;
+        }
+        r.manifestPending = false;
+        const bool ok = CheckLibraryManifest(key, digests, logExisted, &r);
+        OPENSSL_cleanse(&key[0], key.size());
+        if (report) *report = r;
+        return ok;
+    }
+
+    int VerifyLibraryChunks(int maxChunks) {
+        std::lock_guard<std::mutex> lock(g_libMutex);
+        if (!g_libBaselineReady) {
+            return -1;
+        }
+        std::vector<std::uintptr_t> loaded;
+#if !defined(_WIN32)
+        dl_iterate_phdr(CollectLoadedBases, &loaded);
+#endif
+        std::sort(loaded.begin(), loaded.end());
+
+        int changed = 0;
+        const std::size_t n = std::min(g_libChunks.size(), static_cast<std::size_t>(std::max(0, maxChunks)));
+        for (std::size_t k = 0; k < n; ++k) {
+            const LibraryChunk& c = g_libChunks[g_libCursor];
+            g_libCursor = (g_libCursor + 1) % g_libChunks.size();
+            if (!std::binary_search(loaded.begin(), loaded.end(), c.base)) continue; // dlclose edilmiş
+            unsigned char now[32];
+            if (!Sha256(c.addr, c.len, now) || std::memcmp(now, c.hash, sizeof(now)) != 0) {
+                ++changed;
+                SecurityEvent evt;
+                evt.timestamp = GetCurrentTimestamp();
+                evt.eventType = "LIBRARY_CODE_MODIFIED";
+                evt.description = "Runtime change in " + c.module;
+                evt.severity = 3;
+                LogSecurityEvent(evt);
+            }
+        }
+        return changed;
+    }
+
+    LibraryBaselineReport GetLibraryBaselineReport() {
+        std::lock_guard<std::mutex> lock(g_libMutex);
+        return g_libReport;
+    }
+
     // =================== IAT/PLT Hook Detection ===================
 #if defined(_WIN32)
     int DetectIATHooks() {
@@ -505,24 +848,120 @@ namespace rasp {
     }
 
     // =================== Security Event Logging ===================
-    bool LogSecurityEvent(const SecurityEvent& event) {
-        std::lock_guard<std::mutex> lock(g_logMutex);
-        
+    // Aşağıdaki yardımcılar g_logMutex tutulurken çağrılır
+    static bool WriteEventLocked(const SecurityEvent& event) {
         // Memory log
         g_eventLog.push_back(event);
 
-        // File log
-        std::ofstream logFile(g_config.logFilePath, std::ios::app);
-        if (logFile.is_open()) {
-            logFile << "[" << event.timestamp << "] "
-                    << "[" << event.eventType << "] "
-                    << "[Severity:" << event.severity << "] "
-                    << event.description << "\n";
-            logFile.close();
+        // File log (yol ConfigureRASP ile değişmişse yeniden açılır)
+        if (!g_logFile.is_open() || g_logFileOpenPath != g_config.logFilePath) {
+            g_logFile.close();
+            g_logFile.clear();
+            g_logFile.open(g_config.logFilePath, std::ios::app);
+            g_logFileOpenPath = g_config.logFilePath;
+        }
+        if (!g_logFile.is_open()) {
+            return false;
+        }
+        g_logFile << "[" << event.timestamp << "] "
+                  << "[" << event.eventType << "] "
+                  << "[Severity:" << event.severity << "] "
+                  << event.description;
+        if (!event.firstTimestamp.empty()) {
+            g_logFile << " (tekrar x" << event.count << ", ilk: " << event.firstTimestamp << ")";
+        }
+        g_logFile << "\n";
+        g_logFile.flush(); // sonlandırma öncesi kayıt kaybolmasın
+        return g_logFile.good();
+    }
+
+    static void EmitSummaryLocked(EventAggregate& agg) {
+        if (agg.summary.count > 0) {
+            WriteEventLocked(agg.summary);
+        }
+    }
+
+    static void FlushExpiredLocked(std::chrono::steady_clock::time_point now) {
+        const std::chrono::milliseconds window(g_config.eventWindowMs);
+        for (auto it = g_aggregates.begin(); it != g_aggregates.end();) {
+            if (now - it->second.windowStart >= window) {
+                EmitSummaryLocked(it->second);
+                it = g_aggregates.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    static bool TakeTokenLocked(const std::string& eventType, std::chrono::steady_clock::time_point now) {
+        const double capacity = g_config.eventBurstPerType;
+        auto it = g_buckets.find(eventType);
+        if (it == g_buckets.end()) {
+            TokenBucket fresh = { capacity, now };
+            it = g_buckets.insert(std::make_pair(eventType, fresh)).first;
+        }
+        TokenBucket& bucket = it->second;
+        const double elapsedMs = std::chrono::duration<double, std::milli>(now - bucket.refilled).count();
+        bucket.tokens = std::min(capacity, bucket.tokens + elapsedMs * g_config.eventRefillPerMinute / 60000.0);
+        bucket.refilled = now;
+        if (bucket.tokens < 1.0) {
+            return false;
+        }
+        bucket.tokens -= 1.0;
+        return true;
+    }
+
+    static void SuppressLocked(EventAggregate& agg, const SecurityEvent& event) {
+        if (agg.summary.count == 0) {
+            agg.summary.firstTimestamp = event.timestamp;
+        }
+        ++agg.summary.count;
+        agg.summary.timestamp = event.timestamp;
+    }
+
+    static bool RecordSecurityEvent(const SecurityEvent& event) {
+        std::lock_guard<std::mutex> lock(g_logMutex);
+        const auto now = std::chrono::steady_clock::now();
+        FlushExpiredLocked(now);
+
+        const std::string key = event.eventType + '\n' + std::to_string(std::hash<std::string>()(event.description));
+        auto it = g_aggregates.find(key);
+        if (it != g_aggregates.end()) {
+            SuppressLocked(it->second, event); // açık penceredeki tekrar: yalnızca sayılır
             return true;
         }
 
-        return false;
+        EventAggregate agg;
+        agg.windowStart = now;
+        agg.summary = event;
+        agg.summary.count = 0;
+        const bool admitted = TakeTokenLocked(event.eventType, now) || event.severity >= 3;
+        if (!admitted) {
+            SuppressLocked(agg, event);
+        }
+        g_aggregates.insert(std::make_pair(key, agg));
+        return admitted ? WriteEventLocked(event) : true;
+    }
+
+    bool LogSecurityEvent(const SecurityEvent& event) {
+        const bool ok = RecordSecurityEvent(event);
+        if (event.severity >= 2) {
+            TightenMonitoring(); // bastırılan tekrarlar da alarmı sürdürür
+        }
+        return ok;
+    }
+
+    void FlushSecurityEvents() {
+        std::lock_guard<std::mutex> lock(g_logMutex);
+        for (auto it = g_aggregates.begin(); it != g_aggregates.end(); ++it) {
+            EmitSummaryLocked(it->second);
+        }
+        g_aggregates.clear();
+    }
+
+    static void FlushExpiredSecurityEvents() {
+        std::lock_guard<std::mutex> lock(g_logMutex);
+        FlushExpiredLocked(std::chrono::steady_clock::now());
     }
 
     void HandleCriticalEvent(const std::string& eventType, 
@@ -548,12 +987,16 @@ namespace rasp {
 
     std::vector<SecurityEvent> GetSecurityEventLog() {
         std::lock_guard<std::mutex> lock(g_logMutex);
+        FlushExpiredLocked(std::chrono::steady_clock::now());
         return g_eventLog;
     }
 
     void ClearSecurityLog() {
         std::lock_guard<std::mutex> lock(g_logMutex);
         g_eventLog.clear();
+        g_aggregates.clear();
+        g_buckets.clear();
+        g_logFile.close();
         
         std::ofstream logFile(g_config.logFilePath, std::ios::trunc);
         logFile.close();
@@ -646,14 +1089,20 @@ namespace rasp {
                 return false; // Uygulama sonlandırılır
             }
             LogToConsole(security::LogLevel::NORMAL, "[RASP] Integrity check passed.");
-        }
 
-        // Debugger monitoring başlat
-        if (g_config.enableDebuggerDetection) {
-            LogToConsole(security::LogLevel::DEBUG, "[RASP] Starting debugger monitoring...");
-            StartDebuggerMonitoring([]() {
-                LogErrorToConsole(security::LogLevel::MINIMAL, "[RASP] ALERT: Debugger detected!");
-            }, g_config.monitoringIntervalMs);
+            // Paylaşımlı kütüphaneler: maliyet .text kontrolünden ayrı raporlanır
+            if (g_config.enableLibraryVerification) {
+                LibraryBaselineReport lib;
+                const bool libOk = CaptureLibraryBaseline(&lib);
+                std::ostringstream msg;
+                msg << "[RASP] Library baseline: " << lib.modules << " libraries, "
+                    << lib.bytes / 1024 << " KB in " << std::fixed << std::setprecision(1) << lib.elapsedMs
+                    << " ms (" << lib.threads << " threads)";
+                LogToConsole(security::LogLevel::NORMAL, msg.str());
+                if (!libOk && g_config.autoTerminateOnThreat) {
+                    return false;
+                }
+            }
         }
 
         // Hook detection
@@ -672,6 +1121,11 @@ namespace rasp {
         }
 
         g_raspActive.store(true);
+
+        // Debugger, integrity ve hook kontrolleri kendi aralıklarıyla (sakin ortamda seyrekleşir)
+        LogToConsole(security::LogLevel::DEBUG, "[RASP] Starting adaptive monitoring...");
+        StartAdaptiveMonitoring();
+
         LogToConsole(security::LogLevel::DEBUG, "[RASP] Initialization complete. System is protected.");
         LogToConsole(security::LogLevel::NORMAL, "[RASP] RASP is now active and protecting the application.");
         
@@ -685,49 +1139,525 @@ namespace rasp {
 
         LogToConsole(security::LogLevel::DEBUG, "[RASP] Shutting down...");
 
+        StopAdaptiveMonitoring();
         StopDebuggerMonitoring();
+        StopScanWorkers();
+        FlushSecurityEvents();
         g_raspActive.store(false);
 
+        const MonitoringStats stats = GetMonitoringStats();
+        std::ostringstream msg;
+        msg << "[RASP] Monitoring CPU overhead: quiet " << std::fixed << std::setprecision(3)
+            << stats.QuietOverheadPercent() << "% (" << stats.quietRuns << " checks), alert "
+            << stats.AlertOverheadPercent() << "% (" << stats.alertRuns << " checks)";
+        LogToConsole(security::LogLevel::NORMAL, msg.str());
+
         LogToConsole(security::LogLevel::DEBUG, "[RASP] Shutdown complete.");
     }
 
+    static void ForgetMonitorThreadAfterFork();
+
+    void ReinitializeAfterFork() {
+        // Ebeveynin izleme thread'leri çocuğa kopyalanmaz; nesneleri join edilemez, bilerek bırakılır
+        const bool debuggerMonitor = g_debuggerMonitorRunning.load() || g_resumeDebuggerMonitor;
+        g_resumeDebuggerMonitor = false;
+        g_debuggerMonitorThread = nullptr;
+        g_debuggerMonitorRunning.store(false);
+        ForgetMonitorThreadAfterFork();
+        ForgetScanWorkersAfterFork();
+        if (!g_raspActive.load()) {
+            return;
+        }
+        if (debuggerMonitor) {
+            StartDebuggerMonitoring([]() {
+                LogErrorToConsole(security::LogLevel::MINIMAL, "[RASP] ALERT: Debugger detected!");
+            }, g_config.monitoringIntervalMs);
+        }
+        StartAdaptiveMonitoring();
+    }
+
+    void StopBackgroundThreads() {
+        // fork'tan önce: kilit tutan başka thread kalmasın (malloc, stdio, g_logMutex)
+        if (g_debuggerMonitorRunning.load()) g_resumeDebuggerMonitor = true;
+        StopAdaptiveMonitoring();
+        StopDebuggerMonitoring();
+        StopScanWorkers();
+        FlushSecurityEvents();
+    }
+
     bool IsRASPActive() {
         return g_raspActive.load();
     }
 
     bool PerformSecurityScan() {
+        return PerformSecurityScanDetailed().passed;
+    }
+
+    // =================== Concurrent Security Scan ===================
+    // Süresi dolan kontrolün thread'i de yazabilsin diye sonuçlar paylaşılan durumda tutulur
+    struct ScanState {
+        std::mutex mutex;
+        std::condition_variable done;
+        std::vector<ScanCheckResult> results;
+        std::vector<bool> finished;
+        std::size_t pending = 0;
+    };
+
+    // Kalıcı tarama işçileri: taramalar thread açmaz, süresi dolan kontroller birikmez; ShutdownRASP join eder
+    struct ScanPool {
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::deque<std::function<void()>> queue;
+        std::vector<std::thread> workers;
+        std::set<std::string> inFlight; // süresi dolmuş olsa da hâlâ çalışan kontroller
+        std::size_t idle = 0;
+        bool stopping = false;
+    };
+
+    static const std::size_t MAX_SCAN_WORKERS = 8;
+    static ScanPool* g_scanPool = new ScanPool(); // statik yıkımda join edilmemiş thread kalmasın diye bırakılır
+
+    static void ScanWorkerLoop(ScanPool* pool) {
+        std::unique_lock<std::mutex> lock(pool->mutex);
+        for (;;) {
+            ++pool->idle;
+            pool->wake.wait(lock, [pool]() { return pool->stopping || !pool->queue.empty(); });
+            --pool->idle;
+            if (pool->queue.empty()) return; // durduruluyor; kuyruk önce boşaltılır
+            std::function<void()> task = std::move(pool->queue.front());
+            pool->queue.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+    // false ise kuyruğa alınamadı (durduruluyor veya hiç işçi açılamadı)
+    static bool SubmitScanTask(const std::function<void()>& task) {
+        ScanPool* pool = g_scanPool;
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        if (pool->stopping) return false;
+        if (pool->idle <= pool->queue.size() && pool->workers.size() < MAX_SCAN_WORKERS) {
+            try {
+                pool->workers.push_back(std::thread(ScanWorkerLoop, pool));
+            } catch (const std::system_error&) {
+                if (pool->workers.empty()) return false;
+            }
+        }
+        pool->queue.push_back(task);
+        pool->wake.notify_one();
+        return true;
+    }
+
+    static void StopScanWorkers() {
+        ScanPool* pool = g_scanPool;
+        std::vector<std::thread> workers;
+        {
+            std::lock_guard<std::mutex> lock(pool->mutex);
+            pool->stopping = true;
+            workers.swap(pool->workers);
+        }
+        pool->wake.notify_all();
+        for (std::size_t i = 0; i < workers.size(); ++i) {
+            if (workers[i].get_id() == std::this_thread::get_id()) workers[i].detach();
+            else if (workers[i].joinable()) workers[i].join();
+        }
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        pool->stopping = false; // sonraki tarama işçileri yeniden açar
+    }
+
+    static void ForgetScanWorkersAfterFork() {
+        // Ebeveynin işçileri çocukta yok; kilidi bir ebeveyn thread'inde kalmış olabilecek havuz bırakılır
+        g_scanPool = new ScanPool();
+    }
+
+    static void RunScanCheck(const std::shared_ptr<ScanState>& state, std::size_t index, const ScanCheck& check,
+                             bool tracked) {
+        const auto t0 = std::chrono::steady_clock::now();
+        bool ok = false;
+        try {
+            ok = check.run && check.run();
+        } catch (...) {
+            ok = false; // fail-closed
+        }
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        if (tracked) {
+            // Sonuç bildirilmeden önce: hemen ardından gelen tarama bu kontrolü atlamamalı
+            std::lock_guard<std::mutex> lock(g_scanPool->mutex);
+            g_scanPool->inFlight.erase(check.name);
+        }
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->results[index].status = ok ? ScanStatus::PASSED : ScanStatus::FAILED;
+        state->results[index].elapsedMs = ms;
+        state->finished[index] = true;
+        if (--state->pending == 0) {
+            state->done.notify_all();
+        }
+    }
+
+    SecurityScanReport RunChecksConcurrently(const std::vector<ScanCheck>& checks, int deadlineMs) {
+        const auto t0 = std::chrono::steady_clock::now();
+        std::shared_ptr<ScanState> state = std::make_shared<ScanState>();
+        state->results.resize(checks.size());
+        state->finished.assign(checks.size(), false);
+        state->pending = checks.size();
+        for (std::size_t i = 0; i < checks.size(); ++i) {
+            state->results[i].name = checks[i].name;
+        }
+
+        for (std::size_t i = 0; i < checks.size(); ++i) {
+            const ScanCheck check = checks[i];
+            bool running = false;
+            {
+                std::lock_guard<std::mutex> lock(g_scanPool->mutex);
+                running = !g_scanPool->inFlight.insert(check.name).second;
+            }
+            if (running) {
+                // Önceki çalışması hâlâ sürüyor: ikinci kopya başlatılmaz, TIMED_OUT kalır
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->finished[i] = false;
+                --state->pending;
+                continue;
+            }
+            if (!SubmitScanTask([state, i, check]() { RunScanCheck(state, i, check, true); })) {
+                {
+                    std::lock_guard<std::mutex> lock(g_scanPool->mutex);
+                    g_scanPool->inFlight.erase(check.name);
+                }
+                RunScanCheck(state, i, check, false); // işçi yok: bu thread'de çalıştır
+            }
+        }
+
+        SecurityScanReport report;
+        {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            auto allDone = [&state]() { return state->pending == 0; };
+            if (deadlineMs > 0) {
+                state->done.wait_until(lock, t0 + std::chrono::milliseconds(deadlineMs), allDone);
+            } else {
+                state->done.wait(lock, allDone);
+            }
+            report.checks = state->results;
+            report.deadlineExceeded = state->pending > 0;
+            report.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            for (std::size_t i = 0; i < checks.size(); ++i) {
+                if (!state->finished[i]) {
+                    report.checks[i].status = ScanStatus::TIMED_OUT;
+                    report.checks[i].elapsedMs = report.elapsedMs;
+                }
+            }
+        }
+        report.passed = true;
+        for (std::size_t i = 0; i < report.checks.size(); ++i) {
+            report.passed = report.passed && report.checks[i].status == ScanStatus::PASSED;
+        }
+        return report;
+    }
+
+    // Yapılandırmadaki bağımsız kontroller (tarama ve uyarlanır izleme ortak kullanır)
+    static std::vector<ScanCheck> BuildScanChecks() {
+        std::vector<ScanCheck> checks;
+        if (g_config.enableDebuggerDetection) {
+            ScanCheck c = { "debugger", "DEBUGGER_DETECTED", "Debugger detected during security scan",
+                            []() { return !DetectDebugger(); } };
+            checks.push_back(c);
+        }
+        if (g_config.enableChecksumVerification) {
+            const std::string expected = g_expectedChecksum;
+            ScanCheck c = { "text-integrity", "INTEGRITY_VIOLATION", "Code integrity violation detected",
+                            [expected]() { return VerifyTextSectionIntegrity(expected); } };
+            checks.push_back(c);
+        }
+        // Shared library check: her taramada sıradaki parçalar (tam tur chunks / libraryChunksPerScan tarama)
+        if (g_config.enableChecksumVerification && g_config.enableLibraryVerification) {
+            const int budget = g_config.libraryChunksPerScan;
+            ScanCheck c = { "library-integrity", "LIBRARY_CODE_MODIFIED", "Shared library code modified at runtime",
+                            [budget]() {
+                                VerifyLibraryManifest(); // ertelenmişse; uyuşmazlık kendi kritik olayını üretir
+                                return VerifyLibraryChunks(budget) <= 0;
+                            } };
+            checks.push_back(c);
+        }
+        if (g_config.enableHookDetection) {
+            ScanCheck c = { "hooks", "HOOK_DETECTED", "Hooks detected during security scan",
+                            []() { return DetectIATHooks() + DetectPLTHooks() <= 0; } };
+            checks.push_back(c);
+        }
+        return checks;
+    }
+
+    SecurityScanReport PerformSecurityScanDetailed() {
+        SecurityScanReport report;
         if (!g_raspActive.load()) {
             std::cerr << "[RASP] Cannot scan: RASP not active.\n";
-            return false;
+            return report;
         }
 
-        bool allPassed = true;
+        const std::vector<ScanCheck> checks = BuildScanChecks();
+        const int deadlineMs = g_config.scanDeadlineMs;
+        report = RunChecksConcurrently(checks, deadlineMs);
+
+        // Fail-closed: sonlandırma kararı çağıran thread'de, kontrol sırasıyla
+        for (std::size_t i = 0; i < report.checks.size(); ++i) {
+            if (report.checks[i].status == ScanStatus::FAILED) {
+                HandleCriticalEvent(checks[i].eventType, checks[i].description, g_config.autoTerminateOnThreat);
+            } else if (report.checks[i].status == ScanStatus::TIMED_OUT) {
+                HandleCriticalEvent("SECURITY_SCAN_TIMEOUT", "Check '" + checks[i].name + "' did not finish within " +
+                    std::to_string(deadlineMs) + " ms", g_config.autoTerminateOnThreat);
+            }
+        }
+        return report;
+    }
 
-        // Debugger check
-        if (g_config.enableDebuggerDetection && DetectDebugger()) {
-            HandleCriticalEvent("DEBUGGER_DETECTED", 
-                "Debugger detected during security scan", g_config.autoTerminateOnThreat);
-            allPassed = false;
+    SecurityScanReport PerformSecurityScanInline() {
+        SecurityScanReport report;
+        if (!g_raspActive.load()) {
+            std::cerr << "[RASP] Cannot scan: RASP not active.\n";
+            return report;
         }
 
-        // Integrity check
-        if (g_config.enableChecksumVerification && !VerifyTextSectionIntegrity(g_expectedChecksum)) {
-            HandleCriticalEvent("INTEGRITY_VIOLATION", 
-                "Code integrity violation detected", g_config.autoTerminateOnThreat);
-            allPassed = false;
+        const auto start = std::chrono::steady_clock::now();
+        const std::vector<ScanCheck> checks = BuildScanChecks();
+        report.passed = true;
+        for (std::size_t i = 0; i < checks.size(); ++i) {
+            const auto t0 = std::chrono::steady_clock::now();
+            bool ok = false;
+            try {
+                ok = checks[i].run && checks[i].run();
+            } catch (...) {
+                ok = false; // fail-closed
+            }
+            ScanCheckResult result;
+            result.name = checks[i].name;
+            result.status = ok ? ScanStatus::PASSED : ScanStatus::FAILED;
+            result.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            report.checks.push_back(result);
+            if (!ok) {
+                report.passed = false;
+                HandleCriticalEvent(checks[i].eventType, checks[i].description, g_config.autoTerminateOnThreat);
+            }
         }
+        FlushExpiredSecurityEvents(); // izleme thread'i olmayan süreçte (zygote) özetleri bu çağrı yazar
+        report.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return report;
+    }
 
-        // Hook check
-        if (g_config.enableHookDetection) {
-            int hooks = DetectIATHooks() + DetectPLTHooks();
-            if (hooks > 0) {
-                HandleCriticalEvent("HOOK_DETECTED", 
-                    "Hooks detected during security scan", g_config.autoTerminateOnThreat);
-                allPassed = false;
+    // =================== Adaptive Monitoring ===================
+    AdaptiveInterval::AdaptiveInterval(int minMs, int maxMs, double backoff)
+        : min_(std::max(1, minMs)), max_(std::max(std::max(1, minMs), maxMs)), current_(min_),
+          backoff_(backoff > 1.0 ? backoff : 1.0) {
+    }
+
+    int AdaptiveInterval::OnQuiet() {
+        current_ = static_cast<int>(std::min<double>(max_, current_ * backoff_));
+        return current_;
+    }
+
+    void AdaptiveInterval::Tighten() {
+        current_ = min_;
+    }
+
+    struct MonitorSlot {
+        ScanCheck check;
+        AdaptiveInterval interval;
+        std::chrono::steady_clock::time_point due;
+    };
+
+    static std::mutex g_monitorMutex;
+    static std::condition_variable g_monitorWake;
+    static std::thread* g_monitorThread = nullptr;
+    static bool g_monitorRunning = false;
+    static std::vector<MonitorSlot> g_monitorSlots;
+    static bool g_alertSeen = false;
+    static std::chrono::steady_clock::time_point g_lastAlert;
+    static std::chrono::steady_clock::time_point g_statsMark;
+    static MonitoringStats g_monitorStats;
+
+    static double ThreadCpuMs() {
+#if defined(_WIN32)
+        FILETIME created, exited, kernel, user;
+        if (!GetThreadTimes(GetCurrentThread(), &created, &exited, &kernel, &user)) return 0.0;
+        const auto ticks = [](const FILETIME& ft) {
+            return (static_cast<unsigned long long>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+        };
+        return (ticks(kernel) + ticks(user)) / 10000.0; // 100 ns
+#else
+        timespec ts;
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) return 0.0;
+        return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+#endif
+    }
+
+    static RASPConfig::IntervalRange IntervalFor(const std::string& checkName) {
+        if (checkName == "debugger") return g_config.debuggerInterval;
+        if (checkName == "text-integrity") return g_config.integrityInterval;
+        if (checkName == "library-integrity") return g_config.libraryInterval;
+        return g_config.hookInterval;
+    }
+
+    // Aşağıdaki yardımcılar g_monitorMutex tutulurken çağrılır
+    static std::chrono::steady_clock::time_point AlertEndsLocked() {
+        return g_lastAlert + std::chrono::milliseconds(g_config.alertHoldMs);
+    }
+
+    static bool InAlertLocked(std::chrono::steady_clock::time_point now) {
+        return g_alertSeen && now < AlertEndsLocked();
+    }
+
+    // Son işaretten bu yana geçen duvar süresini sakin/alarm dönemlerine böl
+    static void AccountWallLocked(std::chrono::steady_clock::time_point now) {
+        typedef std::chrono::duration<double, std::milli> ms;
+        if (now <= g_statsMark) return;
+        const auto alertEnd = g_alertSeen ? AlertEndsLocked() : g_statsMark;
+        if (alertEnd > g_statsMark) {
+            const auto split = std::min(alertEnd, now);
+            g_monitorStats.alertWallMs += ms(split - g_statsMark).count();
+            g_monitorStats.quietWallMs += ms(now - split).count();
+        } else {
+            g_monitorStats.quietWallMs += ms(now - g_statsMark).count();
+        }
+        g_statsMark = now;
+    }
+
+    static void AdaptiveMonitorLoop() {
+        std::unique_lock<std::mutex> lock(g_monitorMutex);
+        while (g_monitorRunning) {
+            // Süresi dolan tekrar özetleri sonraki olayı beklemeden yazılır (çökmede kaybolmaz);
+            // olay kaydı g_logMutex'i aldığı için izleme kilidi dışında
+            lock.unlock();
+            FlushExpiredSecurityEvents();
+            lock.lock();
+            if (!g_monitorRunning) break;
+
+            auto now = std::chrono::steady_clock::now();
+            AccountWallLocked(now);
+            std::size_t next = 0;
+            for (std::size_t i = 1; i < g_monitorSlots.size(); ++i) {
+                if (g_monitorSlots[i].due < g_monitorSlots[next].due) next = i;
             }
+            if (g_monitorSlots.empty() || g_monitorSlots[next].due > now) {
+                // Daraltma ya da durdurma bekleyişi erken bitirir; uzun aralıklar özet penceresini aşmaz
+                const auto flushBy = now + std::chrono::milliseconds(std::max(1, g_config.eventWindowMs));
+                if (g_monitorSlots.empty()) g_monitorWake.wait_until(lock, flushBy);
+                else g_monitorWake.wait_until(lock, std::min(g_monitorSlots[next].due, flushBy));
+                continue;
+            }
+
+            const ScanCheck check = g_monitorSlots[next].check;
+            lock.unlock();
+            const double cpu0 = ThreadCpuMs();
+            bool ok = false;
+            try {
+                ok = check.run && check.run();
+            } catch (...) {
+                ok = false; // fail-closed
+            }
+            const double cpuMs = ThreadCpuMs() - cpu0;
+            if (!ok) {
+                // Olay kaydı izleme kilidini alır (TightenMonitoring); kilit dışında çağrılır
+                HandleCriticalEvent(check.eventType, check.description, g_config.autoTerminateOnThreat);
+            }
+            lock.lock();
+
+            now = std::chrono::steady_clock::now();
+            const bool alert = InAlertLocked(now);
+            if (alert) {
+                g_monitorStats.alertCpuMs += cpuMs;
+                ++g_monitorStats.alertRuns;
+            } else {
+                g_monitorStats.quietCpuMs += cpuMs;
+                ++g_monitorStats.quietRuns;
+            }
+            if (next < g_monitorSlots.size()) {
+                MonitorSlot& slot = g_monitorSlots[next];
+                const int waitMs = ok && !alert ? slot.interval.OnQuiet() : slot.interval.Current();
+                slot.due = now + std::chrono::milliseconds(waitMs);
+            }
+        }
+    }
+
+    void StartAdaptiveMonitoring() {
+        std::vector<ScanCheck> checks = BuildScanChecks();
+        std::lock_guard<std::mutex> lock(g_monitorMutex);
+        if (g_monitorRunning) {
+            std::cerr << "[RASP] Adaptive monitoring already running.\n";
+            return;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        g_monitorSlots.clear();
+        for (std::size_t i = 0; i < checks.size(); ++i) {
+            const RASPConfig::IntervalRange range = IntervalFor(checks[i].name);
+            MonitorSlot slot = { checks[i], AdaptiveInterval(range.minMs, range.maxMs, g_config.intervalBackoff),
+                                 now + std::chrono::milliseconds(std::max(1, range.minMs)) };
+            g_monitorSlots.push_back(slot);
+        }
+        g_monitorStats = MonitoringStats();
+        g_statsMark = now;
+        g_alertSeen = false;
+        g_monitorRunning = true;
+        g_monitorThread = new std::thread(AdaptiveMonitorLoop);
+    }
+
+    void StopAdaptiveMonitoring() {
+        std::thread* thread = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(g_monitorMutex);
+            if (!g_monitorRunning) return;
+            g_monitorRunning = false;
+            AccountWallLocked(std::chrono::steady_clock::now());
+            thread = g_monitorThread;
+            g_monitorThread = nullptr;
+            g_monitorSlots.clear();
+        }
+        g_monitorWake.notify_all();
+        if (thread->get_id() == std::this_thread::get_id()) {
+            thread->detach(); // fail-closed sonlandırma izleme thread'inin içinden geldi
+        } else {
+            thread->join();
         }
+        delete thread;
+    }
+
+    static void ForgetMonitorThreadAfterFork() {
+        g_monitorThread = nullptr;
+        g_monitorRunning = false;
+        g_monitorSlots.clear();
+    }
+
+    static void TightenMonitoring() {
+        {
+            std::lock_guard<std::mutex> lock(g_monitorMutex);
+            if (!g_monitorRunning) return;
+            const auto now = std::chrono::steady_clock::now();
+            AccountWallLocked(now);
+            g_alertSeen = true;
+            g_lastAlert = now;
+            for (std::size_t i = 0; i < g_monitorSlots.size(); ++i) {
+                MonitorSlot& slot = g_monitorSlots[i];
+                slot.interval.Tighten();
+                slot.due = std::min(slot.due, now + std::chrono::milliseconds(slot.interval.Current()));
+            }
+        }
+        g_monitorWake.notify_all();
+    }
+
+    void NotifySensitiveOperation(const std::string& operation) {
+        LogToConsole(security::LogLevel::DEBUG, "[RASP] Sensitive operation: " + operation);
+        TightenMonitoring();
+    }
+
+    int GetCheckIntervalMs(const std::string& checkName) {
+        std::lock_guard<std::mutex> lock(g_monitorMutex);
+        for (std::size_t i = 0; i < g_monitorSlots.size(); ++i) {
+            if (g_monitorSlots[i].check.name == checkName) return g_monitorSlots[i].interval.Current();
+        }
+        return -1;
+    }
 
-        return allPassed;
+    MonitoringStats GetMonitoringStats() {
+        std::lock_guard<std::mutex> lock(g_monitorMutex);
+        if (g_monitorRunning) AccountWallLocked(std::chrono::steady_clock::now());
+        return g_monitorStats;
     }
 
     // =================== Configuration ===================
@@ -0,0 +1,134 @@
+// src/record_store.cpp
+// SQLite -> RecordStore toplu yükleme (tek sıralı geçiş)
+
+#include "record_store.h"
+
+#include <iostream>
+#include <sqlite3.h>
+
+namespace teamcore {
+namespace store {
+
+    // =================== Helper Functions ===================
+    template <std::size_t N>
+    static void CopyField(char (&dst)[N], const std::string& src) {
+        std::size_t n = src.size() < N - 1 ? src.size() : N - 1;
+        std::memcpy(dst, src.data(), n);
+        std::memset(dst + n, 0, N - n);
+    }
+
+    template <std::size_t N>
+    static void CopyColumn(char (&dst)[N], sqlite3_stmt* st, int col) {
+        const char* txt = reinterpret_cast<const char*>(sqlite3_column_text(st, col));
+        CopyField(dst, txt ? std::string(txt, sqlite3_column_bytes(st, col)) : std::string());
+    }
+
+    template <std::size_t N>
+    static void CopyDecoded(char (&dst)[N], sqlite3_stmt* st, int col, const FieldDecoder& decode) {
+        const char* txt = reinterpret_cast<const char*>(sqlite3_column_text(st, col));
+        std::string raw = txt ? std::string(txt, sqlite3_column_bytes(st, col)) : std::string();
+        if (!decode) {
+            CopyField(dst, raw);
+            return;
+        }
+        std::string plain = decode(raw);
+        CopyField(dst, plain);
+        SecureBuffer::secure_bzero(&plain[0], plain.size());
+    }
+
+    static bool PrepareScan(sqlite3* db, sqlite3_stmt** st, const char* sql) {
+        if (!db) return false;
+        if (sqlite3_prepare_v2(db, sql, -1, st, nullptr) != SQLITE_OK) {
+            std::cerr << "prepare failed: " << sqlite3_errmsg(db) << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    // Tek geçiş: satırlar id sırasıyla okunur ve doğrudan slab'a yazılır
+    template <typename T, typename RowFn>
+    static bool ScanInto(sqlite3* db, const char* sql, RecordStore<T>& out, RowFn fillRow) {
+        sqlite3_stmt* st = nullptr;
+        if (!PrepareScan(db, &st, sql)) return false;
+
+        out.Clear();
+        int rc;
+        T rec;
+        while ((rc = sqlite3_step(st)) == SQLITE_ROW) {
+            std::memset(&rec, 0, sizeof(rec));
+            rec.id = static_cast<uint32_t>(sqlite3_column_int64(st, 0));
+            fillRow(st, rec);
+            out.Upsert(rec);
+        }
+        SecureBuffer::secure_bzero(&rec, sizeof(rec));
+        sqlite3_finalize(st);
+        return rc == SQLITE_DONE;
+    }
+
+    // =================== Loaders ===================
+    bool LoadPlayers(sqlite3* db, RecordStore<Player>& out, const FieldDecoder& decode, bool activeOnly) {
+        const char* sql = activeOnly
+            ? "SELECT id,name,position,phone,email,active FROM players WHERE active=1 ORDER BY id;"
+            : "SELECT id,name,position,phone,email,active FROM players ORDER BY id;";
+
+        return ScanInto(db, sql, out, [&decode](sqlite3_stmt* st, Player& p) {
+            CopyColumn(p.name, st, 1);
+            CopyColumn(p.position, st, 2);
+            CopyDecoded(p.phone, st, 3, decode);
+            CopyDecoded(p.email, st, 4, decode);
+            p.active = static_cast<uint8_t>(sqlite3_column_int(st, 5));
+        });
+    }
+
+    bool LoadRoster(sqlite3* db, RecordStore<Player>& out) {
+        return ScanInto(db, "SELECT id,name,position,active FROM players WHERE active=1 ORDER BY id;", out,
+            [](sqlite3_stmt* st, Player& p) {
+                CopyColumn(p.name, st, 1);
+                CopyColumn(p.position, st, 2);
+                p.active = static_cast<uint8_t>(sqlite3_column_int(st, 3));
+            });
+    }
+
+    bool LoadGames(sqlite3* db, RecordStore<Game>& out) {
+        return ScanInto(db, "SELECT id,date,time,opponent,location,played,result FROM games ORDER BY id;", out,
+            [](sqlite3_stmt* st, Game& g) {
+                CopyColumn(g.date, st, 1);
+                CopyColumn(g.time, st, 2);
+                CopyColumn(g.opponent, st, 3);
+                CopyColumn(g.location, st, 4);
+                g.played = static_cast<uint8_t>(sqlite3_column_int(st, 5));
+                CopyColumn(g.result, st, 6);
+            });
+    }
+
+    bool LoadStats(sqlite3* db, RecordStore<Stat>& out) {
+        return ScanInto(db, "SELECT id,gameId,playerId,goals,assists,saves,yellow,red FROM stats ORDER BY id;", out,
+            [](sqlite3_stmt* st, Stat& s) {
+                s.gameId = static_cast<uint32_t>(sqlite3_column_int64(st, 1));
+                s.playerId = static_cast<uint32_t>(sqlite3_column_int64(st, 2));
+                s.goals = sqlite3_column_int(st, 3);
+                s.assists = sqlite3_column_int(st, 4);
+                s.saves = sqlite3_column_int(st, 5);
+                s.yellow = sqlite3_column_int(st, 6);
+                s.red = sqlite3_column_int(st, 7);
+            });
+    }
+
+    bool LoadMessages(sqlite3* db, RecordStore<Message>& out, const FieldDecoder& decode) {
+        return ScanInto(db, "SELECT id,datetime,text FROM messages ORDER BY id;", out,
+            [&decode](sqlite3_stmt* st, Message& m) {
+                CopyColumn(m.datetime, st, 1);
+                CopyDecoded(m.text, st, 2, decode);
+            });
+    }
+
+    bool LoadSnapshot(sqlite3* db, Snapshot& out, const FieldDecoder& decode) {
+        bool ok = LoadPlayers(db, out.players, decode, false);
+        ok = LoadGames(db, out.games) && ok;
+        ok = LoadStats(db, out.stats) && ok;
+        ok = LoadMessages(db, out.messages, decode) && ok;
+        return ok;
+    }
+
+} // namespace store
+} // namespace teamcore
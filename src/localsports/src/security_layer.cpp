@@ -8,6 +8,7 @@
 #include <iostream>
 #include <algorithm>
 #include <vector>
+#include <thread>
 
 #if defined(_WIN32)
 #ifndef NOMINMAX
@@ -21,7 +22,9 @@
 #endif
 
 // OpenSSL includes
+#include <openssl/crypto.h>
 #include <openssl/evp.h>
+#include <openssl/hmac.h>
 #include <openssl/rand.h>
 #include <openssl/sha.h>
 #include <openssl/err.h>
@@ -51,49 +54,77 @@ namespace teamcore {
 #endif
     }
 
+    const std::size_t SecureBuffer::INLINE_CAPACITY;
+
     SecureBuffer::SecureBuffer(std::size_t size) : data_(nullptr), size_(0) {
         if (size > 0) {
-            data_ = new unsigned char[size];
+            data_ = size <= INLINE_CAPACITY ? inline_ : new unsigned char[size];
             size_ = size;
             std::memset(data_, 0, size_);
         }
     }
 
-    SecureBuffer::SecureBuffer(SecureBuffer&& other) noexcept
-        : data_(other.data_), size_(other.size_) {
+    // Tampon içeriğini sil, yığındaysa serbest bırak; nesne boş kalır
+    void SecureBuffer::release() {
+        cleanse();
+        if (isHeap()) delete[] data_;
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    // other'ın içeriğini devral; other her durumda boş kalır
+    void SecureBuffer::takeFrom(SecureBuffer& other) {
+        size_ = other.size_;
+        if (other.isHeap()) {
+            data_ = other.data_;
+        }
+        else if (other.data_) {
+            data_ = inline_;
+            std::memcpy(inline_, other.inline_, size_);
+            secure_bzero(other.inline_, other.size_);
+        }
+        else {
+            data_ = nullptr;
+        }
         other.data_ = nullptr;
         other.size_ = 0;
     }
 
+    SecureBuffer::SecureBuffer(SecureBuffer&& other) noexcept
+        : data_(nullptr), size_(0) {
+        takeFrom(other);
+    }
+
     SecureBuffer& SecureBuffer::operator=(SecureBuffer&& other) noexcept {
         if (this != &other) {
-            cleanse();
-            delete[] data_;
-            data_ = other.data_;
-            size_ = other.size_;
-            other.data_ = nullptr;
-            other.size_ = 0;
+            release();
+            takeFrom(other);
         }
         return *this;
     }
 
     SecureBuffer::~SecureBuffer() {
-        cleanse();
-        delete[] data_;
+        release();
     }
 
     void SecureBuffer::resize(std::size_t newSize) {
         if (newSize == size_) return;
 
         if (newSize == 0) {
-            cleanse();
-            delete[] data_;
-            data_ = nullptr;
-            size_ = 0;
+            release();
+            return;
+        }
+
+        // Satır içinde kalan boyut değişimi: kopya yok, yalnızca kuyruk silinir/sıfırlanır
+        if (newSize <= INLINE_CAPACITY && !isHeap()) {
+            if (newSize < size_) secure_bzero(inline_ + newSize, size_ - newSize);
+            else std::memset(inline_ + size_, 0, newSize - size_);
+            data_ = inline_;
+            size_ = newSize;
             return;
         }
 
-        unsigned char* newData = new unsigned char[newSize];
+        unsigned char* newData = newSize <= INLINE_CAPACITY ? inline_ : new unsigned char[newSize];
         std::size_t copyLen = (size_ < newSize) ? size_ : newSize;
         if (copyLen > 0 && data_)
             std::memcpy(newData, data_, copyLen);
@@ -102,7 +133,7 @@ namespace teamcore {
             std::memset(newData + copyLen, 0, newSize - copyLen);
 
         cleanse();
-        delete[] data_;
+        if (isHeap()) delete[] data_;
         data_ = newData;
         size_ = newSize;
     }
@@ -112,9 +143,165 @@ namespace teamcore {
             secure_bzero(data_, size_);
     }
 
+    // =================== Key Hierarchy Implementation ===================
+    void KeyHierarchy::Init(const unsigned char* rootKey32) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cache_.clear(); // SecureBuffer yıkıcıları siler
+        root_ = SecureBuffer(rootKey32 ? 32 : 0);
+        if (rootKey32) std::memcpy(root_.data(), rootKey32, 32);
+    }
+
+    void KeyHierarchy::Clear() {
+        Init(nullptr);
+    }
+
+    bool KeyHierarchy::IsReady() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return root_.size() == 32;
+    }
+
+    const SecureBuffer* KeyHierarchy::Subkey(const std::string& label) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (root_.size() != 32) return nullptr;
+        std::map<std::string, SecureBuffer>::iterator it = cache_.find(label);
+        if (it != cache_.end()) return &it->second;
+
+        SecureBuffer key(32);
+        if (!crypto::HkdfExpandSha256(root_.data(), root_.size(), label, key.data(), key.size())) return nullptr;
+        return &(cache_[label] = std::move(key));
+    }
+
+    // =================== SecureString Implementation ===================
+    // Başlangıç kapasitesi: tipik parola/telefon/e-posta büyüme (ve silinen eski blok) olmadan sığar
+    static const std::size_t SECURE_STRING_RESERVE = 64;
+
+    SecureString::SecureString() {
+        buf_.reserve(SECURE_STRING_RESERVE);
+        buf_.push_back('\0');
+    }
+
+    SecureString::SecureString(const char* s, std::size_t n) {
+        buf_.reserve(std::max(SECURE_STRING_RESERVE, n + 1));
+        if (s && n) buf_.insert(buf_.end(), s, s + n);
+        buf_.push_back('\0');
+    }
+
+    SecureString::SecureString(SecureString&& other) noexcept : buf_(std::move(other.buf_)) {
+        other.buf_.assign(1, '\0'); // taşınan nesne geçerli boş metin kalır
+    }
+
+    SecureString& SecureString::operator=(SecureString&& other) noexcept {
+        if (this != &other) {
+            clear();
+            buf_.swap(other.buf_);
+            other.clear();
+        }
+        return *this;
+    }
+
+    SecureString::~SecureString() {
+        clear();
+    }
+
+    void SecureString::push_back(char c) {
+        buf_.back() = c;
+        buf_.push_back('\0');
+    }
+
+    void SecureString::pop_back() {
+        if (buf_.size() < 2) return;
+        buf_.pop_back();
+        buf_.back() = '\0';
+    }
+
+    void SecureString::append(const char* s, std::size_t n) {
+        if (!s || n == 0) return;
+        buf_.pop_back();
+        buf_.insert(buf_.end(), s, s + n);
+        buf_.push_back('\0');
+    }
+
+    void SecureString::clear() {
+        if (!buf_.empty()) SecureBuffer::secure_bzero(&buf_[0], buf_.size());
+        buf_.resize(1);
+    }
+
+    bool SecureString::equals(const SecureString& other) const {
+        return size() == other.size() && CRYPTO_memcmp(data(), other.data(), size()) == 0;
+    }
+
     // =================== Crypto Implementation ===================
     namespace crypto {
 
+        bool HkdfExpandSha256(const unsigned char* prk, std::size_t prkLen,
+            const std::string& info,
+            unsigned char* out, std::size_t outLen)
+        {
+            if (!prk || prkLen == 0 || !out || outLen == 0 || outLen > 255 * 32) return false;
+
+            // T(i) = HMAC(PRK, T(i-1) || info || i)
+            std::vector<unsigned char> msg(32 + info.size() + 1);
+            std::size_t msgLen = 0;
+            unsigned char t[32];
+            unsigned int tLen = 0;
+            bool ok = true;
+            for (unsigned char i = 1; ok && outLen > 0; ++i) {
+                if (i > 1) std::memcpy(msg.data(), t, tLen);
+                msgLen = (i > 1 ? tLen : 0);
+                if (!info.empty()) std::memcpy(msg.data() + msgLen, info.data(), info.size());
+                msgLen += info.size();
+                msg[msgLen++] = i;
+                ok = HMAC(EVP_sha256(), prk, static_cast<int>(prkLen), msg.data(), msgLen, t, &tLen) != nullptr &&
+                    tLen == sizeof(t);
+                if (!ok) break;
+                const std::size_t n = std::min<std::size_t>(outLen, tLen);
+                std::memcpy(out, t, n);
+                out += n;
+                outLen -= n;
+            }
+            SecureBuffer::secure_bzero(t, sizeof(t));
+            SecureBuffer::secure_bzero(msg.data(), msg.size());
+            return ok;
+        }
+
+        // ---- Nonce havuzu ----
+        static const std::size_t NONCE_LEN = 12;
+        static const std::size_t NONCE_POOL_SLICES = 64;
+
+        static unsigned long CurrentProcessId() {
+#if defined(_WIN32)
+            return static_cast<unsigned long>(GetCurrentProcessId());
+#else
+            return static_cast<unsigned long>(getpid());
+#endif
+        }
+
+        struct NoncePool {
+            unsigned char bytes[NONCE_LEN * NONCE_POOL_SLICES];
+            std::size_t next;       // sıradaki dilimin ofseti; sizeof(bytes) = boş
+            unsigned long pid;      // tamponu dolduran süreç
+            NoncePool() : next(sizeof(bytes)), pid(0) {}
+            ~NoncePool() { SecureBuffer::secure_bzero(bytes, sizeof(bytes)); }
+        };
+
+        bool GenerateNonce12(unsigned char out[12]) {
+            static thread_local NoncePool pool;
+            const unsigned long pid = CurrentProcessId();
+            // fork edilen çocuk ebeveynin kalan dilimlerini asla kullanmamalı (IV tekrarı = GCM kırılır)
+            if (pool.next >= sizeof(pool.bytes) || pool.pid != pid) {
+                if (RAND_bytes(pool.bytes, static_cast<int>(sizeof(pool.bytes))) != 1) {
+                    pool.next = sizeof(pool.bytes);
+                    return false;
+                }
+                pool.next = 0;
+                pool.pid = pid;
+            }
+            std::memcpy(out, pool.bytes + pool.next, NONCE_LEN);
+            SecureBuffer::secure_bzero(pool.bytes + pool.next, NONCE_LEN);
+            pool.next += NONCE_LEN;
+            return true;
+        }
+
         bool DeriveKeyFromPassphrase(
             const std::string& passphrase,
             const unsigned char* salt,
@@ -135,12 +322,32 @@ namespace teamcore {
             return ret == 1;
         }
 
-        std::string EncryptForDB(
-            const std::string& plaintext,
+        bool DeriveKeyFromPassphrase(
+            const SecureString& passphrase,
+            const unsigned char* salt,
+            std::size_t saltLen,
+            int iterations,
+            unsigned char* outKey32) {
+
+            if (!salt || saltLen == 0 || !outKey32 || iterations < 1)
+                return false;
+
+            return PKCS5_PBKDF2_HMAC(
+                passphrase.data(), static_cast<int>(passphrase.size()),
+                salt, static_cast<int>(saltLen),
+                iterations,
+                EVP_sha256(),
+                32, outKey32) == 1;
+        }
+
+        // Ortak GCM1 mühürleme; düz metin çağıranın tamponundan okunur
+        static std::string SealForDB(
+            const char* plaintext,
+            std::size_t plaintextLen,
             const unsigned char* key32,
             const std::string& aad)
         {
-            if (!key32 || plaintext.empty()) return "";
+            if (!key32 || !plaintext || plaintextLen == 0) return "";
 
             EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
             if (!ctx) return "";
@@ -153,7 +360,7 @@ namespace teamcore {
 
                 // IV olutur (12 bayt)
                 unsigned char iv[12];
-                if (RAND_bytes(iv, sizeof(iv)) != 1)
+                if (!GenerateNonce12(iv))
                     throw std::runtime_error("RAND_bytes failed");
 
                 if (EVP_EncryptInit_ex(ctx, nullptr, nullptr, key32, iv) != 1)
@@ -169,10 +376,10 @@ namespace teamcore {
                 }
 
                 // ifreleme
-                std::vector<unsigned char> ciphertext(plaintext.size() + 16);
+                std::vector<unsigned char> ciphertext(plaintextLen + 16);
                 if (EVP_EncryptUpdate(ctx, ciphertext.data(), &len,
-                    reinterpret_cast<const unsigned char*>(plaintext.data()),
-                    static_cast<int>(plaintext.size())) != 1)
+                    reinterpret_cast<const unsigned char*>(plaintext),
+                    static_cast<int>(plaintextLen)) != 1)
                     throw std::runtime_error("EncryptUpdate failed");
                 int ciphertextLen = len;
 
@@ -213,6 +420,22 @@ namespace teamcore {
             return result;
         }
 
+        std::string EncryptForDB(
+            const std::string& plaintext,
+            const unsigned char* key32,
+            const std::string& aad)
+        {
+            return SealForDB(plaintext.data(), plaintext.size(), key32, aad);
+        }
+
+        std::string EncryptForDB(
+            const SecureString& plaintext,
+            const unsigned char* key32,
+            const std::string& aad)
+        {
+            return SealForDB(plaintext.data(), plaintext.size(), key32, aad);
+        }
+
         std::string DecryptFromDB(
             const std::string& sealed,
             const unsigned char* key32,
@@ -278,6 +501,101 @@ namespace teamcore {
             return result;
         }
 
+        // Toplu şifrelemede bir iş parçacığına düşen en az alan sayısı (altında thread maliyeti baskın)
+        static const std::size_t BATCH_ITEMS_PER_WORKER = 2048;
+
+        // [begin, end) aralığını tek bağlamla şifrele; anahtar bir kez yüklenir, her alanda yalnızca IV değişir
+        static bool EncryptBatchRange(const std::vector<std::string>& plaintexts,
+            const unsigned char* key32,
+            const std::string& aad,
+            std::vector<std::string>& sealed,
+            std::size_t begin,
+            std::size_t end)
+        {
+            EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+            if (!ctx) return false;
+
+            // Tüm IV'ler tek RAND çağrısıyla
+            std::vector<unsigned char> ivs((end - begin) * 12);
+            bool ok = EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), nullptr, key32, nullptr) == 1 &&
+                (ivs.empty() || RAND_bytes(ivs.data(), static_cast<int>(ivs.size())) == 1);
+
+            std::vector<unsigned char> raw;
+            std::vector<unsigned char> b64;
+            for (std::size_t i = begin; ok && i < end; ++i) {
+                const std::string& plain = plaintexts[i];
+                if (plain.empty()) continue; // EncryptForDB ile aynı: boş alan ""
+
+                // IV + ciphertext + tag, sonra base64 (BIO zinciri yerine tek EVP_EncodeBlock)
+                const unsigned char* iv = ivs.data() + (i - begin) * 12;
+                raw.resize(12 + plain.size() + 16);
+                std::memcpy(raw.data(), iv, 12);
+                int len = 0;
+                int cipherLen = 0;
+                ok = EVP_EncryptInit_ex(ctx, nullptr, nullptr, nullptr, iv) == 1 &&
+                    (aad.empty() || EVP_EncryptUpdate(ctx, nullptr, &len,
+                        reinterpret_cast<const unsigned char*>(aad.data()), static_cast<int>(aad.size())) == 1) &&
+                    EVP_EncryptUpdate(ctx, raw.data() + 12, &cipherLen,
+                        reinterpret_cast<const unsigned char*>(plain.data()), static_cast<int>(plain.size())) == 1 &&
+                    EVP_EncryptFinal_ex(ctx, raw.data() + 12 + cipherLen, &len) == 1;
+                if (!ok) break;
+                cipherLen += len;
+                ok = EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, 16, raw.data() + 12 + cipherLen) == 1;
+                if (!ok) break;
+
+                const int rawLen = 12 + cipherLen + 16;
+                b64.resize(4 * ((rawLen + 2) / 3) + 1);
+                const int b64Len = EVP_EncodeBlock(b64.data(), raw.data(), rawLen);
+                std::string& out = sealed[i];
+                out.reserve(5 + b64Len);
+                out.assign("GCM1:");
+                out.append(reinterpret_cast<const char*>(b64.data()), b64Len);
+            }
+
+            if (!raw.empty()) SecureBuffer::secure_bzero(raw.data(), raw.size());
+            EVP_CIPHER_CTX_free(ctx);
+            return ok;
+        }
+
+        bool EncryptBatchForDB(
+            const std::vector<std::string>& plaintexts,
+            const unsigned char* key32,
+            const std::string& aad,
+            std::vector<std::string>& sealed)
+        {
+            sealed.assign(plaintexts.size(), std::string());
+            if (!key32) return false;
+            const std::size_t n = plaintexts.size();
+            if (n == 0) return true;
+
+            // OpenSSL 3.0'da GCM için çok tamponlu/pipeline EVP arayüzü yok; paralellik iş parçacığıyla
+            std::size_t workers = std::thread::hardware_concurrency();
+            workers = std::max<std::size_t>(1, std::min(workers, n / BATCH_ITEMS_PER_WORKER));
+
+            bool ok = true;
+            if (workers == 1) {
+                ok = EncryptBatchRange(plaintexts, key32, aad, sealed, 0, n);
+            }
+            else {
+                std::vector<char> results(workers, 0);
+                std::vector<std::thread> threads;
+                const std::size_t chunk = (n + workers - 1) / workers;
+                for (std::size_t w = 0; w < workers; ++w) {
+                    const std::size_t begin = w * chunk;
+                    const std::size_t end = std::min(n, begin + chunk);
+                    threads.emplace_back([&, w, begin, end]() {
+                        results[w] = EncryptBatchRange(plaintexts, key32, aad, sealed, begin, end) ? 1 : 0;
+                    });
+                }
+                for (std::size_t w = 0; w < threads.size(); ++w) {
+                    threads[w].join();
+                    ok = ok && results[w] != 0;
+                }
+            }
+
+            if (!ok) sealed.clear();
+            return ok;
+        }
 
     } // namespace crypto
 
@@ -291,12 +609,13 @@ namespace teamcore {
 
     static SecureBuffer g_appKey;
     static bool g_appKeyInitialized = false;
+    static KeyHierarchy g_appKeyHierarchy;
 
-    std::string read_password_secure(const std::string& prompt) {
+    SecureString read_password_secure(const std::string& prompt) {
         std::cout << prompt;
         std::cout.flush();
 
-        std::string password;
+        SecureString password;
 
 #if defined(_WIN32)
         char ch;
@@ -318,11 +637,14 @@ namespace teamcore {
 #else
         struct termios oldTermios, newTermios;
         if (tcgetattr(STDIN_FILENO, &oldTermios) != 0)
-            return "";
+            return password;
         newTermios = oldTermios;
         newTermios.c_lflag &= ~(ECHO | ECHONL);
         tcsetattr(STDIN_FILENO, TCSANOW, &newTermios);
-        std::getline(std::cin, password);
+        // Karakter karakter: std::getline'ın büyüyen std::string'i silinmemiş kopya bırakırdı
+        for (int c = std::cin.get(); c != EOF && c != '\n'; c = std::cin.get()) {
+            if (c != '\r') password.push_back(static_cast<char>(c));
+        }
         tcsetattr(STDIN_FILENO, TCSANOW, &oldTermios);
 #endif
         return password;
@@ -332,10 +654,10 @@ namespace teamcore {
         if (g_appKeyInitialized)
             return true;
 
-        std::string passphrase;
+        SecureString passphrase;
         const char* envVal = std::getenv("LS_APP_PASSPHRASE");
         if (envVal)
-            passphrase = envVal;
+            passphrase = SecureString(envVal, std::strlen(envVal));
 
         if (passphrase.empty()) {
             passphrase = read_password_secure("Enter application encryption passphrase: ");
@@ -355,7 +677,7 @@ namespace teamcore {
             return false;
         }
 
-        SecureBuffer::secure_bzero(&passphrase[0], passphrase.size());
+        g_appKeyHierarchy.Init(g_appKey.data());
         g_appKeyInitialized = true;
         return true;
     }
@@ -370,4 +692,8 @@ namespace teamcore {
         return g_appKeyInitialized;
     }
 
+    const SecureBuffer* AppKey_Subkey(const std::string& label) {
+        return g_appKeyInitialized ? g_appKeyHierarchy.Subkey(label) : nullptr;
+    }
+
 } // namespace teamcore
@@ -0,0 +1,154 @@
+// src/sql_functions.cpp
+// SQLite içinde çözme ve istatistik: ls_decrypt + ls_median/ls_stddev/ls_quantile
+
+#include "sql_functions.h"
+#include "security_layer.h"
+#include "mathUtility.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <sqlite3.h>
+
+#ifndef SQLITE_DIRECTONLY
+#define SQLITE_DIRECTONLY 0
+#endif
+#ifndef SQLITE_INNOCUOUS
+#define SQLITE_INNOCUOUS 0
+#endif
+
+using Coruh::Utility::MathUtility;
+
+namespace teamcore {
+namespace sqlfn {
+
+    // =================== ls_decrypt ===================
+    static void DestroyKey(void* p) {
+        delete static_cast<SecureBuffer*>(p);
+    }
+
+    static void LsDecrypt(sqlite3_context* ctx, int, sqlite3_value** argv) {
+        if (sqlite3_value_type(argv[0]) != SQLITE_TEXT) {
+            sqlite3_result_value(ctx, argv[0]); // NULL/sayı/BLOB olduğu gibi
+            return;
+        }
+        const char* text = reinterpret_cast<const char*>(sqlite3_value_text(argv[0]));
+        const int len = sqlite3_value_bytes(argv[0]);
+        if (len < 5 || std::strncmp(text, "GCM1:", 5) != 0) {
+            sqlite3_result_value(ctx, argv[0]); // eski/düz değer
+            return;
+        }
+
+        const SecureBuffer* key = static_cast<const SecureBuffer*>(sqlite3_user_data(ctx));
+        try {
+            std::string plain = crypto::DecryptFromDB(std::string(text, len), key->data(), /*aad*/"");
+            sqlite3_result_text(ctx, plain.data(), static_cast<int>(plain.size()), SQLITE_TRANSIENT);
+            SecureBuffer::secure_bzero(&plain[0], plain.size());
+        }
+        catch (...) {
+            sqlite3_result_null(ctx); // yanlış anahtar / bozuk değer
+        }
+    }
+
+    // =================== Aggregates ===================
+    // Aggregate bağlamı yalnızca bir işaretçi tutar; değerler heap'teki vektörde toplanır
+    struct AggState {
+        std::vector<double> values;
+        double quantile;
+        bool quantileSet;
+        AggState() : quantile(0.0), quantileSet(false) {}
+    };
+
+    static AggState* StateOf(sqlite3_context* ctx, bool create) {
+        AggState** slot = static_cast<AggState**>(sqlite3_aggregate_context(ctx, create ? sizeof(AggState*) : 0));
+        if (!slot) return nullptr;
+        if (!*slot && create) *slot = new AggState();
+        return *slot;
+    }
+
+    static void CollectStep(sqlite3_context* ctx, int, sqlite3_value** argv) {
+        if (sqlite3_value_type(argv[0]) == SQLITE_NULL) return;
+        AggState* st = StateOf(ctx, true);
+        if (!st) {
+            sqlite3_result_error_nomem(ctx);
+            return;
+        }
+        st->values.push_back(sqlite3_value_double(argv[0]));
+    }
+
+    static void QuantileStep(sqlite3_context* ctx, int argc, sqlite3_value** argv) {
+        AggState* st = StateOf(ctx, true);
+        if (!st) {
+            sqlite3_result_error_nomem(ctx);
+            return;
+        }
+        if (!st->quantileSet) {
+            st->quantile = sqlite3_value_double(argv[1]);
+            st->quantileSet = true;
+        }
+        CollectStep(ctx, argc, argv);
+    }
+
+    static void MedianFinal(sqlite3_context* ctx) {
+        AggState* st = StateOf(ctx, false);
+        if (st && !st->values.empty()) {
+            sqlite3_result_double(ctx, MathUtility::calculateMedian(st->values.data(), static_cast<int>(st->values.size())));
+        }
+        else {
+            sqlite3_result_null(ctx);
+        }
+        delete st;
+    }
+
+    static void StdDevFinal(sqlite3_context* ctx) {
+        AggState* st = StateOf(ctx, false);
+        if (st && !st->values.empty()) {
+            sqlite3_result_double(ctx, MathUtility::calculateStdDev(st->values.data(), static_cast<int>(st->values.size())));
+        }
+        else {
+            sqlite3_result_null(ctx);
+        }
+        delete st;
+    }
+
+    static void QuantileFinal(sqlite3_context* ctx) {
+        AggState* st = StateOf(ctx, false);
+        if (st && st->quantileSet && (st->quantile < 0.0 || st->quantile > 1.0)) {
+            sqlite3_result_error(ctx, "ls_quantile: q 0 ile 1 arasinda olmali", -1);
+        }
+        else if (st && !st->values.empty()) {
+            sqlite3_result_double(ctx, MathUtility::calculateQuantile(st->values.data(),
+                static_cast<int>(st->values.size()), st->quantile));
+        }
+        else {
+            sqlite3_result_null(ctx);
+        }
+        delete st;
+    }
+
+    // =================== Registration ===================
+    bool RegisterSqlFunctions(sqlite3* db, const unsigned char* key32) {
+        if (!db) return false;
+        const int pure = SQLITE_UTF8 | SQLITE_DETERMINISTIC | SQLITE_INNOCUOUS;
+        bool ok = true;
+
+        if (key32) {
+            SecureBuffer* key = new SecureBuffer(32);
+            std::memcpy(key->data(), key32, 32);
+            // Hata durumunda da xDestroy çağrılır; anahtar sızmaz
+            ok = sqlite3_create_function_v2(db, "ls_decrypt", 1,
+                SQLITE_UTF8 | SQLITE_DETERMINISTIC | SQLITE_DIRECTONLY,
+                key, LsDecrypt, nullptr, nullptr, DestroyKey) == SQLITE_OK;
+        }
+        ok = sqlite3_create_function_v2(db, "ls_median", 1, pure, nullptr,
+            nullptr, CollectStep, MedianFinal, nullptr) == SQLITE_OK && ok;
+        ok = sqlite3_create_function_v2(db, "ls_stddev", 1, pure, nullptr,
+            nullptr, CollectStep, StdDevFinal, nullptr) == SQLITE_OK && ok;
+        ok = sqlite3_create_function_v2(db, "ls_quantile", 2, pure, nullptr,
+            nullptr, QuantileStep, QuantileFinal, nullptr) == SQLITE_OK && ok;
+        return ok;
+    }
+
+} // namespace sqlfn
+} // namespace teamcore
@@ -0,0 +1,192 @@
+// src/tenant_router.cpp
+// Kiracı (kulüp) başına veritabanı yönlendirme, lazy açılış ve LRU bağlantı limiti
+
+#include "tenant_router.h"
+
+#include <cctype>
+#include <iostream>
+
+#include <sqlite3.h>
+#include <sys/stat.h>
+#if defined(_WIN32)
+#include <direct.h>
+#endif
+
+namespace teamcore {
+namespace tenant {
+
+    // =================== Helper Functions ===================
+    static void EnsureDirectory(const std::string& dir) {
+        if (dir.empty()) return;
+#if defined(_WIN32)
+        _mkdir(dir.c_str());
+#else
+        mkdir(dir.c_str(), 0700);
+#endif
+    }
+
+    // =================== TenantLease ===================
+    TenantLease::TenantLease(TenantLease&& other)
+        : router_(other.router_), db_(other.db_), tenantId_(std::move(other.tenantId_)) {
+        other.router_ = nullptr;
+        other.db_ = nullptr;
+    }
+
+    TenantLease& TenantLease::operator=(TenantLease&& other) {
+        if (this != &other) {
+            Release();
+            router_ = other.router_;
+            db_ = other.db_;
+            tenantId_ = std::move(other.tenantId_);
+            other.router_ = nullptr;
+            other.db_ = nullptr;
+        }
+        return *this;
+    }
+
+    void TenantLease::Release() {
+        if (router_ && db_) router_->Unpin(tenantId_);
+        router_ = nullptr;
+        db_ = nullptr;
+    }
+
+    // =================== TenantRouter ===================
+    TenantRouter::TenantRouter(const RouterConfig& config) : config_(config) {
+        if (config_.maxOpen == 0) config_.maxOpen = 1;
+        if (config_.openFlags == 0) {
+            config_.openFlags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX | SQLITE_OPEN_URI;
+        }
+        EnsureDirectory(config_.baseDir);
+    }
+
+    TenantRouter::~TenantRouter() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = open_.begin(); it != open_.end(); ++it) {
+            if (it->second.pins > 0) {
+                std::cerr << "Uyari: kiraci baglantisi kullanimdayken kapatiliyor: " << it->first << "\n";
+            }
+            sqlite3_close_v2(it->second.db);
+        }
+        open_.clear();
+        lru_.clear();
+    }
+
+    bool TenantRouter::IsValidTenantId(const std::string& tenantId) {
+        if (tenantId.empty() || tenantId.size() > 64) return false;
+        for (std::size_t i = 0; i < tenantId.size(); ++i) {
+            unsigned char c = static_cast<unsigned char>(tenantId[i]);
+            if (!(std::islower(c) || std::isdigit(c) || c == '_' || c == '-')) return false;
+        }
+        return true;
+    }
+
+    std::string TenantRouter::PathFor(const std::string& tenantId) const {
+        if (config_.baseDir.empty()) return tenantId + ".db";
+        return config_.baseDir + "/" + tenantId + ".db";
+    }
+
+    TenantLease TenantRouter::Acquire(const std::string& tenantId) {
+        if (!IsValidTenantId(tenantId)) {
+            std::cerr << "Gecersiz kiraci kimligi: " << tenantId << "\n";
+            return TenantLease();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = open_.find(tenantId);
+        if (it != open_.end()) {
+            stats_.hits++;
+            it->second.pins++;
+            lru_.splice(lru_.begin(), lru_, it->second.lruPos);
+            return TenantLease(this, tenantId, it->second.db);
+        }
+
+        if (open_.size() >= config_.maxOpen && !EvictOneLocked()) {
+            stats_.rejected++;
+            std::cerr << "Acik baglanti limiti dolu (" << config_.maxOpen << "), tumu kullanimda.\n";
+            return TenantLease();
+        }
+
+        sqlite3* db = nullptr;
+        const std::string path = PathFor(tenantId);
+        if (sqlite3_open_v2(path.c_str(), &db, config_.openFlags,
+                            config_.vfs.empty() ? nullptr : config_.vfs.c_str()) != SQLITE_OK) {
+            std::cerr << "Kiraci DB acilamadi (" << path << "): " << (db ? sqlite3_errmsg(db) : "(null)") << "\n";
+            sqlite3_close(db);
+            return TenantLease();
+        }
+        if (config_.setup && !config_.setup(db)) {
+            std::cerr << "Kiraci DB kurulumu basarisiz: " << path << "\n";
+            sqlite3_close(db);
+            return TenantLease();
+        }
+
+        stats_.opens++;
+        lru_.push_front(tenantId);
+        Entry e;
+        e.db = db;
+        e.pins = 1;
+        e.lruPos = lru_.begin();
+        open_[tenantId] = e;
+        return TenantLease(this, tenantId, db);
+    }
+
+    bool TenantRouter::Close(const std::string& tenantId) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = open_.find(tenantId);
+        if (it == open_.end() || it->second.pins > 0) return false;
+        CloseLocked(it);
+        return true;
+    }
+
+    void TenantRouter::CloseIdle() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = open_.begin(); it != open_.end();) {
+            auto next = it;
+            ++next;
+            if (it->second.pins == 0) CloseLocked(it);
+            it = next;
+        }
+    }
+
+    std::size_t TenantRouter::OpenCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return open_.size();
+    }
+
+    bool TenantRouter::IsOpen(const std::string& tenantId) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return open_.find(tenantId) != open_.end();
+    }
+
+    RouterStats TenantRouter::Stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    void TenantRouter::Unpin(const std::string& tenantId) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = open_.find(tenantId);
+        if (it != open_.end() && it->second.pins > 0) it->second.pins--;
+    }
+
+    // LRU sonundan başlayarak ilk pin'lenmemiş bağlantıyı kapat
+    bool TenantRouter::EvictOneLocked() {
+        for (auto pos = lru_.rbegin(); pos != lru_.rend(); ++pos) {
+            auto it = open_.find(*pos);
+            if (it != open_.end() && it->second.pins == 0) {
+                CloseLocked(it);
+                stats_.evictions++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void TenantRouter::CloseLocked(std::unordered_map<std::string, Entry>::iterator it) {
+        sqlite3_close_v2(it->second.db);
+        lru_.erase(it->second.lruPos);
+        open_.erase(it);
+    }
+
+} // namespace tenant
+} // namespace teamcore
@@ -0,0 +1,430 @@
+// src/zygote.cpp
+// Ön-başlatılmış zygote: hazırlık bir kez yapılır, her komut için fork edilen worker çalışır
+
+#include "zygote.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace teamcore {
+namespace zygote {
+
+#if !defined(_WIN32)
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+    static const char MAGIC[4] = { 'L', 'S', 'Z', '1' };
+    static const uint32_t MAX_ARGS = 256;
+    static const uint32_t MAX_ARG_BYTES = 64 * 1024;
+
+    // =================== Helper Functions ===================
+    static bool WriteAll(int fd, const void* data, size_t len) {
+        const char* p = static_cast<const char*>(data);
+        while (len > 0) {
+            const ssize_t n = send(fd, p, len, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            p += n;
+            len -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    static bool ReadAll(int fd, void* data, size_t len) {
+        char* p = static_cast<char*>(data);
+        while (len > 0) {
+            const ssize_t n = read(fd, p, len);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            p += n;
+            len -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    static void SetCloseOnExec(int fd) {
+        const int flags = fcntl(fd, F_GETFD);
+        if (flags >= 0) fcntl(fd, F_SETFD, flags | FD_CLOEXEC);
+    }
+
+    static bool FillAddress(const std::string& path, sockaddr_un* addr) {
+        std::memset(addr, 0, sizeof(*addr));
+        addr->sun_family = AF_UNIX;
+        if (path.empty() || path.size() >= sizeof(addr->sun_path)) return false;
+        std::memcpy(addr->sun_path, path.c_str(), path.size() + 1);
+        return true;
+    }
+
+    static int Connect(const std::string& path) {
+        sockaddr_un addr;
+        if (!FillAddress(path, &addr)) return -1;
+        const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+        SetCloseOnExec(fd);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    static bool PeerIsSameUser(int fd) {
+#if defined(__linux__)
+        struct ucred cred;
+        socklen_t len = sizeof(cred);
+        if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0) return false;
+        return cred.uid == geteuid();
+#else
+        uid_t uid = 0;
+        gid_t gid = 0;
+        if (getpeereid(fd, &uid, &gid) != 0) return false;
+        return uid == geteuid();
+#endif
+    }
+
+    // Soketin dizini başka kullanıcıların yazabileceği bir yerde olmamalı (ör. yapışkan /tmp):
+    // orada yolu önceden oluşturan biri istemcinin terminalini alabilirdi
+    static bool ParentDirIsPrivate(const std::string& path) {
+        const std::string::size_type slash = path.rfind('/');
+        const std::string dir = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+        struct stat st;
+        if (stat(dir.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) return false;
+        return st.st_uid == geteuid() && (st.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+    }
+
+    // =================== Protocol ===================
+    // İstek: "LSZ1" + SCM_RIGHTS{stdin, stdout, stderr}, u32 argc, her argüman için u32 uzunluk + baytlar
+    // Yanıt: worker bittiğinde int32 çıkış kodu (sinyalle ölürse 128 + sinyal)
+    static bool SendRequest(int fd, const std::vector<std::string>& args) {
+        int fds[3] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+        char control[CMSG_SPACE(sizeof(fds))];
+        std::memset(control, 0, sizeof(control));
+        iovec iov;
+        iov.iov_base = const_cast<char*>(MAGIC);
+        iov.iov_len = sizeof(MAGIC);
+        msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        cmsghdr* cm = CMSG_FIRSTHDR(&msg);
+        cm->cmsg_level = SOL_SOCKET;
+        cm->cmsg_type = SCM_RIGHTS;
+        cm->cmsg_len = CMSG_LEN(sizeof(fds));
+        std::memcpy(CMSG_DATA(cm), fds, sizeof(fds));
+        ssize_t n;
+        do { n = sendmsg(fd, &msg, MSG_NOSIGNAL); } while (n < 0 && errno == EINTR);
+        if (n != static_cast<ssize_t>(sizeof(MAGIC))) return false;
+
+        std::string payload;
+        const uint32_t argc = static_cast<uint32_t>(args.size());
+        payload.append(reinterpret_cast<const char*>(&argc), sizeof(argc));
+        for (size_t i = 0; i < args.size(); ++i) {
+            const uint32_t len = static_cast<uint32_t>(args[i].size());
+            payload.append(reinterpret_cast<const char*>(&len), sizeof(len));
+            payload += args[i];
+        }
+        return WriteAll(fd, payload.data(), payload.size());
+    }
+
+    static bool ReceiveRequest(int fd, int fds[3], std::vector<std::string>* args) {
+        char magic[sizeof(MAGIC)];
+        char control[CMSG_SPACE(3 * sizeof(int))];
+        iovec iov;
+        iov.iov_base = magic;
+        iov.iov_len = sizeof(magic);
+        msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        ssize_t n;
+        do { n = recvmsg(fd, &msg, 0); } while (n < 0 && errno == EINTR);
+        if (n <= 0) return false;
+
+        int received = 0;
+        for (cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+            if (cm->cmsg_level != SOL_SOCKET || cm->cmsg_type != SCM_RIGHTS) continue;
+            const size_t count = (cm->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            for (size_t i = 0; i < count; ++i) {
+                int got;
+                std::memcpy(&got, CMSG_DATA(cm) + i * sizeof(int), sizeof(int));
+                if (received < 3) fds[received++] = got;
+                else close(got);
+            }
+        }
+        bool ok = received == 3 && (msg.msg_flags & MSG_CTRUNC) == 0 &&
+            ReadAll(fd, magic + n, sizeof(magic) - static_cast<size_t>(n)) &&
+            std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+
+        uint32_t argc = 0;
+        ok = ok && ReadAll(fd, &argc, sizeof(argc)) && argc <= MAX_ARGS;
+        for (uint32_t i = 0; ok && i < argc; ++i) {
+            uint32_t len = 0;
+            ok = ReadAll(fd, &len, sizeof(len)) && len <= MAX_ARG_BYTES;
+            if (!ok) break;
+            std::string arg(len, '\0');
+            ok = len == 0 || ReadAll(fd, &arg[0], len);
+            args->push_back(arg);
+        }
+        if (!ok) {
+            for (int i = 0; i < received; ++i) close(fds[i]);
+        }
+        return ok;
+    }
+
+    // =================== Worker ===================
+    static void FlushStdio() {
+        std::cout.flush();
+        std::cerr.flush();
+        std::fflush(nullptr);
+    }
+
+    // Ebeveynin tek bağlantılık çocuğu: isteği alır, worker'ı fork eder, bitince kodu bildirir.
+    // İstemci bağlantısı koparsa (Ctrl-C ile kapanan terminal vb.) worker sonlandırılır.
+    static int Supervise(int conn, const ZygoteConfig& config, const Handler& handler) {
+        int fds[3];
+        std::vector<std::string> args;
+        if (!ReceiveRequest(conn, fds, &args)) {
+            std::cerr << "[ZYGOTE] Gecersiz istek.\n";
+            return 1;
+        }
+        int done[2];
+        if (pipe(done) != 0) {
+            std::cerr << "[ZYGOTE] pipe basarisiz: " << std::strerror(errno) << "\n";
+            return 1;
+        }
+
+        const pid_t worker = fork();
+        if (worker == 0) {
+            close(conn);
+            close(done[0]);
+            SetCloseOnExec(done[1]); // worker'ın başlattığı programlar bitişi geciktirmesin
+            for (int i = 0; i < 3; ++i) {
+                dup2(fds[i], i);
+            }
+            for (int i = 0; i < 3; ++i) {
+                if (fds[i] > STDERR_FILENO) close(fds[i]);
+            }
+            // Yeni oturum: istemcinin terminalinden okurken arka plan grubu (SIGTTIN) olmayız
+            setsid();
+            std::signal(SIGCHLD, SIG_DFL);
+            if (config.afterFork) config.afterFork();
+            const int rc = handler(args);
+            FlushStdio();
+            _exit(rc & 0xff);
+        }
+        close(done[1]);
+        for (int i = 0; i < 3; ++i) close(fds[i]);
+        if (worker < 0) {
+            std::cerr << "[ZYGOTE] fork basarisiz: " << std::strerror(errno) << "\n";
+            close(done[0]);
+            return 1;
+        }
+
+        // Worker çıkınca pipe'ın yazma ucu kapanır; istemci giderse bağlantı okunabilir olur
+        pollfd p[2];
+        p[0].fd = done[0];
+        p[0].events = POLLIN;
+        p[1].fd = conn;
+        p[1].events = POLLIN;
+        for (;;) {
+            p[0].revents = p[1].revents = 0;
+            const int r = poll(p, 2, -1);
+            if (r < 0 && errno == EINTR) continue;
+            if (r < 0 || p[0].revents) break;
+            if (p[1].revents) {
+                kill(worker, SIGTERM);
+                break;
+            }
+        }
+        close(done[0]);
+
+        int status = 0;
+        while (waitpid(worker, &status, 0) < 0 && errno == EINTR) {}
+        const int32_t code = WIFEXITED(status) ? WEXITSTATUS(status)
+            : WIFSIGNALED(status) ? 128 + WTERMSIG(status) : 1;
+        WriteAll(conn, &code, sizeof(code));
+        return 0;
+    }
+
+    static void ReapChildren(std::vector<pid_t>& children, bool block) {
+        for (size_t i = 0; i < children.size();) {
+            pid_t r;
+            do { r = waitpid(children[i], nullptr, block ? 0 : WNOHANG); } while (r < 0 && errno == EINTR);
+            if (r == 0) {
+                ++i;
+                continue;
+            }
+            children[i] = children.back();
+            children.pop_back();
+        }
+    }
+
+    // =================== Server ===================
+    bool Serve(const ZygoteConfig& config, const Handler& handler) {
+        const std::string path = config.socketPath.empty() ? DefaultSocketPath() : config.socketPath;
+        sockaddr_un addr;
+        if (!FillAddress(path, &addr)) {
+            std::cerr << "[ZYGOTE] Gecersiz soket yolu: " << path << "\n";
+            return false;
+        }
+        if (!ParentDirIsPrivate(path)) {
+            std::cerr << "[ZYGOTE] Soket dizini kullaniciya ait degil veya baskalarinca yazilabilir: " << path << "\n";
+            return false;
+        }
+        const int probe = Connect(path);
+        if (probe >= 0) {
+            close(probe);
+            std::cerr << "[ZYGOTE] Bu sokette zaten bir zygote calisiyor: " << path << "\n";
+            return false;
+        }
+        unlink(path.c_str()); // önceki çalışmadan kalan soket dosyası
+
+        const int lfd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (lfd < 0) {
+            std::cerr << "[ZYGOTE] socket basarisiz: " << std::strerror(errno) << "\n";
+            return false;
+        }
+        SetCloseOnExec(lfd);
+        const mode_t oldMask = umask(077);
+        const bool bound = bind(lfd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+        umask(oldMask);
+        if (!bound || chmod(path.c_str(), 0600) != 0 || listen(lfd, 16) != 0) {
+            std::cerr << "[ZYGOTE] Soket dinlenemedi: " << path << " (" << std::strerror(errno) << ")\n";
+            close(lfd);
+            return false;
+        }
+
+        std::vector<pid_t> children;
+        int served = 0;
+        const int idleMs = config.idleIntervalMs > 0 ? config.idleIntervalMs : 1000;
+        std::chrono::steady_clock::time_point nextIdle = std::chrono::steady_clock::now() + std::chrono::milliseconds(idleMs);
+        while (config.maxRequests <= 0 || served < config.maxRequests) {
+            ReapChildren(children, false);
+            // Yoğun bağlantı altında da onIdle aralığı aşılmaz
+            if (config.onIdle && std::chrono::steady_clock::now() >= nextIdle) {
+                config.onIdle();
+                nextIdle = std::chrono::steady_clock::now() + std::chrono::milliseconds(idleMs);
+            }
+            pollfd p;
+            p.fd = lfd;
+            p.events = POLLIN;
+            p.revents = 0;
+            const int r = poll(&p, 1, config.onIdle ? idleMs : 1000);
+            if (r <= 0) {
+                if (r < 0 && errno != EINTR) break;
+                continue;
+            }
+            const int conn = accept(lfd, nullptr, nullptr);
+            if (conn < 0) continue;
+            SetCloseOnExec(conn);
+            if (!PeerIsSameUser(conn)) {
+                std::cerr << "[ZYGOTE] Baska kullanicidan baglanti reddedildi.\n";
+                close(conn);
+                continue;
+            }
+
+            FlushStdio(); // ebeveynin tamponu çocuklarda ikinci kez yazılmasın
+            const pid_t pid = fork();
+            if (pid == 0) {
+                close(lfd);
+                const int rc = Supervise(conn, config, handler);
+                close(conn);
+                _exit(rc);
+            }
+            close(conn);
+            if (pid < 0) {
+                std::cerr << "[ZYGOTE] fork basarisiz: " << std::strerror(errno) << "\n";
+                continue;
+            }
+            children.push_back(pid);
+            ++served;
+        }
+
+        close(lfd);
+        unlink(path.c_str());
+        ReapChildren(children, true);
+        return true;
+    }
+
+    // =================== Client ===================
+    int RunClient(const std::string& socketPath, const std::vector<std::string>& args) {
+        if (!ParentDirIsPrivate(socketPath)) {
+            std::cerr << "[ZYGOTE] Guvensiz soket dizini, zygote kullanilmiyor: " << socketPath << "\n";
+            return -1;
+        }
+        const int fd = Connect(socketPath);
+        if (fd < 0) return -1;
+        // Terminal yalnızca aynı kullanıcının zygote'una devredilir
+        if (!PeerIsSameUser(fd)) {
+            std::cerr << "[ZYGOTE] Soketi baska bir kullanici dinliyor, zygote kullanilmiyor: " << socketPath << "\n";
+            close(fd);
+            return -1;
+        }
+        FlushStdio(); // worker aynı tanımlayıcılara yazacak; sıra korunmalı
+        if (!SendRequest(fd, args)) {
+            close(fd);
+            return -1; // istek tamamlanmadı: worker başlamadı
+        }
+        int32_t code = 1;
+        if (!ReadAll(fd, &code, sizeof(code))) {
+            std::cerr << "[ZYGOTE] Worker baglantisi koptu.\n";
+            code = 1;
+        }
+        close(fd);
+        return code;
+    }
+
+    std::string DefaultSocketPath() {
+        const char* runtimeDir = std::getenv("XDG_RUNTIME_DIR");
+        if (runtimeDir && *runtimeDir) {
+            return std::string(runtimeDir) + "/localsports.zygote";
+        }
+        const char* home = std::getenv("HOME");
+        if (home && *home) {
+            return std::string(home) + "/.localsports.zygote";
+        }
+        return std::string();
+    }
+
+#else // _WIN32
+
+    bool Serve(const ZygoteConfig&, const Handler&) {
+        std::cerr << "[ZYGOTE] Bu platformda desteklenmiyor (fork gerekli).\n";
+        return false;
+    }
+
+    int RunClient(const std::string&, const std::vector<std::string>&) {
+        return -1;
+    }
+
+    std::string DefaultSocketPath() {
+        return std::string();
+    }
+
+#endif
+
+} // namespace zygote
+} // namespace teamcore
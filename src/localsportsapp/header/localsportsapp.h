@@ -5,4 +5,8 @@
 // Starts the console app (auth + main menu)
 void LS_AppStart();
 
+// Zygote mode: preloads keys once, then forks a worker running the app per client connection
+// (nullptr/"" socketPath = default path). Returns the process exit code.
+int LS_AppServeZygote(const char* socketPath);
+
 #endif // LOCALSPORTSAPP_H
@@ -3,13 +3,17 @@
 #include "localsports.h"
 #include "rasp.h"
 #include "security_config.h"
+#include "zygote.h"
 
 #include <iostream>
+#include <cstdlib>
+#include <cstring>
 #include <string>
 #include <iomanip>
 #include <limits>
 #include <thread>
 #include <chrono>
+#include <vector>
 
 // Windows color codes
 #ifdef _WIN32
@@ -82,6 +86,15 @@ static void banner() {
     std::cout << "================================================================================\n";
     setColor(COLOR_RESET);
     
+    if (LS_CurrentTenant()) {
+        setColor(COLOR_GREEN);
+        std::cout << "  Kulup: ";
+        setColor(COLOR_YELLOW);
+        std::cout << LS_CurrentTenant();
+        setColor(COLOR_RESET);
+        std::cout << "\n";
+    }
+    
     if (LS_IsAuthenticated()) {
         setColor(COLOR_GREEN);
         std::cout << "  Kullanici: ";
@@ -89,6 +102,16 @@ static void banner() {
         std::cout << (LS_CurrentUsername() ? LS_CurrentUsername() : "(yok)");
         setColor(COLOR_RESET);
         std::cout << "\n";
+
+        const int unread = LS_UnreadMessageCount();
+        if (unread > 0) {
+            setColor(COLOR_GREEN);
+            std::cout << "  Okunmamis mesaj: ";
+            setColor(COLOR_YELLOW);
+            std::cout << unread;
+            setColor(COLOR_RESET);
+            std::cout << "\n";
+        }
     }
     
     setColor(COLOR_CYAN);
@@ -162,6 +185,7 @@ static void statsMenu() {
         setColor(COLOR_RESET);
         std::cout << "  1) Mac icin oyuncu istatistigi ekle\n"
                   << "  2) Oyuncu toplamlarini goruntule\n"
+                  << "  3) Tum sezonlar (arsiv dahil) toplamlari\n"
                   << "  0) Geri\n\n";
         
         int sel = readInt("Seciminiz: ");
@@ -170,6 +194,7 @@ static void statsMenu() {
         switch (sel) {
         case 1: LS_RecordStatsInteractive(); break;
         case 2: LS_ViewPlayerTotalsInteractive(); break;
+        case 3: LS_ViewAllSeasonTotalsInteractive(); break;
         default: 
             setColor(COLOR_RED);
             std::cout << "Gecersiz secim.\n";
@@ -188,6 +213,7 @@ static void commsMenu() {
         setColor(COLOR_RESET);
         std::cout << "  1) Duyuru/Mesaj olustur\n"
                   << "  2) Mesajlari listele\n"
+                  << "  3) Mesajlarda ara\n"
                   << "  0) Geri\n\n";
         
         int sel = readInt("Seciminiz: ");
@@ -196,6 +222,37 @@ static void commsMenu() {
         switch (sel) {
         case 1: LS_AddMessageInteractive(); break;
         case 2: LS_ListMessagesInteractive(); break;
+        case 3: LS_SearchMessagesInteractive(); break;
+        default: 
+            setColor(COLOR_RED);
+            std::cout << "Gecersiz secim.\n";
+            setColor(COLOR_RESET);
+            break;
+        }
+        waitForEnter();
+    }
+}
+
+static void dataMenu() {
+    while (true) {
+        banner();
+        setColor(COLOR_YELLOW);
+        std::cout << "\n[VERI YONETIMI]\n";
+        setColor(COLOR_RESET);
+        std::cout << "  1) Yedek al (canli, arka planda)\n"
+                  << "  2) Yedekten geri yukle\n"
+                  << "  3) Bakim durumu (WAL/checkpoint)\n"
+                  << "  4) Kapanan sezonu arsivle\n"
+                  << "  0) Geri\n\n";
+        
+        int sel = readInt("Seciminiz: ");
+        if (sel == 0) return;
+        std::cout << "\n";
+        switch (sel) {
+        case 1: LS_BackupInteractive(); break;
+        case 2: LS_RestoreInteractive(); break;
+        case 3: LS_MaintenanceStatusInteractive(); break;
+        case 4: LS_ArchiveSeasonInteractive(); break;
         default: 
             setColor(COLOR_RED);
             std::cout << "Gecersiz secim.\n";
@@ -203,6 +260,7 @@ static void commsMenu() {
             break;
         }
         waitForEnter();
+        if (!LS_IsAuthenticated()) return;
     }
 }
 
@@ -214,6 +272,7 @@ static void authGate() {
         setColor(COLOR_RESET);
         std::cout << "  1) Giris yap\n"
                   << "  2) Kayit ol\n"
+                  << "  3) Kulup sec\n"
                   << "  0) Cikis\n\n";
         
         int sel = readInt("Seciminiz: ");
@@ -225,6 +284,9 @@ static void authGate() {
         else if (sel == 2) {
             LS_AuthRegisterInteractive();
         }
+        else if (sel == 3) {
+            LS_SelectTenantInteractive();
+        }
         else {
             setColor(COLOR_RED);
             std::cout << "Gecersiz secim.\n";
@@ -234,15 +296,48 @@ static void authGate() {
     }
 }
 
-void LS_AppStart() {
+// Ortam değişkenlerinden veritabanı ayarları (LS_Init/LS_Preload'dan önce)
+static void configureFromEnv() {
+    // Sayfa duzeyinde sifreleme: yeni veritabanlari "ls-crypt" VFS ile olusturulur
+    const char* encMode = std::getenv("LS_DB_ENCRYPTION");
+    if (encMode && std::strcmp(encMode, "page") == 0) {
+        LS_SetEncryptionMode(LS_ENCRYPT_PAGES);
+    }
+    // Sayfa checksum'i (alan sifreleme modunda): yeni veritabanlari "ls-cksum" VFS ile olusturulur
+    const char* checksums = std::getenv("LS_DB_CHECKSUMS");
+    if (checksums && std::strcmp(checksums, "1") == 0) {
+        LS_SetPageChecksums(true);
+    }
+    // Veritabani yolu ve depolama modu (memory: turnuva gunu kiosklari icin RAM'den okuma)
+    const char* dbPath = std::getenv("LS_DB_PATH");
+    if (dbPath && *dbPath) {
+        LS_SetDatabasePath(dbPath);
+    }
+    const char* dbMode = std::getenv("LS_DB_MODE");
+    if (dbMode && std::strcmp(dbMode, "memory") == 0) {
+        LS_SetStorageMode(LS_STORAGE_MEMORY);
+    }
+}
+
+// Veritabanı + kiracı + menü; zygote worker'ında da aynı yol çalışır
+static void runSession(bool splash) {
     LS_Init();
     
+    // Coklu kulup barindirma: LS_TENANT verilmisse o kulubun veritabani kullanilir
+    const char* tenantId = std::getenv("LS_TENANT");
+    if (tenantId && *tenantId && !LS_SelectTenant(tenantId)) {
+        std::cerr << "Kulup veritabani acilamadi: " << tenantId << "\n";
+        std::exit(1);
+    }
+    
     // Sistem başlatma
     clearScreen();
-    setColor(COLOR_CYAN);
-    std::cout << "\n\n        SISTEM BASLATILIYOR...\n";
-    setColor(COLOR_RESET);
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    if (splash) {
+        setColor(COLOR_CYAN);
+        std::cout << "\n\n        SISTEM BASLATILIYOR...\n";
+        setColor(COLOR_RESET);
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
     
     authGate();
 
@@ -256,6 +351,7 @@ void LS_AppStart() {
                   << "  3) Statistic Tracker  - Istatistik ve performans analizi\n"
                   << "  4) Communication Tool - Duyuru ve mesajlasma\n"
                   << "  5) Oturumu kapat      - Guvenli cikis yap\n"
+                  << "  6) Veri Yonetimi      - Yedek, bakim, sezon arsivi\n"
                   << "  0) Programdan cik     - Uygulamayi sonlandir\n\n";
         
         int sel = readInt("Seciminiz: ");
@@ -286,9 +382,13 @@ void LS_AppStart() {
             LS_AuthLogout(); 
             authGate(); 
             break;
+        case 6: 
+            dataMenu(); 
+            authGate(); 
+            break;
         default: 
             setColor(COLOR_RED);
-            std::cout << "\nGecersiz secim. Lutfen 0-5 arasi bir deger girin.\n";
+            std::cout << "\nGecersiz secim. Lutfen 0-6 arasi bir deger girin.\n";
             setColor(COLOR_RESET);
             std::this_thread::sleep_for(std::chrono::milliseconds(1000));
             break;
@@ -296,11 +396,53 @@ void LS_AppStart() {
     }
 }
 
+void LS_AppStart() {
+    configureFromEnv();
+    runSession(true);
+}
 
+int LS_AppServeZygote(const char* socketPath) {
+    configureFromEnv();
+    if (!LS_Preload()) {
+        return 1;
+    }
+    teamcore::zygote::ZygoteConfig config;
+    config.socketPath = socketPath && *socketPath ? socketPath : teamcore::zygote::DefaultSocketPath();
+    config.afterFork = []() { teamcore::rasp::ReinitializeAfterFork(); };
+    // Zygote tek thread'li fork eder: izleme thread'leri durur, kontroller bağlantılar arasında
+    // bu thread'de yapılır; worker'da ReinitializeAfterFork izlemeyi yeniden başlatır
+    teamcore::rasp::StopBackgroundThreads();
+    config.onIdle = []() {
+        if (teamcore::rasp::IsRASPActive()) teamcore::rasp::PerformSecurityScanInline();
+    };
+    config.idleIntervalMs = teamcore::rasp::GetRASPConfig().monitoringIntervalMs;
 
-int main() {
+    setColor(COLOR_GREEN);
+    std::cout << "Zygote hazir: " << config.socketPath << "\n";
+    setColor(COLOR_RESET);
+    const bool ok = teamcore::zygote::Serve(config, [](const std::vector<std::string>&) {
+        runSession(false);
+        return 0;
+    });
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
     using namespace teamcore::security;
     using namespace teamcore::rasp;
+
+    // =================== Zygote Client ===================
+    // LS_ZYGOTE_SOCKET ayarlıysa hazır bekleyen zygote'tan worker iste; RASP, AppKey KDF ve
+    // VFS orada bir kez yapıldı. Bu süreç yalnızca terminalini devreder ve çıkış kodunu bekler.
+    const bool serveZygote = argc > 1 && std::strcmp(argv[1], "--zygote") == 0;
+    const char* zygoteSocket = std::getenv("LS_ZYGOTE_SOCKET");
+    if (!serveZygote && zygoteSocket && *zygoteSocket) {
+        const int rc = teamcore::zygote::RunClient(zygoteSocket, std::vector<std::string>(argv, argv + argc));
+        if (rc >= 0) {
+            return rc;
+        }
+        // Zygote çalışmıyor: normal başlatma
+    }
     
     // =================== RASP Initialization ===================
     if (ShouldLogToConsole(LogLevel::NORMAL)) {
@@ -350,6 +492,12 @@ int main() {
     }
     
     // =================== Application Start ===================
+    if (serveZygote) {
+        // --zygote [soket]: hazırlığı bir kez yap, her bağlantı için worker fork et
+        const int rc = LS_AppServeZygote(argc > 2 ? argv[2] : zygoteSocket);
+        ShutdownRASP();
+        return rc;
+    }
     LS_AppStart();
     
     // =================== RASP Shutdown ===================
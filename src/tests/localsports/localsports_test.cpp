@@ -26,6 +26,11 @@
  * @code
  * ./LocalSports_tests
  * @endcode
+ * Benchmarks (DISABLED_Bench*) print [BENCH] timings and are skipped by default; their
+ * correctness checks are covered by the unit tests next to them:
+ * @code
+ * ./LocalSports_tests --gtest_also_run_disabled_tests --gtest_filter='*Bench*'
+ * @endcode
  * 
  * @note Some interactive functions require I/O mocking for complete testing
  * @see localsports.h for API documentation
@@ -39,6 +44,22 @@
 #include "../../localsports/header/security_layer.h"
 #include "../../localsports/header/security_hardening.h"
 #include "../../localsports/header/rasp.h"
+#include "../../localsports/header/record_store.h"
+#include "../../localsports/header/backup.h"
+#include "../../localsports/header/maintenance.h"
+#include "../../localsports/header/archive.h"
+#include "../../localsports/header/tenant_router.h"
+#include "../../localsports/header/page_vfs.h"
+#include "../../localsports/header/sql_functions.h"
+#include "../../localsports/header/hybrid_store.h"
+#include "../../localsports/header/message_partitions.h"
+#include "../../localsports/header/message_index.h"
+#include "../../localsports/header/zygote.h"
+
+#include <sqlite3.h>
+#include <openssl/rand.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
 
 #include <iostream>
 #include <sstream>
@@ -48,7 +69,13 @@
 #include <cstring>
 #include <vector>
 #include <thread>
+#include <mutex>
 #include <chrono>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include <type_traits>
+#include <stdexcept>
 
 #ifdef _WIN32
 #include <io.h>
@@ -57,6 +84,11 @@
 #define REMOVE remove
 #else
 #include <unistd.h>
+#include <fcntl.h>
+#include <dlfcn.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
 #define REMOVE remove
 #endif
 
@@ -1027,7 +1059,7 @@ TEST_F(LocalSportsTest, ReadPasswordSecure) {  /**< Test: read_password_secure *
     // Provide input for password  /**< Mock password input */
     provideInput("test_password\n");  /**< Provide password input */
     
-    std::string password = teamcore::read_password_secure("Enter password: ");  /**< Read password */
+    teamcore::SecureString password = teamcore::read_password_secure("Enter password: ");  /**< Read password */
     
     // Password should be read (implementation may hide input)  /**< Verify password read */
     EXPECT_FALSE(password.empty());  /**< Password should not be empty */
@@ -1924,6 +1956,3796 @@ TEST_F(LocalSportsTest, HardeningObfuscationRoundTrip) {  /**< Test: Hardening o
     }
 }
 
+// ===================================================================================
+// =================== RECORD_STORE.h/.cpp İÇİN TESTLER ===================
+// ===================================================================================
+// Bu bölüm slab tabanlı RecordStore ve SQLite toplu yükleme fonksiyonlarını test eder
+// Test edilen dosyalar: src/localsports/header/record_store.h, src/localsports/src/record_store.cpp
+// Namespace: teamcore::store
+
+/**
+ * @brief Helper: build a Player record with the given id and name
+ */
+static Player MakeTestPlayer(uint32_t id, const char* name) {
+    Player p;  /**< Player record */
+    std::memset(&p, 0, sizeof(p));  /**< Zero all fixed-size fields */
+    p.id = id;  /**< Set id */
+    std::snprintf(p.name, sizeof(p.name), "%s", name);  /**< Set name */
+    p.active = 1;  /**< Mark active */
+    return p;
+}
+
+/**
+ * @brief Helper: create an in-memory players table with n rows
+ */
+static sqlite3* OpenTestPlayersDb(int n) {
+    sqlite3* db = nullptr;  /**< In-memory database */
+    sqlite3_open(":memory:", &db);  /**< Open database */
+    sqlite3_exec(db, "CREATE TABLE players(id INTEGER PRIMARY KEY, name TEXT, position TEXT,"
+        "phone TEXT, email TEXT, active INTEGER);", nullptr, nullptr, nullptr);  /**< Same columns as LS_Init */
+    sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr);  /**< Batch inserts */
+    sqlite3_stmt* ins = nullptr;  /**< Insert statement */
+    sqlite3_prepare_v2(db, "INSERT INTO players VALUES(?,?,?,?,?,1);", -1, &ins, nullptr);
+    for (int i = 1; i <= n; ++i) {  /**< Insert n players */
+        std::string name = "Player " + std::to_string(i);
+        std::string phone = "enc:555" + std::to_string(i);
+        std::string email = "enc:p" + std::to_string(i) + "@club.org";
+        sqlite3_bind_int(ins, 1, i);
+        sqlite3_bind_text(ins, 2, name.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(ins, 3, "Forward", -1, SQLITE_STATIC);
+        sqlite3_bind_text(ins, 4, phone.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(ins, 5, email.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_step(ins);
+        sqlite3_reset(ins);
+    }
+    sqlite3_finalize(ins);
+    sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+    return db;
+}
+
+/**
+ * @brief Helper: decoder that strips the "enc:" prefix (stands in for decryptMaybe)
+ */
+static std::string StripEncPrefix(const std::string& v) {
+    return v.compare(0, 4, "enc:") == 0 ? v.substr(4) : v;
+}
+
+/**
+ * @brief Test RecordStore upsert and id lookup
+ * @test Verifies records are found by id and updated in place
+ */
+TEST_F(LocalSportsTest, RecordStoreUpsertAndFind) {  /**< Test: RecordStore - Upsert/FindById */
+    teamcore::store::RecordStore<Player> store;  /**< Empty store */
+    store.Upsert(MakeTestPlayer(7, "Ali"));  /**< Insert id 7 */
+    store.Upsert(MakeTestPlayer(42, "Veli"));  /**< Insert id 42 */
+    EXPECT_EQ(2u, store.size());  /**< Two records */
+
+    ASSERT_NE(nullptr, store.FindById(42));  /**< id 42 found */
+    EXPECT_STREQ("Veli", store.FindById(42)->name);  /**< Correct record */
+    EXPECT_EQ(nullptr, store.FindById(8));  /**< Missing id */
+
+    store.Upsert(MakeTestPlayer(7, "Ali Updated"));  /**< Same id updates in place */
+    EXPECT_EQ(2u, store.size());  /**< Size unchanged */
+    EXPECT_STREQ("Ali Updated", store.FindById(7)->name);  /**< Updated value */
+}
+
+/**
+ * @brief Test RecordStore handle and pointer stability across growth
+ * @test Verifies slabs never move when the store grows
+ */
+TEST_F(LocalSportsTest, RecordStoreStableHandles) {  /**< Test: RecordStore - Stable handles */
+    teamcore::store::RecordStore<Player, 16> store;  /**< Small slabs to force growth */
+    teamcore::store::RecordHandle h = store.Upsert(MakeTestPlayer(1, "First"));  /**< First record */
+    const Player* before = store.Get(h);  /**< Pointer before growth */
+
+    for (uint32_t i = 2; i <= 1000; ++i) {  /**< Grow through many slabs and rehashes */
+        store.Upsert(MakeTestPlayer(i, "Other"));
+    }
+
+    EXPECT_EQ(before, store.Get(h));  /**< Same address after growth */
+    EXPECT_STREQ("First", store.Get(h)->name);  /**< Same content */
+    for (uint32_t i = 1; i <= 1000; ++i) {  /**< Every id still resolvable */
+        ASSERT_NE(nullptr, store.FindById(i));
+    }
+}
+
+/**
+ * @brief Test RecordStore erase semantics
+ * @test Verifies stale handles are rejected and the index stays consistent
+ */
+TEST_F(LocalSportsTest, RecordStoreEraseInvalidatesHandle) {  /**< Test: RecordStore - Erase */
+    teamcore::store::RecordStore<Player, 16> store;  /**< Store */
+    for (uint32_t i = 1; i <= 100; ++i) {  /**< Fill store */
+        store.Upsert(MakeTestPlayer(i, "P"));
+    }
+    teamcore::store::RecordHandle h = store.HandleOf(50);  /**< Handle to id 50 */
+    EXPECT_TRUE(store.Erase(50));  /**< Erase it */
+    EXPECT_FALSE(store.Erase(50));  /**< Second erase is a no-op */
+    EXPECT_EQ(nullptr, store.Get(h));  /**< Stale handle rejected */
+    EXPECT_EQ(99u, store.size());  /**< Size decremented */
+
+    teamcore::store::RecordHandle h2 = store.Upsert(MakeTestPlayer(500, "Reused"));  /**< Reuses the freed slot */
+    EXPECT_EQ(h.slot, h2.slot);  /**< Same slot */
+    EXPECT_EQ(nullptr, store.Get(h));  /**< Old handle still stale (generation bumped) */
+    for (uint32_t i = 1; i <= 100; ++i) {  /**< Backward-shift delete kept probe chains intact */
+        if (i == 50) continue;
+        ASSERT_NE(nullptr, store.FindById(i));
+    }
+}
+
+/**
+ * @brief Test LoadPlayers bulk load from SQLite
+ * @test Verifies rows are loaded in id order with decoded PII fields
+ */
+TEST_F(LocalSportsTest, RecordStoreLoadPlayers) {  /**< Test: store::LoadPlayers */
+    sqlite3* db = OpenTestPlayersDb(300);  /**< 300 players */
+    teamcore::store::RecordStore<Player> store;  /**< Target store */
+    ASSERT_TRUE(teamcore::store::LoadPlayers(db, store, StripEncPrefix));  /**< Single-pass load */
+    EXPECT_EQ(300u, store.size());  /**< All rows loaded */
+    EXPECT_STREQ("5553", store.FindById(3)->phone);  /**< Decoder applied */
+    EXPECT_STREQ("p3@club.org", store.FindById(3)->email);  /**< Decoder applied */
+
+    uint32_t lastId = 0;  /**< Iteration follows id order */
+    bool ordered = true;
+    store.ForEach([&](const Player& p) { ordered = ordered && p.id > lastId; lastId = p.id; });
+    EXPECT_TRUE(ordered);  /**< Ascending ids */
+    sqlite3_close(db);  /**< Cleanup */
+}
+
+/**
+ * @brief Test the roster loader used by the long-lived player cache
+ * @test Verifies active players load without their phone/email columns
+ */
+TEST_F(LocalSportsTest, RecordStoreLoadRosterSkipsPII) {  /**< Test: store::LoadRoster */
+    sqlite3* db = OpenTestPlayersDb(10);
+    sqlite3_exec(db, "UPDATE players SET active = 0 WHERE id = 4;", nullptr, nullptr, nullptr);
+    teamcore::store::RecordStore<Player> store;
+    ASSERT_TRUE(teamcore::store::LoadRoster(db, store));
+    EXPECT_EQ(9u, store.size());
+    EXPECT_EQ(nullptr, store.FindById(4));  /**< Inactive skipped */
+    ASSERT_NE(nullptr, store.FindById(3));
+    EXPECT_STREQ("Player 3", store.FindById(3)->name);
+    EXPECT_STREQ("", store.FindById(3)->phone);  /**< PII not cached */
+    EXPECT_STREQ("", store.FindById(3)->email);
+    sqlite3_close(db);
+}
+
+/**
+ * @brief Benchmark RecordStore against std::vector<std::string> based rows
+ * @test Reports load and lookup timings; only correctness is asserted
+ */
+TEST_F(LocalSportsTest, DISABLED_BenchRecordStoreVsStringRows) {  /**< Benchmark: RecordStore vs string rows */
+    const int kRows = 20000;  /**< Working set size */
+    const int kLookups = 200000;  /**< Random id lookups */
+    sqlite3* db = OpenTestPlayersDb(kRows);  /**< Source table */
+
+    auto t0 = std::chrono::steady_clock::now();
+    teamcore::store::RecordStore<Player> store;  /**< Flat record store */
+    ASSERT_TRUE(teamcore::store::LoadPlayers(db, store, StripEncPrefix));
+    auto t1 = std::chrono::steady_clock::now();
+
+    std::vector<std::vector<std::string>> rows;  /**< Baseline: vector of string rows */
+    sqlite3_stmt* st = nullptr;
+    sqlite3_prepare_v2(db, "SELECT id,name,position,phone,email,active FROM players WHERE active=1 ORDER BY id;", -1, &st, nullptr);
+    while (sqlite3_step(st) == SQLITE_ROW) {
+        std::vector<std::string> row;
+        for (int c = 0; c < 6; ++c) {
+            const char* v = reinterpret_cast<const char*>(sqlite3_column_text(st, c));
+            row.push_back(c == 3 || c == 4 ? StripEncPrefix(v ? v : "") : std::string(v ? v : ""));
+        }
+        rows.push_back(row);
+    }
+    sqlite3_finalize(st);
+    auto t2 = std::chrono::steady_clock::now();
+
+    uint32_t seed = 12345;  /**< Deterministic LCG for lookup ids */
+    size_t hitsStore = 0, hitsRows = 0;
+    for (int i = 0; i < kLookups; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        const Player* p = store.FindById(1 + (seed >> 8) % kRows);
+        hitsStore += (p && p->active) ? 1 : 0;
+    }
+    auto t3 = std::chrono::steady_clock::now();
+
+    seed = 12345;
+    for (int i = 0; i < kLookups; ++i) {  /**< Baseline lookup: binary search on id column */
+        seed = seed * 1103515245u + 12345u;
+        uint32_t id = 1 + (seed >> 8) % kRows;
+        auto it = std::lower_bound(rows.begin(), rows.end(), id,
+            [](const std::vector<std::string>& r, uint32_t v) { return std::stoul(r[0]) < v; });
+        hitsRows += (it != rows.end() && (*it)[5] == "1") ? 1 : 0;
+    }
+    auto t4 = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(hitsStore, hitsRows);  /**< Both paths see the same data */
+    EXPECT_EQ(static_cast<size_t>(kLookups), hitsStore);
+
+    typedef std::chrono::duration<double, std::milli> ms;
+    std::cerr << "[BENCH] rows=" << kRows
+              << " load(store)=" << ms(t1 - t0).count() << "ms"
+              << " load(string rows)=" << ms(t2 - t1).count() << "ms"
+              << " lookups(store)=" << ms(t3 - t2).count() << "ms"
+              << " lookups(string rows)=" << ms(t4 - t3).count() << "ms\n";
+    sqlite3_close(db);
+}
+
+// =================== BACKUP TESTS ===================
+
+/**
+ * @brief Helper: count rows of a table
+ */
+static int CountRows(sqlite3* db, const char* table) {
+    std::string sql = std::string("SELECT COUNT(*) FROM ") + table + ";";  /**< Count query */
+    sqlite3_stmt* st = nullptr;  /**< Statement */
+    int n = -1;  /**< Result (-1 = error) */
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &st, nullptr) == SQLITE_OK &&
+        sqlite3_step(st) == SQLITE_ROW) {
+        n = sqlite3_column_int(st, 0);
+    }
+    sqlite3_finalize(st);
+    return n;
+}
+
+/**
+ * @brief Helper: make sure AppKey is ready for encrypted backups
+ */
+static void EnsureAppKey() {
+    if (teamcore::AppKey_IsReady()) return;  /**< Already initialized */
+    teamcore::AppKey_InitFromEnvOrPrompt();  /**< Env (LS_APP_PASSPHRASE) or prompt */
+}
+
+/**
+ * @brief Test plain online backup and restore round trip
+ * @test Verifies pages are copied in steps and restored data matches
+ */
+TEST_F(LocalSportsTest, BackupPlainRoundTrip) {  /**< Test: Backup - plain round trip */
+    const char* path = "test_backup_plain.db";  /**< Backup file */
+    std::remove(path);
+    sqlite3* src = OpenTestPlayersDb(2000);  /**< Source with enough pages for several steps */
+
+    teamcore::backup::BackupOptions opts;  /**< Small steps, no throttle */
+    opts.pagesPerStep = 4;
+    opts.sleepMs = 0;
+    int callbacks = 0;  /**< Progress callback count */
+    opts.onProgress = [&callbacks](const teamcore::backup::BackupProgress&) { ++callbacks; };
+
+    teamcore::backup::BackupJob job;  /**< Background job */
+    ASSERT_TRUE(job.StartBackup(src, path, opts));
+    EXPECT_EQ(teamcore::backup::BackupStatus::SUCCEEDED, job.Wait());  /**< Completed and verified */
+    EXPECT_GT(job.Progress().steps, 1);  /**< Copied incrementally */
+    EXPECT_EQ(0, job.Progress().remainingPages);  /**< Nothing left */
+    EXPECT_EQ(job.Progress().steps, callbacks);  /**< Callback per step */
+    EXPECT_TRUE(teamcore::backup::VerifyBackup(path));  /**< Valid SQLite file */
+
+    sqlite3* dst = nullptr;  /**< Restore target */
+    sqlite3_open(":memory:", &dst);
+    EXPECT_TRUE(teamcore::backup::RunRestore(dst, path, opts));  /**< Restore */
+    EXPECT_EQ(2000, CountRows(dst, "players"));  /**< All rows restored */
+
+    sqlite3_close(dst);
+    sqlite3_close(src);
+    std::remove(path);
+}
+
+/**
+ * @brief Test encrypted + compressed backup container
+ * @test Verifies the file is not a plain SQLite image and restores correctly
+ */
+TEST_F(LocalSportsTest, BackupEncryptedCompressedRoundTrip) {  /**< Test: Backup - encrypted/compressed */
+    EnsureAppKey();
+    if (!teamcore::AppKey_IsReady()) GTEST_SKIP() << "AppKey not available";
+
+    const char* path = "test_backup_enc.lsbk";  /**< Backup container */
+    std::remove(path);
+    sqlite3* src = OpenTestPlayersDb(500);  /**< Source */
+    sqlite3_exec(src, "DELETE FROM players WHERE id > 250;", nullptr, nullptr, nullptr);  /**< Leave free pages */
+
+    teamcore::backup::BackupOptions opts;  /**< Encrypt + compress */
+    opts.sleepMs = 0;
+    opts.encrypt = true;
+    opts.compress = true;
+    ASSERT_TRUE(teamcore::backup::RunBackup(src, path, opts));
+
+    std::ifstream in(path, std::ios::binary);  /**< Inspect header */
+    char magic[16] = { 0 };
+    in.read(magic, sizeof(magic));
+    in.close();
+    EXPECT_EQ(0, std::memcmp(magic, "LSBK", 4));  /**< Container magic */
+    EXPECT_NE(0, std::memcmp(magic, "SQLite format 3", 15));  /**< Not plaintext SQLite */
+    EXPECT_TRUE(teamcore::backup::VerifyBackup(path));  /**< Decrypts and passes quick_check */
+
+    sqlite3* dst = nullptr;  /**< Restore target */
+    sqlite3_open(":memory:", &dst);
+    EXPECT_TRUE(teamcore::backup::RunRestore(dst, path, opts));
+    EXPECT_EQ(250, CountRows(dst, "players"));  /**< Restored content */
+
+    sqlite3_close(dst);
+    sqlite3_close(src);
+    std::remove(path);
+}
+
+/**
+ * @brief Test that a tampered backup container is rejected
+ * @test Verifies GCM tag check fails and restore leaves target untouched
+ */
+TEST_F(LocalSportsTest, BackupDetectsCorruption) {  /**< Test: Backup - tamper detection */
+    EnsureAppKey();
+    if (!teamcore::AppKey_IsReady()) GTEST_SKIP() << "AppKey not available";
+
+    const char* path = "test_backup_bad.lsbk";  /**< Backup container */
+    std::remove(path);
+    sqlite3* src = OpenTestPlayersDb(100);  /**< Source */
+
+    teamcore::backup::BackupOptions opts;  /**< Encrypted */
+    opts.sleepMs = 0;
+    opts.encrypt = true;
+    ASSERT_TRUE(teamcore::backup::RunBackup(src, path, opts));
+
+    std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);  /**< Flip one payload byte */
+    f.seekg(100);
+    char c = 0;
+    f.read(&c, 1);
+    c ^= 0x01;
+    f.seekp(100);
+    f.write(&c, 1);
+    f.close();
+
+    EXPECT_FALSE(teamcore::backup::VerifyBackup(path));  /**< Tag mismatch */
+    sqlite3* dst = nullptr;  /**< Restore target */
+    sqlite3_open(":memory:", &dst);
+    sqlite3_exec(dst, "CREATE TABLE keep(x);", nullptr, nullptr, nullptr);
+    EXPECT_FALSE(teamcore::backup::RunRestore(dst, path, opts));  /**< Rejected */
+    EXPECT_EQ(0, CountRows(dst, "keep"));  /**< Target untouched */
+
+    sqlite3_close(dst);
+    sqlite3_close(src);
+    std::remove(path);
+}
+
+// =================== MAINTENANCE TESTS ===================
+
+/**
+ * @brief Helper: open a WAL database file with a players table
+ */
+static sqlite3* OpenWalTestDb(const char* path, bool incrementalVacuum) {
+    std::remove(path);  /**< Fresh file */
+    std::remove((std::string(path) + "-wal").c_str());
+    std::remove((std::string(path) + "-shm").c_str());
+    sqlite3* db = nullptr;  /**< Application-side connection */
+    sqlite3_open(path, &db);
+    if (incrementalVacuum) sqlite3_exec(db, "PRAGMA auto_vacuum=INCREMENTAL;", nullptr, nullptr, nullptr);
+    sqlite3_exec(db, "PRAGMA journal_mode=WAL;", nullptr, nullptr, nullptr);  /**< Same as LS_Init */
+    sqlite3_exec(db, "CREATE TABLE players(id INTEGER PRIMARY KEY, name TEXT, pad BLOB);", nullptr, nullptr, nullptr);
+    return db;
+}
+
+/**
+ * @brief Helper: insert n rows with a padded blob in one transaction
+ */
+static void InsertPaddedRows(sqlite3* db, int n) {
+    sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr);
+    for (int i = 0; i < n; ++i) {
+        sqlite3_exec(db, "INSERT INTO players(name,pad) VALUES('p', zeroblob(512));", nullptr, nullptr, nullptr);
+    }
+    sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+}
+
+/**
+ * @brief Helper: remove a test database and its WAL side files
+ */
+static void RemoveWalTestDb(const char* path) {
+    std::remove(path);
+    std::remove((std::string(path) + "-wal").c_str());
+    std::remove((std::string(path) + "-shm").c_str());
+}
+
+/**
+ * @brief Test that an idle period triggers a PASSIVE checkpoint
+ * @test Verifies commits are noticed via wal_hook and timings reach the sink
+ */
+TEST_F(LocalSportsTest, MaintenancePassiveCheckpointWhenIdle) {  /**< Test: Maintenance - idle checkpoint */
+    const char* path = "test_maint_passive.db";
+    sqlite3* db = OpenWalTestDb(path, false);
+
+    std::mutex m;  /**< Guards captured task names */
+    std::vector<std::string> tasks;  /**< Captured timings */
+    teamcore::maintenance::MaintenanceConfig cfg;  /**< Fast polling for the test */
+    cfg.pollMs = 5;
+    cfg.idleMs = 30;
+
+    teamcore::maintenance::MaintenanceScheduler sched;
+    ASSERT_TRUE(sched.Start(db, path, cfg, [&](const teamcore::maintenance::TaskTiming& t) {
+        std::lock_guard<std::mutex> lock(m);
+        tasks.push_back(t.task);
+        EXPECT_GE(t.ms, 0.0);  /**< Timing recorded */
+    }));
+
+    InsertPaddedRows(db, 200);  /**< Writes go to the WAL only */
+    for (int i = 0; i < 200 && sched.Stats().passiveCheckpoints == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    sched.Stop();
+
+    EXPECT_GE(sched.Stats().passiveCheckpoints, 1u);  /**< Idle checkpoint ran */
+    std::lock_guard<std::mutex> lock(m);
+    EXPECT_NE(tasks.end(), std::find(tasks.begin(), tasks.end(), "checkpoint_passive"));  /**< Logged */
+
+    sqlite3_close(db);
+    RemoveWalTestDb(path);
+}
+
+/**
+ * @brief Test TRUNCATE escalation for an oversized WAL
+ * @test Verifies the WAL file is truncated to zero bytes
+ */
+TEST_F(LocalSportsTest, MaintenanceTruncatesLargeWal) {  /**< Test: Maintenance - TRUNCATE */
+    const char* path = "test_maint_truncate.db";
+    sqlite3* db = OpenWalTestDb(path, false);
+
+    teamcore::maintenance::MaintenanceConfig cfg;  /**< Tiny threshold */
+    cfg.pollMs = 5;
+    cfg.idleMs = 20;
+    cfg.walTruncateBytes = 64 * 1024;
+
+    teamcore::maintenance::MaintenanceScheduler sched;
+    ASSERT_TRUE(sched.Start(db, path, cfg, [](const teamcore::maintenance::TaskTiming&) {}));
+    InsertPaddedRows(db, 500);  /**< ~300KB of WAL */
+    EXPECT_GT(sched.WalFileBytes(), cfg.walTruncateBytes);  /**< Auto-checkpoint disabled: WAL grew */
+
+    for (int i = 0; i < 200 && sched.Stats().truncateCheckpoints == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_GE(sched.Stats().truncateCheckpoints, 1u);  /**< Escalated */
+    EXPECT_EQ(0, sched.WalFileBytes());  /**< WAL truncated */
+    sched.Stop();
+
+    EXPECT_EQ(500, CountRows(db, "players"));  /**< Data intact */
+    sqlite3_close(db);
+    RemoveWalTestDb(path);
+}
+
+/**
+ * @brief Test incremental vacuum and optimize tasks
+ * @test Verifies free pages are returned and optimize succeeds
+ */
+TEST_F(LocalSportsTest, MaintenanceIncrementalVacuumAndOptimize) {  /**< Test: Maintenance - vacuum/optimize */
+    const char* path = "test_maint_vacuum.db";
+    sqlite3* db = OpenWalTestDb(path, true);
+    InsertPaddedRows(db, 300);
+    sqlite3_exec(db, "DELETE FROM players;", nullptr, nullptr, nullptr);  /**< Create free pages */
+
+    teamcore::maintenance::MaintenanceConfig cfg;  /**< Scheduler idle; tasks run manually */
+    cfg.vacuumPages = 100000;
+    int reclaimed = 0;  /**< Pages returned by vacuum */
+    teamcore::maintenance::MaintenanceScheduler sched;
+    ASSERT_TRUE(sched.Start(db, path, cfg, [&reclaimed](const teamcore::maintenance::TaskTiming& t) {
+        if (std::string(t.task) == "incremental_vacuum") reclaimed = t.done;
+    }));
+
+    EXPECT_EQ(SQLITE_OK, sched.RunIncrementalVacuum());
+    EXPECT_GT(reclaimed, 0);  /**< Free pages released */
+    EXPECT_EQ(SQLITE_OK, sched.RunOptimize());
+    EXPECT_EQ(1u, sched.Stats().vacuumRuns);
+    EXPECT_EQ(1u, sched.Stats().optimizeRuns);
+    sched.Stop();
+
+    sqlite3_close(db);
+    RemoveWalTestDb(path);
+}
+
+// =================== SEASON ARCHIVE TESTS ===================
+
+/**
+ * @brief Two seasons of games, stats and messages; 2020 is fully played, 2021 still has an unplayed game
+ */
+static const char* SEASON_TEST_SQL =
+    "CREATE TABLE players(id INTEGER PRIMARY KEY AUTOINCREMENT, name TEXT NOT NULL, position TEXT NOT NULL,"
+    " phone TEXT NOT NULL, email TEXT NOT NULL, active INTEGER NOT NULL DEFAULT 1);"
+    "CREATE TABLE games(id INTEGER PRIMARY KEY AUTOINCREMENT, date TEXT NOT NULL, time TEXT NOT NULL,"
+    " opponent TEXT NOT NULL, location TEXT NOT NULL, played INTEGER NOT NULL DEFAULT 0, result TEXT NOT NULL DEFAULT '');"
+    "CREATE TABLE stats(id INTEGER PRIMARY KEY AUTOINCREMENT, gameId INTEGER NOT NULL, playerId INTEGER NOT NULL,"
+    " goals INTEGER NOT NULL, assists INTEGER NOT NULL, saves INTEGER NOT NULL, yellow INTEGER NOT NULL, red INTEGER NOT NULL,"
+    " FOREIGN KEY(gameId) REFERENCES games(id), FOREIGN KEY(playerId) REFERENCES players(id));"
+    "CREATE TABLE messages(id INTEGER PRIMARY KEY AUTOINCREMENT, datetime TEXT NOT NULL, text TEXT NOT NULL);"
+    "INSERT INTO players(name,position,phone,email) VALUES('Ali','FW','x','y');"
+    "INSERT INTO games(date,time,opponent,location,played,result) VALUES"
+    " ('2020-03-01','18:00','A','H',1,'1-0 W'),('2020-09-01','18:00','B','H',1,'0-0 D'),"
+    " ('2021-03-01','18:00','C','H',1,'2-1 W'),('2021-09-01','18:00','D','H',0,'');"
+    "INSERT INTO stats(gameId,playerId,goals,assists,saves,yellow,red) VALUES"
+    " (1,1,2,0,0,0,0),(2,1,1,1,0,0,0),(3,1,3,0,0,1,0);"
+    "INSERT INTO messages(datetime,text) VALUES('2020-05-05 10:00','old'),('2021-05-05 10:00','new');";
+
+/**
+ * @brief Helper: database file with the SEASON_TEST_SQL seasons
+ */
+static sqlite3* OpenSeasonTestDb(const char* path) {
+    RemoveWalTestDb(path);
+    std::remove("test_season_2020.db");
+    sqlite3* db = nullptr;  /**< URI flag required for read-only ATTACH */
+    sqlite3_open_v2(path, &db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_URI, nullptr);
+    sqlite3_exec(db, "PRAGMA journal_mode=WAL; PRAGMA foreign_keys=ON;", nullptr, nullptr, nullptr);
+    sqlite3_exec(db, SEASON_TEST_SQL, nullptr, nullptr, nullptr);
+    return db;
+}
+
+/**
+ * @brief Helper: single integer query result
+ */
+static int QueryIntValue(sqlite3* db, const char* sql) {
+    sqlite3_stmt* st = nullptr;  /**< Statement */
+    int v = -1;  /**< -1 on error */
+    if (sqlite3_prepare_v2(db, sql, -1, &st, nullptr) == SQLITE_OK && sqlite3_step(st) == SQLITE_ROW) {
+        v = sqlite3_column_int(st, 0);
+    }
+    sqlite3_finalize(st);
+    return v;
+}
+
+/**
+ * @brief Test archiving a closed season
+ * @test Verifies rows move to the season file and hot tables shrink
+ */
+TEST_F(LocalSportsTest, ArchiveClosedSeasonMovesRows) {  /**< Test: Archive - move season */
+    const char* path = "test_season.db";
+    sqlite3* db = OpenSeasonTestDb(path);
+    EXPECT_EQ("test_season_2020.db", teamcore::archive::ArchivePathFor(path, "2020"));  /**< Naming */
+
+    std::vector<teamcore::archive::SeasonInfo> seasons = teamcore::archive::ListSeasons(db, 2025);
+    ASSERT_EQ(2u, seasons.size());
+    EXPECT_TRUE(seasons[0].closed);  /**< 2020 fully played */
+    EXPECT_FALSE(seasons[1].closed);  /**< 2021 has an unplayed game */
+
+    teamcore::archive::ArchiveEntry entry;
+    ASSERT_TRUE(teamcore::archive::ArchiveSeason(db, path, "2020", 2025, &entry));
+    EXPECT_EQ(2, entry.games);
+    EXPECT_EQ(2, entry.stats);
+    EXPECT_EQ(1, entry.messages);
+    EXPECT_FALSE(teamcore::archive::ArchiveSeason(db, path, "2021", 2025));  /**< Open season refused */
+
+    EXPECT_EQ(2, CountRows(db, "games"));  /**< Only 2021 left hot */
+    EXPECT_EQ(1, CountRows(db, "stats"));
+    EXPECT_EQ(1, CountRows(db, "messages"));
+    EXPECT_EQ(1u, teamcore::archive::ListArchives(db).size());  /**< Catalog entry */
+
+    sqlite3* arch = nullptr;  /**< Season file is a normal SQLite database */
+    sqlite3_open(entry.path.c_str(), &arch);
+    EXPECT_EQ(2, CountRows(arch, "games"));
+    sqlite3_close(arch);
+
+    sqlite3_close(db);
+    RemoveWalTestDb(path);
+    std::remove(entry.path.c_str());
+}
+
+/**
+ * @brief Test read-only attach and cross-season views
+ * @test Verifies union views cover all seasons and archives reject writes
+ */
+TEST_F(LocalSportsTest, ArchiveAttachReadOnlyUnionViews) {  /**< Test: Archive - attach/views */
+    const char* path = "test_season.db";
+    sqlite3* db = OpenSeasonTestDb(path);
+    ASSERT_TRUE(teamcore::archive::ArchiveSeason(db, path, "2020", 2025));
+
+    EXPECT_EQ(1, teamcore::archive::AttachArchives(db));  /**< One archive attached */
+    EXPECT_EQ(4, CountRows(db, "all_games"));  /**< Hot + archived */
+    EXPECT_EQ(3, CountRows(db, "all_stats"));
+    EXPECT_EQ(2, CountRows(db, "all_messages"));
+    EXPECT_EQ(6, QueryIntValue(db, "SELECT SUM(goals) FROM all_stats WHERE playerId=1;"));  /**< Cross-season total */
+
+    EXPECT_NE(SQLITE_OK, sqlite3_exec(db, "DELETE FROM arch_2020.games;", nullptr, nullptr, nullptr));  /**< Read-only */
+    EXPECT_EQ(2, QueryIntValue(db, "SELECT COUNT(*) FROM arch_2020.games;"));  /**< Untouched */
+
+    teamcore::archive::DetachArchives(db);
+    EXPECT_EQ(-1, CountRows(db, "all_games"));  /**< Views removed */
+
+    sqlite3_close(db);
+    RemoveWalTestDb(path);
+    std::remove("test_season_2020.db");
+}
+
+/**
+ * @brief Test an archive run whose delete phase fails
+ * @test Verifies the archive copy is committed before main is touched and a rerun completes without duplicates
+ */
+TEST_F(LocalSportsTest, ArchiveSeasonFailedDeleteKeepsRows) {  /**< Test: Archive - two-phase commit */
+    const char* path = "test_season.db";
+    sqlite3* db = OpenSeasonTestDb(path);
+    ASSERT_EQ(SQLITE_OK, sqlite3_exec(db, "CREATE TRIGGER games_no_delete BEFORE DELETE ON games "
+                                          "BEGIN SELECT RAISE(ABORT, 'interrupted'); END;", nullptr, nullptr, nullptr));
+
+    EXPECT_FALSE(teamcore::archive::ArchiveSeason(db, path, "2020", 2025));
+    EXPECT_EQ(4, CountRows(db, "games"));  /**< Nothing left main */
+    EXPECT_EQ(3, CountRows(db, "stats"));
+    EXPECT_EQ(0u, teamcore::archive::ListArchives(db).size());
+
+    sqlite3* arch = nullptr;  /**< Copy already durable in the season file */
+    ASSERT_EQ(SQLITE_OK, sqlite3_open("test_season_2020.db", &arch));
+    EXPECT_EQ(2, CountRows(arch, "games"));
+    EXPECT_EQ(2, CountRows(arch, "stats"));
+    EXPECT_EQ(1, CountRows(arch, "messages"));
+    sqlite3_close(arch);
+
+    sqlite3_exec(db, "DROP TRIGGER games_no_delete;", nullptr, nullptr, nullptr);
+    teamcore::archive::ArchiveEntry entry;
+    ASSERT_TRUE(teamcore::archive::ArchiveSeason(db, path, "2020", 2025, &entry));
+    EXPECT_EQ(2, CountRows(db, "games"));
+    EXPECT_EQ(1, CountRows(db, "stats"));
+    ASSERT_EQ(1u, teamcore::archive::ListArchives(db).size());
+    EXPECT_EQ(2, teamcore::archive::ListArchives(db)[0].games);  /**< Rerun replaced, not duplicated */
+    EXPECT_EQ(1, teamcore::archive::AttachArchives(db));
+    EXPECT_EQ(4, CountRows(db, "all_games"));
+
+    teamcore::archive::DetachArchives(db);
+    sqlite3_close(db);
+    RemoveWalTestDb(path);
+    std::remove(entry.path.c_str());
+}
+
+// =================== TENANT ROUTER TESTS ===================
+
+/**
+ * @brief Helper: remove a tenant database file and its WAL side files
+ */
+static void RemoveTenantDb(const std::string& dir, const char* tenantId) {
+    RemoveWalTestDb((dir + "/" + tenantId + ".db").c_str());
+}
+
+/**
+ * @brief Test tenant id validation and path mapping
+ * @test Verifies ids that could escape the base directory are rejected
+ */
+TEST_F(LocalSportsTest, TenantRouterValidatesIds) {  /**< Test: TenantRouter - id validation */
+    using teamcore::tenant::TenantRouter;
+    EXPECT_TRUE(TenantRouter::IsValidTenantId("fc_ankara-2"));  /**< Allowed characters */
+    EXPECT_FALSE(TenantRouter::IsValidTenantId(""));  /**< Empty */
+    EXPECT_FALSE(TenantRouter::IsValidTenantId("../etc"));  /**< Path traversal */
+    EXPECT_FALSE(TenantRouter::IsValidTenantId("a/b"));  /**< Separator */
+    EXPECT_FALSE(TenantRouter::IsValidTenantId("Club"));  /**< Upper case (case-insensitive file systems) */
+    EXPECT_FALSE(TenantRouter::IsValidTenantId(std::string(65, 'a')));  /**< Too long */
+
+    teamcore::tenant::RouterConfig cfg;  /**< Router under a test directory */
+    cfg.baseDir = "test_tenants";
+    TenantRouter router(cfg);
+    EXPECT_EQ("test_tenants/club.db", router.PathFor("club"));
+    EXPECT_FALSE(router.Acquire("../escape"));  /**< Invalid id yields empty lease */
+    EXPECT_EQ(0u, router.OpenCount());
+}
+
+/**
+ * @brief Test lazy open, LRU eviction and pinning
+ * @test Verifies open handles stay within the limit and pinned handles survive
+ */
+TEST_F(LocalSportsTest, TenantRouterLruEvictionRespectsLeases) {  /**< Test: TenantRouter - LRU */
+    teamcore::tenant::RouterConfig cfg;  /**< Two open handles at most */
+    cfg.baseDir = "test_tenants";
+    cfg.maxOpen = 2;
+    int setups = 0;  /**< Setup calls == lazy opens */
+    cfg.setup = [&setups](sqlite3* db) {
+        ++setups;
+        return sqlite3_exec(db, "PRAGMA journal_mode=WAL;", nullptr, nullptr, nullptr) == SQLITE_OK;
+    };
+    teamcore::tenant::TenantRouter router(cfg);
+
+    {
+        teamcore::tenant::TenantLease a = router.Acquire("club_a");  /**< Pinned for the whole block */
+        ASSERT_TRUE(a);
+        { teamcore::tenant::TenantLease b = router.Acquire("club_b"); ASSERT_TRUE(b); }  /**< Released */
+        EXPECT_EQ(2u, router.OpenCount());
+
+        teamcore::tenant::TenantLease c = router.Acquire("club_c");  /**< Evicts club_b, not pinned club_a */
+        ASSERT_TRUE(c);
+        EXPECT_EQ(2u, router.OpenCount());  /**< Bounded */
+        EXPECT_TRUE(router.IsOpen("club_a"));
+        EXPECT_FALSE(router.IsOpen("club_b"));
+
+        EXPECT_FALSE(router.Acquire("club_d"));  /**< Both handles pinned: rejected */
+        EXPECT_EQ(1u, router.Stats().rejected);
+
+        teamcore::tenant::TenantLease a2 = router.Acquire("club_a");  /**< Hit, same handle */
+        EXPECT_EQ(a.Db(), a2.Db());
+    }
+    EXPECT_EQ(3, setups);  /**< a, b, c opened once each */
+    EXPECT_EQ(1u, router.Stats().evictions);
+    EXPECT_EQ(1u, router.Stats().hits);
+
+    router.CloseIdle();  /**< Nothing pinned any more */
+    EXPECT_EQ(0u, router.OpenCount());
+    RemoveTenantDb("test_tenants", "club_a");
+    RemoveTenantDb("test_tenants", "club_b");
+    RemoveTenantDb("test_tenants", "club_c");
+}
+
+/**
+ * @brief Test that LS_* operations follow the selected tenant
+ * @test Verifies data written for one club is not visible to another
+ */
+TEST_F(LocalSportsTest, SelectTenantIsolatesData) {  /**< Test: LS_SelectTenant - isolation */
+    LS_Init();  /**< AppKey + default database */
+    LS_ConfigureTenants("test_tenants", 4);
+
+    ASSERT_TRUE(LS_SelectTenant("club_a"));
+    EXPECT_STREQ("club_a", LS_CurrentTenant());
+    provideInput("Club A only\n");
+    LS_AddMessageInteractive();  /**< Written to club_a.db */
+
+    ASSERT_TRUE(LS_SelectTenant("club_b"));
+    clearOutput();
+    LS_ListMessagesInteractive();
+    EXPECT_EQ(std::string::npos, getOutput().find("Club A only"));  /**< Not visible in club_b */
+
+    ASSERT_TRUE(LS_SelectTenant("club_a"));
+    clearOutput();
+    LS_ListMessagesInteractive();
+    EXPECT_NE(std::string::npos, getOutput().find("Club A only"));  /**< Visible again in club_a */
+    EXPECT_FALSE(LS_IsAuthenticated());  /**< Switching tenant ends the session */
+
+    EXPECT_TRUE(LS_SelectTenant(nullptr));  /**< Back to the default database */
+    EXPECT_EQ(nullptr, LS_CurrentTenant());
+    LS_ConfigureTenants("test_tenants", 4);  /**< Closes tenant handles */
+    RemoveTenantDb("test_tenants", "club_a");
+    RemoveTenantDb("test_tenants", "club_b");
+    std::remove("test_tenants");
+}
+
+// =================== PAGE VFS TESTS ===================
+
+/**
+ * @brief Helper: register a page-encrypting test VFS with a key filled by one byte
+ */
+static bool RegisterTestPageVfs(const char* name, unsigned char keyByte) {
+    unsigned char key[32];  /**< Deterministic test key */
+    std::memset(key, keyByte, sizeof(key));
+    return teamcore::pagevfs::RegisterPageVfs(name, teamcore::pagevfs::MakeAesGcmCodec(key));
+}
+
+/**
+ * @brief Helper: open a fresh WAL database through the given VFS (nullptr = default)
+ */
+static sqlite3* OpenPageTestDb(const char* path, const char* vfs) {
+    RemoveWalTestDb(path);  /**< Fresh file */
+    sqlite3* db = nullptr;  /**< Connection */
+    sqlite3_open_v2(path, &db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, vfs);
+    teamcore::pagevfs::PrepareNewDatabase(db);  /**< No-op on the default VFS */
+    sqlite3_exec(db, "PRAGMA journal_mode=WAL;", nullptr, nullptr, nullptr);
+    sqlite3_exec(db, "PRAGMA synchronous=NORMAL;", nullptr, nullptr, nullptr);
+    sqlite3_exec(db, "CREATE TABLE players(id INTEGER PRIMARY KEY, name TEXT, email TEXT);", nullptr, nullptr, nullptr);
+    return db;
+}
+
+/**
+ * @brief Helper: does a file contain the given byte string?
+ */
+static bool FileContains(const std::string& path, const std::string& needle) {
+    std::ifstream in(path.c_str(), std::ios::binary);  /**< Raw file */
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    return data.find(needle) != std::string::npos;
+}
+
+/**
+ * @brief Tests where backup and restore stage the decoded database
+ * @test Verifies the default VFS stages nothing on disk, a page VFS stages 0600 files that are
+ *       gone afterwards, and both round trip
+ */
+TEST_F(LocalSportsTest, BackupStagesNoPlaintextFile) {  /**< Test: Backup staging */
+#ifndef _WIN32
+    EnsureAppKey();
+    if (!teamcore::AppKey_IsReady()) GTEST_SKIP() << "AppKey not available";
+    ASSERT_TRUE(RegisterTestPageVfs("ls-crypt-test", 0x41));
+    const char* vfsNames[] = { nullptr, "ls-crypt-test" };
+    const char* path = "test_backup_stage.lsbk";
+    const std::string partial = std::string(path) + ".partial";
+    const std::string restoreTmp = std::string(path) + ".restore.tmp";
+    for (int v = 0; v < 2; ++v) {
+        SCOPED_TRACE(vfsNames[v] ? vfsNames[v] : "default");
+        sqlite3* src = OpenPageTestDb("test_backup_stage.db", vfsNames[v]);
+        ASSERT_EQ(SQLITE_OK, sqlite3_exec(src,
+            "INSERT INTO players(name, email) VALUES('A', 'stage-secret@club.org'), ('B', 'b@club.org');",
+            nullptr, nullptr, nullptr));
+
+        int stagedFiles = 0;
+        int stagedMode = 0;
+        teamcore::backup::BackupOptions opts;
+        opts.sleepMs = 0;
+        opts.encrypt = true;
+        opts.compress = true;
+        opts.onProgress = [&](const teamcore::backup::BackupProgress&) {
+            struct stat st;
+            if (stat(partial.c_str(), &st) == 0 || stat(restoreTmp.c_str(), &st) == 0) {
+                ++stagedFiles;
+                stagedMode |= st.st_mode & 0777;
+            }
+        };
+        ASSERT_TRUE(teamcore::backup::RunBackup(src, path, opts));
+        EXPECT_TRUE(teamcore::backup::VerifyBackup(path, vfsNames[v]));
+        sqlite3* dst = OpenPageTestDb("test_backup_stage_dst.db", vfsNames[v]);
+        EXPECT_TRUE(teamcore::backup::RunRestore(dst, path, opts));
+        EXPECT_EQ(2, CountRows(dst, "players"));
+
+        if (vfsNames[v]) {
+            EXPECT_GT(stagedFiles, 0);
+            EXPECT_EQ(0600, stagedMode);
+        }
+        else {
+            EXPECT_EQ(0, stagedFiles);
+        }
+        struct stat st;
+        EXPECT_NE(0, stat(partial.c_str(), &st));
+        EXPECT_NE(0, stat(restoreTmp.c_str(), &st));
+
+        sqlite3_close(dst);
+        sqlite3_close(src);
+        RemoveWalTestDb("test_backup_stage_dst.db");
+        RemoveWalTestDb("test_backup_stage.db");
+        std::remove(path);
+    }
+#endif
+}
+
+/**
+ * @brief Test that pages are encrypted on disk and readable through the VFS
+ * @test Verifies no plaintext in db/WAL, plaintext header and a clean integrity check
+ */
+TEST_F(LocalSportsTest, PageVfsEncryptsPagesOnDisk) {  /**< Test: PageVfs - encryption at rest */
+    const char* path = "test_page_vfs.db";  /**< Test database */
+    ASSERT_TRUE(RegisterTestPageVfs("ls-crypt-test", 0x41));
+    sqlite3* db = OpenPageTestDb(path, "ls-crypt-test");
+    ASSERT_NE(nullptr, db);
+
+    sqlite3_exec(db, "CREATE INDEX idx_players_email ON players(email);", nullptr, nullptr, nullptr);
+    sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr);
+    for (int i = 0; i < 500; ++i) {
+        std::string sql = "INSERT INTO players(name,email) VALUES('PLAINTEXT_MARKER_" + std::to_string(i) +
+                          "','marker" + std::to_string(i) + "@club.test');";
+        sqlite3_exec(db, sql.c_str(), nullptr, nullptr, nullptr);
+    }
+    sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+    EXPECT_TRUE(teamcore::pagevfs::IsPageTransformed(db));  /**< Header carries the codec layout */
+    EXPECT_STREQ("ls-crypt-test", teamcore::pagevfs::VfsNameOf(db));
+    EXPECT_FALSE(FileContains(std::string(path) + "-wal", "PLAINTEXT_MARKER"));  /**< WAL frames encrypted */
+
+    sqlite3_exec(db, "PRAGMA wal_checkpoint(TRUNCATE);", nullptr, nullptr, nullptr);
+    EXPECT_FALSE(FileContains(path, "PLAINTEXT_MARKER"));  /**< Database pages encrypted */
+    EXPECT_TRUE(FileContains(path, "SQLite format 3"));  /**< 100-byte header stays plaintext */
+
+    EXPECT_EQ(500, CountRows(db, "players"));
+    EXPECT_EQ(1, QueryIntValue(db, "SELECT COUNT(*) FROM players WHERE email='marker42@club.test';"));  /**< Index usable */
+    EXPECT_EQ(1, QueryIntValue(db, "SELECT COUNT(*) FROM pragma_integrity_check WHERE integrity_check='ok';"));
+    sqlite3_close(db);
+    RemoveWalTestDb(path);
+}
+
+/**
+ * @brief Test that a different key cannot read the database
+ * @test Verifies GCM tag failure surfaces as an SQLite error, not garbage rows
+ */
+TEST_F(LocalSportsTest, PageVfsRejectsWrongKey) {  /**< Test: PageVfs - wrong key */
+    const char* path = "test_page_vfs_key.db";  /**< Test database */
+    ASSERT_TRUE(RegisterTestPageVfs("ls-crypt-test", 0x41));
+    ASSERT_TRUE(RegisterTestPageVfs("ls-crypt-test-b", 0x42));
+    sqlite3* db = OpenPageTestDb(path, "ls-crypt-test");
+    sqlite3_exec(db, "INSERT INTO players(name,email) VALUES('a','a@club.test');", nullptr, nullptr, nullptr);
+    sqlite3_exec(db, "PRAGMA wal_checkpoint(TRUNCATE);", nullptr, nullptr, nullptr);
+    sqlite3_close(db);
+
+    sqlite3* other = nullptr;  /**< Same file, wrong key */
+    ASSERT_EQ(SQLITE_OK, sqlite3_open_v2(path, &other, SQLITE_OPEN_READWRITE, "ls-crypt-test-b"));
+    EXPECT_EQ(-1, CountRows(other, "players"));  /**< Schema page cannot be decrypted */
+    sqlite3_close(other);
+
+    sqlite3* plain = nullptr;  /**< Default VFS sees ciphertext */
+    sqlite3_open_v2(path, &plain, SQLITE_OPEN_READONLY, nullptr);
+    EXPECT_EQ(-1, CountRows(plain, "players"));
+    sqlite3_close(plain);
+    RemoveWalTestDb(path);
+}
+
+/**
+ * @brief Test WAL recovery of encrypted frames
+ * @test Verifies a copy of db + WAL taken before checkpoint recovers all rows
+ */
+TEST_F(LocalSportsTest, PageVfsRecoversEncryptedWal) {  /**< Test: PageVfs - WAL recovery */
+    const char* path = "test_page_vfs_wal.db";  /**< Live database */
+    const char* copy = "test_page_vfs_wal_copy.db";  /**< Crash image */
+    ASSERT_TRUE(RegisterTestPageVfs("ls-crypt-test", 0x41));
+    sqlite3* db = OpenPageTestDb(path, "ls-crypt-test");
+    sqlite3_exec(db, "PRAGMA wal_autocheckpoint=0;", nullptr, nullptr, nullptr);
+    for (int i = 0; i < 50; ++i) {
+        sqlite3_exec(db, "INSERT INTO players(name,email) VALUES('w','w@club.test');", nullptr, nullptr, nullptr);
+    }
+
+    RemoveWalTestDb(copy);
+    const char* suffixes[] = { "", "-wal" };
+    for (int i = 0; i < 2; ++i) {  /**< Copy while the connection is still open */
+        std::ifstream in((std::string(path) + suffixes[i]).c_str(), std::ios::binary);
+        std::ofstream out((std::string(copy) + suffixes[i]).c_str(), std::ios::binary);
+        out << in.rdbuf();
+    }
+    sqlite3_close(db);
+
+    sqlite3* rec = nullptr;  /**< Recovery reads full frames through the VFS */
+    ASSERT_EQ(SQLITE_OK, sqlite3_open_v2(copy, &rec, SQLITE_OPEN_READWRITE, "ls-crypt-test"));
+    EXPECT_EQ(50, CountRows(rec, "players"));
+    sqlite3_close(rec);
+    RemoveWalTestDb(path);
+    RemoveWalTestDb(copy);
+}
+
+/**
+ * @brief Test that the page number is bound into each encrypted page
+ * @test Verifies rollback through the encrypted journal, then that two valid pages swapped
+ *       on disk fail with IOERR_DATA and are both reported by VerifyPages
+ */
+TEST_F(LocalSportsTest, PageVfsRejectsSwappedPages) {  /**< Test: PageVfs - page number AAD */
+    const char* path = "test_page_vfs_swap.db";  /**< Test database */
+    ASSERT_TRUE(RegisterTestPageVfs("ls-crypt-test", 0x41));
+    sqlite3* db = OpenPageTestDb(path, "ls-crypt-test");
+    ASSERT_NE(nullptr, db);
+    sqlite3_exec(db, "PRAGMA journal_mode=DELETE;", nullptr, nullptr, nullptr);
+    sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr);
+    for (int i = 0; i < 300; ++i) {
+        std::string sql = "INSERT INTO players(name,email) VALUES('swap_" + std::to_string(i) +
+                          "','s" + std::to_string(i) + "@club.test');";
+        sqlite3_exec(db, sql.c_str(), nullptr, nullptr, nullptr);
+    }
+    sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+
+    sqlite3_exec(db, "BEGIN; DELETE FROM players; ROLLBACK;", nullptr, nullptr, nullptr);  /**< Replays journal pages */
+    EXPECT_EQ(300, CountRows(db, "players"));
+    sqlite3_close(db);
+
+    const int ps = 4096;  /**< PrepareNewDatabase page size */
+    {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);  /**< Raw file */
+        std::vector<char> a(ps), b(ps);
+        f.seekg(ps);
+        f.read(a.data(), ps);
+        f.read(b.data(), ps);
+        ASSERT_TRUE(f.good());
+        f.seekp(ps);
+        f.write(b.data(), ps);
+        f.write(a.data(), ps);
+    }
+
+    ASSERT_EQ(SQLITE_OK, sqlite3_open_v2(path, &db, SQLITE_OPEN_READWRITE, "ls-crypt-test"));
+    sqlite3_stmt* stmt = nullptr;  /**< Both pages decrypt under their own number only */
+    ASSERT_EQ(SQLITE_OK, sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM players;", -1, &stmt, nullptr));
+    EXPECT_NE(SQLITE_ROW, sqlite3_step(stmt));
+    EXPECT_EQ(SQLITE_IOERR_DATA, sqlite3_extended_errcode(db));
+    sqlite3_finalize(stmt);
+    sqlite3_close(db);
+
+    unsigned char key[32];  /**< Same key as the test VFS */
+    std::memset(key, 0x41, sizeof(key));
+    std::shared_ptr<teamcore::pagevfs::PageCodec> codec = teamcore::pagevfs::MakeAesGcmCodec(key);
+    teamcore::pagevfs::PageScanResult r;
+    ASSERT_TRUE(teamcore::pagevfs::VerifyPages(path, *codec, 1, 1 << 20, &r));
+    ASSERT_EQ(2u, r.badPages.size());
+    EXPECT_EQ(2, r.badPages[0]);
+    EXPECT_EQ(3, r.badPages[1]);
+    RemoveWalTestDb(path);
+}
+
+/**
+ * @brief Benchmark page encryption against per-field encryption
+ * @test Compares insert, list and search throughput; asserts only that both modes agree
+ */
+TEST_F(LocalSportsTest, DISABLED_BenchPageVfsVsFieldEncryption) {  /**< Benchmark: page VFS vs per-field GCM */
+    const int kRows = 5000;  /**< Players per database */
+    const int kSearches = 50;  /**< Email lookups */
+    unsigned char key[32];  /**< Field key */
+    std::memset(key, 0x5A, sizeof(key));
+    ASSERT_TRUE(RegisterTestPageVfs("ls-crypt-test", 0x41));
+    typedef std::chrono::duration<double, std::milli> ms;
+
+    // Per-field: email encrypted in the column, search must decrypt every row
+    sqlite3* fdb = OpenPageTestDb("test_bench_fields.db", nullptr);
+    auto t0 = std::chrono::steady_clock::now();
+    sqlite3_exec(fdb, "BEGIN;", nullptr, nullptr, nullptr);
+    sqlite3_stmt* ins = nullptr;
+    sqlite3_prepare_v2(fdb, "INSERT INTO players(name,email) VALUES(?,?);", -1, &ins, nullptr);
+    for (int i = 0; i < kRows; ++i) {
+        std::string email = teamcore::crypto::EncryptForDB("user" + std::to_string(i) + "@club.test", key, "");
+        sqlite3_bind_text(ins, 1, "player", -1, SQLITE_STATIC);
+        sqlite3_bind_text(ins, 2, email.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_step(ins);
+        sqlite3_reset(ins);
+    }
+    sqlite3_finalize(ins);
+    sqlite3_exec(fdb, "COMMIT;", nullptr, nullptr, nullptr);
+    auto t1 = std::chrono::steady_clock::now();
+
+    size_t listedFields = 0;
+    sqlite3_stmt* st = nullptr;
+    sqlite3_prepare_v2(fdb, "SELECT email FROM players ORDER BY id;", -1, &st, nullptr);
+    while (sqlite3_step(st) == SQLITE_ROW) {
+        listedFields += teamcore::crypto::DecryptFromDB(reinterpret_cast<const char*>(sqlite3_column_text(st, 0)), key, "").size();
+    }
+    sqlite3_finalize(st);
+    auto t2 = std::chrono::steady_clock::now();
+
+    int foundFields = 0;
+    for (int s = 0; s < kSearches; ++s) {
+        const std::string target = "user" + std::to_string(s * 97 % kRows) + "@club.test";
+        sqlite3_prepare_v2(fdb, "SELECT email FROM players;", -1, &st, nullptr);
+        while (sqlite3_step(st) == SQLITE_ROW) {
+            if (teamcore::crypto::DecryptFromDB(reinterpret_cast<const char*>(sqlite3_column_text(st, 0)), key, "") == target) {
+                ++foundFields;
+                break;
+            }
+        }
+        sqlite3_finalize(st);
+    }
+    auto t3 = std::chrono::steady_clock::now();
+    sqlite3_close(fdb);
+
+    // Page mode: plaintext columns with an index, pages encrypted by the VFS
+    sqlite3* pdb = OpenPageTestDb("test_bench_pages.db", "ls-crypt-test");
+    sqlite3_exec(pdb, "CREATE INDEX idx_players_email ON players(email);", nullptr, nullptr, nullptr);
+    auto t4 = std::chrono::steady_clock::now();
+    sqlite3_exec(pdb, "BEGIN;", nullptr, nullptr, nullptr);
+    sqlite3_prepare_v2(pdb, "INSERT INTO players(name,email) VALUES(?,?);", -1, &ins, nullptr);
+    for (int i = 0; i < kRows; ++i) {
+        std::string email = "user" + std::to_string(i) + "@club.test";
+        sqlite3_bind_text(ins, 1, "player", -1, SQLITE_STATIC);
+        sqlite3_bind_text(ins, 2, email.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_step(ins);
+        sqlite3_reset(ins);
+    }
+    sqlite3_finalize(ins);
+    sqlite3_exec(pdb, "COMMIT;", nullptr, nullptr, nullptr);
+    sqlite3_exec(pdb, "PRAGMA wal_checkpoint(TRUNCATE);", nullptr, nullptr, nullptr);
+    sqlite3_exec(pdb, "PRAGMA cache_size=-64;", nullptr, nullptr, nullptr);  /**< Small cache: reads hit the VFS */
+    auto t5 = std::chrono::steady_clock::now();
+
+    size_t listedPages = 0;
+    sqlite3_prepare_v2(pdb, "SELECT email FROM players ORDER BY id;", -1, &st, nullptr);
+    while (sqlite3_step(st) == SQLITE_ROW) {
+        listedPages += static_cast<size_t>(sqlite3_column_bytes(st, 0));
+    }
+    sqlite3_finalize(st);
+    auto t6 = std::chrono::steady_clock::now();
+
+    int foundPages = 0;
+    sqlite3_prepare_v2(pdb, "SELECT COUNT(*) FROM players WHERE email=?;", -1, &st, nullptr);
+    for (int s = 0; s < kSearches; ++s) {
+        const std::string target = "user" + std::to_string(s * 97 % kRows) + "@club.test";
+        sqlite3_bind_text(st, 1, target.c_str(), -1, SQLITE_TRANSIENT);
+        if (sqlite3_step(st) == SQLITE_ROW) foundPages += sqlite3_column_int(st, 0);
+        sqlite3_reset(st);
+    }
+    sqlite3_finalize(st);
+    auto t7 = std::chrono::steady_clock::now();
+    sqlite3_close(pdb);
+
+    EXPECT_EQ(listedFields, listedPages);  /**< Same plaintext volume */
+    EXPECT_EQ(kSearches, foundFields);
+    EXPECT_EQ(kSearches, foundPages);
+
+    std::cerr << "[BENCH] rows=" << kRows << " searches=" << kSearches
+              << " insert(fields)=" << ms(t1 - t0).count() << "ms"
+              << " insert(pages)=" << ms(t5 - t4).count() << "ms"
+              << " list(fields)=" << ms(t2 - t1).count() << "ms"
+              << " list(pages)=" << ms(t6 - t5).count() << "ms"
+              << " search(fields)=" << ms(t3 - t2).count() << "ms"
+              << " search(pages)=" << ms(t7 - t6).count() << "ms\n";
+    RemoveWalTestDb("test_bench_fields.db");
+    RemoveWalTestDb("test_bench_pages.db");
+}
+
+/**
+ * @brief Test LS page encryption mode end to end on a tenant database
+ * @test Verifies messages are stored as plain columns but never reach the disk in clear
+ */
+TEST_F(LocalSportsTest, EncryptionModePagesStoresPlainColumns) {  /**< Test: LS_SetEncryptionMode(PAGES) */
+    LS_SetEncryptionMode(LS_ENCRYPT_PAGES);
+    LS_Init();  /**< Registers "ls-crypt" with the derived page key */
+    LS_ConfigureTenants("test_tenants_enc", 4);
+    ASSERT_TRUE(LS_SelectTenant("club_enc"));  /**< New database, created through the VFS */
+    provideInput("PAGE_MODE_SECRET\n");
+    LS_AddMessageInteractive();
+
+    clearOutput();
+    LS_ListMessagesInteractive();
+    EXPECT_NE(std::string::npos, getOutput().find("PAGE_MODE_SECRET"));
+
+    sqlite3* db = nullptr;  /**< Second connection through the same VFS */
+    ASSERT_EQ(SQLITE_OK, sqlite3_open_v2("test_tenants_enc/club_enc.db", &db, SQLITE_OPEN_READWRITE,
+                                         teamcore::pagevfs::ENCRYPTED_VFS_NAME));
+    EXPECT_TRUE(teamcore::pagevfs::IsPageTransformed(db));
+    EXPECT_EQ(1, QueryIntValue(db, "SELECT COUNT(*) FROM messages WHERE text='PAGE_MODE_SECRET';"));  /**< Column is searchable */
+    sqlite3_exec(db, "PRAGMA wal_checkpoint(TRUNCATE);", nullptr, nullptr, nullptr);
+    sqlite3_close(db);
+    EXPECT_FALSE(FileContains("test_tenants_enc/club_enc.db", "PAGE_MODE_SECRET"));
+
+    LS_SelectTenant(nullptr);
+    LS_ConfigureTenants("test_tenants_enc", 4);  /**< Closes tenant handles */
+    LS_SetEncryptionMode(LS_ENCRYPT_FIELDS);
+    RemoveTenantDb("test_tenants_enc", "club_enc");
+    std::remove("test_tenants_enc");
+}
+
+// =================== SQL FUNCTION TESTS ===================
+
+/**
+ * @brief Test ls_decrypt inside SQLite for filtering and ordering
+ * @test Verifies encrypted columns sort by plaintext and legacy/NULL values pass through
+ */
+TEST_F(LocalSportsTest, SqlFunctionDecryptOrdersByPlaintext) {  /**< Test: ls_decrypt */
+    unsigned char key[32];  /**< Field key */
+    std::memset(key, 0x33, sizeof(key));
+    sqlite3* db = nullptr;  /**< In-memory database */
+    ASSERT_EQ(SQLITE_OK, sqlite3_open(":memory:", &db));
+    ASSERT_TRUE(teamcore::sqlfn::RegisterSqlFunctions(db, key));
+    sqlite3_exec(db, "CREATE TABLE players(id INTEGER PRIMARY KEY, email TEXT);", nullptr, nullptr, nullptr);
+
+    const char* emails[] = { "carol@club.test", "alice@club.test", "bob@club.test" };  /**< Insert order != sort order */
+    sqlite3_stmt* ins = nullptr;
+    sqlite3_prepare_v2(db, "INSERT INTO players(email) VALUES(?);", -1, &ins, nullptr);
+    for (int i = 0; i < 3; ++i) {
+        std::string enc = teamcore::crypto::EncryptForDB(emails[i], key, "");
+        sqlite3_bind_text(ins, 1, enc.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_step(ins);
+        sqlite3_reset(ins);
+    }
+    sqlite3_finalize(ins);
+    sqlite3_exec(db, "INSERT INTO players(email) VALUES('dave@club.test'),(NULL);", nullptr, nullptr, nullptr);  /**< Legacy plaintext + NULL */
+
+    std::vector<std::string> ordered;  /**< Decrypted, engine-sorted */
+    sqlite3_stmt* st = nullptr;
+    sqlite3_prepare_v2(db, "SELECT ls_decrypt(email) AS e FROM players WHERE e IS NOT NULL ORDER BY e;", -1, &st, nullptr);
+    while (sqlite3_step(st) == SQLITE_ROW) {
+        ordered.push_back(reinterpret_cast<const char*>(sqlite3_column_text(st, 0)));
+    }
+    sqlite3_finalize(st);
+    ASSERT_EQ(4u, ordered.size());
+    EXPECT_EQ("alice@club.test", ordered[0]);
+    EXPECT_EQ("bob@club.test", ordered[1]);
+    EXPECT_EQ("carol@club.test", ordered[2]);
+    EXPECT_EQ("dave@club.test", ordered[3]);
+
+    EXPECT_EQ(1, QueryIntValue(db, "SELECT COUNT(*) FROM players WHERE ls_decrypt(email) LIKE 'bob%';"));
+    EXPECT_EQ(1, QueryIntValue(db, "SELECT COUNT(*) FROM players WHERE ls_decrypt(email) IS NULL;"));  /**< NULL in, NULL out */
+    EXPECT_NE(SQLITE_OK, sqlite3_exec(db, "CREATE VIEW leak AS SELECT ls_decrypt(email) FROM players; SELECT * FROM leak;",
+                                      nullptr, nullptr, nullptr));  /**< DIRECTONLY: not usable from schema objects */
+    sqlite3_close(db);
+}
+
+/**
+ * @brief Test statistical aggregates backed by MathUtility
+ * @test Verifies median/stddev/quantile with GROUP BY, NULL skipping and bad quantile
+ */
+TEST_F(LocalSportsTest, SqlFunctionStatisticalAggregates) {  /**< Test: ls_median/ls_stddev/ls_quantile */
+    sqlite3* db = nullptr;  /**< In-memory database */
+    ASSERT_EQ(SQLITE_OK, sqlite3_open(":memory:", &db));
+    ASSERT_TRUE(teamcore::sqlfn::RegisterSqlFunctions(db, nullptr));
+    sqlite3_exec(db, "CREATE TABLE stats(playerId INTEGER, goals INTEGER);"
+                     "INSERT INTO stats VALUES(1,4),(1,1),(1,3),(1,2),(1,5),(1,NULL),(2,2),(2,4);",
+                 nullptr, nullptr, nullptr);
+
+    sqlite3_stmt* st = nullptr;  /**< Per-player distribution */
+    ASSERT_EQ(SQLITE_OK, sqlite3_prepare_v2(db,
+        "SELECT playerId, ls_median(goals), ls_stddev(goals), ls_quantile(goals, 0.9) "
+        "FROM stats GROUP BY playerId ORDER BY playerId;", -1, &st, nullptr));
+    ASSERT_EQ(SQLITE_ROW, sqlite3_step(st));
+    EXPECT_DOUBLE_EQ(3.0, sqlite3_column_double(st, 1));  /**< NULL ignored */
+    EXPECT_NEAR(1.58113883, sqlite3_column_double(st, 2), 1e-8);  /**< sqrt(2.5) */
+    EXPECT_NEAR(4.6, sqlite3_column_double(st, 3), 1e-12);
+    ASSERT_EQ(SQLITE_ROW, sqlite3_step(st));
+    EXPECT_DOUBLE_EQ(3.0, sqlite3_column_double(st, 1));
+    sqlite3_finalize(st);
+
+    EXPECT_EQ(1, QueryIntValue(db, "SELECT ls_median(goals) IS NULL FROM stats WHERE playerId=99;"));  /**< Empty set -> NULL */
+    EXPECT_NE(SQLITE_OK, sqlite3_exec(db, "SELECT ls_quantile(goals, 1.5) FROM stats;", nullptr, nullptr, nullptr));
+    sqlite3_close(db);
+}
+
+// =================== HYBRID STORE TESTS ===================
+
+/**
+ * @brief Helper: remove a hybrid database file and its commit log
+ */
+static void RemoveHybridDb(const char* path) {
+    RemoveWalTestDb(path);
+    std::remove((std::string(path) + ".journal").c_str());
+}
+
+/**
+ * @brief Helper: copy a file byte for byte (simulated crash image)
+ */
+static void CopyFileBytes(const std::string& from, const std::string& to) {
+    std::ifstream in(from.c_str(), std::ios::binary);
+    std::ofstream out(to.c_str(), std::ios::binary | std::ios::trunc);
+    out << in.rdbuf();
+}
+
+/**
+ * @brief Test that commits reach the log and a checkpoint persists the RAM image
+ * @test Verifies load-from-disk, journaling, checkpoint log reset and reopen
+ */
+TEST_F(LocalSportsTest, HybridStoreCheckpointPersistsMemoryImage) {  /**< Test: HybridStore - checkpoint */
+    const char* path = "test_hybrid.db";  /**< Disk image */
+    RemoveHybridDb(path);
+    teamcore::hybrid::HybridConfig cfg;  /**< Long interval: only explicit checkpoints */
+    cfg.diskPath = path;
+    cfg.checkpointIntervalMs = 60000;
+
+    teamcore::hybrid::HybridStore store;
+    ASSERT_TRUE(store.Open(cfg));
+    sqlite3* db = store.Db();  /**< In-memory connection */
+    sqlite3_exec(db, "CREATE TABLE players(id INTEGER PRIMARY KEY, name TEXT);", nullptr, nullptr, nullptr);
+    sqlite3_stmt* ins = nullptr;
+    sqlite3_prepare_v2(db, "INSERT INTO players(name) VALUES(?);", -1, &ins, nullptr);
+    for (int i = 0; i < 10; ++i) {
+        sqlite3_bind_text(ins, 1, ("p" + std::to_string(i)).c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_step(ins);
+        sqlite3_reset(ins);
+    }
+    sqlite3_finalize(ins);
+
+    teamcore::hybrid::HybridStats s = store.Stats();
+    EXPECT_EQ(11u, s.loggedTx);  /**< CREATE + 10 autocommit inserts */
+    EXPECT_GT(s.logBytes, 0u);
+    EXPECT_EQ(0, QueryIntValue(store.DiskDb(), "SELECT COUNT(*) FROM sqlite_master WHERE name='players';"));  /**< Not on disk yet */
+
+    ASSERT_TRUE(store.Checkpoint());
+    s = store.Stats();
+    EXPECT_EQ(0u, s.logBytes);  /**< Log reset after the image is durable */
+    EXPECT_EQ(s.lastSeq, s.checkpointSeq);
+    EXPECT_EQ(10, CountRows(store.DiskDb(), "players"));
+    store.Close();
+
+    ASSERT_TRUE(store.Open(cfg));  /**< Reload from disk */
+    EXPECT_EQ(10, CountRows(store.Db(), "players"));
+    EXPECT_EQ(0u, store.Stats().replayedTx);
+    store.Close();
+    RemoveHybridDb(path);
+}
+
+/**
+ * @brief Test crash recovery by replaying the commit log
+ * @test Verifies a crash image (stale disk + log) replays bound parameters, skips a torn tail
+ *       and keeps the log encrypted
+ */
+TEST_F(LocalSportsTest, HybridStoreReplaysLogAfterCrash) {  /**< Test: HybridStore - replay */
+    const char* path = "test_hybrid_live.db";  /**< Live store */
+    const char* crash = "test_hybrid_crash.db";  /**< Crash image */
+    RemoveHybridDb(path);
+    RemoveHybridDb(crash);
+    unsigned char key[32];  /**< Log key */
+    std::memset(key, 0x6B, sizeof(key));
+
+    teamcore::hybrid::HybridConfig cfg;
+    cfg.diskPath = path;
+    cfg.checkpointIntervalMs = 60000;
+    cfg.logKey = key;
+    teamcore::hybrid::HybridStore live;
+    ASSERT_TRUE(live.Open(cfg));
+    sqlite3_exec(live.Db(), "CREATE TABLE messages(id INTEGER PRIMARY KEY, text TEXT);", nullptr, nullptr, nullptr);
+    ASSERT_TRUE(live.Checkpoint());  /**< Disk has the schema only */
+
+    sqlite3_exec(live.Db(), "BEGIN; INSERT INTO messages(text) VALUES('HYBRID_SECRET_1');"
+                            "SAVEPOINT sp; INSERT INTO messages(text) VALUES('undone'); ROLLBACK TO sp; RELEASE sp;"
+                            "COMMIT;", nullptr, nullptr, nullptr);
+    sqlite3_stmt* ins = nullptr;  /**< Bound parameter must be expanded into the log */
+    sqlite3_prepare_v2(live.Db(), "INSERT INTO messages(text) VALUES(?);", -1, &ins, nullptr);
+    sqlite3_bind_text(ins, 1, "it's bound", -1, SQLITE_STATIC);
+    sqlite3_step(ins);
+    sqlite3_finalize(ins);
+    sqlite3_exec(live.Db(), "BEGIN; INSERT INTO messages(text) VALUES('rolled back'); ROLLBACK;", nullptr, nullptr, nullptr);
+
+    CopyFileBytes(path, crash);  /**< Process "dies" here: disk image is stale */
+    CopyFileBytes(std::string(path) + ".journal", std::string(crash) + ".journal");
+    EXPECT_FALSE(FileContains(std::string(crash) + ".journal", "HYBRID_SECRET"));  /**< Log is encrypted */
+    {
+        std::ofstream torn((std::string(crash) + ".journal").c_str(), std::ios::binary | std::ios::app);
+        torn << "LSJ1\x05";  /**< Half-written record */
+    }
+    live.Close();
+
+    cfg.diskPath = crash;
+    teamcore::hybrid::HybridStore recovered;
+    ASSERT_TRUE(recovered.Open(cfg));
+    EXPECT_EQ(2u, recovered.Stats().replayedTx);
+    EXPECT_EQ(0u, recovered.Stats().replayErrors);
+    EXPECT_EQ(2, CountRows(recovered.Db(), "messages"));
+    EXPECT_EQ(1, QueryIntValue(recovered.Db(), "SELECT COUNT(*) FROM messages WHERE text='it''s bound';"));
+    EXPECT_EQ(0, QueryIntValue(recovered.Db(), "SELECT COUNT(*) FROM messages WHERE text IN ('undone','rolled back');"));
+    EXPECT_EQ(2, CountRows(recovered.DiskDb(), "messages"));  /**< Replay checkpointed immediately */
+    recovered.Close();
+    RemoveHybridDb(path);
+    RemoveHybridDb(crash);
+}
+
+/**
+ * @brief Test LS memory storage mode with a configurable path
+ * @test Verifies data written in memory mode is on disk after switching back to disk mode
+ */
+TEST_F(LocalSportsTest, StorageModeMemoryPersistsToConfiguredPath) {  /**< Test: LS_SetStorageMode(MEMORY) */
+    const char* path = "test_ls_hybrid.db";  /**< Configured database path */
+    RemoveHybridDb(path);
+    LS_SetDatabasePath(path);
+    LS_SetStorageMode(LS_STORAGE_MEMORY);
+    LS_Init();
+    EXPECT_STREQ(path, LS_GetDatabasePath());
+    provideInput("Kiosk duyurusu\n");
+    LS_AddMessageInteractive();
+
+    clearOutput();
+    LS_MaintenanceStatusInteractive();
+    EXPECT_NE(std::string::npos, getOutput().find("bellek (hibrit)"));
+
+    clearOutput();
+    LS_ListMessagesInteractive();
+    EXPECT_NE(std::string::npos, getOutput().find("Kiosk duyurusu"));
+
+    LS_SetStorageMode(LS_STORAGE_DISK);
+    LS_Init();  /**< Closes the hybrid store with a final checkpoint, reopens the file */
+    clearOutput();
+    LS_ListMessagesInteractive();
+    EXPECT_NE(std::string::npos, getOutput().find("Kiosk duyurusu"));
+
+    LS_SetDatabasePath(nullptr);
+    LS_Init();  /**< Back to the default file */
+    RemoveHybridDb(path);
+}
+
+/**
+ * @brief Test log replay after a season archive and cross-season attach
+ * @test Verifies ATTACH, archive_rw writes and TEMP views stay out of the log so replay succeeds
+ */
+TEST_F(LocalSportsTest, HybridStoreReplaysAfterArchive) {  /**< Test: HybridStore - non-main statements */
+    const char* path = "test_hybrid_season.db";  /**< Live store */
+    const char* crash = "test_hybrid_season_crash.db";  /**< Crash image */
+    const std::string archivePath = teamcore::archive::ArchivePathFor(path, "2020");
+    RemoveHybridDb(path);
+    RemoveHybridDb(crash);
+    std::remove(archivePath.c_str());
+
+    teamcore::hybrid::HybridConfig cfg;
+    cfg.diskPath = path;
+    cfg.checkpointIntervalMs = 60000;
+    teamcore::hybrid::HybridStore live;
+    ASSERT_TRUE(live.Open(cfg));
+    ASSERT_EQ(SQLITE_OK, sqlite3_exec(live.Db(), SEASON_TEST_SQL, nullptr, nullptr, nullptr));
+    ASSERT_TRUE(live.Checkpoint());  /**< Disk has both seasons */
+
+    ASSERT_TRUE(teamcore::archive::ArchiveSeason(live.Db(), path, "2020", 2025));
+    EXPECT_EQ(1, teamcore::archive::AttachArchives(live.Db()));
+    EXPECT_EQ(4, CountRows(live.Db(), "all_games"));
+    teamcore::archive::DetachArchives(live.Db());
+    ASSERT_EQ(SQLITE_OK, sqlite3_exec(live.Db(), "INSERT INTO messages(datetime,text) VALUES('2021-06-06 10:00','after');",
+                                      nullptr, nullptr, nullptr));
+
+    CopyFileBytes(path, crash);  /**< Stale disk image + log */
+    CopyFileBytes(std::string(path) + ".journal", std::string(crash) + ".journal");
+    EXPECT_FALSE(FileContains(std::string(crash) + ".journal", "archive_rw"));
+    EXPECT_FALSE(FileContains(std::string(crash) + ".journal", "all_games"));
+    live.Close();
+
+    cfg.diskPath = crash;
+    teamcore::hybrid::HybridStore recovered;
+    ASSERT_TRUE(recovered.Open(cfg));
+    EXPECT_GT(recovered.Stats().replayedTx, 0u);
+    EXPECT_EQ(0u, recovered.Stats().replayErrors);
+    EXPECT_EQ(2, CountRows(recovered.Db(), "games"));  /**< 2020 removed from main */
+    EXPECT_EQ(1, CountRows(recovered.Db(), "stats"));
+    EXPECT_EQ(2, CountRows(recovered.Db(), "messages"));
+    EXPECT_EQ(2, QueryIntValue(recovered.Db(), "SELECT games FROM _ls_archives WHERE season='2020';"));
+    EXPECT_EQ(0, QueryIntValue(recovered.Db(), "SELECT COUNT(*) FROM sqlite_temp_master;"));
+    recovered.Close();
+
+    sqlite3* arch = nullptr;  /**< Archive written once, not again by replay */
+    ASSERT_EQ(SQLITE_OK, sqlite3_open(archivePath.c_str(), &arch));
+    EXPECT_EQ(2, CountRows(arch, "games"));
+    sqlite3_close(arch);
+    RemoveHybridDb(path);
+    RemoveHybridDb(crash);
+    std::remove(archivePath.c_str());
+}
+
+/**
+ * @brief Test that a new hybrid database keeps the page-encrypting VFS layout
+ * @test Verifies page_size/reserve requested on the empty disk file reach the checkpointed image
+ */
+TEST_F(LocalSportsTest, HybridStoreKeepsPageVfsLayout) {  /**< Test: HybridStore + PageVfs */
+    const char* path = "test_hybrid_pages.db";  /**< Disk image */
+    RemoveHybridDb(path);
+    ASSERT_TRUE(RegisterTestPageVfs("ls-crypt-test", 0x41));
+    teamcore::hybrid::HybridConfig cfg;
+    cfg.diskPath = path;
+    cfg.vfs = "ls-crypt-test";
+    cfg.checkpointIntervalMs = 60000;
+    cfg.diskSetup = [](sqlite3* disk) { return teamcore::pagevfs::PrepareNewDatabase(disk); };
+
+    teamcore::hybrid::HybridStore store;
+    ASSERT_TRUE(store.Open(cfg));
+    sqlite3_exec(store.Db(), "CREATE TABLE t(x); INSERT INTO t VALUES('HYBRID_PAGE_SECRET');", nullptr, nullptr, nullptr);
+    ASSERT_TRUE(store.Checkpoint());
+    EXPECT_TRUE(teamcore::pagevfs::IsPageTransformed(store.DiskDb()));
+    store.Close();
+    EXPECT_FALSE(FileContains(path, "HYBRID_PAGE_SECRET"));
+    RemoveHybridDb(path);
+}
+
+// =================== Context Tests ===================
+
+/**
+ * @brief Helper: run one context's message round trip with its own streams
+ * @param ctx Context under test
+ * @param tag Text prefix of the messages
+ * @param count Messages to add
+ * @return Output of the final listing
+ */
+static std::string ContextMessageRoundTrip(LSContext& ctx, const std::string& tag, int count) {
+    std::stringstream input;
+    std::stringstream output;
+    for (int i = 0; i < count; ++i) input << tag << " " << i << "\n";
+    LS_SetContextStreams(ctx, &input, &output);
+    for (int i = 0; i < count; ++i) LS_AddMessageInteractive(ctx);
+    output.str("");
+    LS_ListMessagesInteractive(ctx);
+    LS_SetContextStreams(ctx, nullptr, nullptr);
+    return output.str();
+}
+
+/**
+ * @brief Helper: number of occurrences of needle in text
+ */
+static int CountOccurrences(const std::string& text, const std::string& needle) {
+    int n = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) ++n;
+    return n;
+}
+
+/**
+ * @brief Test that two contexts keep separate databases, keys and streams
+ * @test Verifies messages stay in their own file, are sealed with the context key,
+ *       and the default context is untouched
+ */
+TEST_F(LocalSportsTest, ContextsAreIsolated) {  /**< Test: LSContext isolation */
+    const char* pathA = "test_ctx_a.db";  /**< Context A database */
+    const char* pathB = "test_ctx_b.db";  /**< Context B database */
+    RemoveWalTestDb(pathA);
+    RemoveWalTestDb(pathB);
+    unsigned char keyA[32];
+    unsigned char keyB[32];
+    std::memset(keyA, 0xA1, sizeof(keyA));
+    std::memset(keyB, 0xB2, sizeof(keyB));
+
+    LSContext* a = LS_CreateContext(pathA);
+    LSContext* b = LS_CreateContext(pathB);
+    LS_SetContextKey(*a, keyA);
+    LS_SetContextKey(*b, keyB);
+    LS_Init(*a);
+    LS_Init(*b);
+    EXPECT_STREQ(pathA, LS_GetDatabasePath(*a));
+    EXPECT_STRNE(pathA, LS_GetDatabasePath());  /**< Default context keeps its own path */
+
+    std::string listA = ContextMessageRoundTrip(*a, "alpha", 2);
+    std::string listB = ContextMessageRoundTrip(*b, "beta", 1);
+    EXPECT_EQ(2, CountOccurrences(listA, "alpha"));
+    EXPECT_EQ(0, CountOccurrences(listA, "beta"));
+    EXPECT_EQ(1, CountOccurrences(listB, "beta"));
+    EXPECT_EQ(0, CountOccurrences(listB, "alpha"));
+    EXPECT_EQ(std::string::npos, getOutput().find("alpha"));  /**< Nothing leaked to std::cout */
+
+    LS_DestroyContext(a);
+    LS_DestroyContext(b);
+
+    // A's rows decrypt with A's key only
+    sqlite3* db = nullptr;
+    ASSERT_EQ(SQLITE_OK, sqlite3_open(pathA, &db));
+    ASSERT_TRUE(teamcore::sqlfn::RegisterSqlFunctions(db, keyA));
+    EXPECT_EQ(2, QueryIntValue(db, "SELECT COUNT(*) FROM messages WHERE ls_decrypt(text) LIKE 'alpha %';"));
+    sqlite3_close(db);
+    ASSERT_EQ(SQLITE_OK, sqlite3_open(pathA, &db));
+    ASSERT_TRUE(teamcore::sqlfn::RegisterSqlFunctions(db, keyB));
+    EXPECT_EQ(0, QueryIntValue(db, "SELECT COUNT(*) FROM messages WHERE ls_decrypt(text) LIKE 'alpha %';"));
+    sqlite3_close(db);
+    RemoveWalTestDb(pathA);
+    RemoveWalTestDb(pathB);
+}
+
+/**
+ * @brief Test that independent contexts run in parallel threads
+ * @test Verifies each thread sees exactly its own messages through its own streams
+ */
+TEST_F(LocalSportsTest, ContextsRunInParallelThreads) {  /**< Test: LSContext per thread */
+    const int kThreads = 4;  /**< Parallel contexts */
+    const int kMessages = 25;  /**< Messages per context */
+    std::vector<std::string> listings(kThreads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < kThreads; ++t) {
+        workers.push_back(std::thread([t, &listings]() {
+            const std::string path = "test_ctx_par_" + std::to_string(t) + ".db";
+            RemoveWalTestDb(path.c_str());
+            unsigned char key[32];
+            std::memset(key, 0x30 + t, sizeof(key));
+            LSContext* ctx = LS_CreateContext(path.c_str());
+            LS_SetContextKey(*ctx, key);
+            LS_Init(*ctx);
+            listings[t] = ContextMessageRoundTrip(*ctx, "thread" + std::to_string(t), kMessages);
+            LS_DestroyContext(ctx);
+            RemoveWalTestDb(path.c_str());
+        }));
+    }
+    for (size_t i = 0; i < workers.size(); ++i) workers[i].join();
+
+    for (int t = 0; t < kThreads; ++t) {
+        EXPECT_EQ(kMessages, CountOccurrences(listings[t], "thread"));
+        EXPECT_EQ(kMessages, CountOccurrences(listings[t], "thread" + std::to_string(t) + " "));
+    }
+}
+
+// =================== Message Feed Tests ===================
+
+/**
+ * @brief Helper: context on its own database with a fixed key
+ */
+static LSContext* CreateTestContext(const char* path, unsigned char keyByte) {
+    RemoveWalTestDb(path);
+    unsigned char key[32];
+    std::memset(key, keyByte, sizeof(key));
+    LSContext* ctx = LS_CreateContext(path);
+    LS_SetContextKey(*ctx, key);
+    LS_Init(*ctx);
+    return ctx;
+}
+
+/**
+ * @brief Test interactive backup and restore of a page-encrypted database
+ * @test Verifies the backup written through "ls-crypt" passes restore verification and brings back its rows
+ */
+TEST_F(LocalSportsTest, RestoreInteractivePageEncryptedRoundTrip) {  /**< Test: LS_RestoreInteractive - PAGES */
+    const char* path = "test_restore_pages.db";  /**< Live database */
+    const char* backupPath = "test_restore_pages_backup.db";  /**< Plain (unpacked) backup file */
+    RemoveWalTestDb(path);
+    std::remove(backupPath);
+    unsigned char key[32];
+    std::memset(key, 0x6C, sizeof(key));
+    LSContext* ctx = LS_CreateContext(path);
+    LS_SetContextKey(*ctx, key);
+    LS_SetEncryptionMode(*ctx, LS_ENCRYPT_PAGES);
+    LS_Init(*ctx);
+    ContextMessageRoundTrip(*ctx, "kept", 2);
+
+    std::stringstream input;
+    std::stringstream output;
+    input << backupPath << "\nh\nh\n";  /**< Path, no container encryption, no compression */
+    LS_SetContextStreams(*ctx, &input, &output);
+    LS_BackupInteractive(*ctx);
+    ASSERT_NE(std::string::npos, output.str().find("Yedek olusturuldu"));
+    EXPECT_FALSE(FileContains(backupPath, "kept 0"));  /**< Pages of the backup are encrypted too */
+
+    ContextMessageRoundTrip(*ctx, "dropped", 1);
+    Message page[8];
+    EXPECT_EQ(3, LS_FetchMessages(*ctx, 0, page, 8));
+
+    input.clear();
+    input.str(std::string(backupPath) + "\ne\n");  /**< Path, confirm */
+    output.str("");
+    LS_SetContextStreams(*ctx, &input, &output);
+    LS_RestoreInteractive(*ctx);
+    EXPECT_NE(std::string::npos, output.str().find("Geri yukleme tamamlandi")) << output.str();
+    LS_SetContextStreams(*ctx, nullptr, nullptr);
+    ASSERT_EQ(2, LS_FetchMessages(*ctx, 0, page, 8));
+    EXPECT_STREQ("kept 0", page[0].text);
+
+    LS_DestroyContext(ctx);
+    RemoveWalTestDb(path);
+    RemoveWalTestDb(backupPath);
+}
+
+/**
+ * @brief Test an encrypted backup round trip on a keyed context
+ * @test Verifies the package is sealed with the context's backup subkey, not the process AppKey
+ */
+TEST_F(LocalSportsTest, BackupInteractiveEncryptsWithContextKey) {  /**< Test: LS_BackupInteractive - context key */
+    const char* path = "test_backup_keyed.db";  /**< Live database */
+    const char* otherPath = "test_backup_other.db";  /**< Context with another key */
+    const char* backupPath = "test_backup_keyed.bak";  /**< Encrypted package */
+    std::remove(backupPath);
+    LSContext* ctx = CreateTestContext(path, 0x6D);
+    ContextMessageRoundTrip(*ctx, "sealed", 2);
+
+    std::stringstream input;
+    std::stringstream output;
+    input << backupPath << "\ne\nh\n";  /**< Path, encrypt, no compression */
+    LS_SetContextStreams(*ctx, &input, &output);
+    LS_BackupInteractive(*ctx);
+    ASSERT_NE(std::string::npos, output.str().find("Yedek olusturuldu")) << output.str();
+    EXPECT_FALSE(FileContains(backupPath, "players"));  /**< Schema text is inside the ciphertext */
+    EXPECT_FALSE(teamcore::backup::VerifyBackup(backupPath));  /**< Process AppKey cannot open it */
+
+    LSContext* other = CreateTestContext(otherPath, 0x6E);
+    input.clear();
+    input.str(std::string(backupPath) + "\ne\n");
+    output.str("");
+    LS_SetContextStreams(*other, &input, &output);
+    LS_RestoreInteractive(*other);
+    EXPECT_NE(std::string::npos, output.str().find("Yedek dogrulanamadi")) << output.str();
+    LS_SetContextStreams(*other, nullptr, nullptr);
+    LS_DestroyContext(other);
+    RemoveWalTestDb(otherPath);
+
+    ContextMessageRoundTrip(*ctx, "dropped", 1);
+    input.clear();
+    input.str(std::string(backupPath) + "\ne\n");  /**< Path, confirm */
+    output.str("");
+    LS_SetContextStreams(*ctx, &input, &output);
+    LS_RestoreInteractive(*ctx);
+    EXPECT_NE(std::string::npos, output.str().find("Geri yukleme tamamlandi")) << output.str();
+    LS_SetContextStreams(*ctx, nullptr, nullptr);
+    Message page[8];
+    ASSERT_EQ(2, LS_FetchMessages(*ctx, 0, page, 8));
+    EXPECT_STREQ("sealed 0", page[0].text);
+
+    LS_DestroyContext(ctx);
+    RemoveWalTestDb(path);
+    std::remove(backupPath);
+}
+
+/**
+ * @brief Test that a keyed context's page VFS leaves with the context
+ * @test Verifies UnregisterPageVfs refuses while a file is open and ~LSContext drops the per-context VFS
+ */
+TEST_F(LocalSportsTest, PageVfsUnregisteredWithContext) {  /**< Test: pagevfs::UnregisterPageVfs */
+    const char* rawPath = "test_page_vfs_unreg.db";  /**< Direct VFS database */
+    ASSERT_TRUE(RegisterTestPageVfs("ls-crypt-unreg", 0x43));
+    sqlite3* db = OpenPageTestDb(rawPath, "ls-crypt-unreg");
+    ASSERT_NE(nullptr, db);
+    EXPECT_FALSE(teamcore::pagevfs::UnregisterPageVfs("ls-crypt-unreg"));  /**< File still open */
+    EXPECT_NE(nullptr, sqlite3_vfs_find("ls-crypt-unreg"));
+    sqlite3_close(db);
+    EXPECT_TRUE(teamcore::pagevfs::UnregisterPageVfs("ls-crypt-unreg"));
+    EXPECT_EQ(nullptr, sqlite3_vfs_find("ls-crypt-unreg"));
+    EXPECT_FALSE(teamcore::pagevfs::UnregisterPageVfs("ls-crypt-unreg"));
+    RemoveWalTestDb(rawPath);
+
+    const char* path = "test_page_vfs_ctx.db";  /**< Context database */
+    RemoveWalTestDb(path);
+    unsigned char key[32];
+    std::memset(key, 0x6F, sizeof(key));
+    LSContext* ctx = LS_CreateContext(path);
+    LS_SetContextKey(*ctx, key);
+    LS_SetEncryptionMode(*ctx, LS_ENCRYPT_PAGES);
+    LS_Init(*ctx);
+    ContextMessageRoundTrip(*ctx, "paged", 1);
+    char name[48];  /**< "ls-crypt-<context address>" */
+    std::snprintf(name, sizeof(name), "%s-%p", teamcore::pagevfs::ENCRYPTED_VFS_NAME, static_cast<void*>(ctx));
+    EXPECT_NE(nullptr, sqlite3_vfs_find(name));
+    LS_DestroyContext(ctx);
+    EXPECT_EQ(nullptr, sqlite3_vfs_find(name));  /**< Subkey no longer reachable from the registry */
+    EXPECT_NE(nullptr, sqlite3_vfs_find(nullptr));
+    RemoveWalTestDb(path);
+}
+
+/**
+ * @brief Test since-id paging of the message feed
+ * @test Verifies pages follow the cursor, respect the limit and carry decrypted text
+ */
+TEST_F(LocalSportsTest, MessageFeedPagesAfterCursor) {  /**< Test: LS_FetchMessages */
+    const char* path = "test_feed_pages.db";  /**< Feed database */
+    LSContext* ctx = CreateTestContext(path, 0x5A);
+    ContextMessageRoundTrip(*ctx, "feed", 5);
+
+    Message page[3];
+    ASSERT_EQ(3, LS_FetchMessages(*ctx, 0, page, 3));
+    EXPECT_STREQ("feed 0", page[0].text);
+    EXPECT_STREQ("feed 2", page[2].text);
+    EXPECT_EQ(16u, std::strlen(page[0].datetime));  /**< "YYYY-MM-DD HH:MM" */
+
+    const uint32_t cursor = page[2].id;
+    ASSERT_EQ(2, LS_FetchMessages(*ctx, cursor, page, 3));
+    EXPECT_STREQ("feed 3", page[0].text);
+    EXPECT_STREQ("feed 4", page[1].text);
+    EXPECT_EQ(0, LS_FetchMessages(*ctx, page[1].id, page, 3));
+    EXPECT_EQ(-1, LS_FetchMessages(*ctx, 0, page, 0));
+
+    LS_DestroyContext(ctx);
+    RemoveWalTestDb(path);
+}
+
+/**
+ * @brief Test long-poll wake-up on a new message
+ * @test Verifies a waiter on a second context wakes when the first commits, and an idle wait times out
+ */
+TEST_F(LocalSportsTest, MessageFeedWaitWakesOnCommit) {  /**< Test: LS_WaitForMessages */
+    const char* path = "test_feed_wait.db";  /**< Shared database */
+    LSContext* writer = CreateTestContext(path, 0x5B);
+    unsigned char key[32];
+    std::memset(key, 0x5B, sizeof(key));
+    LSContext* reader = LS_CreateContext(path);
+    LS_SetContextKey(*reader, key);
+    LS_Init(*reader);
+
+    typedef std::chrono::duration<double, std::milli> ms;
+    Message page[4];
+    auto t0 = std::chrono::steady_clock::now();
+    EXPECT_EQ(0, LS_WaitForMessages(*reader, 0, page, 4, 100));
+    EXPECT_GE(ms(std::chrono::steady_clock::now() - t0).count(), 90.0);  /**< Timed out */
+
+    int got = -1;
+    std::chrono::steady_clock::time_point woke;
+    std::thread waiter([&]() {
+        got = LS_WaitForMessages(*reader, 0, page, 4, 10000);
+        woke = std::chrono::steady_clock::now();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto posted = std::chrono::steady_clock::now();
+    ContextMessageRoundTrip(*writer, "wake", 1);
+    waiter.join();
+
+    ASSERT_EQ(1, got);
+    EXPECT_STREQ("wake 0", page[0].text);
+    EXPECT_LT(ms(woke - posted).count(), 5000.0);  /**< Woken by the commit, not the timeout */
+
+    LS_DestroyContext(reader);
+    LS_DestroyContext(writer);
+    RemoveWalTestDb(path);
+}
+
+/**
+ * @brief Benchmark: reading new messages through the feed vs listing the whole history
+ */
+TEST_F(LocalSportsTest, DISABLED_BenchMessageFeedVsFullList) {  /**< Benchmark: feed page vs full list */
+    const char* path = "test_feed_bench.db";  /**< Feed database */
+    const int kHistory = 400;  /**< Existing messages */
+    LSContext* ctx = CreateTestContext(path, 0x5C);
+    ContextMessageRoundTrip(*ctx, "history", kHistory);
+
+    Message page[10];
+    typedef std::chrono::duration<double, std::milli> ms;
+    auto t0 = std::chrono::steady_clock::now();
+    std::string full = ContextMessageRoundTrip(*ctx, "new", 0);  /**< Lists everything */
+    auto t1 = std::chrono::steady_clock::now();
+    int n = LS_FetchMessages(*ctx, kHistory - 10, page, 10);
+    auto t2 = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(kHistory, CountOccurrences(full, "history"));
+    EXPECT_EQ(10, n);
+    std::cerr << "[BENCH] messages=" << kHistory << " full list=" << ms(t1 - t0).count()
+              << "ms feed page(10)=" << ms(t2 - t1).count() << "ms\n";
+
+    LS_DestroyContext(ctx);
+    RemoveWalTestDb(path);
+}
+
+// =================== Read State Tests ===================
+
+/**
+ * @brief Helper: log the default admin into a context through its own streams
+ */
+static bool LoginTestAdmin(LSContext& ctx) {
+    std::stringstream input("admin\nadmin\n");
+    std::stringstream output;
+    LS_SetContextStreams(ctx, &input, &output);
+    const bool ok = LS_AuthLoginInteractive(ctx);
+    LS_SetContextStreams(ctx, nullptr, nullptr);
+    return ok;
+}
+
+/**
+ * @brief Test unread counters across posting, partial acknowledgment, listing and deletion
+ * @test Verifies the trigger-maintained counter matches the read cursor at every step
+ */
+TEST_F(LocalSportsTest, UnreadCountFollowsReadCursor) {  /**< Test: LS_UnreadMessageCount */
+    const char* path = "test_unread.db";  /**< Read-state database */
+    LSContext* ctx = CreateTestContext(path, 0x6A);
+    EXPECT_EQ(-1, LS_UnreadMessageCount(*ctx));  /**< Not logged in */
+    ASSERT_TRUE(LoginTestAdmin(*ctx));
+    EXPECT_EQ(0, LS_UnreadMessageCount(*ctx));
+
+    ContextMessageRoundTrip(*ctx, "note", 3);  /**< Listing inside the helper marks all read */
+    EXPECT_EQ(0, LS_UnreadMessageCount(*ctx));
+
+    std::stringstream input("late 0\nlate 1\nlate 2\n");
+    std::stringstream output;
+    LS_SetContextStreams(*ctx, &input, &output);
+    for (int i = 0; i < 3; ++i) LS_AddMessageInteractive(*ctx);
+    LS_SetContextStreams(*ctx, nullptr, nullptr);
+    EXPECT_EQ(3, LS_UnreadMessageCount(*ctx));
+
+    Message page[2];
+    ASSERT_EQ(2, LS_FetchMessages(*ctx, 3, page, 2));
+    ASSERT_TRUE(LS_MarkMessagesRead(*ctx, page[1].id));
+    EXPECT_EQ(1, LS_UnreadMessageCount(*ctx));
+    ASSERT_TRUE(LS_MarkMessagesRead(*ctx, 1));  /**< Cursor never moves back */
+    EXPECT_EQ(1, LS_UnreadMessageCount(*ctx));
+
+    // Deleting a read message keeps the count, deleting the unread one lowers it
+    sqlite3* db = nullptr;
+    ASSERT_EQ(SQLITE_OK, sqlite3_open(path, &db));
+    sqlite3_exec(db, "DELETE FROM messages WHERE id = 1;", nullptr, nullptr, nullptr);
+    EXPECT_EQ(1, LS_UnreadMessageCount(*ctx));
+    sqlite3_exec(db, "DELETE FROM messages WHERE id = 6;", nullptr, nullptr, nullptr);
+    EXPECT_EQ(0, LS_UnreadMessageCount(*ctx));
+    EXPECT_EQ(4, QueryIntValue(db, "SELECT posted FROM message_counters;"));
+    sqlite3_close(db);
+
+    LS_AuthLogout(*ctx);
+    EXPECT_EQ(-1, LS_UnreadMessageCount(*ctx));
+    LS_DestroyContext(ctx);
+    RemoveWalTestDb(path);
+}
+
+// =================== Message Partition Tests ===================
+
+/**
+ * @brief Helper: raw database with the partitioned message schema
+ */
+static sqlite3* OpenPartitionTestDb(const char* path) {
+    RemoveWalTestDb(path);
+    sqlite3* db = nullptr;
+    if (sqlite3_open(path, &db) != SQLITE_OK) return nullptr;
+    sqlite3_exec(db, "PRAGMA secure_delete=ON;", nullptr, nullptr, nullptr);
+    return db;
+}
+
+/**
+ * @brief Test that messages are routed to monthly partitions behind the view
+ * @test Verifies ids stay ascending across months, the feed skips old partitions and plain SQL still works
+ */
+TEST_F(LocalSportsTest, MessagePartitionsRouteByMonth) {  /**< Test: partition::InsertMessage */
+    const char* path = "test_partitions.db";  /**< Partitioned database */
+    sqlite3* db = OpenPartitionTestDb(path);
+    ASSERT_NE(nullptr, db);
+    ASSERT_TRUE(teamcore::partition::EnsureSchema(db));
+    EXPECT_TRUE(teamcore::partition::IsPartitioned(db));
+    EXPECT_EQ(0, CountRows(db, "messages"));  /**< Empty view */
+
+    const char* dates[] = { "2024-01-05 10:00", "2024-01-20 10:00", "2024-02-01 09:00", "2024-03-15 18:30" };
+    int64_t id = 0;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(teamcore::partition::InsertMessage(db, dates[i], "m" + std::to_string(i), &id));
+        EXPECT_EQ(i + 1, id);
+    }
+    std::vector<teamcore::partition::PartitionInfo> parts = teamcore::partition::ListPartitions(db);
+    ASSERT_EQ(3u, parts.size());
+    EXPECT_EQ("2024-01", parts[0].month);
+    EXPECT_EQ("messages_p202401", parts[0].table);
+    EXPECT_EQ(2, parts[0].rows);
+    EXPECT_EQ(4, CountRows(db, "messages"));
+    EXPECT_EQ(4, QueryIntValue(db, "SELECT posted FROM message_counters;"));
+
+    std::vector<int64_t> seen;
+    EXPECT_EQ(2, teamcore::partition::ForEachAfter(db, 2, 10, [&](int64_t rid, const char*, const char*) { seen.push_back(rid); }));
+    ASSERT_EQ(2u, seen.size());
+    EXPECT_EQ(3, seen[0]);
+    EXPECT_EQ(4, seen[1]);
+
+    // Plain SQL through the view: existing month is routed, unknown month is rejected
+    EXPECT_EQ(SQLITE_OK, sqlite3_exec(db, "INSERT INTO messages(datetime,text) VALUES('2024-02-10 12:00','sql');", nullptr, nullptr, nullptr));
+    EXPECT_EQ(2, CountRows(db, "messages_p202402"));
+    EXPECT_NE(SQLITE_OK, sqlite3_exec(db, "INSERT INTO messages(datetime,text) VALUES('1999-01-01 00:00','x');", nullptr, nullptr, nullptr));
+    EXPECT_EQ(SQLITE_OK, sqlite3_exec(db, "DELETE FROM messages WHERE text='sql';", nullptr, nullptr, nullptr));
+    EXPECT_EQ(4, QueryIntValue(db, "SELECT posted FROM message_counters;"));
+    ASSERT_TRUE(teamcore::partition::InsertMessage(db, "2024-03-16 08:00", "after delete", &id));
+    EXPECT_EQ(6, id);  /**< Ids are never reused */
+
+    sqlite3_close(db);
+    RemoveWalTestDb(path);
+}
+
+/**
+ * @brief Test acknowledged-range counting through insertion ordinals
+ * @test Verifies the ordinal difference matches COUNT(*) across deletes, out-of-order ids and pre-ordinal partitions
+ */
+TEST_F(LocalSportsTest, MessagePartitionsCountRangeUsesOrdinals) {  /**< Test: partition::CountRange */
+    const char* path = "test_partitions_ord.db";  /**< Partitioned database */
+    sqlite3* db = OpenPartitionTestDb(path);
+    ASSERT_NE(nullptr, db);
+    ASSERT_TRUE(teamcore::partition::EnsureSchema(db));
+
+    const char* dates[] = { "2024-01-05 10:00", "2024-02-01 09:00", "2024-01-20 10:00",
+                            "2024-03-15 18:30", "2024-02-11 08:00", "2024-03-20 07:00" };
+    for (int i = 0; i < 6; ++i) {
+        ASSERT_TRUE(teamcore::partition::InsertMessage(db, dates[i], "m" + std::to_string(i), nullptr));
+    }
+    EXPECT_EQ(5, QueryIntValue(db, "SELECT ord FROM messages WHERE id = 5;"));
+    EXPECT_EQ(0, QueryIntValue(db, "SELECT gap_id FROM message_ordinals;"));  /**< Ordinals follow ids */
+    EXPECT_EQ(6, teamcore::partition::CountRange(db, 0, 6));
+    EXPECT_EQ(3, teamcore::partition::CountRange(db, 2, 5));
+    EXPECT_EQ(0, teamcore::partition::CountRange(db, 5, 2));
+
+    // A delete inside the range falls back to counting rows
+    ASSERT_EQ(SQLITE_OK, sqlite3_exec(db, "DELETE FROM messages WHERE id = 3;", nullptr, nullptr, nullptr));
+    EXPECT_EQ(3, QueryIntValue(db, "SELECT gap_id FROM message_ordinals;"));
+    EXPECT_EQ(2, teamcore::partition::CountRange(db, 2, 5));
+    EXPECT_EQ(3, teamcore::partition::CountRange(db, 3, 6));
+    EXPECT_EQ(2, teamcore::partition::CountRange(db, 4, 6));
+
+    // An explicit id below the high-water mark breaks ordinal order up to last_id
+    ASSERT_EQ(SQLITE_OK, sqlite3_exec(db, "INSERT INTO messages(id,datetime,text) VALUES(3,'2024-01-21 10:00','re');",
+                                      nullptr, nullptr, nullptr));
+    EXPECT_EQ(6, QueryIntValue(db, "SELECT gap_id FROM message_ordinals;"));
+    EXPECT_EQ(4, teamcore::partition::CountRange(db, 2, 6));
+    ASSERT_TRUE(teamcore::partition::InsertMessage(db, "2024-03-21 07:00", "m7", nullptr));
+    EXPECT_EQ(1, teamcore::partition::CountRange(db, 6, 7));
+    EXPECT_EQ(7, teamcore::partition::CountRange(db, 0, 7));
+
+    // Partitions created before ordinals get the column; their rows stay unordered
+    sqlite3_exec(db, "DROP VIEW messages; DROP TRIGGER messages_p202401_ai; DROP TRIGGER messages_p202401_ad;"
+                     "ALTER TABLE messages_p202401 DROP COLUMN ord; DROP TABLE message_ordinals;", nullptr, nullptr, nullptr);
+    ASSERT_EQ(0, QueryIntValue(db, "SELECT COUNT(*) FROM pragma_table_info('messages_p202401') WHERE name = 'ord';"));
+    ASSERT_TRUE(teamcore::partition::EnsureSchema(db));
+    EXPECT_EQ(1, QueryIntValue(db, "SELECT COUNT(*) FROM pragma_table_info('messages_p202401') WHERE name = 'ord';"));
+    EXPECT_EQ(7, QueryIntValue(db, "SELECT gap_id FROM message_ordinals;"));
+    EXPECT_EQ(7, teamcore::partition::CountRange(db, 0, 7));
+    ASSERT_TRUE(teamcore::partition::InsertMessage(db, "2024-01-30 07:00", "m8", nullptr));
+    ASSERT_TRUE(teamcore::partition::InsertMessage(db, "2024-01-31 07:00", "m9", nullptr));
+    EXPECT_EQ(2, QueryIntValue(db, "SELECT ord FROM messages WHERE id = 9;"));
+    EXPECT_EQ(2, teamcore::partition::CountRange(db, 7, 9));
+    EXPECT_EQ(9, teamcore::partition::CountRange(db, 0, 9));
+
+    sqlite3_close(db);
+    RemoveWalTestDb(path);
+}
+
+/**
+ * @brief Test migration of the legacy single messages table
+ * @test Verifies rows, ids and the AUTOINCREMENT high-water mark survive the move into partitions
+ */
+TEST_F(LocalSportsTest, MessagePartitionsMigrateLegacyTable) {  /**< Test: partition::EnsureSchema migration */
+    const char* path = "test_partitions_legacy.db";  /**< Legacy database */
+    sqlite3* db = OpenPartitionTestDb(path);
+    ASSERT_NE(nullptr, db);
+    ASSERT_EQ(SQLITE_OK, sqlite3_exec(db,
+        "CREATE TABLE messages(id INTEGER PRIMARY KEY AUTOINCREMENT, datetime TEXT NOT NULL, text TEXT NOT NULL);"
+        "INSERT INTO messages(datetime,text) VALUES('2023-11-01 10:00','a'),('2023-12-24 20:00','b'),"
+        "('bozuk','c'),('2023-12-31 23:59','d');"
+        "DELETE FROM messages WHERE text='d';", nullptr, nullptr, nullptr));
+
+    ASSERT_TRUE(teamcore::partition::EnsureSchema(db));
+    EXPECT_TRUE(teamcore::partition::IsPartitioned(db));
+    EXPECT_EQ(3, CountRows(db, "messages"));
+    EXPECT_EQ(3u, teamcore::partition::ListPartitions(db).size());  /**< 2023-11, 2023-12, 0000-00 */
+    EXPECT_EQ(2, QueryIntValue(db, "SELECT id FROM messages WHERE text='b';"));
+    EXPECT_EQ(3, QueryIntValue(db, "SELECT posted FROM message_counters;"));
+    EXPECT_EQ(4, teamcore::partition::LastAssignedId(db));
+
+    int64_t id = 0;
+    ASSERT_TRUE(teamcore::partition::InsertMessage(db, "2024-01-01 00:00", "e", &id));
+    EXPECT_EQ(5, id);
+    ASSERT_TRUE(teamcore::partition::EnsureSchema(db));  /**< Idempotent */
+    EXPECT_EQ(4, CountRows(db, "messages"));
+    sqlite3_close(db);
+    RemoveWalTestDb(path);
+}
+
+/**
+ * @brief Test retention purge by dropping whole partitions
+ * @test Verifies counters and read cursors are corrected without touching newer partitions
+ *       or the undated "0000-00" partition
+ */
+TEST_F(LocalSportsTest, MessagePartitionsPurgeDropsWholeMonths) {  /**< Test: partition::DropBefore */
+    const char* path = "test_partitions_purge.db";  /**< Partitioned database */
+    const int kPerMonth = 200;  /**< Messages per month */
+    sqlite3* db = OpenPartitionTestDb(path);
+    ASSERT_NE(nullptr, db);
+    ASSERT_TRUE(teamcore::partition::EnsureSchema(db));
+
+    const std::string payload(120, 'x');
+    const char* months[] = { "2024-01", "2024-02", "2024-03" };
+    sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr);
+    for (int m = 0; m < 3; ++m) {
+        for (int i = 0; i < kPerMonth; ++i) {
+            const std::string dt = std::string(months[m]) + "-10 12:00";
+            ASSERT_TRUE(teamcore::partition::InsertMessage(db, dt, payload, nullptr));
+        }
+    }
+    ASSERT_TRUE(teamcore::partition::InsertMessage(db, "bozuk", payload, nullptr));  /**< "0000-00" partition */
+    sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+
+    // user 1 read everything, user 2 read half of January, user 3 nothing
+    sqlite3_exec(db, "INSERT INTO message_reads VALUES(1, 600, 600),(2, 100, 100),(3, 0, 0);", nullptr, nullptr, nullptr);
+
+    EXPECT_EQ(2 * kPerMonth, teamcore::partition::DropBefore(db, "2024-03"));
+
+    EXPECT_EQ(kPerMonth + 1, CountRows(db, "messages"));
+    EXPECT_EQ(2u, teamcore::partition::ListPartitions(db).size());
+    EXPECT_EQ(-1, CountRows(db, "messages_p202401"));  /**< Table is gone */
+    EXPECT_EQ(1, CountRows(db, "messages_p000000"));  /**< Undated messages have no age */
+    EXPECT_EQ(kPerMonth + 1, QueryIntValue(db, "SELECT posted FROM message_counters;"));
+    EXPECT_EQ(kPerMonth, QueryIntValue(db, "SELECT read_count FROM message_reads WHERE user_id=1;"));
+    EXPECT_EQ(0, QueryIntValue(db, "SELECT read_count FROM message_reads WHERE user_id=2;"));
+    EXPECT_EQ(0, QueryIntValue(db, "SELECT read_count FROM message_reads WHERE user_id=3;"));
+    EXPECT_EQ(0, teamcore::partition::DropBefore(db, "2024-03"));
+    EXPECT_EQ(0, teamcore::partition::DropYear(db, "0000"));
+    EXPECT_EQ(1, CountRows(db, "messages_p000000"));
+    EXPECT_EQ(-1, teamcore::partition::DropBefore(db, "2024-3"));
+
+    sqlite3_close(db);
+    RemoveWalTestDb(path);
+}
+
+
+/**
+ * @brief Test season archive on partitioned messages
+ * @test Verifies the season's monthly partitions are dropped instead of deleted row by row
+ */
+TEST_F(LocalSportsTest, ArchiveSeasonDropsMessagePartitions) {  /**< Test: Archive + partitions */
+    const char* path = "test_season.db";
+    sqlite3* db = OpenSeasonTestDb(path);
+    ASSERT_TRUE(teamcore::partition::EnsureSchema(db));  /**< Legacy table migrated */
+    ASSERT_EQ(2u, teamcore::partition::ListPartitions(db).size());
+
+    teamcore::archive::ArchiveEntry entry;
+    ASSERT_TRUE(teamcore::archive::ArchiveSeason(db, path, "2020", 2025, &entry));
+    EXPECT_EQ(1, entry.messages);
+    std::vector<teamcore::partition::PartitionInfo> parts = teamcore::partition::ListPartitions(db);
+    ASSERT_EQ(1u, parts.size());
+    EXPECT_EQ("2021-05", parts[0].month);
+    EXPECT_EQ(1, CountRows(db, "messages"));
+    EXPECT_EQ(1, QueryIntValue(db, "SELECT posted FROM message_counters;"));
+
+    sqlite3_close(db);
+    RemoveWalTestDb(path);
+    std::remove(entry.path.c_str());
+}
+
+// =================== Message Search Tests ===================
+
+/**
+ * @brief Helper: add the given messages to a context through its streams
+ */
+static void AddContextMessages(LSContext& ctx, const char* const* texts, int count) {
+    std::stringstream input;
+    std::stringstream output;
+    for (int i = 0; i < count; ++i) input << texts[i] << "\n";
+    LS_SetContextStreams(ctx, &input, &output);
+    for (int i = 0; i < count; ++i) LS_AddMessageInteractive(ctx);
+    LS_SetContextStreams(ctx, nullptr, nullptr);
+}
+
+/**
+ * @brief Test word normalization and keyed tokens
+ * @test Verifies case/Turkish folding, separators, short-word skipping and key-dependent tokens
+ */
+TEST_F(LocalSportsTest, MessageSearchTokenizeFoldsTurkish) {  /**< Test: search::Tokenize */
+    std::vector<std::string> words = teamcore::search::Tokenize("Maç BUGÜN saat 19'da, maç! a Şİ");
+    ASSERT_EQ(6u, words.size());
+    EXPECT_EQ("19", words[0]);
+    EXPECT_EQ("bugun", words[1]);
+    EXPECT_EQ("da", words[2]);
+    EXPECT_EQ("mac", words[3]);  /**< Duplicate collapsed */
+    EXPECT_EQ("saat", words[4]);
+    EXPECT_EQ("si", words[5]);
+    EXPECT_TRUE(teamcore::search::Tokenize(" . a ").empty());
+
+    unsigned char k1[32], k2[32];
+    std::memset(k1, 0x11, sizeof(k1));
+    std::memset(k2, 0x22, sizeof(k2));
+    const std::string t = teamcore::search::TokenFor(k1, "mac");
+    EXPECT_EQ(16u, t.size());
+    EXPECT_EQ(t, teamcore::search::TokenFor(k1, "mac"));
+    EXPECT_NE(t, teamcore::search::TokenFor(k2, "mac"));
+    EXPECT_NE(t, teamcore::search::TokenFor(k1, "maç"));  /**< Folding happens in Tokenize only */
+}
+
+/**
+ * @brief Test searching encrypted messages through the token index
+ * @test Verifies all-words matching, newest-first order and that the index holds no plaintext
+ */
+TEST_F(LocalSportsTest, MessageSearchFindsOnlyMatches) {  /**< Test: LS_SearchMessages */
+    const char* path = "test_search.db";  /**< Search database */
+    LSContext* ctx = CreateTestContext(path, 0x6A);
+    const char* texts[] = { "Antrenman yarin saat sekizde", "Mac iptal edildi", "Yarın MAÇ var" };
+    AddContextMessages(*ctx, texts, 3);
+
+    Message page[5];
+    ASSERT_EQ(1, LS_SearchMessages(*ctx, "yarin mac", page, 5));
+    EXPECT_STREQ("Yarın MAÇ var", page[0].text);
+    ASSERT_EQ(2, LS_SearchMessages(*ctx, "YARIN", page, 5));
+    EXPECT_EQ(3u, page[0].id);  /**< Newest first */
+    EXPECT_EQ(1u, page[1].id);
+    EXPECT_EQ(1, LS_SearchMessages(*ctx, "yarin", page, 1));
+    EXPECT_EQ(0, LS_SearchMessages(*ctx, "deplasman", page, 5));
+    EXPECT_EQ(0, LS_SearchMessages(*ctx, "x", page, 5));  /**< No indexable word */
+    EXPECT_EQ(-1, LS_SearchMessages(*ctx, "mac", page, 0));
+
+    sqlite3* raw = nullptr;
+    ASSERT_EQ(SQLITE_OK, sqlite3_open(path, &raw));
+    EXPECT_EQ(10, CountRows(raw, "message_tokens"));
+    EXPECT_EQ(0, QueryIntValue(raw, "SELECT COUNT(*) FROM message_tokens WHERE length(token) <> 16;"));
+    EXPECT_EQ(0, QueryIntValue(raw, "SELECT COUNT(*) FROM message_tokens WHERE instr(token, CAST('yarin' AS BLOB)) > 0;"));
+    sqlite3_close(raw);
+
+    LS_DestroyContext(ctx);
+    RemoveWalTestDb(path);
+}
+
+/**
+ * @brief Test indexing of messages written before the index existed
+ * @test Verifies the first search backfills the pending range and later searches use the index
+ */
+TEST_F(LocalSportsTest, MessageSearchBackfillsOldMessages) {  /**< Test: search::BackfillBatch */
+    const char* path = "test_search_backfill.db";  /**< Search database */
+    LSContext* ctx = CreateTestContext(path, 0x6B);
+    const char* texts[] = { "eski mesaj bir", "eski mesaj iki", "yeni duyuru" };
+    AddContextMessages(*ctx, texts, 3);
+
+    // Index dropped as if the messages predated it
+    sqlite3* raw = nullptr;
+    ASSERT_EQ(SQLITE_OK, sqlite3_open(path, &raw));
+    ASSERT_EQ(SQLITE_OK, sqlite3_exec(raw,
+        "DELETE FROM message_tokens; UPDATE message_index_state SET backfill_done = 0, backfill_upto = 3;",
+        nullptr, nullptr, nullptr));
+    EXPECT_TRUE(teamcore::search::BackfillPending(raw));
+
+    Message page[5];
+    EXPECT_EQ(2, LS_SearchMessages(*ctx, "eski mesaj", page, 5));
+    EXPECT_FALSE(teamcore::search::BackfillPending(raw));
+    EXPECT_EQ(3, QueryIntValue(raw, "SELECT backfill_done FROM message_index_state;"));
+    EXPECT_EQ(8, CountRows(raw, "message_tokens"));
+    sqlite3_close(raw);
+
+    const char* more[] = { "eski mesaj uc" };
+    AddContextMessages(*ctx, more, 1);
+    EXPECT_EQ(3, LS_SearchMessages(*ctx, "eski mesaj", page, 5));
+    EXPECT_STREQ("eski mesaj uc", page[0].text);
+
+    LS_DestroyContext(ctx);
+    RemoveWalTestDb(path);
+}
+
+/**
+ * @brief Test token cleanup after retention purge
+ * @test Verifies tokens of dropped partitions are removed and search no longer returns them
+ */
+TEST_F(LocalSportsTest, MessageSearchPrunedAfterPurge) {  /**< Test: search::PruneMessages */
+    const char* path = "test_search_purge.db";  /**< Search database */
+    LSContext* ctx = CreateTestContext(path, 0x6C);
+    const char* texts[] = { "silinecek mesaj", "silinecek duyuru" };
+    AddContextMessages(*ctx, texts, 2);
+
+    Message page[5];
+    ASSERT_EQ(2, LS_SearchMessages(*ctx, "silinecek", page, 5));
+    EXPECT_EQ(2, LS_PurgeMessagesBefore(*ctx, "9999-12"));
+    EXPECT_EQ(0, LS_SearchMessages(*ctx, "silinecek", page, 5));
+
+    sqlite3* raw = nullptr;
+    ASSERT_EQ(SQLITE_OK, sqlite3_open(path, &raw));
+    EXPECT_EQ(0, CountRows(raw, "message_tokens"));
+    sqlite3_close(raw);
+
+    LS_DestroyContext(ctx);
+    RemoveWalTestDb(path);
+}
+
+/**
+ * @brief Test token cleanup when an archived season's ids are not the lowest left
+ * @test Verifies archive removes exactly that season's tokens, partitioned or not, and Lookup
+ *       fills its limit past tokens whose message is gone
+ */
+TEST_F(LocalSportsTest, MessageSearchPrunesArchivedSeasonTokens) {  /**< Test: search::PruneMessages */
+    const unsigned char key[32] = { 9 };
+    for (int partitioned = 0; partitioned < 2; ++partitioned) {
+        SCOPED_TRACE(partitioned ? "partitioned" : "single table");
+        const char* path = "test_search_season.db";
+        sqlite3* db = OpenSeasonTestDb(path);
+        // Id 3 belongs to 2020 but comes after the 2021 message
+        ASSERT_EQ(SQLITE_OK, sqlite3_exec(db,
+            "INSERT INTO messages(datetime,text) VALUES('2020-06-06 10:00','later');", nullptr, nullptr, nullptr));
+        if (partitioned) {
+            ASSERT_TRUE(teamcore::partition::EnsureSchema(db));
+        }
+        ASSERT_TRUE(teamcore::search::EnsureSchema(db, 0));
+        for (int64_t id = 1; id <= 3; ++id) {
+            ASSERT_TRUE(teamcore::search::IndexMessage(db, key, id, "sezon notu"));
+        }
+
+        teamcore::archive::ArchiveEntry entry;
+        ASSERT_TRUE(teamcore::archive::ArchiveSeason(db, path, "2020", 2025, &entry));
+        EXPECT_EQ(2, entry.messages);
+        EXPECT_EQ(2, CountRows(db, "message_tokens"));
+        EXPECT_EQ(0, QueryIntValue(db, "SELECT COUNT(*) FROM message_tokens WHERE message_id <> 2;"));
+
+        // Leftover tokens of a vanished newer message do not use up the limit
+        ASSERT_EQ(SQLITE_OK, sqlite3_exec(db,
+            "INSERT INTO message_tokens SELECT token, 99 FROM message_tokens;", nullptr, nullptr, nullptr));
+        std::vector<int64_t> ids = teamcore::search::Lookup(db, key, "sezon", 1);
+        ASSERT_EQ(1u, ids.size());
+        EXPECT_EQ(2, ids[0]);
+
+        sqlite3_close(db);
+        RemoveWalTestDb(path);
+        std::remove(entry.path.c_str());
+    }
+}
+
+/**
+ * @brief Benchmark: index lookup versus decrypting every message
+ * @test Verifies both paths agree on the match count
+ */
+TEST_F(LocalSportsTest, DISABLED_BenchMessageSearchVsFullScan) {  /**< Benchmark: token index vs full decrypt */
+    const char* path = "test_search_bench.db";  /**< Search database */
+    const int kMessages = 2000;  /**< Messages in the table */
+    LSContext* ctx = CreateTestContext(path, 0x6D);
+    std::vector<std::string> texts;
+    for (int i = 0; i < kMessages; ++i) {
+        texts.push_back("duyuru " + std::to_string(i) + (i % 100 == 0 ? " hedef kelime" : " rutin bilgi"));
+    }
+    std::vector<const char*> ptrs;
+    for (size_t i = 0; i < texts.size(); ++i) ptrs.push_back(texts[i].c_str());
+    AddContextMessages(*ctx, ptrs.data(), kMessages);
+
+    typedef std::chrono::duration<double, std::milli> ms;
+    std::vector<Message> page(kMessages);
+    auto t0 = std::chrono::steady_clock::now();
+    const int indexed = LS_SearchMessages(*ctx, "hedef kelime", page.data(), kMessages);
+    auto t1 = std::chrono::steady_clock::now();
+    int scanned = 0;
+    uint32_t cursor = 0;
+    for (int n; (n = LS_FetchMessages(*ctx, cursor, page.data(), 500)) > 0; cursor = page[n - 1].id) {
+        for (int i = 0; i < n; ++i) scanned += std::strstr(page[i].text, "hedef kelime") ? 1 : 0;
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(kMessages / 100, indexed);
+    EXPECT_EQ(indexed, scanned);
+    std::cerr << "[BENCH] search " << kMessages << " messages: token index=" << ms(t1 - t0).count()
+              << "ms decrypt all=" << ms(t2 - t1).count() << "ms\n";
+
+    LS_DestroyContext(ctx);
+    RemoveWalTestDb(path);
+}
+
+// =================== Batch Encryption Tests ===================
+
+/**
+ * @brief Test batch field encryption
+ * @test Verifies every sealed value decrypts with EncryptForDB's format, IVs are unique and empty fields stay empty
+ */
+TEST_F(LocalSportsTest, CryptoEncryptBatchMatchesSingleFormat) {  /**< Test: crypto::EncryptBatchForDB */
+    unsigned char key32[32];
+    std::memset(key32, 0x3C, sizeof(key32));
+    std::vector<std::string> plain;
+    for (int i = 0; i < 300; ++i) plain.push_back("alan-" + std::to_string(i) + std::string(i % 200, 'z'));
+    plain[7].clear();
+
+    std::vector<std::string> sealed;
+    ASSERT_TRUE(teamcore::crypto::EncryptBatchForDB(plain, key32, "aad", sealed));
+    ASSERT_EQ(plain.size(), sealed.size());
+    EXPECT_EQ("", sealed[7]);
+    for (size_t i = 0; i < plain.size(); ++i) {
+        if (plain[i].empty()) continue;
+        EXPECT_EQ(0u, sealed[i].rfind("GCM1:", 0));
+        EXPECT_EQ(plain[i], teamcore::crypto::DecryptFromDB(sealed[i], key32, "aad"));
+    }
+    EXPECT_EQ("[DECRYPT-ERROR]", teamcore::crypto::DecryptFromDB(sealed[0], key32, ""));  /**< AAD is bound */
+
+    std::vector<std::string> again;
+    ASSERT_TRUE(teamcore::crypto::EncryptBatchForDB(plain, key32, "aad", again));
+    EXPECT_NE(sealed[0], again[0]);  /**< Fresh IV per field */
+    std::vector<std::string> ivs;
+    for (size_t i = 0; i < sealed.size(); ++i) if (!sealed[i].empty()) ivs.push_back(sealed[i].substr(5, 16));
+    std::sort(ivs.begin(), ivs.end());
+    EXPECT_TRUE(std::adjacent_find(ivs.begin(), ivs.end()) == ivs.end());
+
+    EXPECT_FALSE(teamcore::crypto::EncryptBatchForDB(plain, nullptr, "", sealed));
+    EXPECT_TRUE(sealed.empty() || sealed[0].empty());
+    EXPECT_TRUE(teamcore::crypto::EncryptBatchForDB(std::vector<std::string>(), key32, "", sealed));
+    EXPECT_TRUE(sealed.empty());
+}
+
+/**
+ * @brief Benchmark: fields per second, one EncryptForDB call per field vs the batch API
+ * @test Verifies both paths seal every field for 16, 64 and 200 byte plaintexts
+ */
+TEST_F(LocalSportsTest, DISABLED_BenchCryptoEncryptBatch) {  /**< Benchmark: batch vs single-field GCM */
+    unsigned char key32[32];
+    std::memset(key32, 0x3D, sizeof(key32));
+    const int kFields = 20000;  /**< Fields per run */
+    const size_t sizes[] = { 16, 64, 200 };
+    typedef std::chrono::duration<double> sec;
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        std::vector<std::string> plain(kFields, std::string(sizes[s], 'p'));
+        std::vector<std::string> single(kFields);
+        std::vector<std::string> batch;
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < kFields; ++i) single[i] = teamcore::crypto::EncryptForDB(plain[i], key32, "");
+        auto t1 = std::chrono::steady_clock::now();
+        ASSERT_TRUE(teamcore::crypto::EncryptBatchForDB(plain, key32, "", batch));
+        auto t2 = std::chrono::steady_clock::now();
+
+        ASSERT_EQ(static_cast<size_t>(kFields), batch.size());
+        EXPECT_EQ(single[0].size(), batch[0].size());
+        EXPECT_EQ(plain[kFields - 1], teamcore::crypto::DecryptFromDB(batch[kFields - 1], key32, ""));
+        std::cerr << "[BENCH] GCM " << sizes[s] << "B x" << kFields << ": single="
+                  << static_cast<long>(kFields / sec(t1 - t0).count()) << " fields/s batch="
+                  << static_cast<long>(kFields / sec(t2 - t1).count()) << " fields/s\n";
+    }
+}
+
+// =================== Nonce Pool Tests ===================
+
+/**
+ * @brief Test per-thread buffered nonces
+ * @test Verifies nonces are unique within and across threads and after fork
+ */
+TEST_F(LocalSportsTest, CryptoNoncePoolUniqueAcrossThreads) {  /**< Test: crypto::GenerateNonce12 */
+    const int kThreads = 4;
+    const int kPerThread = 1000;  /**< Spans many pool refills */
+    std::vector<std::string> nonces(kThreads * kPerThread);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&nonces, t]() {
+            unsigned char iv[12];
+            for (int i = 0; i < kPerThread; ++i) {
+                ASSERT_TRUE(teamcore::crypto::GenerateNonce12(iv));
+                nonces[t * kPerThread + i].assign(reinterpret_cast<char*>(iv), sizeof(iv));
+            }
+        });
+    }
+    for (size_t t = 0; t < threads.size(); ++t) threads[t].join();
+    std::sort(nonces.begin(), nonces.end());
+    EXPECT_TRUE(std::adjacent_find(nonces.begin(), nonces.end()) == nonces.end());
+
+#ifndef _WIN32
+    // Parent and child must not hand out the same buffered slice
+    unsigned char warm[12];
+    ASSERT_TRUE(teamcore::crypto::GenerateNonce12(warm));
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        unsigned char iv[12];
+        teamcore::crypto::GenerateNonce12(iv);
+        ssize_t w = write(fds[1], iv, sizeof(iv));
+        _exit(w == static_cast<ssize_t>(sizeof(iv)) ? 0 : 1);
+    }
+    unsigned char parentIv[12], childIv[12];
+    ASSERT_TRUE(teamcore::crypto::GenerateNonce12(parentIv));
+    ASSERT_EQ(static_cast<ssize_t>(sizeof(childIv)), read(fds[0], childIv, sizeof(childIv)));
+    int status = 0;
+    waitpid(pid, &status, 0);
+    close(fds[0]);
+    close(fds[1]);
+    EXPECT_NE(0, std::memcmp(parentIv, childIv, sizeof(parentIv)));
+#endif
+}
+
+/**
+ * @brief Benchmark: concurrent IV generation and field encryption
+ * @test Verifies every thread completes; reports RAND_bytes per field vs the per-thread pool
+ */
+TEST_F(LocalSportsTest, DISABLED_BenchCryptoNoncePoolConcurrent) {  /**< Benchmark: nonce pool under contention */
+    const int kThreads = 4;
+    const int kPerThread = 50000;  /**< Nonces / fields per thread */
+    unsigned char key32[32];
+    std::memset(key32, 0x4E, sizeof(key32));
+    typedef std::chrono::duration<double> sec;
+
+    auto run = [&](int mode) {
+        std::vector<std::thread> threads;
+        auto t0 = std::chrono::steady_clock::now();
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&, mode]() {
+                unsigned char iv[12];
+                const std::string field(32, 'f');
+                for (int i = 0; i < kPerThread; ++i) {
+                    if (mode == 0) RAND_bytes(iv, sizeof(iv));
+                    else if (mode == 1) teamcore::crypto::GenerateNonce12(iv);
+                    else if (i % 10 == 0) teamcore::crypto::EncryptForDB(field, key32, "");
+                }
+            });
+        }
+        for (size_t t = 0; t < threads.size(); ++t) threads[t].join();
+        return sec(std::chrono::steady_clock::now() - t0).count();
+    };
+
+    const double randSec = run(0);
+    const double poolSec = run(1);
+    const double encSec = run(2);
+    EXPECT_GT(randSec, 0.0);
+    std::cerr << "[BENCH] " << kThreads << " threads IV: RAND_bytes per field="
+              << static_cast<long>(kThreads * kPerThread / randSec) << "/s pool="
+              << static_cast<long>(kThreads * kPerThread / poolSec) << "/s; EncryptForDB="
+              << static_cast<long>(kThreads * (kPerThread / 10) / encSec) << " fields/s\n";
+}
+
+// =================== Multi-lane PBKDF2 Tests ===================
+
+/**
+ * @brief Test batch PBKDF2 against the single-key path
+ * @test Verifies bit-identical keys for mixed iteration counts, partial lane groups and long passphrases
+ */
+TEST_F(LocalSportsTest, CryptoDeriveKeysBatchMatchesPbkdf2) {  /**< Test: crypto::DeriveKeysFromPassphrases */
+    const int kJobs = 19;  /**< Two full lane groups plus a partial one */
+    std::vector<std::string> pass(kJobs);
+    std::vector<std::vector<unsigned char> > salts(kJobs);
+    std::vector<std::vector<unsigned char> > out(kJobs, std::vector<unsigned char>(32));
+    std::vector<teamcore::crypto::KdfJob> jobs(kJobs);
+    for (int i = 0; i < kJobs; ++i) {
+        pass[i] = "parola-" + std::to_string(i);
+        if (i == 3) pass[i] = std::string(100, 'L');  /**< Longer than the HMAC block */
+        if (i == 4) pass[i].clear();
+        salts[i].assign(i == 5 ? 70 : 16, static_cast<unsigned char>(i));
+        jobs[i].passphrase = &pass[i];
+        jobs[i].salt = salts[i].data();
+        jobs[i].saltLen = salts[i].size();
+        jobs[i].iterations = (i % 4 == 0) ? 1 : 500 + 37 * i;
+        jobs[i].outKey32 = out[i].data();
+    }
+    ASSERT_TRUE(teamcore::crypto::DeriveKeysFromPassphrases(jobs.data(), jobs.size()));
+
+    for (int i = 0; i < kJobs; ++i) {
+        unsigned char expect[32];
+        ASSERT_EQ(1, PKCS5_PBKDF2_HMAC(pass[i].data(), static_cast<int>(pass[i].size()),
+            salts[i].data(), static_cast<int>(salts[i].size()), jobs[i].iterations, EVP_sha256(), 32, expect));
+        EXPECT_EQ(0, std::memcmp(expect, out[i].data(), 32)) << "job " << i;
+    }
+
+    jobs[2].iterations = 0;
+    EXPECT_FALSE(teamcore::crypto::DeriveKeysFromPassphrases(jobs.data(), jobs.size()));
+    EXPECT_TRUE(teamcore::crypto::DeriveKeysFromPassphrases(nullptr, 0));
+}
+
+/**
+ * @brief Benchmark: serial DeriveKeyFromPassphrase vs the multi-lane batch
+ * @test Verifies batch output matches for 16 users at the login iteration count
+ */
+TEST_F(LocalSportsTest, DISABLED_BenchCryptoDeriveKeysBatch) {  /**< Benchmark: multi-lane PBKDF2 */
+    const int kUsers = 16;  /**< One full lane group */
+    const int kIters = 150000;  /**< Same as stored user hashes */
+    unsigned char salt[16];
+    std::memset(salt, 0x5A, sizeof(salt));
+    std::vector<std::string> pass(kUsers);
+    std::vector<std::vector<unsigned char> > serial(kUsers, std::vector<unsigned char>(32));
+    std::vector<std::vector<unsigned char> > batch(kUsers, std::vector<unsigned char>(32));
+    std::vector<teamcore::crypto::KdfJob> jobs(kUsers);
+    for (int i = 0; i < kUsers; ++i) {
+        pass[i] = "kullanici" + std::to_string(i);
+        teamcore::crypto::KdfJob job = { &pass[i], salt, sizeof(salt), kIters, batch[i].data() };
+        jobs[i] = job;
+    }
+
+    typedef std::chrono::duration<double, std::milli> ms;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < kUsers; ++i) {
+        ASSERT_TRUE(teamcore::crypto::DeriveKeyFromPassphrase(pass[i], salt, sizeof(salt), kIters, serial[i].data()));
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    ASSERT_TRUE(teamcore::crypto::DeriveKeysFromPassphrases(jobs.data(), jobs.size()));
+    auto t2 = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < kUsers; ++i) EXPECT_EQ(serial[i], batch[i]);
+    std::cerr << "[BENCH] PBKDF2 " << kUsers << " users x" << kIters << ": serial=" << ms(t1 - t0).count()
+              << "ms lanes=" << ms(t2 - t1).count() << "ms\n";
+}
+
+// =================== Key Hierarchy Tests ===================
+
+/**
+ * @brief Helper: hex string to bytes
+ */
+static std::vector<unsigned char> FromHex(const std::string& hex) {
+    std::vector<unsigned char> out;
+    for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+        out.push_back(static_cast<unsigned char>(std::stoi(hex.substr(i, 2), nullptr, 16)));
+    }
+    return out;
+}
+
+/**
+ * @brief Test HKDF-Expand against RFC 5869
+ * @test Verifies test case 1 output (multi-block, truncated) and parameter checks
+ */
+TEST_F(LocalSportsTest, CryptoHkdfExpandMatchesRfc5869) {  /**< Test: crypto::HkdfExpandSha256 */
+    const std::vector<unsigned char> prk = FromHex("077709362c2e32df0ddc3f0dc47bba6390b6c73bb50f9c3122ec844ad7c2b3e5");
+    const std::vector<unsigned char> info = FromHex("f0f1f2f3f4f5f6f7f8f9");
+    const std::vector<unsigned char> okm = FromHex(
+        "3cb25f25faacd57a90434f64d0362f2a2d2d0a90cf1a5a4c5db02d56ecc4c5bf34007208d5b887185865");
+    std::vector<unsigned char> out(okm.size());
+    ASSERT_TRUE(teamcore::crypto::HkdfExpandSha256(prk.data(), prk.size(),
+        std::string(info.begin(), info.end()), out.data(), out.size()));
+    EXPECT_EQ(okm, out);
+
+    EXPECT_FALSE(teamcore::crypto::HkdfExpandSha256(prk.data(), prk.size(), "", out.data(), 255 * 32 + 1));
+    EXPECT_FALSE(teamcore::crypto::HkdfExpandSha256(nullptr, 32, "", out.data(), 32));
+}
+
+/**
+ * @brief Test purpose-labelled subkeys
+ * @test Verifies caching, label/root independence and reset on Init/Clear
+ */
+TEST_F(LocalSportsTest, KeyHierarchyCachesIndependentSubkeys) {  /**< Test: KeyHierarchy */
+    unsigned char root[32];
+    std::memset(root, 0x21, sizeof(root));
+    teamcore::KeyHierarchy keys;
+    EXPECT_FALSE(keys.IsReady());
+    EXPECT_EQ(nullptr, keys.Subkey("a"));
+
+    keys.Init(root);
+    ASSERT_TRUE(keys.IsReady());
+    const teamcore::SecureBuffer* a = keys.Subkey("localsports/a/v1");
+    const teamcore::SecureBuffer* b = keys.Subkey("localsports/b/v1");
+    ASSERT_NE(nullptr, a);
+    ASSERT_NE(nullptr, b);
+    EXPECT_EQ(a, keys.Subkey("localsports/a/v1"));  /**< Cached */
+    EXPECT_EQ(32u, a->size());
+    EXPECT_NE(0, std::memcmp(a->data(), b->data(), 32));
+    EXPECT_NE(0, std::memcmp(a->data(), root, 32));  /**< Never the raw root */
+
+    unsigned char expect[32];
+    ASSERT_TRUE(teamcore::crypto::HkdfExpandSha256(root, 32, "localsports/a/v1", expect, 32));
+    EXPECT_EQ(0, std::memcmp(expect, a->data(), 32));
+
+    unsigned char other[32];
+    std::memset(other, 0x22, sizeof(other));
+    keys.Init(other);
+    const teamcore::SecureBuffer* a2 = keys.Subkey("localsports/a/v1");
+    ASSERT_NE(nullptr, a2);
+    EXPECT_NE(0, std::memcmp(expect, a2->data(), 32));
+    keys.Clear();
+    EXPECT_EQ(nullptr, keys.Subkey("localsports/a/v1"));
+
+    ASSERT_TRUE(teamcore::AppKey_InitFromEnvOrPrompt());
+    ASSERT_NE(nullptr, teamcore::AppKey_Subkey("localsports/test/v1"));
+    EXPECT_EQ(teamcore::AppKey_Subkey("localsports/test/v1"), teamcore::AppKey_Subkey("localsports/test/v1"));
+}
+
+/**
+ * @brief Benchmark: new subkey via HKDF vs another PBKDF2 stretch
+ * @test Verifies both produce 32-byte keys; reports microseconds per key
+ */
+TEST_F(LocalSportsTest, DISABLED_BenchKeyHierarchyVsPbkdf2) {  /**< Benchmark: HKDF subkeys */
+    unsigned char root[32];
+    std::memset(root, 0x23, sizeof(root));
+    teamcore::KeyHierarchy keys;
+    keys.Init(root);
+    const int kLabels = 1000;
+    typedef std::chrono::duration<double, std::micro> us;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < kLabels; ++i) ASSERT_NE(nullptr, keys.Subkey("feature/" + std::to_string(i)));
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < kLabels; ++i) ASSERT_NE(nullptr, keys.Subkey("feature/" + std::to_string(i)));
+    auto t2 = std::chrono::steady_clock::now();
+    unsigned char stretched[32];
+    ASSERT_TRUE(teamcore::crypto::DeriveKeyFromPassphrase("x", root, 16, 100000, stretched));
+    auto t3 = std::chrono::steady_clock::now();
+
+    std::cerr << "[BENCH] subkey: HKDF derive=" << us(t1 - t0).count() / kLabels << "us cached="
+              << us(t2 - t1).count() / kLabels << "us PBKDF2(100k)=" << us(t3 - t2).count() << "us\n";
+}
+
+/**
+ * @brief Benchmark: SecureBuffer(32) construction with inline storage
+ * @test Reports nanoseconds per key buffer
+ */
+TEST_F(LocalSportsTest, DISABLED_BenchSecureBufferKeyAlloc) {  /**< Benchmark: inline key buffers */
+    const int kIter = 1000000;
+    typedef std::chrono::duration<double, std::nano> ns;
+    unsigned long sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIter; ++i) {
+        teamcore::SecureBuffer key(32);
+        key.data()[0] = static_cast<unsigned char>(i);
+        sink += key.data()[0];
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIter; ++i) {
+        teamcore::SecureBuffer big(teamcore::SecureBuffer::INLINE_CAPACITY * 2);
+        big.data()[0] = static_cast<unsigned char>(i);
+        sink += big.data()[0];
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    EXPECT_GT(sink, 0ul);
+    std::cerr << "[BENCH] SecureBuffer: 32B inline=" << ns(t1 - t0).count() / kIter << "ns 128B heap="
+              << ns(t2 - t1).count() / kIter << "ns\n";
+}
+
+// =================== SecureString Tests ===================
+
+/**
+ * @brief Test SecureString semantics
+ * @test Verifies move-only type, NUL termination, editing, constant-time equality and in-place wipe
+ */
+TEST_F(LocalSportsTest, SecureStringMoveOnlyAndWipes) {  /**< Test: SecureString */
+    static_assert(!std::is_copy_constructible<teamcore::SecureString>::value, "SecureString must not copy");
+    static_assert(std::is_nothrow_move_constructible<teamcore::SecureString>::value, "SecureString must move");
+
+    teamcore::SecureString s("gizli", 5);
+    EXPECT_EQ(5u, s.size());
+    EXPECT_STREQ("gizli", s.c_str());
+    s.push_back('!');
+    s.append("12", 2);
+    s.pop_back();
+    EXPECT_STREQ("gizli!1", s.c_str());
+    EXPECT_EQ(std::string("gizli!1"), std::string(s.begin(), s.end()));
+
+    teamcore::SecureString t(std::move(s));
+    EXPECT_TRUE(s.empty());
+    EXPECT_STREQ("", s.c_str());  /**< Moved-from stays a valid empty string */
+    EXPECT_TRUE(t.equals(teamcore::SecureString("gizli!1", 7)));
+    EXPECT_FALSE(t.equals(teamcore::SecureString("gizli!2", 7)));
+    EXPECT_FALSE(t.equals(teamcore::SecureString("gizli", 5)));
+
+    const char* storage = t.data();
+    t.clear();
+    EXPECT_TRUE(t.empty());
+    EXPECT_EQ(storage, t.data());  /**< Capacity kept, bytes wiped in place */
+    for (int i = 0; i < 7; ++i) EXPECT_EQ(0, storage[i]);
+
+    // Typical passwords and PII fit the reserved capacity: no regrowth, no stale copies
+    teamcore::SecureString grow;
+    const char* first = grow.data();
+    for (int i = 0; i < 40; ++i) grow.push_back('x');
+    EXPECT_EQ(first, grow.data());
+}
+
+/**
+ * @brief Test register/login and PII storage through SecureString inputs
+ * @test Verifies mismatched passwords are rejected, the new user can log in and phone/email are sealed
+ */
+TEST_F(LocalSportsTest, SecureStringFlowsThroughAuthAndPii) {  /**< Test: SecureString in interactive flows */
+    const char* path = "test_secure_string.db";  /**< Flow database */
+    LSContext* ctx = CreateTestContext(path, 0x7A);
+    std::stringstream output;
+
+    std::stringstream mismatch("yeniuye\nparola1\nparola2\n");
+    LS_SetContextStreams(*ctx, &mismatch, &output);
+    LS_AuthRegisterInteractive(*ctx);
+    EXPECT_NE(std::string::npos, output.str().find("Sifreler eslesmiyor"));
+
+    std::stringstream reg("yeniuye\nparola1\nparola1\n");
+    LS_SetContextStreams(*ctx, &reg, &output);
+    LS_AuthRegisterInteractive(*ctx);
+    std::stringstream login("yeniuye\nparola1\n");
+    LS_SetContextStreams(*ctx, &login, &output);
+    EXPECT_TRUE(LS_AuthLoginInteractive(*ctx));
+    std::stringstream wrong("yeniuye\nparola2\n");
+    LS_SetContextStreams(*ctx, &wrong, &output);
+    EXPECT_FALSE(LS_AuthLoginInteractive(*ctx));
+
+    std::stringstream player("Ali\nKaleci\n05551234567\r\nali@example.com\n");
+    LS_SetContextStreams(*ctx, &player, &output);
+    LS_AddPlayerInteractive(*ctx);
+    output.str("");
+    LS_ListPlayersInteractive(*ctx);
+    EXPECT_NE(std::string::npos, output.str().find("05551234567"));
+    EXPECT_NE(std::string::npos, output.str().find("ali@example.com"));
+    LS_SetContextStreams(*ctx, nullptr, nullptr);
+
+    sqlite3* raw = nullptr;
+    ASSERT_EQ(SQLITE_OK, sqlite3_open(path, &raw));
+    EXPECT_EQ(1, QueryIntValue(raw, "SELECT COUNT(*) FROM players WHERE phone LIKE 'GCM1:%' AND email LIKE 'GCM1:%';"));
+    sqlite3_close(raw);
+
+    LS_DestroyContext(ctx);
+    RemoveWalTestDb(path);
+}
+
+// =================== Zygote Tests ===================
+
+#ifndef _WIN32
+/**
+ * @brief Forks a zygote server that preloads a KDF key, then serves maxRequests connections
+ * @return Server pid; the caller waits for it after the last request
+ */
+static pid_t StartTestZygote(const std::string& socketPath, int maxRequests) {
+    pid_t pid = fork();
+    if (pid != 0) return pid;
+    static unsigned char preloaded[32];
+    static bool afterForkRan = false;
+    teamcore::crypto::DeriveKeyFromPassphrase(std::string("zygote"), reinterpret_cast<const unsigned char*>("salt"), 4, 1000, preloaded);
+    teamcore::zygote::ZygoteConfig config;
+    config.socketPath = socketPath;
+    config.maxRequests = maxRequests;
+    config.afterFork = []() { afterForkRan = true; };
+    const bool ok = teamcore::zygote::Serve(config, [](const std::vector<std::string>& args) {
+        // stdio, not std::cout: the fixture points std::cout at a stringstream
+        std::printf("worker:%u:%s\n", static_cast<unsigned>(args.size()), args.empty() ? "" : args.back().c_str());
+        unsigned char expected[32];
+        teamcore::crypto::DeriveKeyFromPassphrase(std::string("zygote"), reinterpret_cast<const unsigned char*>("salt"), 4, 1000, expected);
+        const bool inherited = std::memcmp(expected, preloaded, sizeof(expected)) == 0;
+        return afterForkRan && inherited ? 7 : 3;
+    });
+    _exit(ok ? 0 : 1);
+}
+
+/**
+ * @brief Connects to a zygote that is still starting up
+ */
+static int RunTestZygoteClient(const std::string& socketPath, const std::vector<std::string>& args) {
+    int rc = -1;
+    for (int i = 0; i < 200 && rc < 0; ++i) {
+        rc = teamcore::zygote::RunClient(socketPath, args);
+        if (rc < 0) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return rc;
+}
+#endif
+
+/**
+ * @brief Tests that a zygote worker inherits preloaded state and the client's stdout
+ * @test Verifies the exit code round trip, afterFork, argument passing and stdout handoff
+ */
+TEST_F(LocalSportsTest, ZygoteWorkerInheritsStateAndStdio) {  /**< Zygote fork per connection */
+#ifndef _WIN32
+    const std::string socketPath = "test_zygote_" + std::to_string(getpid()) + ".sock";
+    pid_t server = StartTestZygote(socketPath, 2);
+    ASSERT_GT(server, 0);
+
+    std::vector<std::string> args;
+    args.push_back("localsportsapp");
+    args.push_back("ping");
+    EXPECT_EQ(7, RunTestZygoteClient(socketPath, args));
+
+    // Worker writes to the client's stdout descriptor, not the zygote's
+    const char* outPath = "test_zygote_stdout.txt";
+    std::fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    int file = open(outPath, O_CREAT | O_TRUNC | O_WRONLY, 0600);
+    ASSERT_GE(file, 0);
+    dup2(file, STDOUT_FILENO);
+    close(file);
+    const int rc = teamcore::zygote::RunClient(socketPath, std::vector<std::string>(1, "second"));
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+    EXPECT_EQ(7, rc);
+    std::ifstream captured(outPath);
+    std::string line;
+    std::getline(captured, line);
+    EXPECT_EQ("worker:1:second", line);
+    captured.close();
+    std::remove(outPath);
+
+    int status = 0;
+    waitpid(server, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(0, WEXITSTATUS(status));
+    // Served its requests: the socket is removed and clients fall back to a normal start
+    EXPECT_EQ(-1, teamcore::zygote::RunClient(socketPath, args));
+#endif
+}
+
+/**
+ * @brief Tests that neither side uses a socket in a directory other users can write
+ * @test Verifies Serve and RunClient refuse a path under a world-writable directory
+ */
+TEST_F(LocalSportsTest, ZygoteRefusesSharedSocketDirectory) {  /**< Zygote socket directory check */
+#ifndef _WIN32
+    const std::string dir = "test_zygote_shared_" + std::to_string(getpid());
+    ASSERT_EQ(0, mkdir(dir.c_str(), 0700));
+    ASSERT_EQ(0, chmod(dir.c_str(), 01777));  /**< Like /tmp */
+    const std::string socketPath = dir + "/ls.zygote";
+
+    teamcore::zygote::ZygoteConfig config;
+    config.socketPath = socketPath;
+    EXPECT_FALSE(teamcore::zygote::Serve(config, [](const std::vector<std::string>&) { return 0; }));
+    EXPECT_EQ(-1, teamcore::zygote::RunClient(socketPath, std::vector<std::string>(1, "x")));
+    EXPECT_EQ(std::string::npos, teamcore::zygote::DefaultSocketPath().find("/tmp/"));
+    rmdir(dir.c_str());
+#endif
+}
+
+#ifndef _WIN32
+/**
+ * @brief Threads of this process, from /proc/self/status (-1 if unavailable)
+ */
+static int CountProcessThreads() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 8, "Threads:") == 0) return std::atoi(line.c_str() + 8);
+    }
+    return -1;
+}
+#endif
+
+/**
+ * @brief Tests that a zygote with RASP forks from a single thread and scans between accepts
+ * @test Verifies onIdle runs with no other threads alive and the worker gets its monitor back
+ */
+TEST_F(LocalSportsTest, ZygoteForksWithoutRASPThreads) {  /**< Zygote fork safety */
+#ifndef _WIN32
+    if (CountProcessThreads() < 0) GTEST_SKIP() << "/proc not available";
+    const std::string socketPath = "test_zygote_rasp_" + std::to_string(getpid()) + ".sock";
+    std::fflush(stdout);
+    pid_t server = fork();
+    ASSERT_GE(server, 0);
+    if (server == 0) {
+        static int idleScans = 0;
+        static int idleThreads = -1;
+        teamcore::rasp::RASPConfig config = teamcore::rasp::GetRASPConfig();
+        config.logFilePath = "test_rasp_zygote.log";
+        config.enableDebuggerDetection = false;
+        config.enableChecksumVerification = false;
+        config.enableHookDetection = true;
+        config.autoTerminateOnThreat = false;
+        teamcore::rasp::ConfigureRASP(config);
+        teamcore::rasp::ReinitializeAfterFork();  /**< Drop handles of the test process's threads */
+        teamcore::rasp::InitializeRASP(teamcore::rasp::CalculateTextSectionChecksum(), false);
+        teamcore::rasp::StopBackgroundThreads();
+
+        teamcore::zygote::ZygoteConfig zygote;
+        zygote.socketPath = socketPath;
+        zygote.maxRequests = 1;
+        zygote.afterFork = []() { teamcore::rasp::ReinitializeAfterFork(); };
+        zygote.idleIntervalMs = 10;
+        zygote.onIdle = []() {
+            teamcore::rasp::PerformSecurityScanInline();
+            ++idleScans;
+            idleThreads = std::max(idleThreads, CountProcessThreads());
+        };
+        const bool ok = teamcore::zygote::Serve(zygote, [](const std::vector<std::string>&) {
+            const bool monitorBack = teamcore::rasp::GetCheckIntervalMs("hooks") > 0 && CountProcessThreads() > 1;
+            return idleScans > 0 && idleThreads == 1 && monitorBack ? 7 : 3;
+        });
+        teamcore::rasp::ShutdownRASP();
+        _exit(ok ? 0 : 1);
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));  /**< A few idle scans */
+    EXPECT_EQ(7, RunTestZygoteClient(socketPath, std::vector<std::string>(1, "rasp")));
+    int status = 0;
+    waitpid(server, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(0, WEXITSTATUS(status));
+    std::remove("test_rasp_zygote.log");
+#endif
+}
+
+/**
+ * @brief Benchmark: zygote round trip vs the AppKey KDF every normal start pays
+ * @test Verifies all requests succeed; reports per-command latency of both paths
+ */
+TEST_F(LocalSportsTest, DISABLED_BenchZygoteRoundTripVsColdStart) {  /**< Benchmark: zygote vs cold start */
+#ifndef _WIN32
+    const int kRequests = 20;
+    const std::string socketPath = "test_zygote_bench_" + std::to_string(getpid()) + ".sock";
+    typedef std::chrono::duration<double, std::milli> ms;
+    pid_t server = StartTestZygote(socketPath, kRequests + 1);
+    ASSERT_GT(server, 0);
+    std::vector<std::string> args(1, "bench");
+    std::fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    int devNull = open("/dev/null", O_WRONLY);
+    ASSERT_GE(devNull, 0);
+    dup2(devNull, STDOUT_FILENO);
+    close(devNull);
+    const int warmup = RunTestZygoteClient(socketPath, args); // server is listening
+    auto t0 = std::chrono::steady_clock::now();
+    int ok = 0;
+    for (int i = 0; i < kRequests; ++i) {
+        ok += teamcore::zygote::RunClient(socketPath, args) == 7 ? 1 : 0;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+    EXPECT_EQ(7, warmup);
+    EXPECT_EQ(kRequests, ok);
+
+    unsigned char key[32];
+    const unsigned char salt[16] = { 0 };
+    auto t2 = std::chrono::steady_clock::now();
+    ASSERT_TRUE(teamcore::crypto::DeriveKeyFromPassphrase(std::string("cold-start"), salt, sizeof(salt), 100000, key));
+    auto t3 = std::chrono::steady_clock::now();
+
+    int status = 0;
+    waitpid(server, &status, 0);
+    std::cerr << "[BENCH] zygote command round trip=" << ms(t1 - t0).count() / kRequests
+              << "ms; cold start AppKey KDF alone=" << ms(t3 - t2).count() << "ms\n";
+#endif
+}
+
+// =================== RASP Event Aggregation Tests ===================
+
+/**
+ * @brief Counts the lines of a log file
+ */
+static int CountLogLines(const char* path) {
+    std::ifstream in(path);
+    std::string line;
+    int n = 0;
+    while (std::getline(in, line)) ++n;
+    return n;
+}
+
+/**
+ * @brief Tests that repeats of one event collapse into a single summary per window
+ * @test Verifies the first event is written at once, repeats are counted, and a new window reopens
+ */
+TEST_F(LocalSportsTest, RASPEventAggregationCollapsesRepeats) {  /**< Test: event dedup window */
+    const teamcore::rasp::RASPConfig saved = teamcore::rasp::GetRASPConfig();
+    teamcore::rasp::RASPConfig config = saved;
+    config.logFilePath = "test_rasp_events.log";
+    config.eventWindowMs = 60000;
+    teamcore::rasp::ConfigureRASP(config);
+    teamcore::rasp::ClearSecurityLog();
+
+    teamcore::rasp::SecurityEvent evt;
+    evt.eventType = "DEBUGGER_DETECTED";
+    evt.description = "Runtime debugger detected";
+    evt.severity = 2;
+    for (int i = 0; i < 50; ++i) {
+        evt.timestamp = "2025-01-01 10:00:" + std::string(i < 10 ? "0" : "") + std::to_string(i);
+        EXPECT_TRUE(teamcore::rasp::LogSecurityEvent(evt));
+    }
+    std::vector<teamcore::rasp::SecurityEvent> log = teamcore::rasp::GetSecurityEventLog();
+    ASSERT_EQ(1u, log.size());
+    EXPECT_EQ(1, log[0].count);
+    EXPECT_TRUE(log[0].firstTimestamp.empty());
+
+    teamcore::rasp::FlushSecurityEvents();
+    log = teamcore::rasp::GetSecurityEventLog();
+    ASSERT_EQ(2u, log.size());
+    EXPECT_EQ(49, log[1].count);
+    EXPECT_EQ("2025-01-01 10:00:01", log[1].firstTimestamp);
+    EXPECT_EQ("2025-01-01 10:00:49", log[1].timestamp);
+    EXPECT_EQ(2, CountLogLines(config.logFilePath.c_str()));
+
+    // Expired window: the summary is written and the next occurrence opens a new window
+    config.eventWindowMs = 20;
+    teamcore::rasp::ConfigureRASP(config);
+    teamcore::rasp::LogSecurityEvent(evt);
+    teamcore::rasp::LogSecurityEvent(evt);
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    teamcore::rasp::LogSecurityEvent(evt);
+    log = teamcore::rasp::GetSecurityEventLog();
+    ASSERT_EQ(5u, log.size());
+    EXPECT_EQ(1, log[3].count);
+    EXPECT_FALSE(log[3].firstTimestamp.empty());
+    EXPECT_TRUE(log[4].firstTimestamp.empty());
+
+    teamcore::rasp::ClearSecurityLog();
+    teamcore::rasp::ConfigureRASP(saved);
+    std::remove("test_rasp_events.log");
+}
+
+/**
+ * @brief Tests the per-type token bucket and the critical-severity bypass
+ * @test Verifies distinct events beyond the burst are only counted, other types keep their own
+ *       bucket, and a severity-3 event is written even when its bucket is empty
+ */
+TEST_F(LocalSportsTest, RASPEventTokenBucketLimitsPerType) {  /**< Test: event rate limiting */
+    const teamcore::rasp::RASPConfig saved = teamcore::rasp::GetRASPConfig();
+    teamcore::rasp::RASPConfig config = saved;
+    config.logFilePath = "test_rasp_bucket.log";
+    config.eventBurstPerType = 3;
+    config.eventRefillPerMinute = 0;
+    teamcore::rasp::ConfigureRASP(config);
+    teamcore::rasp::ClearSecurityLog();
+
+    teamcore::rasp::SecurityEvent evt;
+    evt.timestamp = "2025-01-01 10:00:00";
+    evt.eventType = "HOOK_DETECTED";
+    evt.severity = 2;
+    for (int i = 0; i < 10; ++i) {
+        evt.description = "hook in function " + std::to_string(i);
+        EXPECT_TRUE(teamcore::rasp::LogSecurityEvent(evt));
+    }
+    EXPECT_EQ(3u, teamcore::rasp::GetSecurityEventLog().size());
+
+    evt.eventType = "INTEGRITY_VIOLATION";
+    evt.description = "text section changed";
+    teamcore::rasp::LogSecurityEvent(evt);
+    EXPECT_EQ(4u, teamcore::rasp::GetSecurityEventLog().size());
+
+    evt.eventType = "HOOK_DETECTED";
+    evt.description = "critical hook";
+    evt.severity = 3;
+    teamcore::rasp::LogSecurityEvent(evt);
+    teamcore::rasp::LogSecurityEvent(evt);
+    std::vector<teamcore::rasp::SecurityEvent> log = teamcore::rasp::GetSecurityEventLog();
+    ASSERT_EQ(5u, log.size());
+    EXPECT_EQ("critical hook", log[4].description);
+
+    // 7 rate-limited hooks and the repeated critical hook come out as summaries
+    teamcore::rasp::FlushSecurityEvents();
+    log = teamcore::rasp::GetSecurityEventLog();
+    ASSERT_EQ(13u, log.size());
+    int counted = 0;
+    for (size_t i = 5; i < log.size(); ++i) counted += log[i].count;
+    EXPECT_EQ(8, counted);
+
+    teamcore::rasp::ClearSecurityLog();
+    teamcore::rasp::ConfigureRASP(saved);
+    std::remove("test_rasp_bucket.log");
+}
+
+/**
+ * @brief Benchmark: persistent condition logged every tick, with and without aggregation
+ * @test Verifies the aggregated run writes one line; reports events/s of both paths
+ */
+TEST_F(LocalSportsTest, DISABLED_BenchRASPEventAggregation) {  /**< Benchmark: event pipeline */
+    const int kEvents = 20000;
+    const teamcore::rasp::RASPConfig saved = teamcore::rasp::GetRASPConfig();
+    teamcore::rasp::RASPConfig config = saved;
+    config.logFilePath = "test_rasp_bench.log";
+    typedef std::chrono::duration<double> sec;
+
+    teamcore::rasp::SecurityEvent evt;
+    evt.timestamp = "2025-01-01 10:00:00";
+    evt.eventType = "DEBUGGER_DETECTED";
+    evt.description = "Runtime debugger detected via ptrace";
+    evt.severity = 3;
+
+    auto run = [&](int windowMs, int burst) {
+        config.eventWindowMs = windowMs;
+        config.eventBurstPerType = burst;
+        teamcore::rasp::ConfigureRASP(config);
+        teamcore::rasp::ClearSecurityLog();
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < kEvents; ++i) teamcore::rasp::LogSecurityEvent(evt);
+        teamcore::rasp::FlushSecurityEvents();
+        return sec(std::chrono::steady_clock::now() - t0).count();
+    };
+
+    const double everySec = run(0, kEvents);  // window 0: every event is its own record
+    const int everyLines = CountLogLines(config.logFilePath.c_str());
+    const double aggSec = run(60000, 10);
+    const int aggLines = CountLogLines(config.logFilePath.c_str());
+    EXPECT_EQ(kEvents, everyLines);
+    EXPECT_EQ(2, aggLines);
+    std::cerr << "[BENCH] " << kEvents << " repeated events: every record="
+              << static_cast<long>(kEvents / everySec) << "/s (" << everyLines << " lines) aggregated="
+              << static_cast<long>(kEvents / aggSec) << "/s (" << aggLines << " lines)\n";
+
+    teamcore::rasp::ClearSecurityLog();
+    teamcore::rasp::ConfigureRASP(saved);
+    std::remove("test_rasp_bench.log");
+}
+
+// =================== Shared Library Integrity Tests ===================
+
+/**
+ * @brief Tests the shared library baseline against its manifest
+ * @test Verifies the manifest is created on first run, matches afterwards, and a changed digest
+ *       is reported as LIBRARY_INTEGRITY_MISMATCH
+ */
+TEST_F(LocalSportsTest, RASPLibraryBaselineMatchesManifest) {  /**< Test: library manifest */
+    const teamcore::rasp::RASPConfig saved = teamcore::rasp::GetRASPConfig();
+    teamcore::rasp::RASPConfig config = saved;
+    config.libraryManifestPath = "test_rasp_libs.manifest";
+    config.libraryManifestKey = "test-manifest-key";
+    config.logFilePath = "test_rasp_libs.log";
+    config.autoTerminateOnThreat = false;
+    config.libraryHashThreads = 1;
+    teamcore::rasp::ConfigureRASP(config);
+    teamcore::rasp::ClearSecurityLog();
+    std::remove(config.libraryManifestPath.c_str());
+    std::remove(config.logFilePath.c_str());
+
+    teamcore::rasp::LibraryBaselineReport report;
+    EXPECT_TRUE(teamcore::rasp::CaptureLibraryBaseline(&report));
+#ifdef __linux__
+    EXPECT_TRUE(report.manifestCreated);
+    EXPECT_GT(report.modules, 0);   // libcrypto, libsqlite3, libc, ...
+    EXPECT_GT(report.bytes, 0u);
+    EXPECT_GE(report.chunks, report.modules);
+
+    // Hashed across threads, the digests match the single-threaded manifest
+    config.libraryHashThreads = 4;
+    teamcore::rasp::ConfigureRASP(config);
+    const std::size_t serialBytes = report.bytes;
+    EXPECT_TRUE(teamcore::rasp::CaptureLibraryBaseline(&report));
+    EXPECT_EQ(serialBytes, report.bytes);
+    EXPECT_FALSE(report.manifestCreated);
+    EXPECT_EQ(0, report.mismatches);
+    EXPECT_EQ(0, report.unknown);
+    EXPECT_EQ(0, teamcore::rasp::VerifyLibraryChunks(report.chunks));
+    EXPECT_EQ(report.chunks, teamcore::rasp::GetLibraryBaselineReport().chunks);
+
+    // Replace the first library's digest without re-signing: the manifest is not trusted
+    std::ifstream in(config.libraryManifestPath.c_str());
+    std::string first, rest, line;
+    std::getline(in, first);
+    while (std::getline(in, line)) {
+        if (line.compare(0, 12, "hmac-sha256 ") != 0) rest += line + "\n";
+    }
+    in.close();
+    const std::string forged = std::string(64, '0') + first.substr(64) + "\n" + rest;
+    std::ofstream out(config.libraryManifestPath.c_str(), std::ios::trunc);
+    out << forged;
+    out.close();
+
+    EXPECT_FALSE(teamcore::rasp::CaptureLibraryBaseline(&report));
+    EXPECT_TRUE(report.tampered);
+    EXPECT_FALSE(report.manifestCreated);
+    EXPECT_EQ(0, report.mismatches);
+    std::ifstream kept(config.libraryManifestPath.c_str());
+    EXPECT_EQ(forged, std::string(std::istreambuf_iterator<char>(kept), std::istreambuf_iterator<char>()));
+    kept.close();
+
+    // Signed with the configured key, the changed digest is a real mismatch
+    unsigned char mac[32];
+    unsigned int macLen = 0;
+    ASSERT_TRUE(HMAC(EVP_sha256(), config.libraryManifestKey.data(), static_cast<int>(config.libraryManifestKey.size()),
+                     reinterpret_cast<const unsigned char*>(forged.data()), forged.size(), mac, &macLen) != nullptr);
+    std::string macHex;
+    for (unsigned int i = 0; i < macLen; ++i) {
+        char hex[3];
+        std::snprintf(hex, sizeof(hex), "%02x", mac[i]);
+        macHex += hex;
+    }
+    out.open(config.libraryManifestPath.c_str(), std::ios::trunc);
+    out << forged << "hmac-sha256 " << macHex << "\n";
+    out.close();
+
+    EXPECT_FALSE(teamcore::rasp::CaptureLibraryBaseline(&report));
+    EXPECT_FALSE(report.tampered);
+    EXPECT_EQ(1, report.mismatches);
+
+    // Manifest deleted after the first install: no trust-on-first-use, nothing re-written
+    std::remove(config.libraryManifestPath.c_str());
+    EXPECT_FALSE(teamcore::rasp::CaptureLibraryBaseline(&report));
+    EXPECT_TRUE(report.tampered);
+    EXPECT_FALSE(report.manifestCreated);
+    EXPECT_FALSE(std::ifstream(config.libraryManifestPath.c_str()).good());
+
+    bool tampered = false, mismatch = false, missing = false;
+    std::vector<teamcore::rasp::SecurityEvent> log = teamcore::rasp::GetSecurityEventLog();
+    for (size_t i = 0; i < log.size(); ++i) {
+        tampered = tampered || log[i].eventType == "LIBRARY_MANIFEST_TAMPERED";
+        mismatch = mismatch || (log[i].eventType == "LIBRARY_INTEGRITY_MISMATCH" &&
+                                log[i].description.find(first.substr(65)) != std::string::npos);
+        missing = missing || (log[i].eventType == "LIBRARY_MANIFEST_TAMPERED" &&
+                              log[i].description.find("missing") != std::string::npos && log[i].severity >= 3);
+    }
+    EXPECT_TRUE(tampered);
+    EXPECT_TRUE(mismatch);
+    EXPECT_TRUE(missing);
+#endif
+
+    teamcore::rasp::ClearSecurityLog();
+    teamcore::rasp::ConfigureRASP(saved);
+    std::remove(config.libraryManifestPath.c_str());
+    std::remove(config.logFilePath.c_str());
+}
+
+/**
+ * @brief Tests the manifest key taken from the AppKey hierarchy
+ * @test Verifies a manifest written under the AppKey subkey verifies again and a manifest
+ *       signed with any other key (e.g. one derived from public data) is rejected
+ */
+TEST_F(LocalSportsTest, RASPLibraryManifestKeyedByAppKey) {  /**< Test: manifest key from AppKey */
+#ifdef __linux__
+    ASSERT_TRUE(teamcore::AppKey_InitFromEnvOrPrompt());
+    const teamcore::rasp::RASPConfig saved = teamcore::rasp::GetRASPConfig();
+    teamcore::rasp::RASPConfig config = saved;
+    config.libraryManifestPath = "test_rasp_appkey.manifest";
+    config.libraryManifestKey.clear();
+    config.logFilePath = "test_rasp_appkey.log";
+    config.autoTerminateOnThreat = false;
+    std::remove(config.libraryManifestPath.c_str());
+    std::remove(config.logFilePath.c_str());
+    teamcore::rasp::ConfigureRASP(config);
+    teamcore::rasp::ClearSecurityLog();
+
+    teamcore::rasp::LibraryBaselineReport report;
+    EXPECT_TRUE(teamcore::rasp::CaptureLibraryBaseline(&report));
+    EXPECT_FALSE(report.manifestPending);
+    EXPECT_TRUE(report.manifestCreated);
+    EXPECT_TRUE(teamcore::rasp::CaptureLibraryBaseline(&report));
+    EXPECT_FALSE(report.tampered);
+    EXPECT_TRUE(teamcore::rasp::VerifyLibraryManifest());  // nothing pending
+
+    // Same manifest, checked under a different key
+    config.libraryManifestKey = "some-other-key";
+    teamcore::rasp::ConfigureRASP(config);
+    EXPECT_FALSE(teamcore::rasp::CaptureLibraryBaseline(&report));
+    EXPECT_TRUE(report.tampered);
+#endif
+    teamcore::rasp::ClearSecurityLog();
+    teamcore::rasp::ConfigureRASP(saved);
+    std::remove("test_rasp_appkey.manifest");
+    std::remove("test_rasp_appkey.log");
+}
+
+/**
+ * @brief Tests that the incremental scan finds a patched byte in library code
+ * @test Verifies the scan resumes from its cursor and reports the modified chunk once
+ */
+TEST_F(LocalSportsTest, RASPLibraryChunksDetectRuntimePatch) {  /**< Test: incremental library scan */
+#ifdef __linux__
+    const teamcore::rasp::RASPConfig saved = teamcore::rasp::GetRASPConfig();
+    teamcore::rasp::RASPConfig config = saved;
+    config.libraryManifestPath = "test_rasp_patch.manifest";
+    config.libraryManifestKey = "test-manifest-key";
+    config.logFilePath = "test_rasp_patch.log";
+    std::remove(config.libraryManifestPath.c_str());
+    std::remove(config.logFilePath.c_str());
+    teamcore::rasp::ConfigureRASP(config);
+    teamcore::rasp::LibraryBaselineReport report;
+    ASSERT_TRUE(teamcore::rasp::CaptureLibraryBaseline(&report));
+
+    // Split the full pass over two scans: nothing has changed yet
+    const int half = report.chunks / 2;
+    EXPECT_EQ(0, teamcore::rasp::VerifyLibraryChunks(half));
+    EXPECT_EQ(0, teamcore::rasp::VerifyLibraryChunks(report.chunks - half));
+
+    // Flip one byte of a function in libsqlite3 that nothing calls meanwhile
+    Dl_info info;
+    unsigned char* target = reinterpret_cast<unsigned char*>(reinterpret_cast<std::uintptr_t>(&sqlite3_libversion_number));
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    void* page = reinterpret_cast<void*>(reinterpret_cast<std::uintptr_t>(target) & ~static_cast<std::uintptr_t>(pageSize - 1));
+    if (dladdr(target, &info) && info.dli_fname && std::strchr(info.dli_fname, '/') &&
+        mprotect(page, pageSize, PROT_READ | PROT_WRITE | PROT_EXEC) == 0) {
+        *target ^= 0xFF;
+        const int changed = teamcore::rasp::VerifyLibraryChunks(report.chunks);
+        *target ^= 0xFF;
+        mprotect(page, pageSize, PROT_READ | PROT_EXEC);
+        EXPECT_EQ(1, changed);
+        EXPECT_EQ(0, teamcore::rasp::VerifyLibraryChunks(report.chunks));
+    }
+
+    teamcore::rasp::ClearSecurityLog();
+    teamcore::rasp::ConfigureRASP(saved);
+    std::remove(config.libraryManifestPath.c_str());
+    std::remove(config.logFilePath.c_str());
+#endif
+}
+
+/**
+ * @brief Benchmark: boot-time library hashing on one thread vs all cores
+ * @test Verifies both runs hash the same bytes; reports the boot cost of each
+ */
+TEST_F(LocalSportsTest, DISABLED_BenchRASPLibraryBaselineParallel) {  /**< Benchmark: parallel library hashing */
+    const teamcore::rasp::RASPConfig saved = teamcore::rasp::GetRASPConfig();
+    teamcore::rasp::RASPConfig config = saved;
+    config.libraryManifestPath = "test_rasp_bench.manifest";
+    config.logFilePath = "test_rasp_bench_libs.log";
+
+    teamcore::rasp::LibraryBaselineReport serial, parallel;
+    config.libraryHashThreads = 1;
+    teamcore::rasp::ConfigureRASP(config);
+    teamcore::rasp::CaptureLibraryBaseline(&serial);
+    config.libraryHashThreads = 0;
+    teamcore::rasp::ConfigureRASP(config);
+    teamcore::rasp::CaptureLibraryBaseline(&parallel);
+    EXPECT_EQ(serial.bytes, parallel.bytes);
+    EXPECT_EQ(0, parallel.mismatches);
+    std::cerr << "[BENCH] library baseline " << parallel.modules << " libs / " << parallel.bytes / 1024
+              << " KB: 1 thread=" << serial.elapsedMs << "ms " << parallel.threads
+              << " threads=" << parallel.elapsedMs << "ms\n";
+
+    teamcore::rasp::ClearSecurityLog();
+    teamcore::rasp::ConfigureRASP(saved);
+    std::remove(config.libraryManifestPath.c_str());
+    std::remove(config.logFilePath.c_str());
+}
+
+// =================== Concurrent Security Scan Tests ===================
+
+/**
+ * @brief Tests per-check status and that independent checks overlap
+ * @test Verifies PASSED/FAILED per check, exceptions count as FAILED, and the wait is the longest
+ *       check rather than the sum
+ */
+TEST_F(LocalSportsTest, RASPRunChecksConcurrentlyReportsPerCheck) {  /**< Test: scan fan-out */
+    using teamcore::rasp::ScanCheck;
+    using teamcore::rasp::ScanStatus;
+    auto slowPass = []() { std::this_thread::sleep_for(std::chrono::milliseconds(60)); return true; };
+    std::vector<ScanCheck> checks;
+    ScanCheck a = { "a", "A", "a", slowPass };
+    ScanCheck b = { "b", "B", "b", []() { std::this_thread::sleep_for(std::chrono::milliseconds(60)); return false; } };
+    ScanCheck c = { "c", "C", "c", []() -> bool { throw std::runtime_error("probe failed"); } };
+    ScanCheck d = { "d", "D", "d", slowPass };
+    checks.push_back(a);
+    checks.push_back(b);
+    checks.push_back(c);
+    checks.push_back(d);
+
+    teamcore::rasp::SecurityScanReport report = teamcore::rasp::RunChecksConcurrently(checks, 5000);
+    ASSERT_EQ(4u, report.checks.size());
+    EXPECT_FALSE(report.passed);
+    EXPECT_FALSE(report.deadlineExceeded);
+    EXPECT_EQ("a", report.checks[0].name);
+    EXPECT_TRUE(report.checks[0].status == ScanStatus::PASSED);
+    EXPECT_TRUE(report.checks[1].status == ScanStatus::FAILED);
+    EXPECT_TRUE(report.checks[2].status == ScanStatus::FAILED);
+    EXPECT_TRUE(report.checks[3].status == ScanStatus::PASSED);
+    EXPECT_GE(report.checks[0].elapsedMs, 50.0);
+    EXPECT_LT(report.elapsedMs, 170.0);  // sequential would be >= 180 ms
+
+    checks.erase(checks.begin() + 1, checks.begin() + 3);
+    EXPECT_TRUE(teamcore::rasp::RunChecksConcurrently(checks, 0).passed);
+}
+
+/**
+ * @brief Tests that a hung check is reported as TIMED_OUT at the deadline
+ * @test Verifies the caller returns near the deadline while finished checks keep their status
+ */
+TEST_F(LocalSportsTest, RASPRunChecksConcurrentlyHonoursDeadline) {  /**< Test: scan deadline */
+    using teamcore::rasp::ScanCheck;
+    using teamcore::rasp::ScanStatus;
+    std::vector<ScanCheck> checks;
+    ScanCheck quick = { "quick", "Q", "q", []() { return true; } };
+    ScanCheck hung = { "hung", "H", "h", []() { std::this_thread::sleep_for(std::chrono::milliseconds(400)); return true; } };
+    checks.push_back(quick);
+    checks.push_back(hung);
+
+    teamcore::rasp::SecurityScanReport report = teamcore::rasp::RunChecksConcurrently(checks, 50);
+    EXPECT_FALSE(report.passed);
+    EXPECT_TRUE(report.deadlineExceeded);
+    EXPECT_TRUE(report.checks[0].status == ScanStatus::PASSED);
+    EXPECT_TRUE(report.checks[1].status == ScanStatus::TIMED_OUT);
+    EXPECT_GE(report.elapsedMs, 45.0);
+    EXPECT_LT(report.elapsedMs, 300.0);
+}
+
+/**
+ * @brief Tests that a check still running from a timed-out scan is not started again
+ * @test Verifies the second scan skips it as TIMED_OUT without waiting, and it runs again once finished
+ */
+TEST_F(LocalSportsTest, RASPRunChecksConcurrentlySkipsInFlightCheck) {  /**< Test: scan worker reuse */
+    using teamcore::rasp::ScanCheck;
+    using teamcore::rasp::ScanStatus;
+    std::shared_ptr<std::atomic<int>> runs = std::make_shared<std::atomic<int>>(0);
+    std::shared_ptr<std::atomic<bool>> release = std::make_shared<std::atomic<bool>>(false);
+    ScanCheck slow = { "in-flight-probe", "S", "s", [runs, release]() {
+        ++*runs;
+        while (!release->load()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return true;
+    } };
+    std::vector<ScanCheck> checks(1, slow);
+
+    teamcore::rasp::SecurityScanReport first = teamcore::rasp::RunChecksConcurrently(checks, 20);
+    EXPECT_TRUE(first.checks[0].status == ScanStatus::TIMED_OUT);
+    teamcore::rasp::SecurityScanReport second = teamcore::rasp::RunChecksConcurrently(checks, 2000);
+    EXPECT_TRUE(second.checks[0].status == ScanStatus::TIMED_OUT);
+    EXPECT_LT(second.elapsedMs, 500.0);  /**< Not waited for */
+    EXPECT_EQ(1, runs->load());
+
+    release->store(true);
+    for (int i = 0; i < 200; ++i) {  /**< Previous run drains */
+        teamcore::rasp::SecurityScanReport again = teamcore::rasp::RunChecksConcurrently(checks, 2000);
+        if (again.passed) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_GE(runs->load(), 2);
+}
+
+/**
+ * @brief Benchmark: the real scan checks back to back vs fanned out
+ * @test Verifies both paths agree; reports the caller's wait for each
+ */
+TEST_F(LocalSportsTest, DISABLED_BenchRASPConcurrentScan) {  /**< Benchmark: concurrent scan */
+    using teamcore::rasp::ScanCheck;
+    const teamcore::rasp::RASPConfig saved = teamcore::rasp::GetRASPConfig();
+    teamcore::rasp::RASPConfig config = saved;
+    config.libraryManifestPath = "test_rasp_scan.manifest";
+    config.logFilePath = "test_rasp_scan.log";
+    teamcore::rasp::ConfigureRASP(config);
+    teamcore::rasp::LibraryBaselineReport lib;
+    teamcore::rasp::CaptureLibraryBaseline(&lib);
+    const int chunks = lib.chunks;
+    typedef std::chrono::duration<double, std::milli> ms;
+
+    std::vector<ScanCheck> checks;
+    ScanCheck text = { "text", "T", "t", []() { return !teamcore::rasp::CalculateTextSectionChecksum().empty(); } };
+    ScanCheck libs = { "libs", "L", "l", [chunks]() { return teamcore::rasp::VerifyLibraryChunks(chunks) == 0; } };
+    ScanCheck hooks = { "hooks", "H", "h", []() { return teamcore::rasp::DetectPLTHooks() == 0; } };
+    checks.push_back(text);
+    checks.push_back(libs);
+    checks.push_back(hooks);
+
+    auto t0 = std::chrono::steady_clock::now();
+    bool serialOk = true;
+    for (size_t i = 0; i < checks.size(); ++i) serialOk = checks[i].run() && serialOk;
+    auto t1 = std::chrono::steady_clock::now();
+    teamcore::rasp::SecurityScanReport report = teamcore::rasp::RunChecksConcurrently(checks, 0);
+    EXPECT_EQ(serialOk, report.passed);
+    std::cerr << "[BENCH] security scan (" << checks.size() << " checks, " << std::thread::hardware_concurrency()
+              << " cores): sequential=" << ms(t1 - t0).count() << "ms concurrent=" << report.elapsedMs << "ms\n";
+
+    teamcore::rasp::ClearSecurityLog();
+    teamcore::rasp::ConfigureRASP(saved);
+    std::remove(config.libraryManifestPath.c_str());
+    std::remove(config.logFilePath.c_str());
+}
+
+// =================== Adaptive Monitoring Tests ===================
+
+/**
+ * @brief Tests the back-off and tighten rules of AdaptiveInterval
+ * @test Verifies quiet runs multiply up to the ceiling and Tighten drops straight to the floor
+ */
+TEST_F(LocalSportsTest, RASPAdaptiveIntervalBackoffAndTighten) {  /**< Test: adaptive interval */
+    teamcore::rasp::AdaptiveInterval interval(100, 1000, 2.0);
+    EXPECT_EQ(100, interval.Current());
+    EXPECT_EQ(200, interval.OnQuiet());
+    EXPECT_EQ(400, interval.OnQuiet());
+    EXPECT_EQ(800, interval.OnQuiet());
+    EXPECT_EQ(1000, interval.OnQuiet());
+    EXPECT_EQ(1000, interval.OnQuiet());
+    interval.Tighten();
+    EXPECT_EQ(100, interval.Current());
+
+    // Invalid ranges are clamped instead of rejected
+    teamcore::rasp::AdaptiveInterval odd(0, -5, 0.5);
+    EXPECT_EQ(1, odd.Current());
+    EXPECT_EQ(1, odd.OnQuiet());
+}
+
+/**
+ * @brief Tests that the monitor relaxes while quiet and tightens on a sensitive operation
+ * @test Verifies the hook check interval grows, resets to its floor on NotifySensitiveOperation,
+ *       and runs are attributed to both quiet and alert periods
+ */
+TEST_F(LocalSportsTest, RASPAdaptiveMonitoringTightensOnSensitiveOperation) {  /**< Test: adaptive monitor */
+    const teamcore::rasp::RASPConfig saved = teamcore::rasp::GetRASPConfig();
+    teamcore::rasp::RASPConfig config = saved;
+    config.logFilePath = "test_rasp_adaptive.log";
+    config.enableDebuggerDetection = false;
+    config.enableChecksumVerification = false;
+    config.enableHookDetection = true;
+    config.autoTerminateOnThreat = false;
+    config.hookInterval.minMs = 10;
+    config.hookInterval.maxMs = 80;
+    config.intervalBackoff = 2.0;
+    config.alertHoldMs = 600000;   // the alert period cannot lapse while the test waits
+    teamcore::rasp::ConfigureRASP(config);
+
+    // Waits on monitor state, not on elapsed time; the deadline only bounds a hung monitor
+    auto waitUntil = [](const std::function<bool()>& done) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+        while (!done() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        return done();
+    };
+
+    EXPECT_EQ(-1, teamcore::rasp::GetCheckIntervalMs("hooks"));
+    const bool hooksClean = teamcore::rasp::DetectPLTHooks() + teamcore::rasp::DetectIATHooks() <= 0;
+    teamcore::rasp::StartAdaptiveMonitoring();
+    EXPECT_EQ(10, teamcore::rasp::GetCheckIntervalMs("hooks"));
+    EXPECT_EQ(-1, teamcore::rasp::GetCheckIntervalMs("debugger"));
+
+    if (hooksClean) {
+        // 10 -> 20 -> 40 -> 80 after three clean runs, then capped
+        EXPECT_TRUE(waitUntil([] { return teamcore::rasp::GetCheckIntervalMs("hooks") == 80; }));
+        EXPECT_GE(teamcore::rasp::GetMonitoringStats().quietRuns, 3);
+    }
+
+    teamcore::rasp::NotifySensitiveOperation("login");
+    EXPECT_EQ(10, teamcore::rasp::GetCheckIntervalMs("hooks"));
+    EXPECT_TRUE(waitUntil([] { return teamcore::rasp::GetMonitoringStats().alertRuns >= 2; }));
+    EXPECT_EQ(10, teamcore::rasp::GetCheckIntervalMs("hooks"));   // no back-off while alerted
+    const teamcore::rasp::MonitoringStats stats = teamcore::rasp::GetMonitoringStats();
+    teamcore::rasp::StopAdaptiveMonitoring();
+    EXPECT_EQ(-1, teamcore::rasp::GetCheckIntervalMs("hooks"));
+
+    if (hooksClean) {
+        EXPECT_GT(stats.quietWallMs, 0.0);
+    }
+    EXPECT_GT(stats.alertWallMs, 0.0);
+
+    teamcore::rasp::ClearSecurityLog();
+    teamcore::rasp::ConfigureRASP(saved);
+    std::remove(config.logFilePath.c_str());
+}
+
+/**
+ * @brief Tests that the adaptive monitor writes expired repeat summaries on its own
+ * @test Verifies the summary reaches the log file without another event, a log read or shutdown
+ */
+TEST_F(LocalSportsTest, RASPAdaptiveMonitoringFlushesEventSummaries) {  /**< Test: periodic summary flush */
+    const teamcore::rasp::RASPConfig saved = teamcore::rasp::GetRASPConfig();
+    teamcore::rasp::RASPConfig config = saved;
+    config.logFilePath = "test_rasp_adaptive_flush.log";
+    config.enableDebuggerDetection = false;
+    config.enableChecksumVerification = false;
+    config.enableHookDetection = true;
+    config.autoTerminateOnThreat = false;
+    config.hookInterval.minMs = 5000;   // the flush must not depend on a check coming due
+    config.hookInterval.maxMs = 5000;
+    config.eventWindowMs = 20;
+    std::remove(config.logFilePath.c_str());
+    teamcore::rasp::ConfigureRASP(config);
+    teamcore::rasp::ClearSecurityLog();
+
+    teamcore::rasp::StartAdaptiveMonitoring();
+    teamcore::rasp::SecurityEvent evt;
+    evt.timestamp = "2025-01-01 10:00:00";
+    evt.eventType = "TEST_REPEAT";
+    evt.description = "repeated";
+    evt.severity = 1;
+    teamcore::rasp::LogSecurityEvent(evt);
+    teamcore::rasp::LogSecurityEvent(evt);   // suppressed into the open window
+
+    bool summarized = false;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (!summarized && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        std::ifstream in(config.logFilePath.c_str());
+        std::string line;
+        while (std::getline(in, line)) {
+            summarized = summarized || line.find("(tekrar x1") != std::string::npos;
+        }
+    }
+    teamcore::rasp::StopAdaptiveMonitoring();
+    EXPECT_TRUE(summarized);
+
+    teamcore::rasp::ClearSecurityLog();
+    teamcore::rasp::ConfigureRASP(saved);
+    std::remove(config.logFilePath.c_str());
+}
+
+/**
+ * @brief Benchmark: monitoring CPU overhead while quiet vs while alerted
+ * @test Verifies the alert period runs checks more often; reports CPU overhead of each period
+ */
+TEST_F(LocalSportsTest, DISABLED_BenchRASPAdaptiveMonitoringOverhead) {  /**< Benchmark: adaptive monitoring */
+    const teamcore::rasp::RASPConfig saved = teamcore::rasp::GetRASPConfig();
+    teamcore::rasp::RASPConfig config = saved;
+    config.logFilePath = "test_rasp_adaptive_bench.log";
+    config.enableDebuggerDetection = false;
+    config.enableChecksumVerification = false;
+    config.enableHookDetection = true;
+    config.autoTerminateOnThreat = false;
+    config.hookInterval.minMs = 5;
+    config.hookInterval.maxMs = 250;
+    config.alertHoldMs = 500;
+    teamcore::rasp::ConfigureRASP(config);
+
+    teamcore::rasp::StartAdaptiveMonitoring();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    for (int i = 0; i < 2; ++i) {
+        teamcore::rasp::NotifySensitiveOperation("backup");
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    const teamcore::rasp::MonitoringStats stats = teamcore::rasp::GetMonitoringStats();
+    teamcore::rasp::StopAdaptiveMonitoring();
+
+    EXPECT_GT(stats.alertRuns / std::max(1.0, stats.alertWallMs), stats.quietRuns / std::max(1.0, stats.quietWallMs));
+    std::cerr << "[BENCH] adaptive monitoring: quiet " << stats.QuietOverheadPercent() << "% CPU (" << stats.quietRuns
+              << " checks / " << stats.quietWallMs << "ms), alert " << stats.AlertOverheadPercent() << "% CPU ("
+              << stats.alertRuns << " checks / " << stats.alertWallMs << "ms)\n";
+
+    teamcore::rasp::ClearSecurityLog();
+    teamcore::rasp::ConfigureRASP(saved);
+    std::remove(config.logFilePath.c_str());
+}
+
+// =================== Page Checksum Tests ===================
+
+/**
+ * @brief Helper: fill a checksummed test database and checkpoint it into the main file
+ */
+static void FillChecksumTestDb(const char* path, int rows) {
+    sqlite3* db = OpenPageTestDb(path, "ls-cksum-test");  /**< Fresh file through the checksum VFS */
+    sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr);
+    for (int i = 0; i < rows; ++i) {
+        std::string sql = "INSERT INTO players(name,email) VALUES('player_" + std::to_string(i) +
+                          "','p" + std::to_string(i) + "@club.test');";
+        sqlite3_exec(db, sql.c_str(), nullptr, nullptr, nullptr);
+    }
+    sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+    sqlite3_exec(db, "PRAGMA wal_checkpoint(TRUNCATE);", nullptr, nullptr, nullptr);
+    sqlite3_close(db);
+}
+
+/**
+ * @brief Helper: flip one byte of a page directly in the file (out-of-band edit)
+ */
+static void FlipPageByte(const char* path, int64_t page, int pageSize, int offset) {
+    std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);  /**< Raw file */
+    const std::streamoff pos = static_cast<std::streamoff>((page - 1) * pageSize + offset);
+    char c = 0;
+    f.seekg(pos);
+    f.get(c);
+    f.seekp(pos);
+    f.put(static_cast<char>(c ^ 0x20));
+}
+
+/**
+ * @brief Test that a byte edited outside SQLite is caught on read and by VerifyPages
+ * @test Verifies a clean sweep, the exact bad page after the edit, and IOERR through the VFS
+ */
+TEST_F(LocalSportsTest, PageChecksumDetectsOutOfBandEdit) {  /**< Test: checksum codec */
+    const char* path = "test_page_cksum.db";  /**< Test database */
+    std::shared_ptr<teamcore::pagevfs::PageCodec> codec = teamcore::pagevfs::MakeChecksumCodec();
+    ASSERT_TRUE(teamcore::pagevfs::RegisterPageVfs("ls-cksum-test", codec));
+    FillChecksumTestDb(path, 400);
+
+    teamcore::pagevfs::PageScanResult r;  /**< Whole-file sweep */
+    ASSERT_TRUE(teamcore::pagevfs::VerifyPages(path, *codec, 1, 1 << 20, &r));
+    EXPECT_TRUE(r.transformed);
+    EXPECT_GT(r.pageCount, 3);
+    EXPECT_EQ(r.pageCount, r.pagesChecked);
+    EXPECT_TRUE(r.badPages.empty());
+    EXPECT_EQ(1, r.nextPage);
+    EXPECT_TRUE(FileContains(path, "player_42"));  /**< Integrity only: pages stay plaintext */
+
+    FlipPageByte(path, 3, 4096, 2000);
+    ASSERT_TRUE(teamcore::pagevfs::VerifyPages(path, *codec, 1, 1 << 20, &r));
+    ASSERT_EQ(1u, r.badPages.size());
+    EXPECT_EQ(3, r.badPages[0]);
+
+    teamcore::pagevfs::PageScanResult part;  /**< Resumable range */
+    ASSERT_TRUE(teamcore::pagevfs::VerifyPages(path, *codec, 2, 2, &part));
+    EXPECT_EQ(2, part.pagesChecked);
+    EXPECT_EQ(4, part.nextPage);
+    EXPECT_EQ(1u, part.badPages.size());
+
+    sqlite3* db = nullptr;  /**< Reading the edited page fails instead of returning altered rows */
+    ASSERT_EQ(SQLITE_OK, sqlite3_open_v2(path, &db, SQLITE_OPEN_READWRITE, "ls-cksum-test"));
+    EXPECT_EQ(-1, CountRows(db, "players"));
+    sqlite3_close(db);
+
+    teamcore::pagevfs::PageScanResult plain;  /**< Databases without the codec layout are skipped */
+    sqlite3* pdb = OpenPageTestDb("test_page_cksum_plain.db", nullptr);
+    sqlite3_close(pdb);
+    ASSERT_TRUE(teamcore::pagevfs::VerifyPages("test_page_cksum_plain.db", *codec, 1, 100, &plain));
+    EXPECT_FALSE(plain.transformed);
+    EXPECT_EQ(0, plain.pagesChecked);
+    EXPECT_FALSE(teamcore::pagevfs::VerifyPages("test_page_cksum_missing.db", *codec, 1, 100, &plain));
+    RemoveWalTestDb(path);
+    RemoveWalTestDb("test_page_cksum_plain.db");
+}
+
+/**
+ * @brief Test WAL crash recovery through both page codecs
+ * @test Verifies a child that commits in WAL mode and dies without closing loses no rows
+ */
+TEST_F(LocalSportsTest, PageVfsRecoversWalAfterCrash) {  /**< Test: PageVfs - crash recovery */
+#ifndef _WIN32
+    ASSERT_TRUE(RegisterTestPageVfs("ls-crypt-test", 0x41));
+    ASSERT_TRUE(teamcore::pagevfs::RegisterPageVfs("ls-cksum-test", teamcore::pagevfs::MakeChecksumCodec()));
+    const char* vfs[] = { "ls-crypt-test", "ls-cksum-test" };
+    for (int k = 0; k < 2; ++k) {
+        const char* path = "test_page_vfs_crash.db";  /**< Crash image */
+        RemoveWalTestDb(path);
+        fflush(nullptr);
+        const pid_t pid = fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0) {  /**< Child: commit 50 rows, then die without checkpoint or close */
+            sqlite3* db = OpenPageTestDb(path, vfs[k]);
+            sqlite3_exec(db, "PRAGMA wal_autocheckpoint=0;", nullptr, nullptr, nullptr);
+            for (int i = 0; i < 50; ++i) {
+                sqlite3_exec(db, "INSERT INTO players(name,email) VALUES('c','c@club.test');", nullptr, nullptr, nullptr);
+            }
+            _exit(0);
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+        ASSERT_TRUE(WIFEXITED(status));
+
+        sqlite3* rec = nullptr;  /**< Recovery replays the WAL through the same VFS */
+        ASSERT_EQ(SQLITE_OK, sqlite3_open_v2(path, &rec, SQLITE_OPEN_READWRITE, vfs[k]));
+        EXPECT_EQ(50, CountRows(rec, "players")) << vfs[k];
+        EXPECT_EQ(1, QueryIntValue(rec, "SELECT COUNT(*) FROM pragma_integrity_check WHERE integrity_check='ok';")) << vfs[k];
+        sqlite3_close(rec);
+        RemoveWalTestDb(path);
+    }
+#endif
+}
+
+/**
+ * @brief Test the throttled background verifier
+ * @test Verifies repeated sweeps report a corrupted page exactly once
+ */
+TEST_F(LocalSportsTest, PageVerifierReportsMismatchOnce) {  /**< Test: PageVerifier */
+    const char* path = "test_page_verifier.db";  /**< Test database */
+    std::shared_ptr<teamcore::pagevfs::PageCodec> codec = teamcore::pagevfs::MakeChecksumCodec();
+    ASSERT_TRUE(teamcore::pagevfs::RegisterPageVfs("ls-cksum-test", codec));
+    FillChecksumTestDb(path, 400);
+    FlipPageByte(path, 4, 4096, 100);
+
+    std::mutex mutex;  /**< Guards reports (sink runs on the verifier thread) */
+    std::vector<int64_t> reports;
+    teamcore::pagevfs::VerifierConfig config;
+    config.pagesPerSecond = 2000;
+    config.batchPages = 4;
+    teamcore::pagevfs::PageVerifier verifier;
+    ASSERT_TRUE(verifier.Start(path, codec, config, [&](const std::string&, int64_t page) {
+        std::lock_guard<std::mutex> lock(mutex);
+        reports.push_back(page);
+    }));
+    EXPECT_FALSE(verifier.Start(path, codec, config, teamcore::pagevfs::MismatchSink()));  /**< Already running */
+    for (int i = 0; i < 300 && verifier.Stats().sweeps < 3; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    verifier.Stop();
+
+    const teamcore::pagevfs::VerifierStats stats = verifier.Stats();
+    EXPECT_GE(stats.sweeps, 3u);
+    EXPECT_EQ(1u, stats.mismatches);
+    ASSERT_EQ(1u, reports.size());
+    EXPECT_EQ(4, reports[0]);
+    RemoveWalTestDb(path);
+}
+
+/**
+ * @brief Test LS page checksum mode end to end on a tenant database
+ * @test Verifies new tenant databases get the checksum layout and stay readable
+ */
+TEST_F(LocalSportsTest, PageChecksumsModeCreatesChecksummedTenant) {  /**< Test: LS_SetPageChecksums */
+    LS_SetPageChecksums(true);
+    LS_Init();  /**< Registers "ls-cksum" */
+    LS_ConfigureTenants("test_tenants_cksum", 4);
+    ASSERT_TRUE(LS_SelectTenant("club_cksum"));
+    provideInput("CHECKSUM_MODE_MESSAGE\n");
+    LS_AddMessageInteractive();
+
+    sqlite3* db = nullptr;  /**< Second connection through the same VFS */
+    ASSERT_EQ(SQLITE_OK, sqlite3_open_v2("test_tenants_cksum/club_cksum.db", &db, SQLITE_OPEN_READWRITE,
+                                         teamcore::pagevfs::CHECKSUM_VFS_NAME));
+    EXPECT_TRUE(teamcore::pagevfs::IsPageTransformed(db));
+    EXPECT_TRUE(static_cast<bool>(teamcore::pagevfs::CodecOf(db)));
+    EXPECT_EQ(1, QueryIntValue(db, "SELECT COUNT(*) FROM pragma_integrity_check WHERE integrity_check='ok';"));
+    sqlite3_close(db);
+
+    LS_SelectTenant(nullptr);
+    LS_ConfigureTenants("test_tenants_cksum", 4);  /**< Closes tenant handles */
+    LS_SetPageChecksums(false);
+    RemoveTenantDb("test_tenants_cksum", "club_cksum");
+    std::remove("test_tenants_cksum");
+}
+
+/**
+ * @brief Benchmark: checksum VFS overhead on write and cold-read throughput, and sweep speed
+ * @test Verifies both databases hold the same rows; reports the cost of each path
+ */
+TEST_F(LocalSportsTest, DISABLED_BenchPageChecksumOverhead) {  /**< Benchmark: checksum VFS */
+    const int kRows = 20000;  /**< Players per database */
+    const int kScans = 5;  /**< Full table scans with a tiny cache */
+    std::shared_ptr<teamcore::pagevfs::PageCodec> codec = teamcore::pagevfs::MakeChecksumCodec();
+    ASSERT_TRUE(teamcore::pagevfs::RegisterPageVfs("ls-cksum-test", codec));
+    typedef std::chrono::duration<double, std::milli> ms;
+    const char* paths[] = { "test_bench_cksum_plain.db", "test_bench_cksum.db" };
+    const char* vfs[] = { nullptr, "ls-cksum-test" };
+    double writeMs[2], readMs[2];
+    int64_t rows[2] = { 0, 0 };
+
+    for (int k = 0; k < 2; ++k) {
+        sqlite3* db = OpenPageTestDb(paths[k], vfs[k]);
+        auto t0 = std::chrono::steady_clock::now();
+        sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr);
+        sqlite3_stmt* ins = nullptr;
+        sqlite3_prepare_v2(db, "INSERT INTO players(name,email) VALUES(?,?);", -1, &ins, nullptr);
+        for (int i = 0; i < kRows; ++i) {
+            std::string email = "user" + std::to_string(i) + "@club.test";
+            sqlite3_bind_text(ins, 1, "player", -1, SQLITE_STATIC);
+            sqlite3_bind_text(ins, 2, email.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_step(ins);
+            sqlite3_reset(ins);
+        }
+        sqlite3_finalize(ins);
+        sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+        sqlite3_exec(db, "PRAGMA wal_checkpoint(TRUNCATE);", nullptr, nullptr, nullptr);
+        auto t1 = std::chrono::steady_clock::now();
+
+        sqlite3_exec(db, "PRAGMA cache_size=-64;", nullptr, nullptr, nullptr);  /**< Small cache: reads hit the VFS */
+        sqlite3_stmt* st = nullptr;
+        sqlite3_prepare_v2(db, "SELECT email FROM players;", -1, &st, nullptr);
+        for (int s = 0; s < kScans; ++s) {
+            while (sqlite3_step(st) == SQLITE_ROW) ++rows[k];
+            sqlite3_reset(st);
+        }
+        sqlite3_finalize(st);
+        auto t2 = std::chrono::steady_clock::now();
+        writeMs[k] = ms(t1 - t0).count();
+        readMs[k] = ms(t2 - t1).count();
+        sqlite3_close(db);
+    }
+    EXPECT_EQ(rows[0], rows[1]);
+    EXPECT_EQ(static_cast<int64_t>(kRows) * kScans, rows[1]);
+
+    teamcore::pagevfs::PageScanResult r;  /**< One unthrottled sweep */
+    auto t3 = std::chrono::steady_clock::now();
+    ASSERT_TRUE(teamcore::pagevfs::VerifyPages(paths[1], *codec, 1, 1 << 20, &r));
+    auto t4 = std::chrono::steady_clock::now();
+    EXPECT_TRUE(r.badPages.empty());
+    const double sweepMs = ms(t4 - t3).count();
+
+    std::cerr << "[BENCH] checksum VFS rows=" << kRows << " write: plain=" << writeMs[0] << "ms cksum=" << writeMs[1]
+              << "ms | " << kScans << " cold scans: plain=" << readMs[0] << "ms cksum=" << readMs[1]
+              << "ms | sweep " << r.pagesChecked << " pages in " << sweepMs << "ms ("
+              << (sweepMs > 0 ? r.pagesChecked * 4096.0 / 1048.576 / sweepMs : 0.0) << " MB/s)\n";
+    RemoveWalTestDb(paths[0]);
+    RemoveWalTestDb(paths[1]);
+}
+
 // =================== MAIN FUNCTION ===================
 
 /**
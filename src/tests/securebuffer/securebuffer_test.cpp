@@ -0,0 +1,232 @@
+/**
+ * @file securebuffer_test.cpp
+ * @brief Allocation tests for SecureBuffer
+ * @details Replaces the global operator new/delete to count heap allocations. The replacement
+ *          applies to the whole program, so these tests live in their own executable instead
+ *          of LocalSports_tests.
+ *
+ * @section usage Usage
+ * @code
+ * ./SecureBuffer_tests
+ * @endcode
+ *
+ * @see security_layer.h for API documentation
+ */
+
+#include "gtest/gtest.h"
+#include "../../localsports/header/security_layer.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+// =================== Counting Allocator ===================
+
+static thread_local long t_heapAllocs = 0;  /**< operator new calls on this thread */
+
+// GCC flags the std::free inside these replacements once they are inlined into gtest's
+// "new TestClass" (-Wmismatched-new-delete); malloc/free is the matching pair here
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+/**
+ * @brief Counting global allocator; every replaceable form is routed through it
+ */
+void* operator new(std::size_t n) {
+    ++t_heapAllocs;
+    void* p = std::malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t n) {
+    return operator new(n);
+}
+
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept {
+    ++t_heapAllocs;
+    return std::malloc(n ? n : 1);
+}
+
+void* operator new[](std::size_t n, const std::nothrow_t& tag) noexcept {
+    return operator new(n, tag);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+#if defined(__cpp_sized_deallocation)
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+#endif
+
+#if defined(__cpp_aligned_new)
+static void* AlignedAlloc(std::size_t n, std::align_val_t al) noexcept {
+    const std::size_t a = static_cast<std::size_t>(al);
+#ifdef _WIN32
+    return _aligned_malloc(n ? n : 1, a);
+#else
+    return std::aligned_alloc(a, ((n ? n : 1) + a - 1) / a * a);  // size must be a multiple of the alignment
+#endif
+}
+
+static void AlignedFree(void* p) noexcept {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+/**
+ * @brief Over-aligned forms (C++17)
+ */
+void* operator new(std::size_t n, std::align_val_t al) {
+    ++t_heapAllocs;
+    void* p = AlignedAlloc(n, al);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t n, std::align_val_t al) {
+    return operator new(n, al);
+}
+
+void* operator new(std::size_t n, std::align_val_t al, const std::nothrow_t&) noexcept {
+    ++t_heapAllocs;
+    return AlignedAlloc(n, al);
+}
+
+void* operator new[](std::size_t n, std::align_val_t al, const std::nothrow_t& tag) noexcept {
+    return operator new(n, al, tag);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    AlignedFree(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept {
+    AlignedFree(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    AlignedFree(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+    AlignedFree(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    AlignedFree(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    AlignedFree(p);
+}
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+// =================== SecureBuffer Allocation Tests ===================
+
+/**
+ * @brief Fixture for allocation-counting tests
+ * @details Counts are per thread; SetUp zeroes the counter of the thread running the test.
+ */
+class SecureBufferAllocTest : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        t_heapAllocs = 0;
+    }
+};
+
+/**
+ * @brief Test that keys, salts and nonces stay off the heap
+ * @test Verifies construct/move/resize within the inline capacity allocate nothing and contents survive moves
+ */
+TEST_F(SecureBufferAllocTest, SmallSizesSkipHeap) {  /**< Test: SecureBuffer inline storage */
+    const long before = t_heapAllocs;
+    {
+        teamcore::SecureBuffer key(32);
+        teamcore::SecureBuffer salt(16);
+        teamcore::SecureBuffer nonce(12);
+        std::memset(key.data(), 0xAB, key.size());
+        teamcore::SecureBuffer moved(std::move(key));
+        EXPECT_EQ(0u, key.size());
+        EXPECT_EQ(nullptr, key.data());
+        ASSERT_EQ(32u, moved.size());
+        EXPECT_EQ(0xAB, moved.data()[31]);
+        salt = std::move(moved);
+        EXPECT_EQ(0xAB, salt.data()[0]);
+        salt.resize(64);
+        EXPECT_EQ(0xAB, salt.data()[31]);
+        EXPECT_EQ(0, salt.data()[32]);  /**< Grown tail is zeroed */
+        salt.resize(16);
+        nonce.resize(0);
+        EXPECT_EQ(nullptr, nonce.data());
+    }
+    EXPECT_EQ(before, t_heapAllocs);
+
+    // AppKey pattern: empty buffer resized to a key, filled by the KDF
+    unsigned char salt16[16] = { 1, 2, 3 };
+    const long beforeKdf = t_heapAllocs;
+    teamcore::SecureBuffer appKey;
+    appKey.resize(32);
+    EXPECT_EQ(beforeKdf, t_heapAllocs);
+    ASSERT_TRUE(teamcore::crypto::DeriveKeyFromPassphrase("p", salt16, sizeof(salt16), 10, appKey.data()));
+}
+
+/**
+ * @brief Test the heap path and inline/heap transitions
+ * @test Verifies large buffers allocate once, moves transfer ownership and shrinking back keeps the prefix
+ */
+TEST_F(SecureBufferAllocTest, LargeSizesUseHeap) {  /**< Test: SecureBuffer heap storage */
+    const long before = t_heapAllocs;
+    teamcore::SecureBuffer big(teamcore::SecureBuffer::INLINE_CAPACITY + 1);
+    EXPECT_EQ(before + 1, t_heapAllocs);
+    big.data()[0] = 0x42;
+    const unsigned char* heapPtr = big.data();
+    teamcore::SecureBuffer owner(std::move(big));
+    EXPECT_EQ(heapPtr, owner.data());  /**< Heap storage is handed over, not copied */
+    EXPECT_EQ(before + 1, t_heapAllocs);
+
+    owner.resize(8);  /**< Back to inline */
+    EXPECT_NE(heapPtr, owner.data());
+    EXPECT_EQ(0x42, owner.data()[0]);
+    EXPECT_EQ(before + 1, t_heapAllocs);
+
+    teamcore::SecureBuffer grow(16);
+    grow.data()[15] = 7;
+    grow.resize(1000);
+    EXPECT_EQ(before + 2, t_heapAllocs);
+    EXPECT_EQ(7, grow.data()[15]);
+    EXPECT_EQ(0, grow.data()[999]);
+}
@@ -31,6 +31,7 @@
 #include "../../utility/header/commonTypes.h"
 #include "../../utility/header/mathUtility.h"
 
+#include <cmath>
 #include <fstream>
 #include <sys/stat.h>
 #include <cstdio>
@@ -221,6 +222,39 @@ TEST_F(MathUtilityTest, CalculateMinMaxTest_2) {
   EXPECT_DOUBLE_EQ(max, 7.2);  /**< Verify maximum value is 7.2 */
 }
 
+/**
+ * @brief Test sample standard deviation calculation
+ * @test Verifies that calculateStdDev uses the n-1 denominator
+ * @details Tests with array [2, 4, 4, 4, 5, 5, 7, 9] (mean 5, sum of squares 32)
+ * @return Expected result: sqrt(32/7)
+ */
+TEST_F(MathUtilityTest, CalculateStdDevTest) {
+  const double data[] = { 2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0 };  /**< Array of test values */
+  const int datalen = sizeof(data) / sizeof(data[0]);  /**< Length of the data array */
+  EXPECT_NEAR(MathUtility::calculateStdDev(data, datalen), 2.138089935, 1e-9);  /**< sqrt(32/7) */
+  EXPECT_DOUBLE_EQ(MathUtility::calculateStdDev(data, 1), 0.0);  /**< Single value has no spread */
+}
+
+/**
+ * @brief Test quantile calculation with interpolation
+ * @test Verifies that calculateQuantile interpolates between closest ranks
+ * @details Tests with unsorted array [4, 1, 3, 2, 5]
+ * @return Expected results: q0=1, q0.5=median, q0.9=4.6, q1=5; out-of-range quantiles clamp,
+ *         NaN quantiles and empty arrays give 0
+ */
+TEST_F(MathUtilityTest, CalculateQuantileTest) {
+  const double data[] = { 4.0, 1.0, 3.0, 2.0, 5.0 };  /**< Unsorted array of test values */
+  const int datalen = sizeof(data) / sizeof(data[0]);  /**< Length of the data array */
+  EXPECT_DOUBLE_EQ(MathUtility::calculateQuantile(data, datalen, 0.0), 1.0);  /**< Minimum */
+  EXPECT_DOUBLE_EQ(MathUtility::calculateQuantile(data, datalen, 0.5), MathUtility::calculateMedian(data, datalen));  /**< Matches median */
+  EXPECT_NEAR(MathUtility::calculateQuantile(data, datalen, 0.9), 4.6, 1e-12);  /**< 4 + 0.6 * (5 - 4) */
+  EXPECT_DOUBLE_EQ(MathUtility::calculateQuantile(data, datalen, 1.0), 5.0);  /**< Maximum */
+  EXPECT_DOUBLE_EQ(MathUtility::calculateQuantile(data, datalen, -0.5), 1.0);  /**< Clamped to 0 */
+  EXPECT_DOUBLE_EQ(MathUtility::calculateQuantile(data, datalen, 7.0), 5.0);  /**< Clamped to 1 */
+  EXPECT_DOUBLE_EQ(MathUtility::calculateQuantile(data, datalen, std::nan("")), 0.0);  /**< NaN rejected */
+  EXPECT_DOUBLE_EQ(MathUtility::calculateQuantile(data, 0, 0.5), 0.0);  /**< Empty array */
+}
+
 
 
 
@@ -68,6 +68,31 @@ class MathUtility {
    */
   static void calculateMinMax(const double fiArray[], int fiArrayLen, double *foMin, double *foMax);
 
+  /**
+   * @brief Calculates the sample standard deviation of an array of data.
+   *
+   * This function calculates the sample (n-1) standard deviation of the given array of data.
+   * Arrays with fewer than two elements have no spread and yield 0.
+   *
+   * @param fiArray The array of data.
+   * @param fiArrayLen The length of the data array.
+   * @return The calculated standard deviation.
+   */
+  static double calculateStdDev(const double fiArray[], int fiArrayLen);
+
+  /**
+   * @brief Calculates a quantile of an array of data.
+   *
+   * This function sorts a copy of the data and linearly interpolates between the
+   * closest ranks, so a quantile of 0.5 matches calculateMedian.
+   *
+   * @param fiArray The array of data.
+   * @param fiArrayLen The length of the data array.
+   * @param fiQuantile The quantile to calculate; values outside [0, 1] are clamped.
+   * @return The calculated quantile, or 0.0 for an empty array or a NaN quantile.
+   */
+  static double calculateQuantile(const double fiArray[], int fiArrayLen, double fiQuantile);
+
 };
 }
 }
@@ -4,6 +4,8 @@
  * @brief Provides functions for math. utilities
  */
 
+#include <cmath>
+#include <cstdlib>
 #include <cstring>
 
 #include "../header/mathUtility.h"
@@ -69,3 +71,46 @@ void MathUtility::calculateMinMax(const double data[], int datalen, double* min,
   }
 }
 
+
+double MathUtility::calculateStdDev(const double data[], int datalen) {
+  if (datalen < 2) {
+    return 0.0;
+  }
+
+  double mean = calculateMean(data, datalen);
+  double sumSq = 0.0;
+
+  for (int i = 0; i < datalen; ++i) {
+    double diff = data[i] - mean;
+    sumSq += diff * diff;
+  }
+
+  return std::sqrt(sumSq / (datalen - 1));
+}
+
+double MathUtility::calculateQuantile(const double data[], int datalen, double quantile) {
+  if (datalen <= 0 || std::isnan(quantile)) {
+    return 0.0;
+  }
+
+  if (quantile < 0.0) {
+    quantile = 0.0;
+  } else if (quantile > 1.0) {
+    quantile = 1.0;
+  }
+
+  double *sortedData = new double[datalen];
+  memcpy(sortedData, data, sizeof(double) * datalen);
+  qsort(sortedData, datalen, sizeof(double), compareDouble);
+
+  double position = quantile * (datalen - 1);
+  int lower = static_cast<int>(position);
+  double result = sortedData[lower];
+
+  if (lower + 1 < datalen) {
+    result += (position - lower) * (sortedData[lower + 1] - sortedData[lower]);
+  }
+
+  delete[] sortedData;
+  return result;
+}